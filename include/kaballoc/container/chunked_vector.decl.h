@@ -0,0 +1,376 @@
+#pragma once
+
+#include "kaballoc/trait/relocatable.h"
+#include "kaballoc/memory/detail/destroy.h"
+#include "kaballoc/memory/byte_span.h"
+#include "kaballoc/range/detail/begin.h"
+#include "kaballoc/range/detail/end.h"
+#include "kaballoc/core/ptrdiff_t.h"
+
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace kab
+{
+	namespace detail
+	{
+		/**
+		 * Random access iterator over the elements of a 'chunked_vector'
+		 *
+		 * The iterator stores a pointer to the chunk directory and an index, so it stays valid as long as the directory is not reallocated
+		 */
+		template<typename T, size_t ElementsPerChunk>
+		class chunked_vector_iterator
+		{
+			using element_type = std::remove_const_t<T>;
+
+			template<typename, size_t>
+			friend class chunked_vector_iterator;
+
+			element_type* const* m_chunks = nullptr;
+			size_t m_index = 0;
+
+		public:
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = element_type;
+			using difference_type = ptrdiff_t;
+			using pointer = T*;
+			using reference = T&;
+
+			chunked_vector_iterator() = default;
+			chunked_vector_iterator(element_type* const* chunks, size_t index) noexcept
+				: m_chunks(chunks)
+				, m_index(index)
+			{
+
+			}
+
+			// Conversion from a mutable iterator to a const iterator
+			template<typename U, typename = std::enable_if_t<std::is_same_v<U const, T> && !std::is_same_v<U, T>>>
+			chunked_vector_iterator(chunked_vector_iterator<U, ElementsPerChunk> const& rhs) noexcept
+				: m_chunks(rhs.m_chunks)
+				, m_index(rhs.m_index)
+			{
+
+			}
+
+			[[nodiscard]] reference operator*() const { return m_chunks[m_index / ElementsPerChunk][m_index % ElementsPerChunk]; }
+			[[nodiscard]] pointer operator->() const { return &**this; }
+			[[nodiscard]] reference operator[](difference_type n) const { return *(*this + n); }
+
+			chunked_vector_iterator& operator++() noexcept { ++m_index; return *this; }
+			chunked_vector_iterator& operator--() noexcept { --m_index; return *this; }
+			chunked_vector_iterator operator++(int) noexcept { auto const it = *this; ++m_index; return it; }
+			chunked_vector_iterator operator--(int) noexcept { auto const it = *this; --m_index; return it; }
+			chunked_vector_iterator& operator+=(difference_type n) noexcept { m_index += n; return *this; }
+			chunked_vector_iterator& operator-=(difference_type n) noexcept { m_index -= n; return *this; }
+
+			[[nodiscard]] friend chunked_vector_iterator operator+(chunked_vector_iterator it, difference_type n) noexcept { return it += n; }
+			[[nodiscard]] friend chunked_vector_iterator operator+(difference_type n, chunked_vector_iterator it) noexcept { return it += n; }
+			[[nodiscard]] friend chunked_vector_iterator operator-(chunked_vector_iterator it, difference_type n) noexcept { return it -= n; }
+			[[nodiscard]] friend difference_type operator-(chunked_vector_iterator const& lhs, chunked_vector_iterator const& rhs) noexcept
+			{
+				return static_cast<difference_type>(lhs.m_index) - static_cast<difference_type>(rhs.m_index);
+			}
+
+			[[nodiscard]] friend bool operator==(chunked_vector_iterator const& lhs, chunked_vector_iterator const& rhs) noexcept { return lhs.m_index == rhs.m_index; }
+			[[nodiscard]] friend bool operator!=(chunked_vector_iterator const& lhs, chunked_vector_iterator const& rhs) noexcept { return lhs.m_index != rhs.m_index; }
+			[[nodiscard]] friend bool operator<(chunked_vector_iterator const& lhs, chunked_vector_iterator const& rhs) noexcept { return lhs.m_index < rhs.m_index; }
+			[[nodiscard]] friend bool operator>(chunked_vector_iterator const& lhs, chunked_vector_iterator const& rhs) noexcept { return lhs.m_index > rhs.m_index; }
+			[[nodiscard]] friend bool operator<=(chunked_vector_iterator const& lhs, chunked_vector_iterator const& rhs) noexcept { return lhs.m_index <= rhs.m_index; }
+			[[nodiscard]] friend bool operator>=(chunked_vector_iterator const& lhs, chunked_vector_iterator const& rhs) noexcept { return lhs.m_index >= rhs.m_index; }
+		};
+	}
+
+	/**
+	 * 'chunked_vector' is a dynamically-resizing segmented container with stable element addresses
+	 *
+	 * The elements are stored in fixed-size chunks of ChunkByteSize bytes, and a chunk directory maps an index to its chunk in O(1).
+	 * Growing the container allocates new chunks and never moves the existing elements:
+	 * pointers and references to elements stay valid until the element is removed.
+	 * Only the chunk directory (one pointer per chunk) is reallocated as the container grows.
+	 *
+	 * Every chunk is allocated with exactly ChunkByteSize bytes and the alignment of T, so a 'freelist_resource' with a block size of ChunkByteSize
+	 * can recycle the chunks. The directory is allocated from the same resource, using the over-allocation functions if available.
+	 * Chunks are kept when elements are removed, and only freed by 'shrink_to_fit', 'clear_and_shrink' or the destructor.
+	 *
+	 * The MemoryResource needs to match the kab::memory_resource concept.
+	 *
+	 * chunked_vector is never copyable, is noexcept moveable if the resource is moveable, and is trivially relocatable if the resource is relocatable or empty
+	 *
+	 * As a general rule, functions that have preconditions or functions that can allocate are not marked noexcept, but everything else should be
+	 */
+	template<typename T, typename MemoryResource, size_t ChunkByteSize = 4096>
+	class chunked_vector : MemoryResource {
+	public:
+		/**
+		 * The number of elements stored in each chunk
+		 */
+		static constexpr size_t elements_per_chunk = ChunkByteSize / sizeof(T);
+
+	private:
+		static_assert(elements_per_chunk > 0, "The chunk size must be big enough for at least one element");
+
+		[[nodiscard]] MemoryResource& access_resource() & noexcept { return static_cast<MemoryResource&>(*this); }
+		[[nodiscard]] MemoryResource const& access_resource() const& noexcept { return static_cast<MemoryResource const&>(*this); }
+		[[nodiscard]] MemoryResource&& access_resource() && noexcept { return static_cast<MemoryResource&&>(*this); }
+
+		T** m_chunks = nullptr; // chunk directory
+		size_t m_chunk_count = 0; // number of allocated chunks
+		size_t m_directory_byte_capacity = 0;
+		size_t m_size = 0;
+
+		[[nodiscard]] T* element(size_t i) const noexcept { return m_chunks[i / elements_per_chunk] + (i % elements_per_chunk); }
+
+		void destroy_range(size_t first, size_t last) noexcept;
+		void free_storage() noexcept;
+		void free_chunks(size_t first_chunk) noexcept;
+		void reallocate_directory(size_t new_chunk_capacity);
+		void ensure_capacity(size_t n);
+	public:
+		/**
+		 * chunked_vector is default constructible if the memory resource is default constructible
+		 */
+		chunked_vector() = default;
+		/**
+		 * chunked_vector is never copy constructible
+		 */
+		chunked_vector(chunked_vector const&) = delete;
+		/**
+		 * chunked_vector is noexcept move constructible if the memory resource is moveable
+		 */
+		chunked_vector(chunked_vector && rhs) noexcept;
+		/**
+		 * chunked_vector is never copy assignable
+		 */
+		chunked_vector& operator=(chunked_vector const& rhs) = delete;
+		/**
+		 * chunked_vector is move assignable if the memory resource is moveable
+		 */
+		chunked_vector& operator=(chunked_vector && rhs) noexcept;
+
+		/**
+		 * Destroys all the elements, frees the chunks and the directory, and destroys the memory resource
+		 */
+		~chunked_vector();
+
+		/**
+		 * chunked_vector is swappable if the memory resource is swappable
+		 */
+		void swap(chunked_vector& rhs) noexcept;
+
+		using value_type = T;
+		using memory_resource = MemoryResource;
+		using iterator = detail::chunked_vector_iterator<T, elements_per_chunk>;
+		using const_iterator = detail::chunked_vector_iterator<T const, elements_per_chunk>;
+		using sentinel = iterator;
+		using const_sentinel = const_iterator;
+
+		/**
+		 * If the memory resource is moveable, this constructor lets the user provide a resource value
+		 */
+		explicit chunked_vector(memory_resource r) noexcept
+			: MemoryResource(std::move(r))
+		{
+
+		}
+
+		/**
+		 * Returns the memory resource value used in this container
+		 */
+		[[nodiscard]] memory_resource get_resource() const noexcept { return access_resource(); }
+
+		/**
+		 * Factory function creating a chunked_vector using another container, copying its memory resource and copying its element range.
+		 *
+		 * Requires:
+		 *   - Container is a valid ResourceAwareContainer
+		 *   - The element type of Container can construct T
+		 */
+		template<typename Container>
+		static chunked_vector from_container(Container const& c)
+		{
+			chunked_vector v(c.get_resource());
+			v.insert_back(c);
+			return v;
+		}
+
+		/**
+		 * Returns whether the container has no elements
+		 *
+		 * Note that the capacity may not necessarily be zero if this is true
+		 */
+		[[nodiscard]] bool is_empty() const noexcept { return m_size == 0; }
+
+		/**
+		 * Returns the number of constructed elements
+		 */
+		[[nodiscard]] size_t size() const noexcept { return m_size; }
+
+		/**
+		 * Returns the capacity of the container, which is the number of allocated chunks times 'elements_per_chunk'
+		 *
+		 * As long as the resulting size is smaller or equal to this capacity, constructing functions will not allocate
+		 */
+		[[nodiscard]] size_t capacity() const noexcept { return m_chunk_count * elements_per_chunk; }
+
+		/**
+		 * Returns the number of allocated chunks
+		 */
+		[[nodiscard]] size_t chunk_count() const noexcept { return m_chunk_count; }
+
+		/**
+		 * Returns the maximum possible capacity for the current chunked_vector type
+		 */
+		[[nodiscard]] static constexpr size_t max_capacity() noexcept;
+
+		/**
+		 * 'begin' and 'end' return iterators to the element range of the container
+		 *
+		 * If called with const access, this will return const iterators
+		 */
+		[[nodiscard]] iterator begin() noexcept { return { m_chunks, 0 }; }
+		[[nodiscard]] sentinel end() noexcept { return { m_chunks, m_size }; }
+		[[nodiscard]] const_iterator begin() const noexcept { return { m_chunks, 0 }; }
+		[[nodiscard]] const_sentinel end() const noexcept { return { m_chunks, m_size }; }
+
+		/**
+		 * Returns a reference to the first element of the container
+		 *
+		 * Precondition: The size must be at least 1
+		 */
+		[[nodiscard]] T & front() { return *m_chunks[0]; }
+		[[nodiscard]] T const& front() const { return *m_chunks[0]; }
+
+		/**
+		 * Returns a reference to the last element of the container.
+		 *
+		 * Precondition: The size must be at least 1
+		 */
+		[[nodiscard]] T & back() { return *element(m_size - 1); }
+		[[nodiscard]] T const& back() const { return *element(m_size - 1); }
+
+		/**
+		 * Operator[]. Accesses elements of the container using a zero-based index, returning a reference to the specified element.
+		 *
+		 * Precondition: 'i' must be smaller than the size
+		 */
+		[[nodiscard]] T & operator[](size_t i) { return *element(i); }
+		[[nodiscard]] T const& operator[](size_t i) const { return *element(i); }
+
+		/**
+		 * Construct a new default-initialized element at the back of the container
+		 *
+		 * Requires: T is DefaultConstructible
+		 */
+		T & push_back();
+
+		/**
+		 * Constructs 'n' new default-initialized elements at the back of the container
+		 *
+		 * Requires: T is DefaultConstructible
+		 */
+		void push_back_n(size_t n);
+
+		/**
+		 * Constructs a new element at the back of the container by copying the provided argument
+		 *
+		 * Requires: T is CopyConstructible
+		 */
+		T & push_back(T const& e);
+
+		/**
+		 * Constructs a new element at the back of the container by moving the provided argument
+		 *
+		 * Requires: T must be MoveConstructible
+		 */
+		T & push_back(T && e);
+
+		/**
+		 * Constructs a new element at the back of the container from the provided arguments
+		 *
+		 * Requires: 'T' must be constructible from the provided arguments
+		 */
+		template<typename... Args>
+		T & emplace_back(Args&&... args)
+		{
+			ensure_capacity(m_size + 1);
+			T* ptr = new(element(m_size)) T(std::forward<Args>(args)...);
+			++m_size;
+
+			return *ptr;
+		}
+
+		/**
+		 * Removes the last element of the container.
+		 *
+		 * Precondition: The size of the container must be at least 1
+		 */
+		void pop_back();
+
+		/**
+		 * Inserts an entire Range at the back of the container
+		 *
+		 * Requires: T must be constructible from the element type of Range
+		 */
+		template<typename Range>
+		void insert_back(Range&& r)
+		{
+			auto it = kab::range::begin(r);
+			auto const sent = kab::range::end(r);
+			for (; it != sent; ++it) {
+				emplace_back(*it);
+			}
+		}
+
+		/**
+		 * Allocates chunks until the capacity is at least 'n', without changing the size of the container
+		 */
+		void reserve(size_t n);
+
+		/**
+		 * Changes the size of the container, allocating chunks and constructing or destroying elements as necessary
+		 * New elements are default-initialized
+		 */
+		void resize(size_t n);
+
+		/**
+		 * Removes all elements from the container, making its size 0
+		 * Does not free the chunks.
+		 */
+		void clear() noexcept;
+
+		/**
+		 * Removes all elements from the container, making its size 0, then frees the chunks and the directory.
+		 */
+		void clear_and_shrink() noexcept;
+
+		/**
+		 * Frees the chunks that hold no element. Never moves elements, and never allocates.
+		 * If the container is empty, the directory is freed as well
+		 */
+		void shrink_to_fit() noexcept;
+	};
+
+	template<typename T, typename MemoryResource, size_t ChunkByteSize>
+	struct is_trivially_relocatable<chunked_vector<T, MemoryResource, ChunkByteSize>>
+		: std::conditional_t<std::is_empty_v<MemoryResource> || is_trivially_relocatable_v<MemoryResource>, std::true_type, std::false_type>
+	{
+
+	};
+}
+
+/**
+ * Macro to declare a specialization of the 'chunked_vector' template, with the default chunk size
+ *
+ * By having a matching KAB_CONTAINER_CHUNKED_VECTOR_IMPL in a compiled object, other
+ * translation units are free to use only this declaration without having to import the entire template
+ *
+ * The template signature of 'chunked_vector' is not guaranteed, so use this macro rather than making your own declarations
+ */
+#define KAB_CONTAINER_CHUNKED_VECTOR_DECL(ElementType, ResourceType) \
+	namespace kab { \
+		extern template class chunked_vector<ElementType, ResourceType>; \
+	}
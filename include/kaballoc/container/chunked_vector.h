@@ -0,0 +1,17 @@
+#pragma once
+
+#include "kaballoc/container/chunked_vector.decl.h"
+#include "kaballoc/container/detail/chunked_vector.inl.h"
+
+/**
+ * Macro to define a specialization of the 'chunked_vector' template, with the default chunk size
+ *
+ * By having this KAB_CONTAINER_CHUNKED_VECTOR_IMPL in a compiled object, other
+ * translation units are free to use only the declaration header, not having to import the entire template
+ *
+ * The template signature of 'chunked_vector' is not guaranteed, so use this macro rather than making your own declarations
+ */
+#define KAB_CONTAINER_CHUNKED_VECTOR_IMPL(ElementType, ResourceType) \
+	namespace kab { \
+		template class chunked_vector<ElementType, ResourceType>; \
+	}
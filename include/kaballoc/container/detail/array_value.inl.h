@@ -3,6 +3,7 @@
 #include <iterator>
 
 #include "kaballoc/memory/resource.h"
+#include "kaballoc/memory/detail/over_allocate.h"
 #include "kaballoc/core/atomic_op.h"
 
 namespace kab
@@ -11,7 +12,7 @@ namespace kab
 	auto array_value<ElementT, ResourceT>::new_control(ResourceT& r, size_t size) -> control*
 	{
 		const auto alloc_size = sizeof(control) + (size - 1) * sizeof(ElementT);
-		byte_span const s = r.allocate(alloc_size, align_v<control>);
+		byte_span const s = detail::allocate_or_throw(r, alloc_size, align_v<control>);
 		auto const c = new(s.data) control;
 		c->count = 1;
 		c->size = size;
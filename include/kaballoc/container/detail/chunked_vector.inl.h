@@ -0,0 +1,255 @@
+#pragma once
+
+#include "kaballoc/memory/detail/over_allocate.h"
+#include "kaballoc/memory/detail/uninitialized_construct.h"
+
+#include <string.h>
+#include <algorithm>
+#include <utility>
+
+namespace kab
+{
+	template<typename T, typename R, size_t C>
+	void chunked_vector<T, R, C>::destroy_range(size_t first, size_t last) noexcept
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>)
+		{
+			while (first != last)
+			{
+				size_t const offset = first % elements_per_chunk;
+				size_t const count = std::min(last - first, elements_per_chunk - offset);
+				kab::destroy_n(m_chunks[first / elements_per_chunk] + offset, count);
+				first += count;
+			}
+		}
+	}
+
+	template<typename T, typename R, size_t C>
+	void chunked_vector<T, R, C>::free_chunks(size_t first_chunk) noexcept
+	{
+		for (size_t i = first_chunk; i < m_chunk_count; ++i)
+		{
+			access_resource().deallocate({ reinterpret_cast<byte*>(m_chunks[i]), C }, align_v<T>);
+		}
+		m_chunk_count = first_chunk;
+	}
+
+	template<typename T, typename R, size_t C>
+	void chunked_vector<T, R, C>::free_storage() noexcept
+	{
+		free_chunks(0);
+		if (m_chunks != nullptr)
+		{
+			detail::over_deallocate(access_resource(), { reinterpret_cast<byte*>(m_chunks), m_directory_byte_capacity }, align_v<T*>);
+		}
+	}
+
+	template<typename T, typename R, size_t C>
+	void chunked_vector<T, R, C>::reallocate_directory(size_t new_chunk_capacity)
+	{
+		byte_span const new_block = detail::over_allocate_or_throw(access_resource(), new_chunk_capacity * sizeof(T*), align_v<T*>);
+		auto const new_directory = reinterpret_cast<T**>(new_block.data);
+
+		// Only the chunk pointers move, the elements stay where they are
+		if (m_chunk_count != 0)
+		{
+			memcpy(new_directory, m_chunks, m_chunk_count * sizeof(T*));
+		}
+
+		if (m_chunks != nullptr)
+		{
+			detail::over_deallocate(access_resource(), { reinterpret_cast<byte*>(m_chunks), m_directory_byte_capacity }, align_v<T*>);
+		}
+
+		m_chunks = new_directory;
+		m_directory_byte_capacity = new_block.size;
+	}
+
+	template<typename T, typename R, size_t C>
+	void chunked_vector<T, R, C>::ensure_capacity(size_t n)
+	{
+		if (n <= capacity())
+		{
+			return;
+		}
+
+		size_t const needed_chunks = (n + elements_per_chunk - 1) / elements_per_chunk;
+		size_t const directory_capacity = m_directory_byte_capacity / sizeof(T*);
+		if (directory_capacity < needed_chunks)
+		{
+			reallocate_directory(std::max(needed_chunks, directory_capacity * 2));
+		}
+
+		while (m_chunk_count < needed_chunks)
+		{
+			byte_span const chunk = detail::allocate_or_throw(access_resource(), C, align_v<T>);
+			m_chunks[m_chunk_count] = reinterpret_cast<T*>(chunk.data);
+			++m_chunk_count;
+		}
+	}
+
+	template<typename T, typename R, size_t C>
+	chunked_vector<T, R, C>::chunked_vector(chunked_vector && rhs) noexcept
+		: R(std::move(rhs).access_resource())
+		, m_chunks(std::exchange(rhs.m_chunks, nullptr))
+		, m_chunk_count(std::exchange(rhs.m_chunk_count, 0))
+		, m_directory_byte_capacity(std::exchange(rhs.m_directory_byte_capacity, 0))
+		, m_size(std::exchange(rhs.m_size, 0))
+	{
+
+	}
+
+	template<typename T, typename R, size_t C>
+	auto chunked_vector<T, R, C>::operator=(chunked_vector && rhs) noexcept -> chunked_vector&
+	{
+		if (this != &rhs)
+		{
+			destroy_range(0, m_size);
+			free_storage();
+
+			access_resource() = std::move(rhs).access_resource();
+			m_chunks = std::exchange(rhs.m_chunks, nullptr);
+			m_chunk_count = std::exchange(rhs.m_chunk_count, 0);
+			m_directory_byte_capacity = std::exchange(rhs.m_directory_byte_capacity, 0);
+			m_size = std::exchange(rhs.m_size, 0);
+		}
+
+		return *this;
+	}
+
+	template<typename T, typename R, size_t C>
+	chunked_vector<T, R, C>::~chunked_vector()
+	{
+		destroy_range(0, m_size);
+		free_storage();
+	}
+
+	template<typename T, typename R, size_t C>
+	void chunked_vector<T, R, C>::swap(chunked_vector& rhs) noexcept
+	{
+		using std::swap;
+		swap(access_resource(), rhs.access_resource());
+		swap(m_chunks, rhs.m_chunks);
+		swap(m_chunk_count, rhs.m_chunk_count);
+		swap(m_directory_byte_capacity, rhs.m_directory_byte_capacity);
+		swap(m_size, rhs.m_size);
+	}
+
+	template<typename T, typename R, size_t C>
+	constexpr size_t chunked_vector<T, R, C>::max_capacity() noexcept
+	{
+		return size_t_max_v / sizeof(T);
+	}
+
+	template<typename T, typename R, size_t C>
+	auto chunked_vector<T, R, C>::push_back() -> T &
+	{
+		ensure_capacity(m_size + 1);
+		T* ptr = new(element(m_size)) T;
+		++m_size;
+
+		return *ptr;
+	}
+
+	template<typename T, typename R, size_t C>
+	void chunked_vector<T, R, C>::push_back_n(size_t n)
+	{
+		ensure_capacity(m_size + n);
+
+		// Construct chunk by chunk, removing every new element if a constructor throws
+		size_t const previous_size = m_size;
+		try
+		{
+			while (n != 0)
+			{
+				size_t const offset = m_size % elements_per_chunk;
+				size_t const count = std::min(n, elements_per_chunk - offset);
+				kab::uninitialized_default_construct_n(m_chunks[m_size / elements_per_chunk] + offset, count);
+				m_size += count;
+				n -= count;
+			}
+		}
+		catch (...)
+		{
+			destroy_range(previous_size, m_size);
+			m_size = previous_size;
+			throw;
+		}
+	}
+
+	template<typename T, typename R, size_t C>
+	auto chunked_vector<T, R, C>::push_back(T const& e) -> T &
+	{
+		ensure_capacity(m_size + 1);
+		T* ptr = new(element(m_size)) T(e);
+		++m_size;
+
+		return *ptr;
+	}
+
+	template<typename T, typename R, size_t C>
+	auto chunked_vector<T, R, C>::push_back(T && e) -> T &
+	{
+		ensure_capacity(m_size + 1);
+		T* ptr = new(element(m_size)) T(std::move(e));
+		++m_size;
+
+		return *ptr;
+	}
+
+	template<typename T, typename R, size_t C>
+	void chunked_vector<T, R, C>::pop_back()
+	{
+		--m_size;
+		kab::destroy_at(element(m_size));
+	}
+
+	template<typename T, typename R, size_t C>
+	void chunked_vector<T, R, C>::reserve(size_t n)
+	{
+		ensure_capacity(n);
+	}
+
+	template<typename T, typename R, size_t C>
+	void chunked_vector<T, R, C>::resize(size_t n)
+	{
+		if (m_size < n) {
+			push_back_n(n - m_size);
+		}
+		else if (m_size > n) {
+			destroy_range(n, m_size);
+			m_size = n;
+		}
+	}
+
+	template<typename T, typename R, size_t C>
+	void chunked_vector<T, R, C>::clear() noexcept
+	{
+		destroy_range(0, m_size);
+		m_size = 0;
+	}
+
+	template<typename T, typename R, size_t C>
+	void chunked_vector<T, R, C>::clear_and_shrink() noexcept
+	{
+		destroy_range(0, m_size);
+		free_storage();
+		m_chunks = nullptr;
+		m_directory_byte_capacity = 0;
+		m_size = 0;
+	}
+
+	template<typename T, typename R, size_t C>
+	void chunked_vector<T, R, C>::shrink_to_fit() noexcept
+	{
+		if (m_size == 0)
+		{
+			free_storage();
+			m_chunks = nullptr;
+			m_directory_byte_capacity = 0;
+			return;
+		}
+
+		free_chunks((m_size + elements_per_chunk - 1) / elements_per_chunk);
+	}
+}
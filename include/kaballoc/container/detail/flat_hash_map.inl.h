@@ -0,0 +1,391 @@
+#pragma once
+
+#include "kaballoc/memory/detail/over_allocate.h"
+#include "kaballoc/memory/detail/uninitialized_relocate.h"
+
+#include <string.h>
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+namespace kab
+{
+	template<typename K, typename V, typename R, typename H, typename E>
+	constexpr size_t flat_hash_map<K, V, R, H, E>::capacity_for(size_t n) noexcept
+	{
+		// Smallest power of two number of groups keeping the load under 7/8
+		size_t capacity = detail::hash_group_width;
+		while (max_load(capacity) < n)
+		{
+			capacity *= 2;
+		}
+		return capacity;
+	}
+
+	template<typename K, typename V, typename R, typename H, typename E>
+	constexpr size_t flat_hash_map<K, V, R, H, E>::slot_offset(size_t capacity) noexcept
+	{
+		// Control bytes and the sentinel, padded to the alignment of the slots
+		size_t const ctrl_size = capacity + 1;
+		return (ctrl_size + alignof(value_type) - 1) / alignof(value_type) * alignof(value_type);
+	}
+
+	template<typename K, typename V, typename R, typename H, typename E>
+	constexpr align_t flat_hash_map<K, V, R, H, E>::storage_alignment() noexcept
+	{
+		// Groups of control bytes are loaded with aligned loads
+		return static_cast<align_t>(std::max(detail::hash_group_width, alignof(value_type)));
+	}
+
+	template<typename K, typename V, typename R, typename H, typename E>
+	size_t flat_hash_map<K, V, R, H, E>::find_free_slot(detail::hash_ctrl const* ctrl, size_t capacity, size_t mixed) noexcept
+	{
+		size_t const group_mask = capacity / detail::hash_group_width - 1;
+		size_t group = detail::hash_h1(mixed) & group_mask;
+		for (size_t step = 1;; ++step)
+		{
+			detail::hash_group const g(ctrl + group * detail::hash_group_width);
+			uint32_t const mask = g.match_empty_or_deleted();
+			if (mask != 0)
+			{
+				return group * detail::hash_group_width + static_cast<size_t>(std::countr_zero(mask));
+			}
+			group = (group + step) & group_mask;
+		}
+	}
+
+	template<typename K, typename V, typename R, typename H, typename E>
+	void flat_hash_map<K, V, R, H, E>::relocate_slot(value_type* src, value_type* dst)
+	{
+		if constexpr (is_slot_trivially_relocatable)
+		{
+			memcpy(static_cast<void*>(dst), static_cast<void const*>(src), sizeof(value_type));
+		}
+		else
+		{
+			kab::uninitialized_relocate(src, src + 1, dst);
+		}
+	}
+
+	template<typename K, typename V, typename R, typename H, typename E>
+	void flat_hash_map<K, V, R, H, E>::destroy_slots(detail::hash_ctrl const* ctrl, value_type* slots, size_t capacity) noexcept
+	{
+		if constexpr (!std::is_trivially_destructible_v<value_type>)
+		{
+			for (size_t i = 0; i < capacity; ++i)
+			{
+				if (ctrl[i] >= 0)
+				{
+					kab::destroy_at(slots + i);
+				}
+			}
+		}
+	}
+
+	template<typename K, typename V, typename R, typename H, typename E>
+	size_t flat_hash_map<K, V, R, H, E>::find_index(K const& key, size_t mixed) const
+	{
+		if (m_size == 0)
+		{
+			return m_capacity;
+		}
+
+		detail::hash_ctrl const h2 = detail::hash_h2(mixed);
+		size_t const group_mask = m_capacity / detail::hash_group_width - 1;
+		size_t group = detail::hash_h1(mixed) & group_mask;
+		for (size_t step = 1;; ++step)
+		{
+			size_t const first = group * detail::hash_group_width;
+			detail::hash_group const g(m_ctrl + first);
+			for (uint32_t mask = g.match(h2); mask != 0; mask &= mask - 1)
+			{
+				size_t const i = first + static_cast<size_t>(std::countr_zero(mask));
+				if (m_equal(m_slots[i].first, key))
+				{
+					return i;
+				}
+			}
+
+			// No probe sequence goes past a group with an empty slot
+			if (g.match_empty() != 0)
+			{
+				return m_capacity;
+			}
+			group = (group + step) & group_mask;
+		}
+	}
+
+	template<typename K, typename V, typename R, typename H, typename E>
+	void flat_hash_map<K, V, R, H, E>::free_storage() noexcept
+	{
+		if (m_ctrl != nullptr)
+		{
+			detail::over_deallocate(access_resource(), { reinterpret_cast<byte*>(m_ctrl), m_byte_size }, storage_alignment());
+		}
+	}
+
+	template<typename K, typename V, typename R, typename H, typename E>
+	void flat_hash_map<K, V, R, H, E>::rehash(size_t new_capacity)
+	{
+		byte_span const new_block = detail::over_allocate_or_throw(access_resource(), slot_offset(new_capacity) + new_capacity * sizeof(value_type), storage_alignment());
+		auto const new_ctrl = reinterpret_cast<detail::hash_ctrl*>(new_block.data);
+		auto const new_slots = reinterpret_cast<value_type*>(new_block.data + slot_offset(new_capacity));
+		memset(new_ctrl, static_cast<unsigned char>(detail::hash_ctrl_empty), new_capacity);
+		new_ctrl[new_capacity] = detail::hash_ctrl_sentinel;
+
+		if constexpr (!is_slot_copied_on_rehash)
+		{
+			// Elements are marked empty in the old table before being relocated (a throwing relocation destroys the source),
+			// so that on failure, both tables can be destroyed without destroying an element twice
+			try
+			{
+				for (size_t i = 0; i < m_capacity; ++i)
+				{
+					if (m_ctrl[i] >= 0)
+					{
+						size_t const mixed = detail::hash_mix(m_hash(m_slots[i].first));
+						size_t const dst = find_free_slot(new_ctrl, new_capacity, mixed);
+						m_ctrl[i] = detail::hash_ctrl_empty;
+						relocate_slot(m_slots + i, new_slots + dst);
+						new_ctrl[dst] = detail::hash_h2(mixed);
+					}
+				}
+			}
+			catch (...)
+			{
+				destroy_slots(m_ctrl, m_slots, m_capacity);
+				destroy_slots(new_ctrl, new_slots, new_capacity);
+				detail::over_deallocate(access_resource(), new_block, storage_alignment());
+				free_storage();
+				m_ctrl = nullptr;
+				m_slots = nullptr;
+				m_capacity = 0;
+				m_size = 0;
+				m_growth_left = 0;
+				m_byte_size = 0;
+				throw;
+			}
+		}
+		else
+		{
+			// Copy every element first, so that a throwing copy leaves the map unchanged
+			try
+			{
+				for (size_t i = 0; i < m_capacity; ++i)
+				{
+					if (m_ctrl[i] >= 0)
+					{
+						size_t const mixed = detail::hash_mix(m_hash(m_slots[i].first));
+						size_t const dst = find_free_slot(new_ctrl, new_capacity, mixed);
+						new(new_slots + dst) value_type(m_slots[i]);
+						new_ctrl[dst] = detail::hash_h2(mixed);
+					}
+				}
+			}
+			catch (...)
+			{
+				destroy_slots(new_ctrl, new_slots, new_capacity);
+				detail::over_deallocate(access_resource(), new_block, storage_alignment());
+				throw;
+			}
+
+			destroy_slots(m_ctrl, m_slots, m_capacity);
+		}
+
+		// Free the previous storage
+		free_storage();
+
+		// Use the new storage
+		m_ctrl = new_ctrl;
+		m_slots = new_slots;
+		m_capacity = new_capacity;
+		m_growth_left = max_load(new_capacity) - m_size;
+		m_byte_size = new_block.size;
+	}
+
+	template<typename K, typename V, typename R, typename H, typename E>
+	template<typename Key, typename... Args>
+	auto flat_hash_map<K, V, R, H, E>::try_emplace_impl(Key&& key, Args&&... args) -> std::pair<iterator, bool>
+	{
+		size_t const mixed = detail::hash_mix(m_hash(key));
+		size_t const found = find_index(key, mixed);
+		if (found != m_capacity)
+		{
+			return { iterator(m_ctrl + found, m_slots + found, false), false };
+		}
+
+		if (m_capacity == 0)
+		{
+			rehash(capacity_for(1));
+		}
+
+		size_t i = find_free_slot(m_ctrl, m_capacity, mixed);
+		if (m_growth_left == 0 && m_ctrl[i] == detail::hash_ctrl_empty)
+		{
+			// Rehashing at the same capacity is enough to clear the deleted slots, if there are enough of them
+			rehash(capacity_for(m_size + 1));
+			i = find_free_slot(m_ctrl, m_capacity, mixed);
+		}
+
+		new(m_slots + i) value_type(std::piecewise_construct, std::forward_as_tuple(std::forward<Key>(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+
+		if (m_ctrl[i] == detail::hash_ctrl_empty)
+		{
+			--m_growth_left;
+		}
+		m_ctrl[i] = detail::hash_h2(mixed);
+		++m_size;
+
+		return { iterator(m_ctrl + i, m_slots + i, false), true };
+	}
+
+	template<typename K, typename V, typename R, typename H, typename E>
+	flat_hash_map<K, V, R, H, E>::flat_hash_map(flat_hash_map && rhs) noexcept
+		: R(std::move(rhs).access_resource())
+		, m_ctrl(std::exchange(rhs.m_ctrl, nullptr))
+		, m_slots(std::exchange(rhs.m_slots, nullptr))
+		, m_capacity(std::exchange(rhs.m_capacity, 0))
+		, m_size(std::exchange(rhs.m_size, 0))
+		, m_growth_left(std::exchange(rhs.m_growth_left, 0))
+		, m_byte_size(std::exchange(rhs.m_byte_size, 0))
+		, m_hash(rhs.m_hash)
+		, m_equal(rhs.m_equal)
+	{
+
+	}
+
+	template<typename K, typename V, typename R, typename H, typename E>
+	auto flat_hash_map<K, V, R, H, E>::operator=(flat_hash_map && rhs) noexcept -> flat_hash_map&
+	{
+		if (this != &rhs)
+		{
+			destroy_slots(m_ctrl, m_slots, m_capacity);
+			free_storage();
+
+			access_resource() = std::move(rhs).access_resource();
+			m_ctrl = std::exchange(rhs.m_ctrl, nullptr);
+			m_slots = std::exchange(rhs.m_slots, nullptr);
+			m_capacity = std::exchange(rhs.m_capacity, 0);
+			m_size = std::exchange(rhs.m_size, 0);
+			m_growth_left = std::exchange(rhs.m_growth_left, 0);
+			m_byte_size = std::exchange(rhs.m_byte_size, 0);
+			m_hash = rhs.m_hash;
+			m_equal = rhs.m_equal;
+		}
+
+		return *this;
+	}
+
+	template<typename K, typename V, typename R, typename H, typename E>
+	flat_hash_map<K, V, R, H, E>::~flat_hash_map()
+	{
+		destroy_slots(m_ctrl, m_slots, m_capacity);
+		free_storage();
+	}
+
+	template<typename K, typename V, typename R, typename H, typename E>
+	void flat_hash_map<K, V, R, H, E>::swap(flat_hash_map& rhs) noexcept
+	{
+		using std::swap;
+		swap(access_resource(), rhs.access_resource());
+		swap(m_ctrl, rhs.m_ctrl);
+		swap(m_slots, rhs.m_slots);
+		swap(m_capacity, rhs.m_capacity);
+		swap(m_size, rhs.m_size);
+		swap(m_growth_left, rhs.m_growth_left);
+		swap(m_byte_size, rhs.m_byte_size);
+		swap(m_hash, rhs.m_hash);
+		swap(m_equal, rhs.m_equal);
+	}
+
+	template<typename K, typename V, typename R, typename H, typename E>
+	auto flat_hash_map<K, V, R, H, E>::find(K const& key) -> iterator
+	{
+		size_t const i = find_index(key, detail::hash_mix(m_hash(key)));
+		return { m_ctrl + i, m_slots + i, false };
+	}
+
+	template<typename K, typename V, typename R, typename H, typename E>
+	auto flat_hash_map<K, V, R, H, E>::find(K const& key) const -> const_iterator
+	{
+		size_t const i = find_index(key, detail::hash_mix(m_hash(key)));
+		return { m_ctrl + i, m_slots + i, false };
+	}
+
+	template<typename K, typename V, typename R, typename H, typename E>
+	bool flat_hash_map<K, V, R, H, E>::contains(K const& key) const
+	{
+		return find_index(key, detail::hash_mix(m_hash(key))) != m_capacity;
+	}
+
+	template<typename K, typename V, typename R, typename H, typename E>
+	size_t flat_hash_map<K, V, R, H, E>::erase(K const& key)
+	{
+		size_t const i = find_index(key, detail::hash_mix(m_hash(key)));
+		if (i == m_capacity)
+		{
+			return 0;
+		}
+
+		erase(const_iterator(m_ctrl + i, m_slots + i, false));
+		return 1;
+	}
+
+	template<typename K, typename V, typename R, typename H, typename E>
+	auto flat_hash_map<K, V, R, H, E>::erase(const_iterator it) -> iterator
+	{
+		size_t const i = static_cast<size_t>(&*it - m_slots);
+		kab::destroy_at(m_slots + i);
+		--m_size;
+
+		// If the group still has an empty slot, no probe sequence went past it, and the slot can be empty again.
+		// Otherwise, lookups must keep probing past this slot
+		detail::hash_group const g(m_ctrl + i / detail::hash_group_width * detail::hash_group_width);
+		if (g.match_empty() != 0)
+		{
+			m_ctrl[i] = detail::hash_ctrl_empty;
+			++m_growth_left;
+		}
+		else
+		{
+			m_ctrl[i] = detail::hash_ctrl_deleted;
+		}
+
+		return { m_ctrl + i, m_slots + i, true };
+	}
+
+	template<typename K, typename V, typename R, typename H, typename E>
+	void flat_hash_map<K, V, R, H, E>::reserve(size_t n)
+	{
+		size_t const new_capacity = capacity_for(n);
+		if (new_capacity > m_capacity)
+		{
+			rehash(new_capacity);
+		}
+	}
+
+	template<typename K, typename V, typename R, typename H, typename E>
+	void flat_hash_map<K, V, R, H, E>::clear() noexcept
+	{
+		destroy_slots(m_ctrl, m_slots, m_capacity);
+		if (m_ctrl != nullptr)
+		{
+			memset(m_ctrl, static_cast<unsigned char>(detail::hash_ctrl_empty), m_capacity);
+		}
+		m_size = 0;
+		m_growth_left = max_load(m_capacity);
+	}
+
+	template<typename K, typename V, typename R, typename H, typename E>
+	void flat_hash_map<K, V, R, H, E>::clear_and_shrink() noexcept
+	{
+		destroy_slots(m_ctrl, m_slots, m_capacity);
+		free_storage();
+		m_ctrl = nullptr;
+		m_slots = nullptr;
+		m_capacity = 0;
+		m_size = 0;
+		m_growth_left = 0;
+		m_byte_size = 0;
+	}
+}
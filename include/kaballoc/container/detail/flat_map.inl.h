@@ -0,0 +1,207 @@
+#pragma once
+
+#include "kaballoc/container/vector.h"
+#include "kaballoc/range/lower_bound.h"
+#include "kaballoc/range/rotate.h"
+#include "kaballoc/range/sort.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace kab
+{
+	template<typename K, typename V, typename R, typename C>
+	void flat_map<K, V, R, C>::sort_unique(size_t sorted_size)
+	{
+		size_t const n = size();
+
+		// Nothing to do if the new keys are already sorted, unique, and after the existing ones
+		size_t i = sorted_size == 0 ? 1 : sorted_size;
+		while (i < n && m_compare(m_keys[i - 1], m_keys[i]))
+		{
+			++i;
+		}
+		if (i >= n)
+		{
+			return;
+		}
+
+		// Sort the indices, ordering equal keys by index so that the first element of every key comes first
+		vector<size_t, R> order(get_resource());
+		order.reserve(n);
+		for (i = 0; i < n; ++i)
+		{
+			order.push_back(i);
+		}
+
+		K const* const keys = m_keys.data();
+		range::sort(order.data(), order.data() + n, [this, keys](size_t lhs, size_t rhs)
+		{
+			if (m_compare(keys[lhs], keys[rhs]))
+			{
+				return true;
+			}
+			if (m_compare(keys[rhs], keys[lhs]))
+			{
+				return false;
+			}
+			return lhs < rhs;
+		});
+
+		// Move the first element of every key to the new storage
+		vector<K, R> sorted_keys(get_resource());
+		vector<V, R> sorted_values(get_resource());
+		sorted_keys.reserve(n);
+		sorted_values.reserve(n);
+		for (size_t const index : order)
+		{
+			if (sorted_keys.is_empty() || m_compare(sorted_keys.back(), m_keys[index]))
+			{
+				sorted_keys.emplace_back(std::move(m_keys[index]));
+				sorted_values.emplace_back(std::move(m_values[index]));
+			}
+		}
+
+		m_keys = std::move(sorted_keys);
+		m_values = std::move(sorted_values);
+	}
+
+	template<typename K, typename V, typename R, typename C>
+	void flat_map<K, V, R, C>::truncate(size_t n) noexcept
+	{
+		while (m_keys.size() > n)
+		{
+			m_keys.pop_back();
+		}
+		while (m_values.size() > n)
+		{
+			m_values.pop_back();
+		}
+	}
+
+	template<typename K, typename V, typename R, typename C>
+	void flat_map<K, V, R, C>::grow_for(size_t n)
+	{
+		size_t const needed = size() + n;
+		if (needed > m_keys.capacity())
+		{
+			m_keys.reserve(std::max(m_keys.capacity() * 2, needed));
+		}
+		if (needed > m_values.capacity())
+		{
+			m_values.reserve(std::max(m_values.capacity() * 2, needed));
+		}
+	}
+
+	template<typename K, typename V, typename R, typename C>
+	template<typename Key, typename... Args>
+	auto flat_map<K, V, R, C>::try_emplace_impl(Key&& key, Args&&... args) -> std::pair<V*, bool>
+	{
+		size_t const n = size();
+		size_t const i = lower_bound(key);
+		if (i != n && !m_compare(key, m_keys[i]))
+		{
+			return { m_values.data() + i, false };
+		}
+
+		// Construct at the back, then rotate the new element into its position
+		grow_for(1);
+		m_keys.emplace_back(std::forward<Key>(key));
+		try
+		{
+			m_values.emplace_back(std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			m_keys.pop_back();
+			throw;
+		}
+
+		range::rotate(m_keys.data() + i, m_keys.data() + n, m_keys.data() + n + 1);
+		range::rotate(m_values.data() + i, m_values.data() + n, m_values.data() + n + 1);
+
+		return { m_values.data() + i, true };
+	}
+
+	template<typename K, typename V, typename R, typename C>
+	void flat_map<K, V, R, C>::swap(flat_map& rhs) noexcept
+	{
+		using std::swap;
+		m_keys.swap(rhs.m_keys);
+		m_values.swap(rhs.m_values);
+		swap(m_compare, rhs.m_compare);
+	}
+
+	template<typename K, typename V, typename R, typename C>
+	size_t flat_map<K, V, R, C>::lower_bound(K const& key) const
+	{
+		K const* const first = m_keys.data();
+		return static_cast<size_t>(range::lower_bound(first, first + size(), key, m_compare) - first);
+	}
+
+	template<typename K, typename V, typename R, typename C>
+	V* flat_map<K, V, R, C>::find(K const& key)
+	{
+		size_t const i = lower_bound(key);
+		return i != size() && !m_compare(key, m_keys[i]) ? m_values.data() + i : nullptr;
+	}
+
+	template<typename K, typename V, typename R, typename C>
+	V const* flat_map<K, V, R, C>::find(K const& key) const
+	{
+		size_t const i = lower_bound(key);
+		return i != size() && !m_compare(key, m_keys[i]) ? m_values.data() + i : nullptr;
+	}
+
+	template<typename K, typename V, typename R, typename C>
+	bool flat_map<K, V, R, C>::contains(K const& key) const
+	{
+		return find(key) != nullptr;
+	}
+
+	template<typename K, typename V, typename R, typename C>
+	size_t flat_map<K, V, R, C>::erase(K const& key)
+	{
+		size_t const n = size();
+		size_t const i = lower_bound(key);
+		if (i == n || m_compare(key, m_keys[i]))
+		{
+			return 0;
+		}
+
+		// Rotate the element to the back, then remove it
+		range::rotate(m_keys.data() + i, m_keys.data() + i + 1, m_keys.data() + n);
+		range::rotate(m_values.data() + i, m_values.data() + i + 1, m_values.data() + n);
+		m_keys.pop_back();
+		m_values.pop_back();
+		return 1;
+	}
+
+	template<typename K, typename V, typename R, typename C>
+	void flat_map<K, V, R, C>::reserve(size_t n)
+	{
+		m_keys.reserve(n);
+		m_values.reserve(n);
+	}
+
+	template<typename K, typename V, typename R, typename C>
+	void flat_map<K, V, R, C>::clear() noexcept
+	{
+		m_keys.clear();
+		m_values.clear();
+	}
+
+	template<typename K, typename V, typename R, typename C>
+	void flat_map<K, V, R, C>::clear_and_shrink() noexcept
+	{
+		m_keys.clear_and_shrink();
+		m_values.clear_and_shrink();
+	}
+
+	template<typename K, typename V, typename R, typename C>
+	void flat_map<K, V, R, C>::shrink_to_fit()
+	{
+		m_keys.shrink_to_fit();
+		m_values.shrink_to_fit();
+	}
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "kaballoc/container/vector.h"
+#include "kaballoc/range/lower_bound.h"
+#include "kaballoc/range/rotate.h"
+#include "kaballoc/range/sort.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace kab
+{
+	template<typename K, typename R, typename C>
+	void flat_set<K, R, C>::sort_unique(size_t sorted_size)
+	{
+		size_t const n = size();
+		K* const first = m_keys.data();
+
+		// Nothing to do if the new keys are already sorted, unique, and after the existing ones
+		size_t i = sorted_size == 0 ? 1 : sorted_size;
+		while (i < n && m_compare(first[i - 1], first[i]))
+		{
+			++i;
+		}
+		if (i >= n)
+		{
+			return;
+		}
+
+		range::sort(first, first + n, m_compare);
+		K* const last = std::unique(first, first + n, [this](K const& lhs, K const& rhs)
+		{
+			return !m_compare(lhs, rhs);
+		});
+		truncate(static_cast<size_t>(last - first));
+	}
+
+	template<typename K, typename R, typename C>
+	void flat_set<K, R, C>::truncate(size_t n) noexcept
+	{
+		while (m_keys.size() > n)
+		{
+			m_keys.pop_back();
+		}
+	}
+
+	template<typename K, typename R, typename C>
+	void flat_set<K, R, C>::swap(flat_set& rhs) noexcept
+	{
+		using std::swap;
+		m_keys.swap(rhs.m_keys);
+		swap(m_compare, rhs.m_compare);
+	}
+
+	template<typename K, typename R, typename C>
+	auto flat_set<K, R, C>::lower_bound(K const& key) const -> const_iterator
+	{
+		return range::lower_bound(m_keys.begin(), m_keys.end(), key, m_compare);
+	}
+
+	template<typename K, typename R, typename C>
+	auto flat_set<K, R, C>::find(K const& key) const -> const_iterator
+	{
+		const_iterator const it = lower_bound(key);
+		return it != end() && !m_compare(key, *it) ? it : end();
+	}
+
+	template<typename K, typename R, typename C>
+	bool flat_set<K, R, C>::contains(K const& key) const
+	{
+		return find(key) != end();
+	}
+
+	template<typename K, typename R, typename C>
+	void flat_set<K, R, C>::grow_for(size_t n)
+	{
+		size_t const needed = size() + n;
+		if (needed > m_keys.capacity())
+		{
+			m_keys.reserve(std::max(m_keys.capacity() * 2, needed));
+		}
+	}
+
+	template<typename K, typename R, typename C>
+	template<typename Key>
+	auto flat_set<K, R, C>::insert_impl(Key&& key) -> std::pair<K const*, bool>
+	{
+		size_t const n = size();
+		size_t const i = static_cast<size_t>(lower_bound(key) - begin());
+		if (i != n && !m_compare(key, m_keys[i]))
+		{
+			return { begin() + i, false };
+		}
+
+		// Construct at the back, then rotate the new key into its position
+		grow_for(1);
+		m_keys.emplace_back(std::forward<Key>(key));
+		range::rotate(m_keys.data() + i, m_keys.data() + n, m_keys.data() + n + 1);
+		return { begin() + i, true };
+	}
+
+	template<typename K, typename R, typename C>
+	size_t flat_set<K, R, C>::erase(K const& key)
+	{
+		size_t const n = size();
+		size_t const i = static_cast<size_t>(lower_bound(key) - begin());
+		if (i == n || m_compare(key, m_keys[i]))
+		{
+			return 0;
+		}
+
+		// Rotate the key to the back, then remove it
+		range::rotate(m_keys.data() + i, m_keys.data() + i + 1, m_keys.data() + n);
+		m_keys.pop_back();
+		return 1;
+	}
+}
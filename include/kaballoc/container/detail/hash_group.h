@@ -0,0 +1,117 @@
+#pragma once
+
+#include "kaballoc/core/size_t.h"
+
+#include <stdint.h>
+
+#if !defined(KAB_HASH_GROUP_SSE2)
+#  if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define KAB_HASH_GROUP_SSE2 1
+#  else
+#    define KAB_HASH_GROUP_SSE2 0
+#  endif
+#endif
+
+#if KAB_HASH_GROUP_SSE2
+#  include <emmintrin.h>
+#endif
+
+namespace kab::detail
+{
+	/**
+	 * Control bytes of an open-addressing hash table
+	 *
+	 * A full slot stores the 7 low bits of the hash (H2), so its control byte is never negative.
+	 * Empty and deleted slots both have their sign bit set, which lets a group find them with a single comparison.
+	 * The sentinel marks the end of the control bytes, so iterators can stop without knowing the capacity.
+	 */
+	using hash_ctrl = signed char;
+
+	inline constexpr hash_ctrl hash_ctrl_empty = -128;
+	inline constexpr hash_ctrl hash_ctrl_deleted = -2;
+	inline constexpr hash_ctrl hash_ctrl_sentinel = -1;
+
+	/**
+	 * Number of control bytes probed at once. Groups are aligned on this width, so a group never spans the end of the table
+	 */
+	inline constexpr size_t hash_group_width = 16;
+
+	/**
+	 * Hashes such as std::hash for integers are often the identity, which would put all the entropy in the low bits.
+	 * The hash is mixed with a multiplication, then split in H1 (probe position) and H2 (control byte)
+	 */
+	[[nodiscard]] inline size_t hash_mix(size_t hash) noexcept
+	{
+		size_t mixed = hash * static_cast<size_t>(0x9E3779B97F4A7C15ull);
+		mixed ^= mixed >> (sizeof(size_t) * 4);
+		return mixed;
+	}
+
+	[[nodiscard]] inline size_t hash_h1(size_t mixed) noexcept { return mixed >> 7; }
+	[[nodiscard]] inline hash_ctrl hash_h2(size_t mixed) noexcept { return static_cast<hash_ctrl>(mixed & 0x7F); }
+
+	/**
+	 * 'hash_group' loads 'hash_group_width' control bytes, and returns bit masks of the slots matching a condition:
+	 * bit i is set if the control byte i matches.
+	 *
+	 * With SSE2, each query is a single compare and movemask. Otherwise, the bytes are compared one by one
+	 */
+	class hash_group
+	{
+#if KAB_HASH_GROUP_SSE2
+		__m128i m_ctrl;
+
+		[[nodiscard]] uint32_t match_byte(hash_ctrl c) const noexcept
+		{
+			return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(m_ctrl, _mm_set1_epi8(c))));
+		}
+
+	public:
+		// 'ctrl' must be aligned on 'hash_group_width'
+		explicit hash_group(hash_ctrl const* ctrl) noexcept
+			: m_ctrl(_mm_load_si128(reinterpret_cast<__m128i const*>(ctrl)))
+		{
+
+		}
+
+		[[nodiscard]] uint32_t match_empty_or_deleted() const noexcept
+		{
+			return static_cast<uint32_t>(_mm_movemask_epi8(m_ctrl));
+		}
+#else
+		hash_ctrl m_ctrl[hash_group_width];
+
+		[[nodiscard]] uint32_t match_byte(hash_ctrl c) const noexcept
+		{
+			uint32_t mask = 0;
+			for (size_t i = 0; i < hash_group_width; ++i)
+			{
+				mask |= static_cast<uint32_t>(m_ctrl[i] == c) << i;
+			}
+			return mask;
+		}
+
+	public:
+		explicit hash_group(hash_ctrl const* ctrl) noexcept
+		{
+			for (size_t i = 0; i < hash_group_width; ++i)
+			{
+				m_ctrl[i] = ctrl[i];
+			}
+		}
+
+		[[nodiscard]] uint32_t match_empty_or_deleted() const noexcept
+		{
+			uint32_t mask = 0;
+			for (size_t i = 0; i < hash_group_width; ++i)
+			{
+				mask |= static_cast<uint32_t>(m_ctrl[i] < 0) << i;
+			}
+			return mask;
+		}
+#endif
+
+		[[nodiscard]] uint32_t match(hash_ctrl h2) const noexcept { return match_byte(h2); }
+		[[nodiscard]] uint32_t match_empty() const noexcept { return match_byte(hash_ctrl_empty); }
+	};
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "kaballoc/memory/detail/over_allocate.h"
+#include "kaballoc/memory/resource.h"
+#include "kaballoc/core/ptrdiff_t.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace kab
+{
+	template<typename T, typename R>
+	void mpmc_queue<T, R>::allocate_cells(size_t capacity)
+	{
+		// With a single cell, the sequence number of a full cell would match the next enqueue position
+		capacity = std::max<size_t>(std::bit_ceil(capacity), 2);
+
+		byte_span const block = detail::over_allocate_or_throw(access_resource(), capacity * sizeof(cell), align_v<cell>);
+		m_cells = reinterpret_cast<cell*>(block.data);
+		m_capacity = std::bit_floor(block.size / sizeof(cell));
+		m_byte_capacity = block.size;
+
+		for (size_t i = 0; i < m_capacity; ++i)
+		{
+			new(&m_cells[i].sequence) std::atomic<size_t>(i);
+		}
+	}
+
+	template<typename T, typename R>
+	auto mpmc_queue<T, R>::claim_enqueue(size_t& position) noexcept -> cell*
+	{
+		position = m_enqueue_position.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			cell* const c = m_cells + (position & mask());
+			auto const difference = static_cast<ptrdiff_t>(c->sequence.load(std::memory_order_acquire) - position);
+			if (difference == 0)
+			{
+				// The cell is free for this lap. On failure, 'position' is reloaded
+				if (m_enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					return c;
+				}
+			}
+			else if (difference < 0)
+			{
+				// The cell still holds the element of the previous lap
+				return nullptr;
+			}
+			else
+			{
+				// Another producer claimed the cell
+				position = m_enqueue_position.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	template<typename T, typename R>
+	auto mpmc_queue<T, R>::claim_dequeue(size_t& position) noexcept -> cell*
+	{
+		position = m_dequeue_position.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			cell* const c = m_cells + (position & mask());
+			auto const difference = static_cast<ptrdiff_t>(c->sequence.load(std::memory_order_acquire) - (position + 1));
+			if (difference == 0)
+			{
+				if (m_dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					return c;
+				}
+			}
+			else if (difference < 0)
+			{
+				// The cell has no element yet
+				return nullptr;
+			}
+			else
+			{
+				// Another consumer claimed the cell
+				position = m_dequeue_position.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	template<typename T, typename R>
+	mpmc_queue<T, R>::~mpmc_queue()
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>)
+		{
+			size_t const enqueue_position = m_enqueue_position.load(std::memory_order_relaxed);
+			for (size_t i = m_dequeue_position.load(std::memory_order_relaxed); i != enqueue_position; ++i)
+			{
+				kab::destroy_at(m_cells[i & mask()].value());
+			}
+		}
+
+		detail::over_deallocate(access_resource(), { reinterpret_cast<byte*>(m_cells), m_byte_capacity }, align_v<cell>);
+	}
+
+	template<typename T, typename R>
+	bool mpmc_queue<T, R>::try_pop(T& out) noexcept
+	{
+		size_t position;
+		cell* const c = claim_dequeue(position);
+		if (c == nullptr)
+		{
+			return false;
+		}
+
+		kab::relocate_assign(c->value(), out);
+		// Frees the cell for the next lap
+		c->sequence.store(position + m_capacity, std::memory_order_release);
+		return true;
+	}
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <iterator>
+
+#include "kaballoc/memory/resource.h"
+#include "kaballoc/memory/detail/over_allocate.h"
+#include "kaballoc/core/atomic_op.h"
+
+namespace kab
+{
+	template<typename ElementT, typename ResourceT>
+	auto offset_array_value<ElementT, ResourceT>::new_control(ResourceT& r, size_t size) -> control*
+	{
+		const auto alloc_size = sizeof(control) + (size - 1) * sizeof(ElementT);
+		byte_span const s = detail::allocate_or_throw(r, alloc_size, align_v<control>);
+		auto const c = new(s.data) control;
+		c->count = 1;
+		c->size = size;
+
+		// don't construct the elements here
+
+		return c;
+	}
+
+	template<typename ElementT, typename ResourceT>
+	auto offset_array_value<ElementT, ResourceT>::acquire_control(control* c) noexcept -> control*
+	{
+		if (c != nullptr)
+		{
+			KAB_ATOMIC_FETCH_INC_SIZE_T_RELAXED(c->count);
+		}
+		return c;
+	}
+
+	template<typename ElementT, typename ResourceT>
+	void offset_array_value<ElementT, ResourceT>::release_control(ResourceT& r, control* c)
+	{
+		if (c == nullptr)
+		{
+			return;
+		}
+
+		if (KAB_ATOMIC_FETCH_DEC_SIZE_T_RELEASE(c->count) == 1)
+		{
+			KAB_ATOMIC_FENCE_ACQUIRE();
+
+			auto const alloc_size = sizeof(control) + (c->size - 1) * sizeof(ElementT);
+
+			// destroy the elements
+			if constexpr (!std::is_trivially_destructible_v<ElementT>)
+			{
+				std::destroy_n(c->fam, c->size);
+			}
+
+			// deallocate the memory
+			r.deallocate({ reinterpret_cast<byte*>(c), alloc_size, }, align_v<control>);
+		}
+	}
+
+	template<typename ElementT, typename ResourceT>
+	offset_array_value<ElementT, ResourceT>::offset_array_value(ResourceT r) noexcept
+		: ResourceT(r)
+	{
+
+	}
+
+	template<typename ElementT, typename ResourceT>
+	offset_array_value<ElementT, ResourceT>::offset_array_value(offset_array_value const& rhs) noexcept
+		: ResourceT(rhs.access_resource())
+		, m_control(acquire_control(rhs.m_control.get()))
+	{
+
+	}
+
+	template<typename ElementT, typename ResourceT>
+	offset_array_value<ElementT, ResourceT>::offset_array_value(offset_array_value && rhs) noexcept
+		: ResourceT(std::move(rhs).access_resource())
+		, m_control(rhs.m_control)
+	{
+		rhs.m_control = nullptr;
+	}
+
+	template<typename ElementT, typename ResourceT>
+	auto offset_array_value<ElementT, ResourceT>::operator=(offset_array_value const& rhs) noexcept -> offset_array_value&
+	{
+		if (this != &rhs)
+		{
+			release_control(access_resource(), m_control.get());
+
+			access_resource() = rhs.access_resource();
+			m_control = acquire_control(rhs.m_control.get());
+		}
+		return *this;
+	}
+
+	template<typename ElementT, typename ResourceT>
+	auto offset_array_value<ElementT, ResourceT>::operator=(offset_array_value && rhs) noexcept -> offset_array_value&
+	{
+		if (this != &rhs)
+		{
+			release_control(access_resource(), m_control.get());
+
+			access_resource() = std::move(rhs).access_resource();
+			m_control = rhs.m_control;
+			rhs.m_control = nullptr;
+		}
+		return *this;
+	}
+
+	template<typename ElementT, typename ResourceT>
+	offset_array_value<ElementT, ResourceT>::~offset_array_value()
+	{
+		release_control(access_resource(), m_control.get());
+	}
+
+	template<typename ElementT, typename ResourceT>
+	void offset_array_value<ElementT, ResourceT>::swap(offset_array_value & rhs) noexcept
+	{
+		using std::swap;
+		swap(access_resource(), rhs.access_resource());
+		control* const c = m_control.get();
+		m_control = rhs.m_control;
+		rhs.m_control = c;
+	}
+}
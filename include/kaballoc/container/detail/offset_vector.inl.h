@@ -0,0 +1,124 @@
+#pragma once
+
+#include "kaballoc/memory/detail/over_allocate.h"
+#include "kaballoc/memory/detail/uninitialized_relocate.h"
+#include <utility>
+
+namespace kab
+{
+	template<typename T, typename R>
+	void offset_vector<T, R>::free_storage() noexcept
+	{
+		detail::over_deallocate(access_resource(), { reinterpret_cast<byte*>(data()), m_byte_capacity }, align_v<T>);
+	}
+
+	template<typename T, typename R>
+	void offset_vector<T, R>::reallocate(size_t new_capacity)
+	{
+		byte_span const new_block = detail::over_allocate_or_throw(access_resource(), new_capacity * sizeof(T), align_v<T>);
+		auto const new_buffer = reinterpret_cast<T*>(new_block.data);
+
+		// Relocate data
+		if constexpr (is_nothrow_relocatable_v<T>)
+		{
+			kab::uninitialized_relocate(data(), data() + m_size, new_buffer);
+		}
+		else
+		{
+			try
+			{
+				kab::uninitialized_relocate(data(), data() + m_size, new_buffer);
+			}
+			catch (...)
+			{
+				detail::over_deallocate(access_resource(), new_block, align_v<T>);
+				if constexpr (!std::is_copy_constructible_v<T>)
+				{
+					m_size = 0; // a throwing move relocation destroys the source elements
+				}
+				throw;
+			}
+		}
+
+		// Free the previous storage, and use the new one
+		free_storage();
+		m_data = new_buffer;
+		m_byte_capacity = new_block.size;
+	}
+
+	template<typename T, typename R>
+	void offset_vector<T, R>::ensure_capacity(size_t n)
+	{
+		if (capacity() < n)
+		{
+			size_t const grown = 2 * capacity();
+			reallocate(grown > n ? grown : n);
+		}
+	}
+
+	template<typename T, typename R>
+	offset_vector<T, R>::offset_vector(offset_vector && rhs) noexcept
+		: R(std::move(rhs).access_resource())
+		, m_data(rhs.m_data)
+		, m_size(std::exchange(rhs.m_size, 0))
+		, m_byte_capacity(std::exchange(rhs.m_byte_capacity, 0))
+	{
+		rhs.m_data = nullptr;
+	}
+
+	template<typename T, typename R>
+	auto offset_vector<T, R>::operator=(offset_vector && rhs) noexcept -> offset_vector&
+	{
+		if (this != &rhs)
+		{
+			kab::destroy(data(), data() + m_size);
+			free_storage();
+
+			access_resource() = std::move(rhs).access_resource();
+			m_data = rhs.m_data;
+			m_size = std::exchange(rhs.m_size, 0);
+			m_byte_capacity = std::exchange(rhs.m_byte_capacity, 0);
+			rhs.m_data = nullptr;
+		}
+		return *this;
+	}
+
+	template<typename T, typename R>
+	offset_vector<T, R>::~offset_vector()
+	{
+		kab::destroy(data(), data() + m_size);
+		free_storage();
+	}
+
+	template<typename T, typename R>
+	void offset_vector<T, R>::pop_back()
+	{
+		--m_size;
+		kab::destroy_at(data() + m_size);
+	}
+
+	template<typename T, typename R>
+	void offset_vector<T, R>::reserve(size_t n)
+	{
+		if (capacity() < n)
+		{
+			reallocate(n);
+		}
+	}
+
+	template<typename T, typename R>
+	void offset_vector<T, R>::clear() noexcept
+	{
+		kab::destroy(data(), data() + m_size);
+		m_size = 0;
+	}
+
+	template<typename T, typename R>
+	void offset_vector<T, R>::clear_and_shrink() noexcept
+	{
+		clear();
+		free_storage();
+		m_data = nullptr;
+		m_byte_capacity = 0;
+	}
+}
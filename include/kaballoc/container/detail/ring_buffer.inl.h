@@ -0,0 +1,311 @@
+#pragma once
+
+#include "kaballoc/memory/detail/over_allocate.h"
+#include "kaballoc/memory/detail/uninitialized_relocate.h"
+
+#include <string.h>
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <utility>
+
+namespace kab
+{
+	template<typename T, typename R>
+	size_t ring_buffer<T, R>::contiguous_count(size_t i, size_t n) const noexcept
+	{
+		size_t const position = (m_head + i) & mask();
+		return std::min(n, m_capacity - position);
+	}
+
+	template<typename T, typename R>
+	void ring_buffer<T, R>::destroy_range(size_t first, size_t n) noexcept
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>)
+		{
+			if (n != 0)
+			{
+				size_t const first_count = contiguous_count(first, n);
+				kab::destroy_n(element(first), first_count);
+				kab::destroy_n(m_data, n - first_count);
+			}
+		}
+	}
+
+	template<typename T, typename R>
+	void ring_buffer<T, R>::free_storage() noexcept
+	{
+		if (m_data != nullptr)
+		{
+			detail::over_deallocate(access_resource(), { reinterpret_cast<byte*>(m_data), m_byte_capacity }, align_v<T>);
+		}
+	}
+
+	template<typename T, typename R>
+	void ring_buffer<T, R>::reallocate(size_t new_capacity)
+	{
+		byte_span const new_block = detail::over_allocate_or_throw(access_resource(), new_capacity * sizeof(T), align_v<T>);
+		auto const new_data = reinterpret_cast<T*>(new_block.data);
+
+		// The elements are relocated to the start of the new storage, in two segments: from the head to the end of the storage, then the wrapped part
+		size_t const first_count = m_size == 0 ? 0 : contiguous_count(0, m_size);
+		size_t const second_count = m_size - first_count;
+		T* const first_src = m_data + m_head;
+
+		if constexpr (is_nothrow_relocatable_v<T>)
+		{
+			if (m_size != 0)
+			{
+				kab::uninitialized_relocate(first_src, first_src + first_count, new_data);
+				kab::uninitialized_relocate(m_data, m_data + second_count, new_data + first_count);
+			}
+		}
+		else if constexpr (std::is_copy_constructible_v<T>)
+		{
+			// Copy everything first, so that a throwing copy leaves the ring buffer unchanged
+			try
+			{
+				std::uninitialized_copy_n(first_src, first_count, new_data);
+				try
+				{
+					std::uninitialized_copy_n(m_data, second_count, new_data + first_count);
+				}
+				catch (...)
+				{
+					kab::destroy_n(new_data, first_count);
+					throw;
+				}
+			}
+			catch (...)
+			{
+				detail::over_deallocate(access_resource(), new_block, align_v<T>);
+				throw;
+			}
+
+			destroy_range(0, m_size);
+		}
+		else
+		{
+			// A throwing move relocation destroys its source elements, so the ring buffer loses its elements
+			try
+			{
+				kab::uninitialized_relocate(first_src, first_src + first_count, new_data);
+			}
+			catch (...)
+			{
+				kab::destroy_n(m_data, second_count);
+				m_size = 0;
+				m_head = 0;
+				detail::over_deallocate(access_resource(), new_block, align_v<T>);
+				throw;
+			}
+
+			try
+			{
+				kab::uninitialized_relocate(m_data, m_data + second_count, new_data + first_count);
+			}
+			catch (...)
+			{
+				kab::destroy_n(new_data, first_count);
+				m_size = 0;
+				m_head = 0;
+				detail::over_deallocate(access_resource(), new_block, align_v<T>);
+				throw;
+			}
+		}
+
+		// Free the previous storage
+		free_storage();
+
+		// Use the new storage, with the biggest power of two capacity that fits
+		m_data = new_data;
+		m_head = 0;
+		m_capacity = std::bit_floor(new_block.size / sizeof(T));
+		m_byte_capacity = new_block.size;
+	}
+
+	template<typename T, typename R>
+	void ring_buffer<T, R>::ensure_capacity(size_t n)
+	{
+		if (m_capacity < n)
+		{
+			reallocate(std::bit_ceil(n));
+		}
+	}
+
+	template<typename T, typename R>
+	ring_buffer<T, R>::ring_buffer(ring_buffer && rhs) noexcept
+		: R(std::move(rhs).access_resource())
+		, m_data(std::exchange(rhs.m_data, nullptr))
+		, m_head(std::exchange(rhs.m_head, 0))
+		, m_size(std::exchange(rhs.m_size, 0))
+		, m_capacity(std::exchange(rhs.m_capacity, 0))
+		, m_byte_capacity(std::exchange(rhs.m_byte_capacity, 0))
+	{
+
+	}
+
+	template<typename T, typename R>
+	auto ring_buffer<T, R>::operator=(ring_buffer && rhs) noexcept -> ring_buffer&
+	{
+		if (this != &rhs)
+		{
+			destroy_range(0, m_size);
+			free_storage();
+
+			access_resource() = std::move(rhs).access_resource();
+			m_data = std::exchange(rhs.m_data, nullptr);
+			m_head = std::exchange(rhs.m_head, 0);
+			m_size = std::exchange(rhs.m_size, 0);
+			m_capacity = std::exchange(rhs.m_capacity, 0);
+			m_byte_capacity = std::exchange(rhs.m_byte_capacity, 0);
+		}
+
+		return *this;
+	}
+
+	template<typename T, typename R>
+	ring_buffer<T, R>::~ring_buffer()
+	{
+		destroy_range(0, m_size);
+		free_storage();
+	}
+
+	template<typename T, typename R>
+	void ring_buffer<T, R>::swap(ring_buffer& rhs) noexcept
+	{
+		using std::swap;
+		swap(access_resource(), rhs.access_resource());
+		swap(m_data, rhs.m_data);
+		swap(m_head, rhs.m_head);
+		swap(m_size, rhs.m_size);
+		swap(m_capacity, rhs.m_capacity);
+		swap(m_byte_capacity, rhs.m_byte_capacity);
+	}
+
+	template<typename T, typename R>
+	void ring_buffer<T, R>::push_back_n(T const* src, size_t n)
+	{
+		if (n == 0)
+		{
+			return;
+		}
+
+		ensure_capacity(m_size + n);
+
+		size_t const first_count = contiguous_count(m_size, n);
+		T* const first_dst = element(m_size);
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			memcpy(static_cast<void*>(first_dst), src, first_count * sizeof(T));
+			if (n != first_count)
+			{
+				memcpy(static_cast<void*>(m_data), src + first_count, (n - first_count) * sizeof(T));
+			}
+		}
+		else
+		{
+			std::uninitialized_copy_n(src, first_count, first_dst);
+			try
+			{
+				std::uninitialized_copy_n(src + first_count, n - first_count, m_data);
+			}
+			catch (...)
+			{
+				kab::destroy_n(first_dst, first_count);
+				throw;
+			}
+		}
+
+		m_size += n;
+	}
+
+	template<typename T, typename R>
+	void ring_buffer<T, R>::pop_back()
+	{
+		--m_size;
+		kab::destroy_at(element(m_size));
+	}
+
+	template<typename T, typename R>
+	void ring_buffer<T, R>::pop_front()
+	{
+		kab::destroy_at(m_data + m_head);
+		m_head = (m_head + 1) & mask();
+		--m_size;
+	}
+
+	template<typename T, typename R>
+	void ring_buffer<T, R>::pop_front_n(T* dst, size_t n)
+	{
+		static_assert(is_nothrow_relocatable_v<T>, "Elements which can throw on relocation can't be removed in bulk");
+
+		if (n == 0)
+		{
+			return;
+		}
+
+		size_t const first_count = contiguous_count(0, n);
+		T* const first_src = m_data + m_head;
+		kab::uninitialized_relocate(first_src, first_src + first_count, dst);
+		kab::uninitialized_relocate(m_data, m_data + (n - first_count), dst + first_count);
+
+		m_head = (m_head + n) & mask();
+		m_size -= n;
+	}
+
+	template<typename T, typename R>
+	void ring_buffer<T, R>::pop_front_n(size_t n) noexcept
+	{
+		if (n == 0)
+		{
+			return;
+		}
+
+		destroy_range(0, n);
+		m_head = (m_head + n) & mask();
+		m_size -= n;
+	}
+
+	template<typename T, typename R>
+	void ring_buffer<T, R>::reserve(size_t n)
+	{
+		ensure_capacity(n);
+	}
+
+	template<typename T, typename R>
+	void ring_buffer<T, R>::clear() noexcept
+	{
+		destroy_range(0, m_size);
+		m_head = 0;
+		m_size = 0;
+	}
+
+	template<typename T, typename R>
+	void ring_buffer<T, R>::clear_and_shrink() noexcept
+	{
+		destroy_range(0, m_size);
+		free_storage();
+		m_data = nullptr;
+		m_head = 0;
+		m_size = 0;
+		m_capacity = 0;
+		m_byte_capacity = 0;
+	}
+
+	template<typename T, typename R>
+	void ring_buffer<T, R>::shrink_to_fit()
+	{
+		if (m_size == 0)
+		{
+			clear_and_shrink();
+			return;
+		}
+
+		size_t const new_capacity = std::bit_ceil(m_size);
+		if (new_capacity < m_capacity)
+		{
+			reallocate(new_capacity);
+		}
+	}
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "kaballoc/container/vector.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace kab
+{
+	template<typename T, typename R>
+	uint32_t slot_map<T, R>::acquire_free_slot()
+	{
+		if (m_free_slot == no_slot)
+		{
+			grow_for_one(m_slots);
+			m_slots.push_back(slot{ no_slot, 0 });
+			m_free_slot = static_cast<uint32_t>(m_slots.size() - 1);
+		}
+		return m_free_slot;
+	}
+
+	template<typename T, typename R>
+	template<typename U>
+	void slot_map<T, R>::grow_for_one(vector<U, R>& v)
+	{
+		if (v.size() == v.capacity())
+		{
+			v.reserve(std::max(v.capacity() * 2, v.size() + 1));
+		}
+	}
+
+	template<typename T, typename R>
+	slot_map<T, R>::slot_map(slot_map && rhs) noexcept
+		: m_values(std::move(rhs.m_values))
+		, m_value_slots(std::move(rhs.m_value_slots))
+		, m_slots(std::move(rhs.m_slots))
+		, m_free_slot(std::exchange(rhs.m_free_slot, no_slot))
+	{
+
+	}
+
+	template<typename T, typename R>
+	auto slot_map<T, R>::operator=(slot_map && rhs) noexcept -> slot_map&
+	{
+		if (this != &rhs)
+		{
+			m_values = std::move(rhs.m_values);
+			m_value_slots = std::move(rhs.m_value_slots);
+			m_slots = std::move(rhs.m_slots);
+			m_free_slot = std::exchange(rhs.m_free_slot, no_slot);
+		}
+
+		return *this;
+	}
+
+	template<typename T, typename R>
+	void slot_map<T, R>::swap(slot_map& rhs) noexcept
+	{
+		using std::swap;
+		m_values.swap(rhs.m_values);
+		m_value_slots.swap(rhs.m_value_slots);
+		m_slots.swap(rhs.m_slots);
+		swap(m_free_slot, rhs.m_free_slot);
+	}
+
+	template<typename T, typename R>
+	auto slot_map<T, R>::handle_at(size_t i) const -> handle
+	{
+		uint32_t const slot_index = m_value_slots[i];
+		return { slot_index, m_slots[slot_index].generation };
+	}
+
+	template<typename T, typename R>
+	bool slot_map<T, R>::contains(handle h) const noexcept
+	{
+		return h.index < m_slots.size() && m_slots[h.index].generation == h.generation;
+	}
+
+	template<typename T, typename R>
+	T* slot_map<T, R>::find(handle h) noexcept
+	{
+		return contains(h) ? m_values.data() + m_slots[h.index].index : nullptr;
+	}
+
+	template<typename T, typename R>
+	T const* slot_map<T, R>::find(handle h) const noexcept
+	{
+		return contains(h) ? m_values.data() + m_slots[h.index].index : nullptr;
+	}
+
+	template<typename T, typename R>
+	bool slot_map<T, R>::erase(handle h)
+	{
+		if (!contains(h))
+		{
+			return false;
+		}
+
+		slot& s = m_slots[h.index];
+		uint32_t const index = s.index;
+		uint32_t const last = static_cast<uint32_t>(m_values.size() - 1);
+
+		m_values.swap_remove(index);
+		if (index != last)
+		{
+			// The last element was relocated to 'index'
+			uint32_t const moved_slot = m_value_slots[last];
+			m_value_slots[index] = moved_slot;
+			m_slots[moved_slot].index = index;
+		}
+		m_value_slots.pop_back();
+
+		// Invalidates the handles to the slot, and puts it in the free list
+		++s.generation;
+		s.index = m_free_slot;
+		m_free_slot = h.index;
+
+		return true;
+	}
+
+	template<typename T, typename R>
+	void slot_map<T, R>::reserve(size_t n)
+	{
+		m_values.reserve(n);
+		m_value_slots.reserve(n);
+		m_slots.reserve(n);
+	}
+
+	template<typename T, typename R>
+	void slot_map<T, R>::clear() noexcept
+	{
+		for (uint32_t const slot_index : m_value_slots)
+		{
+			slot& s = m_slots[slot_index];
+			++s.generation;
+			s.index = m_free_slot;
+			m_free_slot = slot_index;
+		}
+
+		m_values.clear();
+		m_value_slots.clear();
+	}
+
+	template<typename T, typename R>
+	void slot_map<T, R>::shrink_to_fit()
+	{
+		m_values.shrink_to_fit();
+		m_value_slots.shrink_to_fit();
+	}
+}
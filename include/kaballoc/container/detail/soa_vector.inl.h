@@ -0,0 +1,295 @@
+#pragma once
+
+#include "kaballoc/memory/detail/over_allocate.h"
+#include "kaballoc/memory/detail/uninitialized_relocate.h"
+#include "kaballoc/memory/detail/uninitialized_construct.h"
+#include "kaballoc/memory/resource.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+namespace kab
+{
+	namespace detail
+	{
+		// Calls 'f' with std::integral_constant<size_t, I> for every column index I, in order
+		template<size_t... I, typename F>
+		void soa_for_each_column(std::index_sequence<I...>, F&& f)
+		{
+			(f(std::integral_constant<size_t, I>()), ...);
+		}
+
+		template<typename... Ts>
+		inline constexpr align_t soa_block_align{ std::max({ alignof(Ts)... }) };
+
+		inline constexpr size_t soa_align_up(size_t offset, size_t align) noexcept
+		{
+			return (offset + align - 1) & ~(align - 1);
+		}
+	}
+
+	template<typename... Ts, typename R>
+	size_t soa_vector<std::tuple<Ts...>, R>::block_size(size_t capacity) noexcept
+	{
+		size_t offset = 0;
+		((offset = detail::soa_align_up(offset, alignof(Ts)) + capacity * sizeof(Ts)), ...);
+		return offset;
+	}
+
+	template<typename... Ts, typename R>
+	auto soa_vector<std::tuple<Ts...>, R>::column_pointers(byte* data, size_t capacity) noexcept -> columns
+	{
+		size_t offset = 0;
+		auto const next_column = [data, capacity, &offset]<typename T>(std::type_identity<T>)
+		{
+			offset = detail::soa_align_up(offset, alignof(T));
+			T* const column = reinterpret_cast<T*>(data + offset);
+			offset += capacity * sizeof(T);
+			return column;
+		};
+
+		// The elements of a braced initializer list are evaluated in order
+		return columns{ next_column(std::type_identity<Ts>())... };
+	}
+
+	template<typename... Ts, typename R>
+	void soa_vector<std::tuple<Ts...>, R>::destroy_range(size_t first, size_t last) noexcept
+	{
+		detail::soa_for_each_column(indices(), [&](auto i)
+		{
+			auto* const column = std::get<i>(m_columns);
+			kab::destroy(column + first, column + last);
+		});
+	}
+
+	template<typename... Ts, typename R>
+	void soa_vector<std::tuple<Ts...>, R>::free_storage() noexcept
+	{
+		if (block() != nullptr)
+		{
+			detail::over_deallocate(access_resource(), { block(), m_byte_capacity }, detail::soa_block_align<Ts...>);
+		}
+	}
+
+	template<typename... Ts, typename R>
+	void soa_vector<std::tuple<Ts...>, R>::reallocate(size_t new_capacity)
+	{
+		byte_span const new_block = detail::over_allocate_or_throw(access_resource(), block_size(new_capacity), detail::soa_block_align<Ts...>);
+
+		// Use the over-allocated bytes for more elements, if they fit with the padding between the columns
+		size_t capacity = new_capacity;
+		constexpr size_t element_size = (sizeof(Ts) + ...);
+		constexpr size_t max_padding = (alignof(Ts) + ...);
+		if (new_block.size > max_padding)
+		{
+			size_t const over_capacity = (new_block.size - max_padding) / element_size;
+			if (over_capacity > capacity && block_size(over_capacity) <= new_block.size)
+			{
+				capacity = over_capacity;
+			}
+		}
+
+		columns const new_columns = column_pointers(new_block.data, capacity);
+
+		if constexpr ((is_nothrow_relocatable_v<Ts> && ...))
+		{
+			detail::soa_for_each_column(indices(), [&](auto i)
+			{
+				auto* const column = std::get<i>(m_columns);
+				kab::uninitialized_relocate(column, column + m_size, std::get<i>(new_columns));
+			});
+		}
+		else
+		{
+			// Copy the columns which can throw on relocation first, so that a throwing copy leaves the soa_vector unchanged
+			size_t copied = 0;
+			try
+			{
+				detail::soa_for_each_column(indices(), [&](auto i)
+				{
+					if constexpr (!is_nothrow_relocatable_v<column_type<i>>)
+					{
+						std::uninitialized_copy_n(std::get<i>(m_columns), m_size, std::get<i>(new_columns));
+					}
+					++copied;
+				});
+			}
+			catch (...)
+			{
+				detail::soa_for_each_column(indices(), [&](auto i)
+				{
+					if constexpr (!is_nothrow_relocatable_v<column_type<i>>)
+					{
+						if (i < copied)
+						{
+							kab::destroy_n(std::get<i>(new_columns), m_size);
+						}
+					}
+				});
+				detail::over_deallocate(access_resource(), new_block, detail::soa_block_align<Ts...>);
+				throw;
+			}
+
+			// Then nothing can throw
+			detail::soa_for_each_column(indices(), [&](auto i)
+			{
+				auto* const column = std::get<i>(m_columns);
+				if constexpr (is_nothrow_relocatable_v<column_type<i>>)
+				{
+					kab::uninitialized_relocate(column, column + m_size, std::get<i>(new_columns));
+				}
+				else
+				{
+					kab::destroy_n(column, m_size);
+				}
+			});
+		}
+
+		// Free the previous storage
+		free_storage();
+
+		// Use the new storage
+		m_columns = new_columns;
+		m_capacity = capacity;
+		m_byte_capacity = new_block.size;
+	}
+
+	template<typename... Ts, typename R>
+	void soa_vector<std::tuple<Ts...>, R>::ensure_capacity(size_t n)
+	{
+		if (m_capacity < n)
+		{
+			reallocate(std::max(n, m_capacity * 2));
+		}
+	}
+
+	template<typename... Ts, typename R>
+	soa_vector<std::tuple<Ts...>, R>::soa_vector(soa_vector && rhs) noexcept
+		: R(std::move(rhs).access_resource())
+		, m_columns(std::exchange(rhs.m_columns, columns{}))
+		, m_size(std::exchange(rhs.m_size, 0))
+		, m_capacity(std::exchange(rhs.m_capacity, 0))
+		, m_byte_capacity(std::exchange(rhs.m_byte_capacity, 0))
+	{
+
+	}
+
+	template<typename... Ts, typename R>
+	auto soa_vector<std::tuple<Ts...>, R>::operator=(soa_vector && rhs) noexcept -> soa_vector&
+	{
+		if (this != &rhs)
+		{
+			destroy_range(0, m_size);
+			free_storage();
+
+			access_resource() = std::move(rhs).access_resource();
+			m_columns = std::exchange(rhs.m_columns, columns{});
+			m_size = std::exchange(rhs.m_size, 0);
+			m_capacity = std::exchange(rhs.m_capacity, 0);
+			m_byte_capacity = std::exchange(rhs.m_byte_capacity, 0);
+		}
+
+		return *this;
+	}
+
+	template<typename... Ts, typename R>
+	soa_vector<std::tuple<Ts...>, R>::~soa_vector()
+	{
+		destroy_range(0, m_size);
+		free_storage();
+	}
+
+	template<typename... Ts, typename R>
+	void soa_vector<std::tuple<Ts...>, R>::swap(soa_vector& rhs) noexcept
+	{
+		using std::swap;
+		swap(access_resource(), rhs.access_resource());
+		swap(m_columns, rhs.m_columns);
+		swap(m_size, rhs.m_size);
+		swap(m_capacity, rhs.m_capacity);
+		swap(m_byte_capacity, rhs.m_byte_capacity);
+	}
+
+	template<typename... Ts, typename R>
+	void soa_vector<std::tuple<Ts...>, R>::pop_back()
+	{
+		--m_size;
+		destroy_range(m_size, m_size + 1);
+	}
+
+	template<typename... Ts, typename R>
+	void soa_vector<std::tuple<Ts...>, R>::reserve(size_t n)
+	{
+		if (m_capacity < n)
+		{
+			reallocate(n);
+		}
+	}
+
+	template<typename... Ts, typename R>
+	void soa_vector<std::tuple<Ts...>, R>::resize(size_t n)
+	{
+		if (n <= m_size)
+		{
+			destroy_range(n, m_size);
+			m_size = n;
+			return;
+		}
+
+		ensure_capacity(n);
+
+		size_t constructed = 0;
+		try
+		{
+			detail::soa_for_each_column(indices(), [&](auto i)
+			{
+				kab::uninitialized_default_construct_n(std::get<i>(m_columns) + m_size, n - m_size);
+				++constructed;
+			});
+		}
+		catch (...)
+		{
+			detail::soa_for_each_column(indices(), [&](auto i)
+			{
+				if (i < constructed)
+				{
+					kab::destroy_n(std::get<i>(m_columns) + m_size, n - m_size);
+				}
+			});
+			throw;
+		}
+		m_size = n;
+	}
+
+	template<typename... Ts, typename R>
+	void soa_vector<std::tuple<Ts...>, R>::clear() noexcept
+	{
+		destroy_range(0, m_size);
+		m_size = 0;
+	}
+
+	template<typename... Ts, typename R>
+	void soa_vector<std::tuple<Ts...>, R>::clear_and_shrink() noexcept
+	{
+		destroy_range(0, m_size);
+		free_storage();
+		m_columns = columns{};
+		m_size = 0;
+		m_capacity = 0;
+		m_byte_capacity = 0;
+	}
+
+	template<typename... Ts, typename R>
+	void soa_vector<std::tuple<Ts...>, R>::shrink_to_fit()
+	{
+		if (m_size == 0)
+		{
+			clear_and_shrink();
+		}
+		else if (m_size < m_capacity)
+		{
+			reallocate(m_size);
+		}
+	}
+}
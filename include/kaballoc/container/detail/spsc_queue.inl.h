@@ -0,0 +1,137 @@
+#pragma once
+
+#include "kaballoc/memory/detail/over_allocate.h"
+#include "kaballoc/memory/detail/uninitialized_relocate.h"
+#include "kaballoc/memory/resource.h"
+
+#include <string.h>
+#include <algorithm>
+#include <bit>
+#include <memory>
+
+namespace kab
+{
+	template<typename T, typename R>
+	void spsc_queue<T, R>::allocate_slots(size_t capacity)
+	{
+		byte_span const block = detail::over_allocate_or_throw(access_resource(), std::bit_ceil(capacity) * sizeof(T), align_v<T>);
+		m_slots = reinterpret_cast<T*>(block.data);
+		m_capacity = std::bit_floor(block.size / sizeof(T));
+		m_byte_capacity = block.size;
+	}
+
+	template<typename T, typename R>
+	size_t spsc_queue<T, R>::free_count(size_t tail, size_t n) noexcept
+	{
+		size_t count = m_capacity - (tail - m_cached_head);
+		if (count < n)
+		{
+			m_cached_head = m_head.load(std::memory_order_acquire);
+			count = m_capacity - (tail - m_cached_head);
+		}
+		return count;
+	}
+
+	template<typename T, typename R>
+	size_t spsc_queue<T, R>::full_count(size_t head, size_t n) noexcept
+	{
+		size_t count = m_cached_tail - head;
+		if (count < n)
+		{
+			m_cached_tail = m_tail.load(std::memory_order_acquire);
+			count = m_cached_tail - head;
+		}
+		return count;
+	}
+
+	template<typename T, typename R>
+	spsc_queue<T, R>::~spsc_queue()
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>)
+		{
+			size_t const tail = m_tail.load(std::memory_order_relaxed);
+			for (size_t i = m_head.load(std::memory_order_relaxed); i != tail; ++i)
+			{
+				kab::destroy_at(m_slots + (i & mask()));
+			}
+		}
+
+		detail::over_deallocate(access_resource(), { reinterpret_cast<byte*>(m_slots), m_byte_capacity }, align_v<T>);
+	}
+
+	template<typename T, typename R>
+	size_t spsc_queue<T, R>::try_push_n(T const* src, size_t n)
+	{
+		size_t const tail = m_tail.load(std::memory_order_relaxed);
+		n = std::min(n, free_count(tail, n));
+		if (n == 0)
+		{
+			return 0;
+		}
+
+		// The free slots are at most two contiguous segments: from the tail to the end of the storage, then from the start of the storage
+		size_t const position = tail & mask();
+		size_t const first_count = std::min(n, m_capacity - position);
+		T* const first_dst = m_slots + position;
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			memcpy(static_cast<void*>(first_dst), src, first_count * sizeof(T));
+			if (n != first_count)
+			{
+				memcpy(static_cast<void*>(m_slots), src + first_count, (n - first_count) * sizeof(T));
+			}
+		}
+		else
+		{
+			std::uninitialized_copy_n(src, first_count, first_dst);
+			try
+			{
+				std::uninitialized_copy_n(src + first_count, n - first_count, m_slots);
+			}
+			catch (...)
+			{
+				kab::destroy_n(first_dst, first_count);
+				throw;
+			}
+		}
+
+		m_tail.store(tail + n, std::memory_order_release);
+		return n;
+	}
+
+	template<typename T, typename R>
+	bool spsc_queue<T, R>::try_pop(T& out)
+	{
+		size_t const head = m_head.load(std::memory_order_relaxed);
+		if (full_count(head, 1) == 0)
+		{
+			return false;
+		}
+
+		kab::relocate_assign(m_slots + (head & mask()), out);
+		m_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	template<typename T, typename R>
+	size_t spsc_queue<T, R>::try_pop_n(T* dst, size_t n)
+	{
+		static_assert(is_nothrow_relocatable_v<T>, "Elements which can throw on relocation can't be removed in bulk");
+
+		size_t const head = m_head.load(std::memory_order_relaxed);
+		n = std::min(n, full_count(head, n));
+		if (n == 0)
+		{
+			return 0;
+		}
+
+		size_t const position = head & mask();
+		size_t const first_count = std::min(n, m_capacity - position);
+		T* const first_src = m_slots + position;
+		kab::uninitialized_relocate(first_src, first_src + first_count, dst);
+		kab::uninitialized_relocate(m_slots, m_slots + (n - first_count), dst + first_count);
+
+		m_head.store(head + n, std::memory_order_release);
+		return n;
+	}
+}
@@ -0,0 +1,269 @@
+#pragma once
+
+#include "kaballoc/memory/detail/over_allocate.h"
+#include "kaballoc/memory/resource.h"
+
+#include <string.h>
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+namespace kab
+{
+	template<typename R>
+	size_t string<R>::encode_byte_capacity(size_t byte_capacity) noexcept
+	{
+		if constexpr (std::endian::native == std::endian::little)
+		{
+			return byte_capacity | (static_cast<size_t>(heap_marker) << ((sizeof(size_t) - 1) * 8));
+		}
+		else
+		{
+			return (byte_capacity << 8) | heap_marker;
+		}
+	}
+
+	template<typename R>
+	size_t string<R>::heap_byte_capacity() const noexcept
+	{
+		if constexpr (std::endian::native == std::endian::little)
+		{
+			return m_rep.heap.byte_capacity & ~(static_cast<size_t>(heap_marker) << ((sizeof(size_t) - 1) * 8));
+		}
+		else
+		{
+			return m_rep.heap.byte_capacity >> 8;
+		}
+	}
+
+	template<typename R>
+	void string<R>::set_heap(byte_span block, size_t size) noexcept
+	{
+		m_rep.heap = { reinterpret_cast<char*>(block.data), size, encode_byte_capacity(block.size) };
+		m_rep.heap.data[size] = '\0';
+	}
+
+	template<typename R>
+	void string<R>::set_size(size_t n) noexcept
+	{
+		if (is_inline())
+		{
+			m_rep.inline_data[n] = '\0';
+			m_rep.inline_data[inline_capacity] = static_cast<char>(inline_capacity - n);
+		}
+		else
+		{
+			m_rep.heap.size = n;
+			m_rep.heap.data[n] = '\0';
+		}
+	}
+
+	template<typename R>
+	void string<R>::free_storage() noexcept
+	{
+		if (!is_inline())
+		{
+			detail::over_deallocate(access_resource(), { reinterpret_cast<byte*>(m_rep.heap.data), heap_byte_capacity() }, align_v<char>);
+		}
+	}
+
+	template<typename R>
+	size_t string<R>::grown_capacity(size_t n) const noexcept
+	{
+		return std::max(n, capacity() * 2);
+	}
+
+	template<typename R>
+	byte_span string<R>::allocate_storage(size_t capacity)
+	{
+		// One more byte for the null terminator
+		return detail::over_allocate_or_throw(access_resource(), capacity + 1, align_v<char>);
+	}
+
+	template<typename R>
+	void string<R>::reallocate(size_t new_capacity, size_t keep)
+	{
+		byte_span const block = allocate_storage(new_capacity);
+		memcpy(block.data, data(), keep);
+		free_storage();
+		set_heap(block, keep);
+	}
+
+	template<typename R>
+	string<R>::string(string && rhs) noexcept
+		: R(std::move(rhs).access_resource())
+		, m_rep(std::exchange(rhs.m_rep, empty_rep()))
+	{
+
+	}
+
+	template<typename R>
+	auto string<R>::operator=(string && rhs) noexcept -> string&
+	{
+		if (this != &rhs)
+		{
+			free_storage();
+
+			access_resource() = std::move(rhs).access_resource();
+			m_rep = std::exchange(rhs.m_rep, empty_rep());
+		}
+
+		return *this;
+	}
+
+	template<typename R>
+	string<R>::~string()
+	{
+		free_storage();
+	}
+
+	template<typename R>
+	void string<R>::swap(string& rhs) noexcept
+	{
+		using std::swap;
+		swap(access_resource(), rhs.access_resource());
+		swap(m_rep, rhs.m_rep);
+	}
+
+	template<typename R>
+	auto string<R>::assign(std::string_view s) -> string&
+	{
+		if (s.size() <= capacity())
+		{
+			if (!s.empty())
+			{
+				memmove(data(), s.data(), s.size());
+			}
+			set_size(s.size());
+		}
+		else
+		{
+			// 's' can't be part of the string, since it is bigger than the string
+			byte_span const block = allocate_storage(s.size());
+			memcpy(block.data, s.data(), s.size());
+			free_storage();
+			set_heap(block, s.size());
+		}
+
+		return *this;
+	}
+
+	template<typename R>
+	auto string<R>::append(std::string_view s) -> string&
+	{
+		if (s.empty())
+		{
+			return *this;
+		}
+
+		size_t const old_size = size();
+		size_t const new_size = old_size + s.size();
+		if (new_size <= capacity())
+		{
+			memmove(data() + old_size, s.data(), s.size());
+			set_size(new_size);
+		}
+		else
+		{
+			// 's' may be part of the string, so the previous storage is freed after copying 's'
+			byte_span const block = allocate_storage(grown_capacity(new_size));
+			memcpy(block.data, data(), old_size);
+			memcpy(block.data + old_size, s.data(), s.size());
+			free_storage();
+			set_heap(block, new_size);
+		}
+
+		return *this;
+	}
+
+	template<typename R>
+	auto string<R>::append(size_t n, char c) -> string&
+	{
+		size_t const old_size = size();
+		size_t const new_size = old_size + n;
+		if (new_size > capacity())
+		{
+			reallocate(grown_capacity(new_size), old_size);
+		}
+
+		memset(data() + old_size, c, n);
+		set_size(new_size);
+
+		return *this;
+	}
+
+	template<typename R>
+	void string<R>::push_back(char c)
+	{
+		append(1, c);
+	}
+
+	template<typename R>
+	void string<R>::pop_back()
+	{
+		set_size(size() - 1);
+	}
+
+	template<typename R>
+	void string<R>::reserve(size_t n)
+	{
+		if (n > capacity())
+		{
+			reallocate(n, size());
+		}
+	}
+
+	template<typename R>
+	void string<R>::resize(size_t n, char c)
+	{
+		size_t const current_size = size();
+		if (n <= current_size)
+		{
+			set_size(n);
+		}
+		else
+		{
+			append(n - current_size, c);
+		}
+	}
+
+	template<typename R>
+	void string<R>::clear() noexcept
+	{
+		set_size(0);
+	}
+
+	template<typename R>
+	void string<R>::clear_and_shrink() noexcept
+	{
+		free_storage();
+		m_rep = empty_rep();
+	}
+
+	template<typename R>
+	void string<R>::shrink_to_fit()
+	{
+		if (is_inline())
+		{
+			return;
+		}
+
+		size_t const current_size = size();
+		if (current_size <= inline_capacity)
+		{
+			// Moves the characters back into the object
+			heap_rep const heap = m_rep.heap;
+			size_t const byte_capacity = heap_byte_capacity();
+
+			m_rep = empty_rep();
+			memcpy(m_rep.inline_data, heap.data, current_size);
+			set_size(current_size);
+
+			detail::over_deallocate(access_resource(), { reinterpret_cast<byte*>(heap.data), byte_capacity }, align_v<char>);
+		}
+		else if (current_size + 1 < heap_byte_capacity())
+		{
+			reallocate(current_size, current_size);
+		}
+	}
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "kaballoc/memory/resource.h"
+#include "kaballoc/memory/detail/over_allocate.h"
+#include "kaballoc/core/atomic_op.h"
+
+#include <string.h>
+#include <algorithm>
+#include <cassert>
+
+namespace kab
+{
+	template<typename ResourceT>
+	auto string_value<ResourceT>::new_control(ResourceT& r, size_t size) -> control*
+	{
+		// 'fam' already has room for the null terminator
+		const auto alloc_size = sizeof(control) + size;
+		byte_span const s = detail::allocate_or_throw(r, alloc_size, align_v<control>);
+		auto const c = new(s.data) control;
+		c->count = 1;
+		c->size = size;
+		return c;
+	}
+
+	template<typename ResourceT>
+	auto string_value<ResourceT>::acquire_control(control* c) noexcept -> control*
+	{
+		if (c != nullptr)
+		{
+			KAB_ATOMIC_FETCH_INC_SIZE_T_RELAXED(c->count);
+		}
+		return c;
+	}
+
+	template<typename ResourceT>
+	void string_value<ResourceT>::release_control(ResourceT& r, control* c)
+	{
+		if (c == nullptr)
+		{
+			return;
+		}
+
+		if (KAB_ATOMIC_FETCH_DEC_SIZE_T_RELEASE(c->count) == 1)
+		{
+			KAB_ATOMIC_FENCE_ACQUIRE();
+
+			// the control and the characters are trivially destructible, so only deallocate the memory
+			auto const alloc_size = sizeof(control) + c->size;
+			r.deallocate({ reinterpret_cast<byte*>(c), alloc_size, }, align_v<control>);
+		}
+	}
+
+	template<typename ResourceT>
+	string_value<ResourceT>::string_value(ResourceT r) noexcept
+		: ResourceT(r)
+	{
+
+	}
+
+	template<typename ResourceT>
+	string_value<ResourceT>::string_value(std::string_view s, ResourceT r)
+		: ResourceT(r)
+	{
+		assign(s);
+	}
+
+	template<typename ResourceT>
+	string_value<ResourceT>::string_value(string_value const& rhs) noexcept
+		: ResourceT(rhs.access_resource())
+		, m_control(acquire_control(rhs.m_control))
+		, m_data(rhs.m_data)
+		, m_size(rhs.m_size)
+	{
+
+	}
+
+	template<typename ResourceT>
+	string_value<ResourceT>::string_value(string_value && rhs) noexcept
+		: ResourceT(std::move(rhs).access_resource())
+		, m_control(std::exchange(rhs.m_control, nullptr))
+		, m_data(std::exchange(rhs.m_data, nullptr))
+		, m_size(std::exchange(rhs.m_size, 0))
+	{
+
+	}
+
+	template<typename ResourceT>
+	auto string_value<ResourceT>::operator=(string_value const& rhs) noexcept -> string_value&
+	{
+		if (this != &rhs)
+		{
+			// acquire first: 'rhs' may share its control with this
+			control* const c = acquire_control(rhs.m_control);
+			release_control(access_resource(), m_control);
+
+			access_resource() = rhs.access_resource();
+			m_control = c;
+			m_data = rhs.m_data;
+			m_size = rhs.m_size;
+		}
+		return *this;
+	}
+
+	template<typename ResourceT>
+	auto string_value<ResourceT>::operator=(string_value && rhs) noexcept -> string_value&
+	{
+		if (this != &rhs)
+		{
+			release_control(access_resource(), m_control);
+
+			access_resource() = std::move(rhs).access_resource();
+			m_control = std::exchange(rhs.m_control, nullptr);
+			m_data = std::exchange(rhs.m_data, nullptr);
+			m_size = std::exchange(rhs.m_size, 0);
+		}
+		return *this;
+	}
+
+	template<typename ResourceT>
+	string_value<ResourceT>::~string_value()
+	{
+		release_control(access_resource(), m_control);
+	}
+
+	template<typename ResourceT>
+	void string_value<ResourceT>::swap(string_value& rhs) noexcept
+	{
+		using std::swap;
+		swap(access_resource(), rhs.access_resource());
+		swap(m_control, rhs.m_control);
+		swap(m_data, rhs.m_data);
+		swap(m_size, rhs.m_size);
+	}
+
+	template<typename ResourceT>
+	auto string_value<ResourceT>::assign(std::string_view s) -> string_value&
+	{
+		// allocate first: 's' may be part of the current value
+		control* const c = s.empty() ? nullptr : new_control(access_resource(), s.size());
+		if (c != nullptr)
+		{
+			memcpy(c->fam, s.data(), s.size());
+			c->fam[s.size()] = '\0';
+		}
+
+		release_control(access_resource(), m_control);
+		m_control = c;
+		m_data = c != nullptr ? c->fam : nullptr;
+		m_size = s.size();
+
+		return *this;
+	}
+
+	template<typename ResourceT>
+	auto string_value<ResourceT>::substr(size_t pos, size_t n) const noexcept -> string_value
+	{
+		assert(pos <= m_size);
+		string_value sub(access_resource());
+		sub.m_control = acquire_control(m_control);
+		sub.m_data = m_data + pos;
+		sub.m_size = std::min(n, m_size - pos);
+		return sub;
+	}
+}
@@ -1,8 +1,13 @@
 #pragma once
 
 #include "kaballoc/memory/detail/over_allocate.h"
+#include "kaballoc/memory/detail/expand.h"
+#include "kaballoc/memory/detail/reallocate.h"
 #include "kaballoc/memory/detail/uninitialized_relocate.h"
+#include "kaballoc/memory/detail/uninitialized_construct.h"
 #include "kaballoc/core/comparison.h"
+#include <functional>
+#include <new>
 #include <utility>
 
 namespace kab
@@ -16,13 +21,64 @@ namespace kab
 	template<typename T, typename R>
 	void vector<T, R>::reallocate(size_t new_capacity)
 	{
-		byte_span const new_block = detail::over_allocate(access_resource(), new_capacity * sizeof(T), align_v<T>);
+		// Growing in place doesn't move the elements, nor need twice the memory
+		if constexpr (detail::has_expand_v<R>)
+		{
+			if (m_data != nullptr && new_capacity > capacity())
+			{
+				byte_span const expanded = access_resource().expand({ reinterpret_cast<byte*>(m_data), m_byte_capacity }, new_capacity * sizeof(T), align_v<T>);
+				if (expanded.data != nullptr)
+				{
+					m_byte_capacity = expanded.size;
+					return;
+				}
+			}
+		}
+
+		// The resource may move the bytes without copying them, for example by remapping pages
+		if constexpr (detail::has_reallocate_v<R> && is_trivially_relocatable_v<T>)
+		{
+			if (m_data != nullptr && new_capacity > capacity())
+			{
+				size_t const current_size = size();
+				byte_span const new_block = access_resource().reallocate({ reinterpret_cast<byte*>(m_data), m_byte_capacity }, new_capacity * sizeof(T), align_v<T>);
+				if (new_block.data == nullptr)
+				{
+					throw std::bad_alloc(); // the resource is exhausted, and the elements are still in the previous storage
+				}
+				m_data = reinterpret_cast<T*>(new_block.data);
+				m_size = m_data + current_size;
+				m_byte_capacity = new_block.size;
+				return;
+			}
+		}
+
+		byte_span const new_block = detail::over_allocate_or_throw(access_resource(), new_capacity * sizeof(T), align_v<T>);
 		size_t const current_size = size();
 
 		auto const new_buffer = reinterpret_cast<T*>(new_block.data);
 
 		// Relocate data
-		kab::uninitialized_relocate(m_data, m_size, new_buffer);
+		if constexpr (is_nothrow_relocatable_v<T>)
+		{
+			kab::uninitialized_relocate(m_data, m_size, new_buffer);
+		}
+		else
+		{
+			try
+			{
+				kab::uninitialized_relocate(m_data, m_size, new_buffer);
+			}
+			catch (...)
+			{
+				detail::over_deallocate(access_resource(), new_block, align_v<T>);
+				if constexpr (!std::is_copy_constructible_v<T>)
+				{
+					m_size = m_data; // a throwing move relocation destroys the source elements
+				}
+				throw;
+			}
+		}
 
 		// Free the previous storage
 		free_storage();
@@ -108,10 +164,8 @@ namespace kab
 	void vector<T, R>::push_back_n(size_t n)
 	{
 		ensure_capacity(size() + n);
-		T const* sent = m_size + n;
-		for (; m_size != sent; ++m_size) {
-			new(m_size) T;
-		}
+		kab::uninitialized_default_construct_n(m_size, n);
+		m_size += n;
 	}
 
 	template<typename T, typename R>
@@ -140,6 +194,30 @@ namespace kab
 		kab::destroy_at(--m_size);
 	}
 
+	template<typename T, typename R>
+	void vector<T, R>::swap_remove(size_t i)
+	{
+		T* const target = m_data + i;
+		T* const last = m_size - 1;
+		if constexpr (is_nothrow_relocatable_v<T>)
+		{
+			kab::destroy_at(target);
+			if (target != last)
+			{
+				kab::uninitialized_relocate(last, m_size, target);
+			}
+		}
+		else
+		{
+			if (target != last)
+			{
+				*target = std::move(*last);
+			}
+			kab::destroy_at(last);
+		}
+		--m_size;
+	}
+
 	template<typename T, typename R>
 	void vector<T, R>::reserve(size_t n)
 	{
@@ -159,14 +237,42 @@ namespace kab
 			}
 
 			// Construct the new objects
-			T* it = data() + current_size;
-			T* const sent = it + (n - current_size);
-			for (; it != sent; ++it) {
-				new(it) T;
+			kab::uninitialized_default_construct_n(m_size, n - current_size);
+
+			// Use the new "size" sentinel
+			m_size = m_data + n;
+		}
+		else if (current_size > n) {
+			m_size = data() + n;
+			kab::destroy(m_size, m_size + (current_size - n));
+		}
+	}
+
+	template<typename T, typename R>
+	void vector<T, R>::resize(size_t n, T const& value)
+	{
+		const size_t current_size = size();
+
+		if (current_size < n) {
+			T const* source = &value;
+			if (capacity() < n) {
+				// 'value' may be an element of this vector, which the reallocation moves
+				std::less<T const*> const less;
+				bool const is_element = !less(source, m_data) && less(source, m_size);
+				size_t const index = is_element ? static_cast<size_t>(source - m_data) : 0;
+
+				reallocate(n);
+
+				if (is_element) {
+					source = m_data + index;
+				}
 			}
 
+			// Construct the new objects
+			kab::uninitialized_fill_n(m_size, n - current_size, *source);
+
 			// Use the new "size" sentinel
-			m_size = it;
+			m_size = m_data + n;
 		}
 		else if (current_size > n) {
 			m_size = data() + n;
@@ -0,0 +1,350 @@
+#pragma once
+
+#include "kaballoc/trait/relocatable.h"
+#include "kaballoc/memory/resource.h"
+#include "kaballoc/std/pair.h"
+#include "kaballoc/container/detail/hash_group.h"
+#include "kaballoc/core/ptrdiff_t.h"
+
+#include <functional>
+#include <iterator>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace kab
+{
+	namespace detail
+	{
+		/**
+		 * Forward iterator over the elements of a 'flat_hash_map'
+		 *
+		 * Increments skip the empty and deleted slots, and stop on the sentinel control byte at the end of the table
+		 */
+		template<typename T>
+		class flat_hash_map_iterator
+		{
+			template<typename>
+			friend class flat_hash_map_iterator;
+
+			hash_ctrl const* m_ctrl = nullptr;
+			T* m_slot = nullptr;
+
+			void skip_free_slots() noexcept
+			{
+				while (*m_ctrl == hash_ctrl_empty || *m_ctrl == hash_ctrl_deleted)
+				{
+					++m_ctrl;
+					++m_slot;
+				}
+			}
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = std::remove_const_t<T>;
+			using difference_type = ptrdiff_t;
+			using pointer = T*;
+			using reference = T&;
+
+			flat_hash_map_iterator() = default;
+
+			// If 'skip' is true, the iterator moves forward to the first full slot
+			flat_hash_map_iterator(hash_ctrl const* ctrl, T* slot, bool skip) noexcept
+				: m_ctrl(ctrl)
+				, m_slot(slot)
+			{
+				if (skip && m_ctrl != nullptr)
+				{
+					skip_free_slots();
+				}
+			}
+
+			// Conversion from a mutable iterator to a const iterator
+			template<typename U, typename = std::enable_if_t<std::is_same_v<U const, T> && !std::is_same_v<U, T>>>
+			flat_hash_map_iterator(flat_hash_map_iterator<U> const& rhs) noexcept
+				: m_ctrl(rhs.m_ctrl)
+				, m_slot(rhs.m_slot)
+			{
+
+			}
+
+			[[nodiscard]] reference operator*() const { return *m_slot; }
+			[[nodiscard]] pointer operator->() const { return m_slot; }
+
+			flat_hash_map_iterator& operator++() noexcept
+			{
+				++m_ctrl;
+				++m_slot;
+				skip_free_slots();
+				return *this;
+			}
+			flat_hash_map_iterator operator++(int) noexcept { auto const it = *this; ++*this; return it; }
+
+			[[nodiscard]] friend bool operator==(flat_hash_map_iterator const& lhs, flat_hash_map_iterator const& rhs) noexcept { return lhs.m_slot == rhs.m_slot; }
+			[[nodiscard]] friend bool operator!=(flat_hash_map_iterator const& lhs, flat_hash_map_iterator const& rhs) noexcept { return lhs.m_slot != rhs.m_slot; }
+		};
+	}
+
+	/**
+	 * 'flat_hash_map' is an open-addressing hash table storing its elements inline, in a single allocation
+	 *
+	 * Kind of like std::unordered_map, but with the kab allocator model, and without a node allocation per element.
+	 *
+	 * The table is made of control bytes followed by the slots. Each control byte holds 7 bits of the hash of its slot (see 'hash_group.h'),
+	 * and lookups compare a whole group of control bytes at once (with SSE2 when available) before looking at any key.
+	 * Groups are probed in a triangular sequence, and the table grows when it would become more than 7/8 full.
+	 *
+	 * The storage is allocated with the over-allocation functions of the resource if available.
+	 * On growth, the elements are relocated to the new table (see 'uninitialized_relocate'): trivially relocatable elements are copied with memcpy.
+	 * If a relocation can throw, elements are copied instead if they are copyable, and a throwing rehash leaves the map unchanged.
+	 * If the hash function or a non-copyable element throws while elements are being relocated, the map is cleared.
+	 *
+	 * Insertions can invalidate every iterator, pointer and reference to elements. Erasure only invalidates the erased element.
+	 * Since the table may grow before the new element is constructed, the arguments of an insertion must not refer to elements of the same map.
+	 *
+	 * The MemoryResource needs to match the kab::memory_resource concept.
+	 *
+	 * flat_hash_map is never copyable, is noexcept moveable if the resource is moveable, and is trivially relocatable if the resource is relocatable or empty
+	 * (and the hash and equality functions are trivially relocatable)
+	 *
+	 * As a general rule, functions that have preconditions or functions that can allocate are not marked noexcept, but everything else should be
+	 */
+	template<typename Key, typename Value, typename MemoryResource, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+	class flat_hash_map : MemoryResource {
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using value_type = std::pair<Key const, Value>;
+		using memory_resource = MemoryResource;
+		using hasher = Hash;
+		using key_equal = KeyEqual;
+		using iterator = detail::flat_hash_map_iterator<value_type>;
+		using const_iterator = detail::flat_hash_map_iterator<value_type const>;
+		using sentinel = iterator;
+		using const_sentinel = const_iterator;
+
+	private:
+		[[nodiscard]] MemoryResource& access_resource() & noexcept { return static_cast<MemoryResource&>(*this); }
+		[[nodiscard]] MemoryResource const& access_resource() const& noexcept { return static_cast<MemoryResource const&>(*this); }
+		[[nodiscard]] MemoryResource&& access_resource() && noexcept { return static_cast<MemoryResource&&>(*this); }
+
+		// Relocation of the elements, relocating the const key as well
+		static constexpr bool is_slot_trivially_relocatable = is_trivially_relocatable_v<Key> && is_trivially_relocatable_v<Value>;
+		static constexpr bool is_slot_nothrow_relocatable = is_slot_trivially_relocatable || is_nothrow_relocatable_v<value_type>;
+		// Elements are copied on rehash only if relocation can throw and they can be copied, like in 'uninitialized_relocate'
+		static constexpr bool is_slot_copied_on_rehash = !is_slot_nothrow_relocatable && std::is_copy_constructible_v<value_type>;
+
+		detail::hash_ctrl* m_ctrl = nullptr; // start of the storage: 'm_capacity' control bytes and a sentinel
+		value_type* m_slots = nullptr;
+		size_t m_capacity = 0; // number of slots, a power of two multiple of the group width
+		size_t m_size = 0;
+		size_t m_growth_left = 0; // number of insertions into empty slots before the next rehash
+		size_t m_byte_size = 0; // size of the storage, as returned by the resource
+		[[no_unique_address]] Hash m_hash;
+		[[no_unique_address]] KeyEqual m_equal;
+
+		[[nodiscard]] static constexpr size_t max_load(size_t capacity) noexcept { return capacity - capacity / 8; }
+		[[nodiscard]] static constexpr size_t capacity_for(size_t n) noexcept;
+		[[nodiscard]] static constexpr size_t slot_offset(size_t capacity) noexcept;
+		[[nodiscard]] static constexpr align_t storage_alignment() noexcept;
+
+		[[nodiscard]] static size_t find_free_slot(detail::hash_ctrl const* ctrl, size_t capacity, size_t mixed) noexcept;
+		static void relocate_slot(value_type* src, value_type* dst);
+		static void destroy_slots(detail::hash_ctrl const* ctrl, value_type* slots, size_t capacity) noexcept;
+
+		[[nodiscard]] size_t find_index(Key const& key, size_t mixed) const;
+		void free_storage() noexcept;
+		void rehash(size_t new_capacity);
+
+		template<typename K, typename... Args>
+		std::pair<iterator, bool> try_emplace_impl(K&& key, Args&&... args);
+	public:
+		/**
+		 * flat_hash_map is default constructible if the memory resource, the hash and the equality functions are default constructible
+		 */
+		flat_hash_map() = default;
+		/**
+		 * flat_hash_map is never copy constructible
+		 */
+		flat_hash_map(flat_hash_map const&) = delete;
+		/**
+		 * flat_hash_map is noexcept move constructible if the memory resource is moveable
+		 */
+		flat_hash_map(flat_hash_map && rhs) noexcept;
+		/**
+		 * flat_hash_map is never copy assignable
+		 */
+		flat_hash_map& operator=(flat_hash_map const& rhs) = delete;
+		/**
+		 * flat_hash_map is move assignable if the memory resource is moveable
+		 */
+		flat_hash_map& operator=(flat_hash_map && rhs) noexcept;
+
+		/**
+		 * Destroys all the elements of the map, frees the storage, and destroys the memory resource
+		 */
+		~flat_hash_map();
+
+		/**
+		 * flat_hash_map is swappable if the memory resource is swappable
+		 */
+		void swap(flat_hash_map& rhs) noexcept;
+
+		/**
+		 * If the memory resource is moveable, this constructor lets the user provide a resource value
+		 */
+		explicit flat_hash_map(memory_resource r, Hash hash = Hash(), KeyEqual equal = KeyEqual()) noexcept
+			: MemoryResource(std::move(r))
+			, m_hash(std::move(hash))
+			, m_equal(std::move(equal))
+		{
+
+		}
+
+		/**
+		 * Returns the memory resource value used in this container
+		 */
+		[[nodiscard]] memory_resource get_resource() const noexcept { return access_resource(); }
+
+		/**
+		 * Returns whether the map has no elements
+		 *
+		 * Note that the capacity may not necessarily be zero if this is true
+		 */
+		[[nodiscard]] bool is_empty() const noexcept { return m_size == 0; }
+
+		/**
+		 * Returns the number of elements in the map
+		 */
+		[[nodiscard]] size_t size() const noexcept { return m_size; }
+
+		/**
+		 * Returns the number of slots of the table.
+		 *
+		 * The map can hold up to 7/8 of its capacity before it has to rehash
+		 */
+		[[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+
+		/**
+		 * 'begin' and 'end' return iterators to the elements of the map, in no particular order
+		 *
+		 * If called with const access, this will return const iterators
+		 */
+		[[nodiscard]] iterator begin() noexcept { return { m_ctrl, m_slots, true }; }
+		[[nodiscard]] sentinel end() noexcept { return { m_ctrl + m_capacity, m_slots + m_capacity, false }; }
+		[[nodiscard]] const_iterator begin() const noexcept { return { m_ctrl, m_slots, true }; }
+		[[nodiscard]] const_sentinel end() const noexcept { return { m_ctrl + m_capacity, m_slots + m_capacity, false }; }
+
+		/**
+		 * Returns an iterator to the element with the given key, or 'end' if there's none
+		 */
+		[[nodiscard]] iterator find(Key const& key);
+		[[nodiscard]] const_iterator find(Key const& key) const;
+
+		/**
+		 * Returns whether the map has an element with the given key
+		 */
+		[[nodiscard]] bool contains(Key const& key) const;
+
+		/**
+		 * Constructs a new element from the key and 'args' if there's no element with this key.
+		 * Returns an iterator to the element with the key, and whether the element was inserted.
+		 * If the key was found, 'args' are not used.
+		 *
+		 * Requires: Value must be constructible from 'args'
+		 */
+		template<typename... Args>
+		std::pair<iterator, bool> try_emplace(Key const& key, Args&&... args)
+		{
+			return try_emplace_impl(key, std::forward<Args>(args)...);
+		}
+		template<typename... Args>
+		std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args)
+		{
+			return try_emplace_impl(std::move(key), std::forward<Args>(args)...);
+		}
+
+		/**
+		 * Inserts a copy of 'value' if there's no element with the same key.
+		 * Returns an iterator to the element with the key, and whether the element was inserted
+		 */
+		std::pair<iterator, bool> insert(value_type const& value) { return try_emplace_impl(value.first, value.second); }
+		std::pair<iterator, bool> insert(value_type && value) { return try_emplace_impl(value.first, std::move(value.second)); }
+
+		/**
+		 * Inserts a new element, or assigns 'value' to the existing element with the same key.
+		 * Returns an iterator to the element with the key, and whether the element was inserted
+		 */
+		template<typename V>
+		std::pair<iterator, bool> insert_or_assign(Key const& key, V&& value)
+		{
+			auto result = try_emplace_impl(key, std::forward<V>(value));
+			if (!result.second)
+			{
+				result.first->second = std::forward<V>(value);
+			}
+			return result;
+		}
+
+		/**
+		 * Returns a reference to the value with the given key, inserting a value-initialized element if there's none
+		 *
+		 * Requires: Value is DefaultConstructible
+		 */
+		Value & operator[](Key const& key) { return try_emplace_impl(key).first->second; }
+		Value & operator[](Key&& key) { return try_emplace_impl(std::move(key)).first->second; }
+
+		/**
+		 * Removes the element with the given key, if any. Returns the number of removed elements
+		 */
+		size_t erase(Key const& key);
+
+		/**
+		 * Removes the element at the iterator, and returns an iterator to the next element
+		 *
+		 * Precondition: 'it' is a valid and dereferenceable iterator of this map
+		 */
+		iterator erase(const_iterator it);
+
+		/**
+		 * Ensures the map can hold 'n' elements without rehashing
+		 */
+		void reserve(size_t n);
+
+		/**
+		 * Removes all elements from the map, making its size 0
+		 * Does not free the storage.
+		 */
+		void clear() noexcept;
+
+		/**
+		 * Removes all elements from the map, making its size 0, then frees the storage.
+		 */
+		void clear_and_shrink() noexcept;
+	};
+
+	template<typename Key, typename Value, typename MemoryResource, typename Hash, typename KeyEqual>
+	struct is_trivially_relocatable<flat_hash_map<Key, Value, MemoryResource, Hash, KeyEqual>>
+		: std::conjunction<
+			std::bool_constant<std::is_empty_v<MemoryResource> || is_trivially_relocatable_v<MemoryResource>>,
+			is_trivially_relocatable<Hash>,
+			is_trivially_relocatable<KeyEqual>
+		>
+	{
+
+	};
+}
+
+/**
+ * Macro to declare a specialization of the 'flat_hash_map' template, with the default hash and equality functions
+ *
+ * By having a matching KAB_CONTAINER_FLAT_HASH_MAP_IMPL in a compiled object, other
+ * translation units are free to use only this declaration without having to import the entire template
+ *
+ * The template signature of 'flat_hash_map' is not guaranteed, so use this macro rather than making your own declarations
+ */
+#define KAB_CONTAINER_FLAT_HASH_MAP_DECL(KeyType, ValueType, ResourceType) \
+	namespace kab { \
+		extern template class flat_hash_map<KeyType, ValueType, ResourceType>; \
+	}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "kaballoc/container/flat_hash_map.decl.h"
+#include "kaballoc/container/detail/flat_hash_map.inl.h"
+
+/**
+ * Macro to define a specialization of the 'flat_hash_map' template, with the default hash and equality functions
+ *
+ * By having this KAB_CONTAINER_FLAT_HASH_MAP_IMPL in a compiled object, other
+ * translation units are free to use only the declaration header, not having to import the entire template
+ *
+ * The template signature of 'flat_hash_map' is not guaranteed, so use this macro rather than making your own declarations
+ */
+#define KAB_CONTAINER_FLAT_HASH_MAP_IMPL(KeyType, ValueType, ResourceType) \
+	namespace kab { \
+		template class flat_hash_map<KeyType, ValueType, ResourceType>; \
+	}
@@ -0,0 +1,263 @@
+#pragma once
+
+#include "kaballoc/container/vector.decl.h"
+#include "kaballoc/trait/relocatable.h"
+
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace kab
+{
+	/**
+	 * 'flat_map' is an associative container storing its elements sorted by key, in two contiguous arrays
+	 *
+	 * The keys and the values are stored in separate 'vector' objects, so that a lookup does a binary search over the keys only,
+	 * touching as few cache lines as possible, and never loads a value until the key is found (see 'range::lower_bound').
+	 *
+	 * Inserting a single element is linear in the size of the map, since the following elements are moved.
+	 * The intended use is to build the map in bulk with 'insert_back', which appends every element, then sorts and removes duplicates once,
+	 * and then to query it many times.
+	 *
+	 * Both vectors get a copy of the memory resource, so the MemoryResource must be copyable (for example a 'resource_reference' or an empty resource)
+	 * and needs to match the kab::memory_resource concept.
+	 *
+	 * Insertions and erasures invalidate pointers and references to the keys and values.
+	 *
+	 * flat_map is never copyable, is noexcept moveable if the resource is moveable, and is trivially relocatable if the resource is relocatable or empty
+	 *
+	 * As a general rule, functions that have preconditions or functions that can allocate are not marked noexcept, but everything else should be
+	 */
+	template<typename Key, typename Value, typename MemoryResource, typename Compare = std::less<Key>>
+	class flat_map
+	{
+		vector<Key, MemoryResource> m_keys;
+		vector<Value, MemoryResource> m_values;
+		[[no_unique_address]] Compare m_compare;
+
+		// Sorts the elements after [0, sorted_size) and merges them with the sorted elements, keeping the first element of every key
+		void sort_unique(size_t sorted_size);
+		// Removes the elements after 'n'
+		void truncate(size_t n) noexcept;
+		// Makes room for 'n' more elements. The vectors only grow to the requested size, so the map grows them geometrically
+		void grow_for(size_t n);
+
+		template<typename K, typename... Args>
+		std::pair<Value*, bool> try_emplace_impl(K&& key, Args&&... args);
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using memory_resource = MemoryResource;
+		using key_compare = Compare;
+
+		/**
+		 * flat_map is default constructible if the memory resource and the comparison function are default constructible
+		 */
+		flat_map() = default;
+		/**
+		 * flat_map is never copy constructible
+		 */
+		flat_map(flat_map const&) = delete;
+		/**
+		 * flat_map is noexcept move constructible if the memory resource is moveable
+		 */
+		flat_map(flat_map && rhs) noexcept = default;
+		/**
+		 * flat_map is never copy assignable
+		 */
+		flat_map& operator=(flat_map const& rhs) = delete;
+		/**
+		 * flat_map is move assignable if the memory resource is moveable
+		 */
+		flat_map& operator=(flat_map && rhs) noexcept = default;
+
+		/**
+		 * flat_map is swappable if the memory resource is swappable
+		 */
+		void swap(flat_map& rhs) noexcept;
+
+		/**
+		 * This constructor lets the user provide a resource value, copied to both the key and value storage
+		 */
+		explicit flat_map(memory_resource r, Compare compare = Compare()) noexcept
+			: m_keys(r)
+			, m_values(std::move(r))
+			, m_compare(std::move(compare))
+		{
+
+		}
+
+		/**
+		 * Returns the memory resource value used in this container
+		 */
+		[[nodiscard]] memory_resource get_resource() const noexcept { return m_keys.get_resource(); }
+
+		/**
+		 * Returns whether the map has no elements
+		 */
+		[[nodiscard]] bool is_empty() const noexcept { return m_keys.is_empty(); }
+
+		/**
+		 * Returns the number of elements in the map
+		 */
+		[[nodiscard]] size_t size() const noexcept { return m_keys.size(); }
+
+		/**
+		 * Returns the sorted keys of the map. The value of the key at index i is at index i in 'values'
+		 */
+		[[nodiscard]] vector<Key, MemoryResource> const& keys() const noexcept { return m_keys; }
+
+		/**
+		 * Returns the values of the map, in the order of their keys
+		 *
+		 * Values can be modified, but not added or removed
+		 */
+		[[nodiscard]] Value* values() noexcept { return m_values.data(); }
+		[[nodiscard]] Value const* values() const noexcept { return m_values.data(); }
+
+		/**
+		 * Returns the index of the first key which is not ordered before 'key', or the size of the map if there's none
+		 */
+		[[nodiscard]] size_t lower_bound(Key const& key) const;
+
+		/**
+		 * Returns a pointer to the value with the given key, or nullptr if there's none
+		 */
+		[[nodiscard]] Value* find(Key const& key);
+		[[nodiscard]] Value const* find(Key const& key) const;
+
+		/**
+		 * Returns whether the map has an element with the given key
+		 */
+		[[nodiscard]] bool contains(Key const& key) const;
+
+		/**
+		 * Constructs a new element from the key and 'args' at its sorted position if there's no element with this key.
+		 * Returns a pointer to the value with the key, and whether the element was inserted.
+		 * If the key was found, 'args' are not used.
+		 *
+		 * Requires: Value must be constructible from 'args'
+		 */
+		template<typename... Args>
+		std::pair<Value*, bool> try_emplace(Key const& key, Args&&... args)
+		{
+			return try_emplace_impl(key, std::forward<Args>(args)...);
+		}
+		template<typename... Args>
+		std::pair<Value*, bool> try_emplace(Key&& key, Args&&... args)
+		{
+			return try_emplace_impl(std::move(key), std::forward<Args>(args)...);
+		}
+
+		/**
+		 * Inserts a new element, or assigns 'value' to the existing element with the same key.
+		 * Returns a pointer to the value with the key, and whether the element was inserted
+		 */
+		template<typename V>
+		std::pair<Value*, bool> insert_or_assign(Key const& key, V&& value)
+		{
+			auto result = try_emplace_impl(key, std::forward<V>(value));
+			if (!result.second)
+			{
+				*result.first = std::forward<V>(value);
+			}
+			return result;
+		}
+
+		/**
+		 * Returns a reference to the value with the given key, inserting a value-initialized element if there's none
+		 *
+		 * Requires: Value is DefaultConstructible
+		 */
+		Value & operator[](Key const& key) { return *try_emplace_impl(key).first; }
+		Value & operator[](Key&& key) { return *try_emplace_impl(std::move(key)).first; }
+
+		/**
+		 * Removes the element with the given key, if any. Returns the number of removed elements
+		 */
+		size_t erase(Key const& key);
+
+		/**
+		 * Inserts every key-value pair of a Range, then sorts the elements and removes the duplicate keys.
+		 * If a key is already in the map, or appears several times in the range, the first element with the key is kept.
+		 *
+		 * If the inserted elements are already sorted and ordered after the existing ones, no sorting is done.
+		 * Otherwise, the elements are sorted through an array of indices, then moved to new storage, which temporarily doubles the memory use.
+		 * If an exception is thrown while sorting, the map is left in a valid but unspecified state.
+		 *
+		 * Requires: the elements of Range are pair-like (std::get<0> and std::get<1> return the key and the value)
+		 */
+		template<typename Range>
+		void insert_back(Range&& r)
+		{
+			size_t const sorted_size = size();
+			auto it = kab::range::begin(r);
+			auto const sent = kab::range::end(r);
+			if constexpr (requires { sent - it; })
+			{
+				reserve(sorted_size + static_cast<size_t>(sent - it));
+			}
+			try
+			{
+				for (; it != sent; ++it) {
+					grow_for(1);
+					auto&& element = *it;
+					m_keys.emplace_back(std::get<0>(std::forward<decltype(element)>(element)));
+					m_values.emplace_back(std::get<1>(std::forward<decltype(element)>(element)));
+				}
+			}
+			catch (...)
+			{
+				truncate(sorted_size);
+				throw;
+			}
+
+			sort_unique(sorted_size);
+		}
+
+		/**
+		 * Ensures the map can hold 'n' elements without reallocating
+		 */
+		void reserve(size_t n);
+
+		/**
+		 * Removes all elements from the map, making its size 0
+		 * Does not free the storage.
+		 */
+		void clear() noexcept;
+
+		/**
+		 * Removes all elements from the map, making its size 0, then frees the storage.
+		 */
+		void clear_and_shrink() noexcept;
+
+		/**
+		 * Potentially reallocate to reduce the capacity of the key and value storage to match the size as much as possible
+		 */
+		void shrink_to_fit();
+	};
+
+	template<typename Key, typename Value, typename MemoryResource, typename Compare>
+	struct is_trivially_relocatable<flat_map<Key, Value, MemoryResource, Compare>>
+		: std::conjunction<
+			is_trivially_relocatable<vector<Key, MemoryResource>>,
+			is_trivially_relocatable<vector<Value, MemoryResource>>,
+			is_trivially_relocatable<Compare>
+		>
+	{
+
+	};
+}
+
+/**
+ * Macro to declare a specialization of the 'flat_map' template, with the default comparison function
+ *
+ * By having a matching KAB_CONTAINER_FLAT_MAP_IMPL in a compiled object, other
+ * translation units are free to use only this declaration without having to import the entire template
+ *
+ * The template signature of 'flat_map' is not guaranteed, so use this macro rather than making your own declarations
+ */
+#define KAB_CONTAINER_FLAT_MAP_DECL(KeyType, ValueType, ResourceType) \
+	namespace kab { \
+		extern template class flat_map<KeyType, ValueType, ResourceType>; \
+	}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "kaballoc/container/flat_map.decl.h"
+#include "kaballoc/container/detail/flat_map.inl.h"
+
+/**
+ * Macro to define a specialization of the 'flat_map' template, with the default comparison function
+ *
+ * By having this KAB_CONTAINER_FLAT_MAP_IMPL in a compiled object, other
+ * translation units are free to use only the declaration header, not having to import the entire template
+ *
+ * The template signature of 'flat_map' is not guaranteed, so use this macro rather than making your own declarations
+ */
+#define KAB_CONTAINER_FLAT_MAP_IMPL(KeyType, ValueType, ResourceType) \
+	namespace kab { \
+		template class flat_map<KeyType, ValueType, ResourceType>; \
+	}
@@ -0,0 +1,222 @@
+#pragma once
+
+#include "kaballoc/container/vector.decl.h"
+#include "kaballoc/trait/relocatable.h"
+
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace kab
+{
+	/**
+	 * 'flat_set' is an associative container storing its unique keys sorted, in a contiguous array
+	 *
+	 * Lookups are a branchless binary search over a 'vector' (see 'range::lower_bound').
+	 *
+	 * Inserting a single key is linear in the size of the set, since the following keys are moved.
+	 * The intended use is to build the set in bulk with 'insert_back', which appends every key, then sorts and removes duplicates once,
+	 * and then to query it many times.
+	 *
+	 * The MemoryResource needs to match the kab::memory_resource concept.
+	 *
+	 * Insertions and erasures invalidate pointers and references to the keys.
+	 *
+	 * flat_set is never copyable, is noexcept moveable if the resource is moveable, and is trivially relocatable if the resource is relocatable or empty
+	 *
+	 * As a general rule, functions that have preconditions or functions that can allocate are not marked noexcept, but everything else should be
+	 */
+	template<typename Key, typename MemoryResource, typename Compare = std::less<Key>>
+	class flat_set
+	{
+		vector<Key, MemoryResource> m_keys;
+		[[no_unique_address]] Compare m_compare;
+
+		// Sorts the keys after [0, sorted_size) and merges them with the sorted keys, removing duplicates
+		void sort_unique(size_t sorted_size);
+		// Removes the keys after 'n'
+		void truncate(size_t n) noexcept;
+		// Makes room for 'n' more keys. The vector only grows to the requested size, so the set grows it geometrically
+		void grow_for(size_t n);
+
+		template<typename K>
+		std::pair<Key const*, bool> insert_impl(K&& key);
+	public:
+		using key_type = Key;
+		using value_type = Key;
+		using memory_resource = MemoryResource;
+		using key_compare = Compare;
+		using iterator = Key const*;
+		using const_iterator = Key const*;
+		using sentinel = iterator;
+		using const_sentinel = const_iterator;
+
+		/**
+		 * flat_set is default constructible if the memory resource and the comparison function are default constructible
+		 */
+		flat_set() = default;
+		/**
+		 * flat_set is never copy constructible
+		 */
+		flat_set(flat_set const&) = delete;
+		/**
+		 * flat_set is noexcept move constructible if the memory resource is moveable
+		 */
+		flat_set(flat_set && rhs) noexcept = default;
+		/**
+		 * flat_set is never copy assignable
+		 */
+		flat_set& operator=(flat_set const& rhs) = delete;
+		/**
+		 * flat_set is move assignable if the memory resource is moveable
+		 */
+		flat_set& operator=(flat_set && rhs) noexcept = default;
+
+		/**
+		 * flat_set is swappable if the memory resource is swappable
+		 */
+		void swap(flat_set& rhs) noexcept;
+
+		/**
+		 * If the memory resource is moveable, this constructor lets the user provide a resource value
+		 */
+		explicit flat_set(memory_resource r, Compare compare = Compare()) noexcept
+			: m_keys(std::move(r))
+			, m_compare(std::move(compare))
+		{
+
+		}
+
+		/**
+		 * Returns the memory resource value used in this container
+		 */
+		[[nodiscard]] memory_resource get_resource() const noexcept { return m_keys.get_resource(); }
+
+		/**
+		 * Returns whether the set has no keys
+		 */
+		[[nodiscard]] bool is_empty() const noexcept { return m_keys.is_empty(); }
+
+		/**
+		 * Returns the number of keys in the set
+		 */
+		[[nodiscard]] size_t size() const noexcept { return m_keys.size(); }
+
+		/**
+		 * Returns a pointer to the sorted keys
+		 */
+		[[nodiscard]] Key const* data() const noexcept { return m_keys.data(); }
+
+		/**
+		 * 'begin' and 'end' return iterators to the sorted keys. Keys are never mutable
+		 */
+		[[nodiscard]] const_iterator begin() const noexcept { return m_keys.begin(); }
+		[[nodiscard]] const_sentinel end() const noexcept { return m_keys.end(); }
+
+		/**
+		 * Returns a pointer to the first key which is not ordered before 'key', or 'end' if there's none
+		 */
+		[[nodiscard]] const_iterator lower_bound(Key const& key) const;
+
+		/**
+		 * Returns a pointer to the given key, or 'end' if the key is not in the set
+		 */
+		[[nodiscard]] const_iterator find(Key const& key) const;
+
+		/**
+		 * Returns whether the set has the given key
+		 */
+		[[nodiscard]] bool contains(Key const& key) const;
+
+		/**
+		 * Inserts the key at its sorted position if it is not already in the set.
+		 * Returns a pointer to the key in the set, and whether the key was inserted.
+		 */
+		std::pair<const_iterator, bool> insert(Key const& key) { return insert_impl(key); }
+		std::pair<const_iterator, bool> insert(Key && key) { return insert_impl(std::move(key)); }
+
+		/**
+		 * Removes the given key, if any. Returns the number of removed keys
+		 */
+		size_t erase(Key const& key);
+
+		/**
+		 * Inserts every key of a Range, then sorts the keys and removes the duplicates.
+		 * Which of several equivalent keys is kept is unspecified.
+		 *
+		 * If the inserted keys are already sorted and ordered after the existing ones, no sorting is done.
+		 * If an exception is thrown while sorting, the set is left in a valid but unspecified state.
+		 *
+		 * Requires: Key must be constructible from the element type of Range
+		 */
+		template<typename Range>
+		void insert_back(Range&& r)
+		{
+			size_t const sorted_size = size();
+			auto it = kab::range::begin(r);
+			auto const sent = kab::range::end(r);
+			if constexpr (requires { sent - it; })
+			{
+				reserve(sorted_size + static_cast<size_t>(sent - it));
+			}
+			try
+			{
+				for (; it != sent; ++it) {
+					grow_for(1);
+					m_keys.emplace_back(*it);
+				}
+			}
+			catch (...)
+			{
+				truncate(sorted_size);
+				throw;
+			}
+
+			sort_unique(sorted_size);
+		}
+
+		/**
+		 * Ensures the set can hold 'n' keys without reallocating
+		 */
+		void reserve(size_t n) { m_keys.reserve(n); }
+
+		/**
+		 * Removes all keys from the set, making its size 0
+		 * Does not free the storage.
+		 */
+		void clear() noexcept { m_keys.clear(); }
+
+		/**
+		 * Removes all keys from the set, making its size 0, then frees the storage.
+		 */
+		void clear_and_shrink() noexcept { m_keys.clear_and_shrink(); }
+
+		/**
+		 * Potentially reallocate to reduce the capacity of the storage to match the size as much as possible
+		 */
+		void shrink_to_fit() { m_keys.shrink_to_fit(); }
+	};
+
+	template<typename Key, typename MemoryResource, typename Compare>
+	struct is_trivially_relocatable<flat_set<Key, MemoryResource, Compare>>
+		: std::conjunction<
+			is_trivially_relocatable<vector<Key, MemoryResource>>,
+			is_trivially_relocatable<Compare>
+		>
+	{
+
+	};
+}
+
+/**
+ * Macro to declare a specialization of the 'flat_set' template, with the default comparison function
+ *
+ * By having a matching KAB_CONTAINER_FLAT_SET_IMPL in a compiled object, other
+ * translation units are free to use only this declaration without having to import the entire template
+ *
+ * The template signature of 'flat_set' is not guaranteed, so use this macro rather than making your own declarations
+ */
+#define KAB_CONTAINER_FLAT_SET_DECL(KeyType, ResourceType) \
+	namespace kab { \
+		extern template class flat_set<KeyType, ResourceType>; \
+	}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "kaballoc/container/flat_set.decl.h"
+#include "kaballoc/container/detail/flat_set.inl.h"
+
+/**
+ * Macro to define a specialization of the 'flat_set' template, with the default comparison function
+ *
+ * By having this KAB_CONTAINER_FLAT_SET_IMPL in a compiled object, other
+ * translation units are free to use only the declaration header, not having to import the entire template
+ *
+ * The template signature of 'flat_set' is not guaranteed, so use this macro rather than making your own declarations
+ */
+#define KAB_CONTAINER_FLAT_SET_IMPL(KeyType, ResourceType) \
+	namespace kab { \
+		template class flat_set<KeyType, ResourceType>; \
+	}
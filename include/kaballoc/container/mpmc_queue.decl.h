@@ -0,0 +1,203 @@
+#pragma once
+
+#include "kaballoc/trait/relocatable.h"
+#include "kaballoc/memory/detail/uninitialized_relocate.h"
+#include "kaballoc/memory/byte_span.h"
+#include "kaballoc/core/cache_line.h"
+
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace kab
+{
+	namespace detail
+	{
+		/**
+		 * Slot of a 'mpmc_queue'. The sequence number tells which lap of the queue may use the cell next:
+		 * it is equal to the enqueue position when the cell is free, and to the dequeue position plus one when the cell holds an element
+		 */
+		template<typename T>
+		struct mpmc_queue_cell
+		{
+			std::atomic<size_t> sequence;
+			alignas(T) byte storage[sizeof(T)];
+
+			[[nodiscard]] T* value() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+		};
+	}
+
+	/**
+	 * 'mpmc_queue' is a bounded, lock-free, first-in first-out queue for any number of producer and consumer threads
+	 *
+	 * The slots are allocated once, at construction, from the MemoryResource. The capacity is rounded up to a power of two,
+	 * and further up if the resource over-allocates, so a slot is found with a mask instead of a division.
+	 *
+	 * Each slot has a sequence number, so producers and consumers only contend on their own position index, with a single compare-exchange,
+	 * and wait on no other thread (see 'detail::mpmc_queue_cell'). The two position indices are on separate cache lines.
+	 *
+	 * Once a thread claimed a slot, it must complete its operation. So the elements are given to the queue and taken from it
+	 * by relocation, which can't throw: trivially relocatable elements are copied with a memcpy.
+	 *
+	 * The MemoryResource used needs to match the kab::memory_resource concept.
+	 *
+	 * mpmc_queue is never copyable nor moveable, since other threads may refer to it
+	 *
+	 * Only the functions documented as such may be called concurrently, the other functions require exclusive access
+	 *
+	 * Requires: T is nothrow relocatable, and nothrow move assignable unless it is trivially relocatable
+	 */
+	template<typename T, typename MemoryResource>
+	class mpmc_queue : private MemoryResource
+	{
+		static_assert(is_nothrow_relocatable_v<T> && (is_trivially_relocatable_v<T> || std::is_nothrow_move_assignable_v<T>),
+			"mpmc_queue elements can't throw when they're moved in or out of the queue");
+
+		using cell = detail::mpmc_queue_cell<T>;
+
+		[[nodiscard]] MemoryResource& access_resource() & noexcept { return static_cast<MemoryResource&>(*this); }
+		[[nodiscard]] MemoryResource const& access_resource() const& noexcept { return static_cast<MemoryResource const&>(*this); }
+
+		// Read-only after construction
+		cell* m_cells = nullptr;
+		size_t m_capacity = 0; // a power of two
+		size_t m_byte_capacity = 0; // size of the storage, as returned by the resource
+
+		alignas(cache_line_size) std::atomic<size_t> m_enqueue_position = 0;
+		alignas(cache_line_size) std::atomic<size_t> m_dequeue_position = 0;
+
+		[[nodiscard]] size_t mask() const noexcept { return m_capacity - 1; }
+
+		void allocate_cells(size_t capacity);
+		// Claim a free or a full cell, or return nullptr if the queue is full or empty. 'position' is set to the position of the claimed cell
+		[[nodiscard]] cell* claim_enqueue(size_t& position) noexcept;
+		[[nodiscard]] cell* claim_dequeue(size_t& position) noexcept;
+	public:
+		using value_type = T;
+		using memory_resource = MemoryResource;
+
+		/**
+		 * Constructs a queue able to hold at least 'capacity' elements, and at least 2
+		 */
+		explicit mpmc_queue(size_t capacity)
+		{
+			allocate_cells(capacity);
+		}
+
+		/**
+		 * This constructor lets the user provide a resource value
+		 */
+		mpmc_queue(size_t capacity, memory_resource r)
+			: MemoryResource(std::move(r))
+		{
+			allocate_cells(capacity);
+		}
+
+		/**
+		 * mpmc_queue is never copyable nor moveable
+		 */
+		mpmc_queue(mpmc_queue const&) = delete;
+		mpmc_queue& operator=(mpmc_queue const&) = delete;
+
+		/**
+		 * Destroys the elements left in the queue, and frees the slots
+		 */
+		~mpmc_queue();
+
+		/**
+		 * Returns the memory resource value used in this container
+		 */
+		[[nodiscard]] memory_resource get_resource() const noexcept { return access_resource(); }
+
+		/**
+		 * Returns the maximum number of elements in the queue
+		 */
+		[[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+
+		/**
+		 * Returns the number of elements in the queue, including the ones being pushed or popped.
+		 * May be called concurrently, in which case the result can be outdated when it's returned
+		 */
+		[[nodiscard]] size_t size() const noexcept
+		{
+			size_t const dequeue_position = m_dequeue_position.load(std::memory_order_acquire);
+			return m_enqueue_position.load(std::memory_order_acquire) - dequeue_position;
+		}
+
+		/**
+		 * Returns whether the queue has no elements. May be called concurrently, in which case the result can be outdated when it's returned
+		 */
+		[[nodiscard]] bool is_empty() const noexcept { return size() == 0; }
+
+		/**
+		 * Constructs a new element at the back of the queue from the provided arguments. Returns false if the queue is full.
+		 *
+		 * If the constructor can throw, the element is constructed before claiming a slot, then relocated into it.
+		 * In that case the element is constructed and destroyed even if the queue is full. If the constructor throws, the queue is unchanged.
+		 *
+		 * May be called concurrently
+		 * Requires: 'T' must be constructible from the provided arguments
+		 */
+		template<typename... Args>
+		bool try_emplace(Args&&... args)
+		{
+			size_t position;
+			if constexpr (std::is_nothrow_constructible_v<T, Args...>)
+			{
+				cell* const c = claim_enqueue(position);
+				if (c == nullptr)
+				{
+					return false;
+				}
+
+				new(c->storage) T(std::forward<Args>(args)...);
+				c->sequence.store(position + 1, std::memory_order_release);
+			}
+			else
+			{
+				alignas(T) byte storage[sizeof(T)];
+				T* const element = new(storage) T(std::forward<Args>(args)...);
+
+				cell* const c = claim_enqueue(position);
+				if (c == nullptr)
+				{
+					kab::destroy_at(element);
+					return false;
+				}
+
+				kab::uninitialized_relocate(element, element + 1, reinterpret_cast<T*>(c->storage));
+				c->sequence.store(position + 1, std::memory_order_release);
+			}
+			return true;
+		}
+
+		/**
+		 * Copies or moves the element at the back of the queue. Returns false if the queue is full
+		 *
+		 * May be called concurrently
+		 */
+		bool try_push(T const& e) { return try_emplace(e); }
+		bool try_push(T && e) { return try_emplace(std::move(e)); }
+
+		/**
+		 * Removes the first element of the queue and gives its value to 'out' (see 'relocate_assign'). Returns false if the queue is empty.
+		 *
+		 * May be called concurrently
+		 */
+		bool try_pop(T& out) noexcept;
+	};
+}
+
+/**
+ * Macro to declare a specialization of the 'mpmc_queue' template
+ *
+ * By having a matching KAB_CONTAINER_MPMC_QUEUE_IMPL in a compiled object, other
+ * translation units are free to use only this declaration without having to import the entire template
+ *
+ * The template signature of 'mpmc_queue' is not guaranteed, so use this macro rather than making your own declarations
+ */
+#define KAB_CONTAINER_MPMC_QUEUE_DECL(ElementType, ResourceType) \
+	namespace kab { \
+		extern template class mpmc_queue<ElementType, ResourceType>; \
+	}
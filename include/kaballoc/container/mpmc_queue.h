@@ -0,0 +1,17 @@
+#pragma once
+
+#include "kaballoc/container/mpmc_queue.decl.h"
+#include "kaballoc/container/detail/mpmc_queue.inl.h"
+
+/**
+ * Macro to define a specialization of the 'mpmc_queue' template
+ *
+ * By having this KAB_CONTAINER_MPMC_QUEUE_IMPL in a compiled object, other
+ * translation units are free to use only the declaration header, not having to import the entire template
+ *
+ * The template signature of 'mpmc_queue' is not guaranteed, so use this macro rather than making your own declarations
+ */
+#define KAB_CONTAINER_MPMC_QUEUE_IMPL(ElementType, ResourceType) \
+	namespace kab { \
+		template class mpmc_queue<ElementType, ResourceType>; \
+	}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "kaballoc/memory/offset_ptr.h"
+#include "kaballoc/memory/resource.h"
+#include "kaballoc/memory/byte_span.h"
+
+#include <type_traits>
+#include <iterator>
+#include <memory>
+
+namespace kab
+{
+	/**
+	 * 'offset_array_value' is a shared immutable container of a contiguous range of elements, which is position-independent
+	 *
+	 * It behaves like 'array_value', but refers to its storage with 'offset_ptr'. An offset_array_value stored in a shared memory segment
+	 * (see 'shared_segment'), with a resource allocating from the same segment, can be read and copied by every process mapping the segment.
+	 * For that, the ResourceT must also be position-independent (for example 'shared_segment_resource'), and so must ElementT.
+	 * The reference count is atomic, and lives in the segment with the elements, so copies made by different processes share the same value.
+	 *
+	 * Copying from an offset_array_value object requires no external synchronization with other 'const' operations on the object.
+	 * However, mutating an offset_array_value object by changing its value does require external synchronization with other operations on the same object
+	 */
+	template<typename ElementT, typename ResourceT>
+	class offset_array_value : ResourceT
+	{
+		[[nodiscard]] ResourceT& access_resource() & noexcept { return static_cast<ResourceT&>(*this); }
+		[[nodiscard]] ResourceT const& access_resource() const& noexcept { return static_cast<ResourceT const&>(*this); }
+		[[nodiscard]] ResourceT&& access_resource() && noexcept { return static_cast<ResourceT&&>(*this); }
+
+		struct control
+		{
+			size_t count;
+			size_t size; // number of elements
+			ElementT fam[1]; // actually a FAM
+		};
+
+		// allocates and construct the control, but not the elements
+		// the control comes with extra space for (size-1) elements contiguously after 'fam'
+		// the control starts with a count of 1
+		static control* new_control(ResourceT& r, size_t size);
+		// increase the count of the control
+		static control* acquire_control(control* c) noexcept;
+		// decrease the count of the control, and deletes it if last
+		static void release_control(ResourceT& r, control* c);
+
+		offset_ptr<control> m_control;
+
+	public:
+		offset_array_value() = default;
+		explicit offset_array_value(ResourceT r) noexcept;
+		offset_array_value(offset_array_value const& rhs) noexcept;
+		offset_array_value(offset_array_value && rhs) noexcept;
+		offset_array_value& operator=(offset_array_value const& rhs) noexcept;
+		offset_array_value& operator=(offset_array_value && rhs) noexcept;
+		~offset_array_value();
+		void swap(offset_array_value& rhs) noexcept;
+
+		using value_type = ElementT;
+		using memory_resource = ResourceT;
+		using const_iterator = value_type const*;
+
+		/**
+		 * Get a copy of the resource's value
+		 */
+		[[nodiscard]] memory_resource get_resource() const noexcept { return access_resource(); }
+
+		/**
+		 * Assigns a new value to the container.
+		 *
+		 * Requires: SizedRanged is a range (begin / end) and is sized (size)
+		 */
+		template<typename SizedRangeT>
+		offset_array_value& assign(SizedRangeT && r)
+		{
+			using std::size;
+			using std::begin;
+			using std::end;
+
+			release_control(access_resource(), m_control.get());
+			m_control = nullptr;
+
+			auto const range_size = size(r);
+			if (range_size == 0)
+			{
+				return *this;
+			}
+
+			control* const c = new_control(access_resource(), range_size);
+			try
+			{
+				std::uninitialized_copy(begin(r), end(r), c->fam);
+			}
+			catch (...)
+			{
+				// the elements were destroyed by uninitialized_copy, only free the block
+				access_resource().deallocate({ reinterpret_cast<byte*>(c), sizeof(control) + (range_size - 1) * sizeof(ElementT) }, align_v<control>);
+				throw;
+			}
+			m_control = c;
+
+			return *this;
+		}
+
+		[[nodiscard]] const_iterator begin() const noexcept { return data(); }
+		[[nodiscard]] const_iterator end() const noexcept { return data() + size(); }
+		[[nodiscard]] value_type const* data() const noexcept { return m_control ? m_control->fam : nullptr; }
+		[[nodiscard]] size_t size() const noexcept { return m_control ? m_control->size : 0; }
+		[[nodiscard]] bool is_empty() const noexcept { return size() == 0; }
+		[[nodiscard]] value_type const& front() const { return *data(); }
+		[[nodiscard]] value_type const& back() const { return data()[size() - 1]; }
+		[[nodiscard]] value_type const& operator[](size_t i) const { return data()[i]; }
+	};
+}
+
+/**
+ * Macro to declare a specialization of the 'offset_array_value' template
+ *
+ * By having a matching KAB_CONTAINER_OFFSET_ARRAY_VALUE_IMPL in a compiled object, other
+ * translation units are free to use only this declaration without having to import the entire template
+ *
+ * The template signature of 'offset_array_value' is not guaranteed, so use this macro rather than making your own declarations
+ */
+#define KAB_CONTAINER_OFFSET_ARRAY_VALUE_DECL(ElementType, ResourceType) \
+	namespace kab { \
+		extern template class offset_array_value<ElementType, ResourceType>; \
+	}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "kaballoc/memory/offset_ptr.h"
+#include "kaballoc/memory/detail/destroy.h"
+
+#include <new>
+#include <utility>
+
+namespace kab
+{
+	/**
+	 * 'offset_vector' is a dynamically-resizing contiguous container which is position-independent
+	 *
+	 * It behaves like 'vector', but refers to its storage with an 'offset_ptr'. An offset_vector stored in a shared memory segment
+	 * (see 'shared_segment'), with a resource allocating from the same segment, can be read by every process mapping the segment, at any address.
+	 * For that, the MemoryResource must also be position-independent (for example 'shared_segment_resource'), and so must T.
+	 *
+	 * Elements are relocated like in 'vector' on reallocation, and the capacity grows geometrically.
+	 * offset_vector is never copyable, is noexcept moveable if the resource is moveable, and is never trivially relocatable.
+	 *
+	 * As a general rule, functions that have preconditions or functions that can allocate are not marked noexcept, but everything else should be
+	 */
+	template<typename T, typename MemoryResource>
+	class offset_vector : MemoryResource
+	{
+		[[nodiscard]] MemoryResource& access_resource() & noexcept { return static_cast<MemoryResource&>(*this); }
+		[[nodiscard]] MemoryResource const& access_resource() const& noexcept { return static_cast<MemoryResource const&>(*this); }
+		[[nodiscard]] MemoryResource&& access_resource() && noexcept { return static_cast<MemoryResource&&>(*this); }
+
+		offset_ptr<T> m_data;
+		size_t m_size = 0;
+		size_t m_byte_capacity = 0;
+
+		void free_storage() noexcept;
+		void reallocate(size_t new_capacity);
+		void ensure_capacity(size_t n);
+	public:
+		/**
+		 * offset_vector is default constructible if the memory resource is default constructible
+		 */
+		offset_vector() = default;
+		/**
+		 * offset_vector is never copy constructible
+		 */
+		offset_vector(offset_vector const&) = delete;
+		/**
+		 * offset_vector is move constructible if the memory resource is moveable
+		 */
+		offset_vector(offset_vector && rhs) noexcept;
+		/**
+		 * offset_vector is never copy assignable
+		 */
+		offset_vector& operator=(offset_vector const& rhs) = delete;
+		/**
+		 * offset_vector is move assignable if the memory resource is moveable
+		 */
+		offset_vector& operator=(offset_vector && rhs) noexcept;
+
+		/**
+		 * Destroys all the elements of the vector, frees the storage, and destroys the memory resource
+		 */
+		~offset_vector();
+
+		using value_type = T;
+		using memory_resource = MemoryResource;
+		using iterator = T * ;
+		using const_iterator = T const*;
+
+		/**
+		 * This constructor lets the user provide a resource value
+		 */
+		explicit offset_vector(memory_resource r) noexcept
+			: MemoryResource(std::move(r))
+		{
+
+		}
+
+		/**
+		 * Returns the memory resource value used in this container
+		 */
+		[[nodiscard]] memory_resource get_resource() const noexcept { return access_resource(); }
+
+		/**
+		 * Return a pointer to the start of the elements, in the current mapping
+		 */
+		[[nodiscard]] T* data() noexcept { return m_data.get(); }
+		[[nodiscard]] T const* data() const noexcept { return m_data.get(); }
+
+		/**
+		 * Returns whether the vector has no elements
+		 */
+		[[nodiscard]] bool is_empty() const noexcept { return m_size == 0; }
+
+		/**
+		 * Returns the number of elements
+		 */
+		[[nodiscard]] size_t size() const noexcept { return m_size; }
+
+		/**
+		 * Returns the number of elements the vector can hold without reallocating
+		 */
+		[[nodiscard]] size_t capacity() const noexcept { return m_byte_capacity / sizeof(T); }
+
+		[[nodiscard]] iterator begin() noexcept { return data(); }
+		[[nodiscard]] iterator end() noexcept { return data() + m_size; }
+		[[nodiscard]] const_iterator begin() const noexcept { return data(); }
+		[[nodiscard]] const_iterator end() const noexcept { return data() + m_size; }
+
+		/**
+		 * Precondition: The size must be at least 1
+		 */
+		[[nodiscard]] T & front() { return *data(); }
+		[[nodiscard]] T const& front() const { return *data(); }
+		[[nodiscard]] T & back() { return data()[m_size - 1]; }
+		[[nodiscard]] T const& back() const { return data()[m_size - 1]; }
+
+		/**
+		 * Precondition: 'i' must be smaller than the size
+		 */
+		[[nodiscard]] T & operator[](size_t i) { return data()[i]; }
+		[[nodiscard]] T const& operator[](size_t i) const { return data()[i]; }
+
+		/**
+		 * Constructs a new element at the back of the vector from the provided arguments
+		 *
+		 * Requires: 'T' must be constructible from the provided arguments
+		 */
+		template<typename... Args>
+		T & emplace_back(Args&&... args)
+		{
+			ensure_capacity(m_size + 1);
+			T* ptr = new(data() + m_size) T(std::forward<Args>(args)...);
+			++m_size;
+
+			return *ptr;
+		}
+
+		T & push_back(T const& e) { return emplace_back(e); }
+		T & push_back(T && e) { return emplace_back(std::move(e)); }
+
+		/**
+		 * Inserts an entire Range at the back of the vector
+		 *
+		 * Requires: T must be constructible from the element type of Range
+		 */
+		template<typename Range>
+		void insert_back(Range&& r)
+		{
+			for (auto&& e : r)
+			{
+				emplace_back(std::forward<decltype(e)>(e));
+			}
+		}
+
+		/**
+		 * Removes the last element of the vector.
+		 *
+		 * Precondition: The size of the vector must be at least 1
+		 */
+		void pop_back();
+
+		/**
+		 * Changes the capacity of the vector, without changing the size of the vector
+		 */
+		void reserve(size_t n);
+
+		/**
+		 * Removes all elements from the vector, making its size 0
+		 * Does not free the storage.
+		 */
+		void clear() noexcept;
+
+		/**
+		 * Removes all elements from the vector, making its size 0, then frees the storage.
+		 */
+		void clear_and_shrink() noexcept;
+	};
+}
+
+/**
+ * Macro to declare a specialization of the 'offset_vector' template
+ *
+ * By having a matching KAB_CONTAINER_OFFSET_VECTOR_IMPL in a compiled object, other
+ * translation units are free to use only this declaration without having to import the entire template
+ *
+ * The template signature of 'offset_vector' is not guaranteed, so use this macro rather than making your own declarations
+ */
+#define KAB_CONTAINER_OFFSET_VECTOR_DECL(ElementType, ResourceType) \
+	namespace kab { \
+		extern template class offset_vector<ElementType, ResourceType>; \
+	}
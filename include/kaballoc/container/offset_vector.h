@@ -0,0 +1,17 @@
+#pragma once
+
+#include "kaballoc/container/offset_vector.decl.h"
+#include "kaballoc/container/detail/offset_vector.inl.h"
+
+/**
+ * Macro to define a specialization of the 'offset_vector' template
+ *
+ * By having this KAB_CONTAINER_OFFSET_VECTOR_IMPL in a compiled object, other
+ * translation units are free to use only the declaration header, not having to import the entire template
+ *
+ * The template signature of 'offset_vector' is not guaranteed, so use this macro rather than making your own declarations
+ */
+#define KAB_CONTAINER_OFFSET_VECTOR_IMPL(ElementType, ResourceType) \
+	namespace kab { \
+		template class offset_vector<ElementType, ResourceType>; \
+	}
@@ -0,0 +1,356 @@
+#pragma once
+
+#include "kaballoc/trait/relocatable.h"
+#include "kaballoc/memory/detail/destroy.h"
+#include "kaballoc/memory/byte_span.h"
+#include "kaballoc/range/detail/begin.h"
+#include "kaballoc/range/detail/end.h"
+#include "kaballoc/core/ptrdiff_t.h"
+
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace kab
+{
+	namespace detail
+	{
+		/**
+		 * Random access iterator over the elements of a 'ring_buffer'
+		 *
+		 * The iterator stores the storage, the capacity mask, and an unmasked position, so that iterators keep their order across the wrap-around
+		 */
+		template<typename T>
+		class ring_buffer_iterator
+		{
+			using element_type = std::remove_const_t<T>;
+
+			template<typename>
+			friend class ring_buffer_iterator;
+
+			element_type* m_data = nullptr;
+			size_t m_mask = 0;
+			size_t m_index = 0;
+
+		public:
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = element_type;
+			using difference_type = ptrdiff_t;
+			using pointer = T*;
+			using reference = T&;
+
+			ring_buffer_iterator() = default;
+			ring_buffer_iterator(element_type* data, size_t mask, size_t index) noexcept
+				: m_data(data)
+				, m_mask(mask)
+				, m_index(index)
+			{
+
+			}
+
+			// Conversion from a mutable iterator to a const iterator
+			template<typename U, typename = std::enable_if_t<std::is_same_v<U const, T> && !std::is_same_v<U, T>>>
+			ring_buffer_iterator(ring_buffer_iterator<U> const& rhs) noexcept
+				: m_data(rhs.m_data)
+				, m_mask(rhs.m_mask)
+				, m_index(rhs.m_index)
+			{
+
+			}
+
+			[[nodiscard]] reference operator*() const { return m_data[m_index & m_mask]; }
+			[[nodiscard]] pointer operator->() const { return &**this; }
+			[[nodiscard]] reference operator[](difference_type n) const { return *(*this + n); }
+
+			ring_buffer_iterator& operator++() noexcept { ++m_index; return *this; }
+			ring_buffer_iterator& operator--() noexcept { --m_index; return *this; }
+			ring_buffer_iterator operator++(int) noexcept { auto const it = *this; ++m_index; return it; }
+			ring_buffer_iterator operator--(int) noexcept { auto const it = *this; --m_index; return it; }
+			ring_buffer_iterator& operator+=(difference_type n) noexcept { m_index += n; return *this; }
+			ring_buffer_iterator& operator-=(difference_type n) noexcept { m_index -= n; return *this; }
+
+			[[nodiscard]] friend ring_buffer_iterator operator+(ring_buffer_iterator it, difference_type n) noexcept { return it += n; }
+			[[nodiscard]] friend ring_buffer_iterator operator+(difference_type n, ring_buffer_iterator it) noexcept { return it += n; }
+			[[nodiscard]] friend ring_buffer_iterator operator-(ring_buffer_iterator it, difference_type n) noexcept { return it -= n; }
+			[[nodiscard]] friend difference_type operator-(ring_buffer_iterator const& lhs, ring_buffer_iterator const& rhs) noexcept
+			{
+				return static_cast<difference_type>(lhs.m_index - rhs.m_index);
+			}
+
+			[[nodiscard]] friend bool operator==(ring_buffer_iterator const& lhs, ring_buffer_iterator const& rhs) noexcept { return lhs.m_index == rhs.m_index; }
+			[[nodiscard]] friend bool operator!=(ring_buffer_iterator const& lhs, ring_buffer_iterator const& rhs) noexcept { return lhs.m_index != rhs.m_index; }
+			[[nodiscard]] friend bool operator<(ring_buffer_iterator const& lhs, ring_buffer_iterator const& rhs) noexcept { return lhs - rhs < 0; }
+			[[nodiscard]] friend bool operator>(ring_buffer_iterator const& lhs, ring_buffer_iterator const& rhs) noexcept { return lhs - rhs > 0; }
+			[[nodiscard]] friend bool operator<=(ring_buffer_iterator const& lhs, ring_buffer_iterator const& rhs) noexcept { return lhs - rhs <= 0; }
+			[[nodiscard]] friend bool operator>=(ring_buffer_iterator const& lhs, ring_buffer_iterator const& rhs) noexcept { return lhs - rhs >= 0; }
+		};
+	}
+
+	/**
+	 * 'ring_buffer' is a dynamically-resizing double-ended queue, storing its elements in a circular buffer
+	 *
+	 * Elements can be added and removed at both ends in constant time, without ever shifting the other elements.
+	 * The capacity is always a power of two, so that positions wrap around with a mask rather than a division.
+	 * If the MemoryResource is an over-allocator, the capacity is the biggest power of two fitting in the over-allocated storage.
+	 *
+	 * On reallocation, the elements are relocated to the start of the new storage, one segment on each side of the wrap-around
+	 * (see 'uninitialized_relocate'): trivially relocatable types are copied with two memcpy.
+	 * Types which can throw on relocation are copied if they are copyable, and a throwing reallocation leaves the ring buffer unchanged.
+	 *
+	 * The bulk functions 'push_back_n' and 'pop_front_n' copy and relocate whole segments at once.
+	 *
+	 * The MemoryResource needs to match the kab::memory_resource concept.
+	 *
+	 * ring_buffer is never copyable, is noexcept moveable if the resource is moveable, and is trivially relocatable if the resource is relocatable or empty
+	 *
+	 * As a general rule, functions that have preconditions or functions that can allocate are not marked noexcept, but everything else should be
+	 */
+	template<typename T, typename MemoryResource>
+	class ring_buffer : MemoryResource {
+		[[nodiscard]] MemoryResource& access_resource() & noexcept { return static_cast<MemoryResource&>(*this); }
+		[[nodiscard]] MemoryResource const& access_resource() const& noexcept { return static_cast<MemoryResource const&>(*this); }
+		[[nodiscard]] MemoryResource&& access_resource() && noexcept { return static_cast<MemoryResource&&>(*this); }
+
+		T* m_data = nullptr;
+		size_t m_head = 0; // position of the first element, always smaller than the capacity
+		size_t m_size = 0;
+		size_t m_capacity = 0; // zero or a power of two
+		size_t m_byte_capacity = 0; // size of the storage, as returned by the resource
+
+		[[nodiscard]] size_t mask() const noexcept { return m_capacity - 1; }
+		[[nodiscard]] T* element(size_t i) const noexcept { return m_data + ((m_head + i) & mask()); }
+
+		// Number of elements from logical index 'i' to the end of the storage, capped by 'n'
+		[[nodiscard]] size_t contiguous_count(size_t i, size_t n) const noexcept;
+
+		void destroy_range(size_t first, size_t n) noexcept;
+		void free_storage() noexcept;
+		void reallocate(size_t new_capacity);
+		void ensure_capacity(size_t n);
+	public:
+		/**
+		 * ring_buffer is default constructible if the memory resource is default constructible
+		 */
+		ring_buffer() = default;
+		/**
+		 * ring_buffer is never copy constructible
+		 */
+		ring_buffer(ring_buffer const&) = delete;
+		/**
+		 * ring_buffer is noexcept move constructible if the memory resource is moveable
+		 */
+		ring_buffer(ring_buffer && rhs) noexcept;
+		/**
+		 * ring_buffer is never copy assignable
+		 */
+		ring_buffer& operator=(ring_buffer const& rhs) = delete;
+		/**
+		 * ring_buffer is move assignable if the memory resource is moveable
+		 */
+		ring_buffer& operator=(ring_buffer && rhs) noexcept;
+
+		/**
+		 * Destroys all the elements of the ring buffer, frees the storage, and destroys the memory resource
+		 */
+		~ring_buffer();
+
+		/**
+		 * ring_buffer is swappable if the memory resource is swappable
+		 */
+		void swap(ring_buffer& rhs) noexcept;
+
+		using value_type = T;
+		using memory_resource = MemoryResource;
+		using iterator = detail::ring_buffer_iterator<T>;
+		using const_iterator = detail::ring_buffer_iterator<T const>;
+		using sentinel = iterator;
+		using const_sentinel = const_iterator;
+
+		/**
+		 * If the memory resource is moveable, this constructor lets the user provide a resource value
+		 */
+		explicit ring_buffer(memory_resource r) noexcept
+			: MemoryResource(std::move(r))
+		{
+
+		}
+
+		/**
+		 * Returns the memory resource value used in this container
+		 */
+		[[nodiscard]] memory_resource get_resource() const noexcept { return access_resource(); }
+
+		/**
+		 * Returns whether the ring buffer has no elements
+		 *
+		 * Note that the capacity may not necessarily be zero if this is true
+		 */
+		[[nodiscard]] bool is_empty() const noexcept { return m_size == 0; }
+
+		/**
+		 * Returns the number of constructed elements
+		 */
+		[[nodiscard]] size_t size() const noexcept { return m_size; }
+
+		/**
+		 * Returns the capacity of the ring buffer, which is zero or a power of two
+		 *
+		 * As long as the resulting size is smaller or equal to this capacity, constructing functions will not allocate
+		 */
+		[[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+
+		/**
+		 * 'begin' and 'end' return iterators to the element range of the ring buffer, from front to back
+		 *
+		 * If called with const access, this will return const iterators
+		 */
+		[[nodiscard]] iterator begin() noexcept { return { m_data, mask(), m_head }; }
+		[[nodiscard]] sentinel end() noexcept { return { m_data, mask(), m_head + m_size }; }
+		[[nodiscard]] const_iterator begin() const noexcept { return { m_data, mask(), m_head }; }
+		[[nodiscard]] const_sentinel end() const noexcept { return { m_data, mask(), m_head + m_size }; }
+
+		/**
+		 * Returns a reference to the first element of the ring buffer
+		 *
+		 * Precondition: The size must be at least 1
+		 */
+		[[nodiscard]] T & front() { return m_data[m_head]; }
+		[[nodiscard]] T const& front() const { return m_data[m_head]; }
+
+		/**
+		 * Returns a reference to the last element of the ring buffer.
+		 *
+		 * Precondition: The size must be at least 1
+		 */
+		[[nodiscard]] T & back() { return *element(m_size - 1); }
+		[[nodiscard]] T const& back() const { return *element(m_size - 1); }
+
+		/**
+		 * Operator[]. Accesses elements using a zero-based index from the front, returning a reference to the specified element.
+		 *
+		 * Precondition: 'i' must be smaller than the size
+		 */
+		[[nodiscard]] T & operator[](size_t i) { return *element(i); }
+		[[nodiscard]] T const& operator[](size_t i) const { return *element(i); }
+
+		/**
+		 * Constructs a new element at the back of the ring buffer from the provided arguments
+		 *
+		 * Requires: 'T' must be constructible from the provided arguments
+		 */
+		template<typename... Args>
+		T & emplace_back(Args&&... args)
+		{
+			ensure_capacity(m_size + 1);
+			T* ptr = new(element(m_size)) T(std::forward<Args>(args)...);
+			++m_size;
+
+			return *ptr;
+		}
+
+		/**
+		 * Constructs a new element at the front of the ring buffer from the provided arguments
+		 *
+		 * Requires: 'T' must be constructible from the provided arguments
+		 */
+		template<typename... Args>
+		T & emplace_front(Args&&... args)
+		{
+			ensure_capacity(m_size + 1);
+			size_t const new_head = (m_head - 1) & mask();
+			T* ptr = new(m_data + new_head) T(std::forward<Args>(args)...);
+			m_head = new_head;
+			++m_size;
+
+			return *ptr;
+		}
+
+		/**
+		 * Constructs a new element at the back or the front of the ring buffer by copying or moving the provided argument
+		 *
+		 * Requires: T is CopyConstructible or MoveConstructible
+		 */
+		T & push_back(T const& e) { return emplace_back(e); }
+		T & push_back(T && e) { return emplace_back(std::move(e)); }
+		T & push_front(T const& e) { return emplace_front(e); }
+		T & push_front(T && e) { return emplace_front(std::move(e)); }
+
+		/**
+		 * Copies the 'n' elements starting at 'src' to the back of the ring buffer.
+		 * Trivially copyable elements are copied with at most two memcpy.
+		 * If a copy throws, the elements already copied are removed
+		 *
+		 * Precondition: [src, src + n) is not part of the ring buffer
+		 * Requires: T is CopyConstructible
+		 */
+		void push_back_n(T const* src, size_t n);
+
+		/**
+		 * Removes the last or the first element of the ring buffer.
+		 *
+		 * Precondition: The size of the ring buffer must be at least 1
+		 */
+		void pop_back();
+		void pop_front();
+
+		/**
+		 * Relocates the 'n' first elements of the ring buffer to the uninitialized storage starting at 'dst', and removes them.
+		 * Trivially relocatable elements are copied with at most two memcpy.
+		 * The caller owns the relocated objects, and is responsible for destroying them.
+		 *
+		 * Precondition: 'n' must be smaller or equal to the size, and [dst, dst + n) must be uninitialized storage outside the ring buffer
+		 * Requires: T is nothrow relocatable
+		 */
+		void pop_front_n(T* dst, size_t n);
+
+		/**
+		 * Destroys the 'n' first elements of the ring buffer.
+		 *
+		 * Precondition: 'n' must be smaller or equal to the size
+		 */
+		void pop_front_n(size_t n) noexcept;
+
+		/**
+		 * Changes the capacity of the ring buffer, without changing its size
+		 */
+		void reserve(size_t n);
+
+		/**
+		 * Removes all elements from the ring buffer, making its size 0
+		 * Does not free the storage.
+		 */
+		void clear() noexcept;
+
+		/**
+		 * Removes all elements from the ring buffer, making its size 0, then frees the storage.
+		 */
+		void clear_and_shrink() noexcept;
+
+		/**
+		 * Potentially reallocate to the smallest power of two capacity holding the elements
+		 * If the size of the ring buffer is 0, the current storage is freed without allocating a new one
+		 */
+		void shrink_to_fit();
+	};
+
+	template<typename T, typename MemoryResource>
+	struct is_trivially_relocatable<ring_buffer<T, MemoryResource>>
+		: std::conditional_t<std::is_empty_v<MemoryResource> || is_trivially_relocatable_v<MemoryResource>, std::true_type, std::false_type>
+	{
+
+	};
+}
+
+/**
+ * Macro to declare a specialization of the 'ring_buffer' template
+ *
+ * By having a matching KAB_CONTAINER_RING_BUFFER_IMPL in a compiled object, other
+ * translation units are free to use only this declaration without having to import the entire template
+ *
+ * The template signature of 'ring_buffer' is not guaranteed, so use this macro rather than making your own declarations
+ */
+#define KAB_CONTAINER_RING_BUFFER_DECL(ElementType, ResourceType) \
+	namespace kab { \
+		extern template class ring_buffer<ElementType, ResourceType>; \
+	}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "kaballoc/container/ring_buffer.decl.h"
+#include "kaballoc/container/detail/ring_buffer.inl.h"
+
+/**
+ * Macro to define a specialization of the 'ring_buffer' template
+ *
+ * By having this KAB_CONTAINER_RING_BUFFER_IMPL in a compiled object, other
+ * translation units are free to use only the declaration header, not having to import the entire template
+ *
+ * The template signature of 'ring_buffer' is not guaranteed, so use this macro rather than making your own declarations
+ */
+#define KAB_CONTAINER_RING_BUFFER_IMPL(ElementType, ResourceType) \
+	namespace kab { \
+		template class ring_buffer<ElementType, ResourceType>; \
+	}
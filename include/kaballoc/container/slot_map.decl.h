@@ -0,0 +1,248 @@
+#pragma once
+
+#include "kaballoc/container/vector.decl.h"
+#include "kaballoc/trait/relocatable.h"
+
+#include <stdint.h>
+#include <type_traits>
+#include <utility>
+
+namespace kab
+{
+	/**
+	 * Handle to an element of a 'slot_map'
+	 *
+	 * The handle stays valid until its element is erased, even when other elements are inserted or erased.
+	 * Once the element is erased, the generation of its slot changes, so the handle no longer refers to any element, even if the slot is reused
+	 */
+	struct slot_map_handle
+	{
+		uint32_t index;
+		uint32_t generation;
+
+		[[nodiscard]] friend bool operator==(slot_map_handle lhs, slot_map_handle rhs) noexcept { return lhs.index == rhs.index && lhs.generation == rhs.generation; }
+		[[nodiscard]] friend bool operator!=(slot_map_handle lhs, slot_map_handle rhs) noexcept { return !(lhs == rhs); }
+	};
+
+	template<>
+	struct is_trivially_relocatable<slot_map_handle> : std::true_type {};
+
+	/**
+	 * 'slot_map' is a pool of elements referred to by handles, with constant time insertion, lookup and erasure
+	 *
+	 * The elements are stored contiguously in a 'vector', so iterating over them touches no other memory.
+	 * A handle refers to a slot, and the slot holds the index of its element in the vector along with a generation counter.
+	 * Erasing an element relocates the last element into its place (see 'vector::swap_remove'), and updates the slot of the relocated element.
+	 * Freed slots are kept in a free list and reused by the next insertions.
+	 *
+	 * The order of the elements is not kept, and insertions and erasures invalidate pointers and references to the elements, but not the handles.
+	 * Slots are never freed, since freeing them would let a stale handle refer to a new element; 'clear' keeps the slots for this reason.
+	 * A slot may be reused 2^32 times before its generation wraps around.
+	 *
+	 * The element vector, the element-to-slot vector, and the slot vector get a copy of the memory resource,
+	 * so the MemoryResource must be copyable (for example a 'resource_reference' or an empty resource) and needs to match the kab::memory_resource concept.
+	 *
+	 * slot_map is never copyable, is noexcept moveable if the resource is moveable, and is trivially relocatable if the resource is relocatable or empty
+	 *
+	 * As a general rule, functions that have preconditions or functions that can allocate are not marked noexcept, but everything else should be
+	 */
+	template<typename T, typename MemoryResource>
+	class slot_map
+	{
+		struct slot
+		{
+			uint32_t index; // index of the element if the slot is used, otherwise index of the next free slot
+			uint32_t generation;
+		};
+
+		static constexpr uint32_t no_slot = UINT32_MAX;
+
+		vector<T, MemoryResource> m_values;
+		vector<uint32_t, MemoryResource> m_value_slots; // slot of each element
+		vector<slot, MemoryResource> m_slots;
+		uint32_t m_free_slot = no_slot; // head of the free list
+
+		// Returns a free slot, adding one if the free list is empty
+		uint32_t acquire_free_slot();
+		// Makes room for one more element in 'v'. The vectors only grow to the requested size, so the slot map grows them geometrically
+		template<typename U>
+		static void grow_for_one(vector<U, MemoryResource>& v);
+	public:
+		using value_type = T;
+		using memory_resource = MemoryResource;
+		using handle = slot_map_handle;
+		using iterator = T*;
+		using const_iterator = T const*;
+		using sentinel = iterator;
+		using const_sentinel = const_iterator;
+
+		/**
+		 * slot_map is default constructible if the memory resource is default constructible
+		 */
+		slot_map() = default;
+		/**
+		 * slot_map is never copy constructible
+		 */
+		slot_map(slot_map const&) = delete;
+		/**
+		 * slot_map is noexcept move constructible if the memory resource is moveable
+		 */
+		slot_map(slot_map && rhs) noexcept;
+		/**
+		 * slot_map is never copy assignable
+		 */
+		slot_map& operator=(slot_map const& rhs) = delete;
+		/**
+		 * slot_map is move assignable if the memory resource is moveable
+		 */
+		slot_map& operator=(slot_map && rhs) noexcept;
+
+		/**
+		 * slot_map is swappable if the memory resource is swappable
+		 */
+		void swap(slot_map& rhs) noexcept;
+
+		/**
+		 * This constructor lets the user provide a resource value, copied to every storage
+		 */
+		explicit slot_map(memory_resource r) noexcept
+			: m_values(r)
+			, m_value_slots(r)
+			, m_slots(std::move(r))
+		{
+
+		}
+
+		/**
+		 * Returns the memory resource value used in this container
+		 */
+		[[nodiscard]] memory_resource get_resource() const noexcept { return m_values.get_resource(); }
+
+		/**
+		 * Returns whether the slot map has no elements
+		 */
+		[[nodiscard]] bool is_empty() const noexcept { return m_values.is_empty(); }
+
+		/**
+		 * Returns the number of elements
+		 */
+		[[nodiscard]] size_t size() const noexcept { return m_values.size(); }
+
+		/**
+		 * 'begin' and 'end' return iterators to the contiguous elements, in no particular order
+		 */
+		[[nodiscard]] iterator begin() noexcept { return m_values.begin(); }
+		[[nodiscard]] sentinel end() noexcept { return m_values.end(); }
+		[[nodiscard]] const_iterator begin() const noexcept { return m_values.begin(); }
+		[[nodiscard]] const_sentinel end() const noexcept { return m_values.end(); }
+		[[nodiscard]] T* data() noexcept { return m_values.data(); }
+		[[nodiscard]] T const* data() const noexcept { return m_values.data(); }
+
+		/**
+		 * Returns the handle of the element at index 'i' of the element range
+		 *
+		 * Precondition: 'i' must be smaller than the size
+		 */
+		[[nodiscard]] handle handle_at(size_t i) const;
+
+		/**
+		 * Returns whether the handle refers to an element of this slot map
+		 */
+		[[nodiscard]] bool contains(handle h) const noexcept;
+
+		/**
+		 * Returns a pointer to the element of the handle, or nullptr if the handle doesn't refer to an element
+		 */
+		[[nodiscard]] T* find(handle h) noexcept;
+		[[nodiscard]] T const* find(handle h) const noexcept;
+
+		/**
+		 * Returns a reference to the element of the handle
+		 *
+		 * Precondition: the handle refers to an element of this slot map
+		 */
+		[[nodiscard]] T & operator[](handle h) { return m_values[m_slots[h.index].index]; }
+		[[nodiscard]] T const& operator[](handle h) const { return m_values[m_slots[h.index].index]; }
+
+		/**
+		 * Constructs a new element from the provided arguments, and returns its handle.
+		 * If the constructor throws, the slot map is unchanged, apart from its capacity
+		 *
+		 * Requires: 'T' must be constructible from the provided arguments
+		 */
+		template<typename... Args>
+		handle emplace(Args&&... args)
+		{
+			grow_for_one(m_values);
+			grow_for_one(m_value_slots);
+			uint32_t const slot_index = acquire_free_slot();
+			m_value_slots.push_back(slot_index);
+			try
+			{
+				m_values.emplace_back(std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				m_value_slots.pop_back();
+				throw;
+			}
+
+			slot& s = m_slots[slot_index];
+			m_free_slot = s.index;
+			s.index = static_cast<uint32_t>(m_values.size() - 1);
+			return { slot_index, s.generation };
+		}
+
+		/**
+		 * Copies or moves a new element, and returns its handle
+		 */
+		handle insert(T const& e) { return emplace(e); }
+		handle insert(T && e) { return emplace(std::move(e)); }
+
+		/**
+		 * Removes the element of the handle, if any, and returns whether an element was removed.
+		 * The last element of the element range is relocated in place of the removed one.
+		 */
+		bool erase(handle h);
+
+		/**
+		 * Ensures the slot map can hold 'n' elements without reallocating
+		 */
+		void reserve(size_t n);
+
+		/**
+		 * Removes all elements, invalidating every handle.
+		 * Does not free the storage.
+		 */
+		void clear() noexcept;
+
+		/**
+		 * Potentially reallocate to reduce the capacity of the element storage to match the size as much as possible.
+		 * The slots are kept
+		 */
+		void shrink_to_fit();
+	};
+
+	template<typename T, typename MemoryResource>
+	struct is_trivially_relocatable<slot_map<T, MemoryResource>>
+		: std::conjunction<
+			is_trivially_relocatable<vector<T, MemoryResource>>,
+			is_trivially_relocatable<vector<uint32_t, MemoryResource>>
+		>
+	{
+
+	};
+}
+
+/**
+ * Macro to declare a specialization of the 'slot_map' template
+ *
+ * By having a matching KAB_CONTAINER_SLOT_MAP_IMPL in a compiled object, other
+ * translation units are free to use only this declaration without having to import the entire template
+ *
+ * The template signature of 'slot_map' is not guaranteed, so use this macro rather than making your own declarations
+ */
+#define KAB_CONTAINER_SLOT_MAP_DECL(ElementType, ResourceType) \
+	namespace kab { \
+		extern template class slot_map<ElementType, ResourceType>; \
+	}
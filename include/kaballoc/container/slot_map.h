@@ -0,0 +1,17 @@
+#pragma once
+
+#include "kaballoc/container/slot_map.decl.h"
+#include "kaballoc/container/detail/slot_map.inl.h"
+
+/**
+ * Macro to define a specialization of the 'slot_map' template
+ *
+ * By having this KAB_CONTAINER_SLOT_MAP_IMPL in a compiled object, other
+ * translation units are free to use only the declaration header, not having to import the entire template
+ *
+ * The template signature of 'slot_map' is not guaranteed, so use this macro rather than making your own declarations
+ */
+#define KAB_CONTAINER_SLOT_MAP_IMPL(ElementType, ResourceType) \
+	namespace kab { \
+		template class slot_map<ElementType, ResourceType>; \
+	}
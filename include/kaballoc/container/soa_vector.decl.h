@@ -0,0 +1,268 @@
+#pragma once
+
+#include "kaballoc/trait/relocatable.h"
+#include "kaballoc/memory/byte_span.h"
+#include "kaballoc/memory/detail/destroy.h"
+
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace kab
+{
+	template<typename Tuple, typename MemoryResource>
+	class soa_vector;
+
+	/**
+	 * 'soa_vector' is a dynamically-resizing container storing each member of its elements in its own contiguous column (structure of arrays)
+	 *
+	 * The element type is given as a std::tuple, for example soa_vector<std::tuple<int, float, id>, R>.
+	 * A loop touching only a few members loads only their columns, instead of whole elements.
+	 *
+	 * Every column lives in a single block from the MemoryResource. The columns are laid out in order, each aligned for its type,
+	 * at offsets computed from the capacity. If the MemoryResource is an over-allocator, the extra bytes are used for capacity.
+	 * When growing, the capacity at least doubles, and every column is relocated to the new block (see 'uninitialized_relocate').
+	 * If a column type can throw on relocation, the columns are copied instead, and a throwing reallocation leaves the soa_vector unchanged.
+	 *
+	 * The MemoryResource needs to match the kab::memory_resource concept.
+	 *
+	 * soa_vector is never copyable, is noexcept moveable if the resource is moveable, and is trivially relocatable if the resource is relocatable or empty
+	 *
+	 * As a general rule, functions that have preconditions or functions that can allocate are not marked noexcept, but everything else should be
+	 */
+	template<typename... Ts, typename MemoryResource>
+	class soa_vector<std::tuple<Ts...>, MemoryResource> : MemoryResource
+	{
+		static_assert(sizeof...(Ts) != 0, "soa_vector needs at least one column");
+		static_assert(((is_nothrow_relocatable_v<Ts> || std::is_copy_constructible_v<Ts>) && ...),
+			"soa_vector columns must be nothrow relocatable or copyable");
+
+		[[nodiscard]] MemoryResource& access_resource() & noexcept { return static_cast<MemoryResource&>(*this); }
+		[[nodiscard]] MemoryResource const& access_resource() const& noexcept { return static_cast<MemoryResource const&>(*this); }
+		[[nodiscard]] MemoryResource&& access_resource() && noexcept { return static_cast<MemoryResource&&>(*this); }
+
+		using columns = std::tuple<Ts*...>;
+		using indices = std::index_sequence_for<Ts...>;
+
+		columns m_columns{}; // the first column is at the start of the block
+		size_t m_size = 0;
+		size_t m_capacity = 0;
+		size_t m_byte_capacity = 0;
+
+		[[nodiscard]] byte* block() const noexcept { return reinterpret_cast<byte*>(std::get<0>(m_columns)); }
+
+		// Returns the size of a block for 'capacity' elements, and the column pointers in a block starting at 'data'
+		[[nodiscard]] static size_t block_size(size_t capacity) noexcept;
+		[[nodiscard]] static columns column_pointers(byte* data, size_t capacity) noexcept;
+
+		void destroy_range(size_t first, size_t last) noexcept;
+		void free_storage() noexcept;
+		void reallocate(size_t new_capacity);
+		void ensure_capacity(size_t n);
+
+		// Constructs the members of the element at index 'i', and destroys the constructed members if one throws
+		template<size_t... I, typename... Args>
+		void construct_at(std::index_sequence<I...>, size_t i, Args&&... args)
+		{
+			size_t constructed = 0;
+			try
+			{
+				((new(std::get<I>(m_columns) + i) Ts(std::forward<Args>(args)), ++constructed), ...);
+			}
+			catch (...)
+			{
+				((I < constructed ? kab::destroy_at(std::get<I>(m_columns) + i) : void()), ...);
+				throw;
+			}
+		}
+
+		template<size_t... I, typename Tuple>
+		void construct_from_tuple(std::index_sequence<I...> is, size_t i, Tuple&& t)
+		{
+			construct_at(is, i, std::get<I>(std::forward<Tuple>(t))...);
+		}
+	public:
+		using value_type = std::tuple<Ts...>;
+		using memory_resource = MemoryResource;
+		using reference = std::tuple<Ts&...>;
+		using const_reference = std::tuple<Ts const&...>;
+
+		/**
+		 * Type of the column 'I'
+		 */
+		template<size_t I>
+		using column_type = std::tuple_element_t<I, value_type>;
+
+		/**
+		 * soa_vector is default constructible if the memory resource is default constructible
+		 */
+		soa_vector() = default;
+		/**
+		 * soa_vector is never copy constructible
+		 */
+		soa_vector(soa_vector const&) = delete;
+		/**
+		 * soa_vector is noexcept move constructible if the memory resource is moveable
+		 */
+		soa_vector(soa_vector && rhs) noexcept;
+		/**
+		 * soa_vector is never copy assignable
+		 */
+		soa_vector& operator=(soa_vector const& rhs) = delete;
+		/**
+		 * soa_vector is move assignable if the memory resource is moveable
+		 */
+		soa_vector& operator=(soa_vector && rhs) noexcept;
+
+		/**
+		 * Destroys all the elements, frees the storage, and destroys the memory resource
+		 */
+		~soa_vector();
+
+		/**
+		 * soa_vector is swappable if the memory resource is swappable
+		 */
+		void swap(soa_vector& rhs) noexcept;
+
+		/**
+		 * If the memory resource is moveable, this constructor lets the user provide a resource value
+		 */
+		explicit soa_vector(memory_resource r) noexcept
+			: MemoryResource(std::move(r))
+		{
+
+		}
+
+		/**
+		 * Returns the memory resource value used in this container
+		 */
+		[[nodiscard]] memory_resource get_resource() const noexcept { return access_resource(); }
+
+		/**
+		 * Returns whether the soa_vector has no elements
+		 */
+		[[nodiscard]] bool is_empty() const noexcept { return m_size == 0; }
+
+		/**
+		 * Returns the number of elements
+		 */
+		[[nodiscard]] size_t size() const noexcept { return m_size; }
+
+		/**
+		 * Returns the number of elements the soa_vector can hold without reallocating
+		 */
+		[[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+
+		/**
+		 * Returns a pointer to the start of the column 'I'. The pointer is aligned for the type of the column
+		 */
+		template<size_t I>
+		[[nodiscard]] column_type<I>* data() noexcept { return std::get<I>(m_columns); }
+		template<size_t I>
+		[[nodiscard]] column_type<I> const* data() const noexcept { return std::get<I>(m_columns); }
+
+		/**
+		 * Returns a span over the column 'I', with one member per element
+		 */
+		template<size_t I>
+		[[nodiscard]] std::span<column_type<I>> column() noexcept { return { data<I>(), m_size }; }
+		template<size_t I>
+		[[nodiscard]] std::span<column_type<I> const> column() const noexcept { return { data<I>(), m_size }; }
+
+		/**
+		 * Operator[]. Returns a tuple of references to the members of the element at index 'i'
+		 *
+		 * Precondition: 'i' must be smaller than the size
+		 */
+		[[nodiscard]] reference operator[](size_t i) { return std::apply([i](Ts*... column) { return reference(column[i]...); }, m_columns); }
+		[[nodiscard]] const_reference operator[](size_t i) const { return std::apply([i](Ts*... column) { return const_reference(column[i]...); }, m_columns); }
+
+		/**
+		 * Constructs a new element at the back, each member being constructed from its argument.
+		 * If a constructor throws, the soa_vector is unchanged, apart from its capacity
+		 *
+		 * Requires: each column type must be constructible from its argument
+		 */
+		template<typename... Args>
+		void emplace_back(Args&&... args)
+		{
+			static_assert(sizeof...(Args) == sizeof...(Ts), "emplace_back takes one argument per column");
+			ensure_capacity(m_size + 1);
+			construct_at(indices(), m_size, std::forward<Args>(args)...);
+			++m_size;
+		}
+
+		/**
+		 * Constructs a new element at the back by copying or moving the members of a tuple
+		 */
+		void push_back(value_type const& e)
+		{
+			ensure_capacity(m_size + 1);
+			construct_from_tuple(indices(), m_size, e);
+			++m_size;
+		}
+		void push_back(value_type && e)
+		{
+			ensure_capacity(m_size + 1);
+			construct_from_tuple(indices(), m_size, std::move(e));
+			++m_size;
+		}
+
+		/**
+		 * Removes the last element
+		 *
+		 * Precondition: The size must be at least 1
+		 */
+		void pop_back();
+
+		/**
+		 * Changes the capacity, without changing the size
+		 */
+		void reserve(size_t n);
+
+		/**
+		 * Changes the size, constructing or destroying elements as necessary. New members are default-initialized
+		 */
+		void resize(size_t n);
+
+		/**
+		 * Removes all elements, making the size 0
+		 * Does not free the storage.
+		 */
+		void clear() noexcept;
+
+		/**
+		 * Removes all elements, making the size 0, then frees the storage.
+		 */
+		void clear_and_shrink() noexcept;
+
+		/**
+		 * Potentially reallocate to reduce the capacity to match the size as much as possible
+		 * If the size is 0, the current storage is freed without allocating a new one
+		 */
+		void shrink_to_fit();
+	};
+
+	template<typename Tuple, typename MemoryResource>
+	struct is_trivially_relocatable<soa_vector<Tuple, MemoryResource>>
+		: std::conditional_t<std::is_empty_v<MemoryResource> || is_trivially_relocatable_v<MemoryResource>, std::true_type, std::false_type>
+	{
+
+	};
+}
+
+/**
+ * Macro to declare a specialization of the 'soa_vector' template
+ *
+ * By having a matching KAB_CONTAINER_SOA_VECTOR_IMPL in a compiled object, other
+ * translation units are free to use only this declaration without having to import the entire template
+ *
+ * The template signature of 'soa_vector' is not guaranteed, so use this macro rather than making your own declarations.
+ * Since the tuple type contains commas, pass it through an alias
+ */
+#define KAB_CONTAINER_SOA_VECTOR_DECL(TupleType, ResourceType) \
+	namespace kab { \
+		extern template class soa_vector<TupleType, ResourceType>; \
+	}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "kaballoc/container/soa_vector.decl.h"
+#include "kaballoc/container/detail/soa_vector.inl.h"
+
+/**
+ * Macro to define a specialization of the 'soa_vector' template
+ *
+ * By having this KAB_CONTAINER_SOA_VECTOR_IMPL in a compiled object, other
+ * translation units are free to use only the declaration header, not having to import the entire template
+ *
+ * The template signature of 'soa_vector' is not guaranteed, so use this macro rather than making your own declarations.
+ * Since the tuple type contains commas, pass it through an alias
+ */
+#define KAB_CONTAINER_SOA_VECTOR_IMPL(TupleType, ResourceType) \
+	namespace kab { \
+		template class soa_vector<TupleType, ResourceType>; \
+	}
@@ -0,0 +1,183 @@
+#pragma once
+
+#include "kaballoc/trait/relocatable.h"
+#include "kaballoc/memory/byte_span.h"
+#include "kaballoc/core/cache_line.h"
+
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace kab
+{
+	/**
+	 * 'spsc_queue' is a bounded, lock-free, first-in first-out queue for one producer thread and one consumer thread
+	 *
+	 * The slots are allocated once, at construction, from the MemoryResource. The capacity is rounded up to a power of two,
+	 * and further up if the resource over-allocates, so a slot is found with a mask instead of a division.
+	 *
+	 * The producer only writes the tail index and the consumer only writes the head index. Both are on their own cache line,
+	 * next to a cached copy of the other index, so a thread only reads the other thread's cache line when its copy says the queue is full or empty.
+	 *
+	 * Popping an element gives it to the caller by relocation: trivially relocatable elements are copied with a memcpy.
+	 *
+	 * The MemoryResource used needs to match the kab::memory_resource concept.
+	 *
+	 * spsc_queue is never copyable nor moveable, since other threads may refer to it
+	 *
+	 * Only the functions documented as such may be called concurrently, the other functions require exclusive access
+	 */
+	template<typename T, typename MemoryResource>
+	class spsc_queue : private MemoryResource
+	{
+		[[nodiscard]] MemoryResource& access_resource() & noexcept { return static_cast<MemoryResource&>(*this); }
+		[[nodiscard]] MemoryResource const& access_resource() const& noexcept { return static_cast<MemoryResource const&>(*this); }
+
+		// Read-only after construction
+		T* m_slots = nullptr;
+		size_t m_capacity = 0; // a power of two
+		size_t m_byte_capacity = 0; // size of the storage, as returned by the resource
+
+		// Written by the producer
+		alignas(cache_line_size) std::atomic<size_t> m_tail = 0;
+		size_t m_cached_head = 0;
+
+		// Written by the consumer
+		alignas(cache_line_size) std::atomic<size_t> m_head = 0;
+		size_t m_cached_tail = 0;
+
+		[[nodiscard]] size_t mask() const noexcept { return m_capacity - 1; }
+
+		void allocate_slots(size_t capacity);
+		// Return the number of free or full slots, only reading the index of the other thread if fewer than 'n' slots are known to be available
+		[[nodiscard]] size_t free_count(size_t tail, size_t n) noexcept;
+		[[nodiscard]] size_t full_count(size_t head, size_t n) noexcept;
+	public:
+		using value_type = T;
+		using memory_resource = MemoryResource;
+
+		/**
+		 * Constructs a queue able to hold at least 'capacity' elements
+		 *
+		 * Precondition: 'capacity' is not 0
+		 */
+		explicit spsc_queue(size_t capacity)
+		{
+			allocate_slots(capacity);
+		}
+
+		/**
+		 * This constructor lets the user provide a resource value
+		 */
+		spsc_queue(size_t capacity, memory_resource r)
+			: MemoryResource(std::move(r))
+		{
+			allocate_slots(capacity);
+		}
+
+		/**
+		 * spsc_queue is never copyable nor moveable
+		 */
+		spsc_queue(spsc_queue const&) = delete;
+		spsc_queue& operator=(spsc_queue const&) = delete;
+
+		/**
+		 * Destroys the elements left in the queue, and frees the slots
+		 */
+		~spsc_queue();
+
+		/**
+		 * Returns the memory resource value used in this container
+		 */
+		[[nodiscard]] memory_resource get_resource() const noexcept { return access_resource(); }
+
+		/**
+		 * Returns the maximum number of elements in the queue
+		 */
+		[[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+
+		/**
+		 * Returns the number of elements in the queue. May be called concurrently, in which case the result can be outdated when it's returned
+		 */
+		[[nodiscard]] size_t size() const noexcept
+		{
+			size_t const head = m_head.load(std::memory_order_acquire);
+			return m_tail.load(std::memory_order_acquire) - head;
+		}
+
+		/**
+		 * Returns whether the queue has no elements. May be called concurrently, in which case the result can be outdated when it's returned
+		 */
+		[[nodiscard]] bool is_empty() const noexcept { return size() == 0; }
+
+		/**
+		 * Constructs a new element at the back of the queue from the provided arguments. Returns false if the queue is full.
+		 * If the constructor throws, the queue is unchanged.
+		 *
+		 * Producer only
+		 * Requires: 'T' must be constructible from the provided arguments
+		 */
+		template<typename... Args>
+		bool try_emplace(Args&&... args)
+		{
+			size_t const tail = m_tail.load(std::memory_order_relaxed);
+			if (free_count(tail, 1) == 0)
+			{
+				return false;
+			}
+
+			new(m_slots + (tail & mask())) T(std::forward<Args>(args)...);
+			m_tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * Copies or moves the element at the back of the queue. Returns false if the queue is full
+		 *
+		 * Producer only
+		 */
+		bool try_push(T const& e) { return try_emplace(e); }
+		bool try_push(T && e) { return try_emplace(std::move(e)); }
+
+		/**
+		 * Copies up to 'n' elements starting at 'src' to the back of the queue, and returns the number of elements copied.
+		 * Trivially copyable elements are copied with at most two memcpy. If a copy throws, the queue is unchanged.
+		 *
+		 * Producer only
+		 * Requires: T is CopyConstructible
+		 */
+		size_t try_push_n(T const* src, size_t n);
+
+		/**
+		 * Removes the first element of the queue and gives its value to 'out' (see 'relocate_assign'). Returns false if the queue is empty.
+		 * If the assignment throws, the queue is unchanged.
+		 *
+		 * Consumer only
+		 */
+		bool try_pop(T& out);
+
+		/**
+		 * Relocates up to 'n' elements from the front of the queue to the uninitialized storage starting at 'dst', and returns the number of elements relocated.
+		 * Trivially relocatable elements are copied with at most two memcpy.
+		 * The caller owns the relocated objects, and is responsible for destroying them.
+		 *
+		 * Consumer only
+		 * Requires: T is nothrow relocatable
+		 */
+		size_t try_pop_n(T* dst, size_t n);
+	};
+}
+
+/**
+ * Macro to declare a specialization of the 'spsc_queue' template
+ *
+ * By having a matching KAB_CONTAINER_SPSC_QUEUE_IMPL in a compiled object, other
+ * translation units are free to use only this declaration without having to import the entire template
+ *
+ * The template signature of 'spsc_queue' is not guaranteed, so use this macro rather than making your own declarations
+ */
+#define KAB_CONTAINER_SPSC_QUEUE_DECL(ElementType, ResourceType) \
+	namespace kab { \
+		extern template class spsc_queue<ElementType, ResourceType>; \
+	}
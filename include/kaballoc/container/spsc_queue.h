@@ -0,0 +1,17 @@
+#pragma once
+
+#include "kaballoc/container/spsc_queue.decl.h"
+#include "kaballoc/container/detail/spsc_queue.inl.h"
+
+/**
+ * Macro to define a specialization of the 'spsc_queue' template
+ *
+ * By having this KAB_CONTAINER_SPSC_QUEUE_IMPL in a compiled object, other
+ * translation units are free to use only the declaration header, not having to import the entire template
+ *
+ * The template signature of 'spsc_queue' is not guaranteed, so use this macro rather than making your own declarations
+ */
+#define KAB_CONTAINER_SPSC_QUEUE_IMPL(ElementType, ResourceType) \
+	namespace kab { \
+		template class spsc_queue<ElementType, ResourceType>; \
+	}
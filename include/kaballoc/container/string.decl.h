@@ -0,0 +1,290 @@
+#pragma once
+
+#include "kaballoc/trait/relocatable.h"
+#include "kaballoc/memory/byte_span.h"
+
+#include <compare>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace kab
+{
+	/**
+	 * 'string' is a dynamically-resizing, null-terminated string of char, with inline storage for small strings
+	 *
+	 * Strings of up to 'inline_capacity' characters are stored in the object itself, longer strings are stored in memory from the MemoryResource.
+	 * The inline characters overlap the heap pointer, size and capacity. The last byte tells which representation is used:
+	 * for an inline string, it is the number of unused inline characters, so it doubles as the null terminator of a full inline string.
+	 *
+	 * There is no pointer from the object to itself: 'data' computes the address of the inline characters on each call.
+	 * This is what makes string trivially relocatable by design, unlike the SSO implementation of std::string in libstdc++.
+	 *
+	 * The MemoryResource needs to match the kab::memory_resource concept.
+	 * If the MemoryResource is an over-allocator, the string uses the over-allocated bytes as capacity.
+	 * When appending beyond the capacity, the capacity at least doubles.
+	 *
+	 * string is never copyable, is noexcept moveable if the resource is moveable, and is trivially relocatable if the resource is relocatable or empty
+	 *
+	 * As a general rule, functions that have preconditions or functions that can allocate are not marked noexcept, but everything else should be
+	 */
+	template<typename MemoryResource>
+	class string : MemoryResource
+	{
+		[[nodiscard]] MemoryResource& access_resource() & noexcept { return static_cast<MemoryResource&>(*this); }
+		[[nodiscard]] MemoryResource const& access_resource() const& noexcept { return static_cast<MemoryResource const&>(*this); }
+		[[nodiscard]] MemoryResource&& access_resource() && noexcept { return static_cast<MemoryResource&&>(*this); }
+
+		struct heap_rep
+		{
+			char* data;
+			size_t size;
+			size_t byte_capacity; // encoded with 'heap_marker' in its last byte
+		};
+
+		union rep
+		{
+			heap_rep heap;
+			char inline_data[sizeof(heap_rep)];
+		};
+
+	public:
+		/**
+		 * Maximum size of a string stored in the object itself
+		 */
+		static constexpr size_t inline_capacity = sizeof(heap_rep) - 1;
+
+	private:
+		static constexpr unsigned char heap_marker = 0xFF;
+
+		// An empty inline string: every inline character is unused
+		[[nodiscard]] static constexpr rep empty_rep() noexcept
+		{
+			rep r{ .inline_data = {} };
+			r.inline_data[inline_capacity] = static_cast<char>(inline_capacity);
+			return r;
+		}
+
+		rep m_rep = empty_rep();
+
+		[[nodiscard]] unsigned char last_byte() const noexcept { return static_cast<unsigned char>(m_rep.inline_data[inline_capacity]); }
+		[[nodiscard]] bool is_inline() const noexcept { return last_byte() != heap_marker; }
+
+		// The byte capacity is stored so that its last byte in memory is 'heap_marker', whatever the endianness
+		[[nodiscard]] static size_t encode_byte_capacity(size_t byte_capacity) noexcept;
+		[[nodiscard]] size_t heap_byte_capacity() const noexcept;
+
+		void set_heap(byte_span block, size_t size) noexcept;
+		void set_size(size_t n) noexcept;
+		void free_storage() noexcept;
+
+		// Returns the capacity to allocate to hold 'n' characters, at least doubling the current capacity
+		[[nodiscard]] size_t grown_capacity(size_t n) const noexcept;
+		[[nodiscard]] byte_span allocate_storage(size_t capacity);
+		// Moves the first 'keep' characters to a new storage of the given capacity
+		void reallocate(size_t new_capacity, size_t keep);
+	public:
+		/**
+		 * string is default constructible if the memory resource is default constructible
+		 */
+		string() = default;
+		/**
+		 * string is never copy constructible
+		 */
+		string(string const&) = delete;
+		/**
+		 * string is noexcept move constructible if the memory resource is moveable
+		 */
+		string(string && rhs) noexcept;
+		/**
+		 * string is never copy assignable
+		 */
+		string& operator=(string const& rhs) = delete;
+		/**
+		 * string is move assignable if the memory resource is moveable
+		 */
+		string& operator=(string && rhs) noexcept;
+
+		/**
+		 * Frees the storage, and destroys the memory resource
+		 */
+		~string();
+
+		/**
+		 * string is swappable if the memory resource is swappable
+		 */
+		void swap(string& rhs) noexcept;
+
+		using value_type = char;
+		using memory_resource = MemoryResource;
+		using iterator = char*;
+		using const_iterator = char const*;
+		using sentinel = iterator;
+		using const_sentinel = const_iterator;
+
+		/**
+		 * If the memory resource is moveable, this constructor lets the user provide a resource value
+		 */
+		explicit string(memory_resource r) noexcept
+			: MemoryResource(std::move(r))
+		{
+
+		}
+
+		/**
+		 * Constructs a string with a copy of the characters of 's', using the provided resource value
+		 */
+		string(std::string_view s, memory_resource r)
+			: string(std::move(r))
+		{
+			append(s);
+		}
+
+		/**
+		 * Returns the memory resource value used in this container
+		 */
+		[[nodiscard]] memory_resource get_resource() const noexcept { return access_resource(); }
+
+		/**
+		 * Returns a pointer to the characters of the string, followed by a null character
+		 */
+		[[nodiscard]] char* data() noexcept { return is_inline() ? m_rep.inline_data : m_rep.heap.data; }
+		[[nodiscard]] char const* data() const noexcept { return is_inline() ? m_rep.inline_data : m_rep.heap.data; }
+		[[nodiscard]] char const* c_str() const noexcept { return data(); }
+
+		/**
+		 * Returns a view of the characters of the string
+		 */
+		[[nodiscard]] std::string_view view() const noexcept { return { data(), size() }; }
+		[[nodiscard]] operator std::string_view() const noexcept { return view(); }
+
+		/**
+		 * Returns whether the string has no characters
+		 */
+		[[nodiscard]] bool is_empty() const noexcept { return size() == 0; }
+
+		/**
+		 * Returns the number of characters in the string, not counting the null terminator
+		 */
+		[[nodiscard]] size_t size() const noexcept { return is_inline() ? inline_capacity - last_byte() : m_rep.heap.size; }
+
+		/**
+		 * Returns the number of characters the string can hold without allocating, not counting the null terminator
+		 */
+		[[nodiscard]] size_t capacity() const noexcept { return is_inline() ? inline_capacity : heap_byte_capacity() - 1; }
+
+		/**
+		 * Returns whether the characters are stored in the object itself
+		 */
+		[[nodiscard]] bool is_small() const noexcept { return is_inline(); }
+
+		/**
+		 * 'begin' and 'end' return iterators to the characters of the string
+		 */
+		[[nodiscard]] iterator begin() noexcept { return data(); }
+		[[nodiscard]] sentinel end() noexcept { return data() + size(); }
+		[[nodiscard]] const_iterator begin() const noexcept { return data(); }
+		[[nodiscard]] const_sentinel end() const noexcept { return data() + size(); }
+
+		/**
+		 * Returns a reference to the first or the last character of the string
+		 *
+		 * Precondition: The size must be at least 1
+		 */
+		[[nodiscard]] char & front() { return *data(); }
+		[[nodiscard]] char const& front() const { return *data(); }
+		[[nodiscard]] char & back() { return data()[size() - 1]; }
+		[[nodiscard]] char const& back() const { return data()[size() - 1]; }
+
+		/**
+		 * Operator[]. Accesses characters using a zero-based index
+		 *
+		 * Precondition: 'i' must be smaller than or equal to the size
+		 */
+		[[nodiscard]] char & operator[](size_t i) { return data()[i]; }
+		[[nodiscard]] char const& operator[](size_t i) const { return data()[i]; }
+
+		/**
+		 * Replaces the characters of the string with the ones of 's', which may be part of the string
+		 */
+		string& assign(std::string_view s);
+
+		/**
+		 * Appends the characters of 's', which may be part of the string
+		 */
+		string& append(std::string_view s);
+
+		/**
+		 * Appends 'n' copies of 'c'
+		 */
+		string& append(size_t n, char c);
+
+		string& operator+=(std::string_view s) { return append(s); }
+		string& operator+=(char c) { push_back(c); return *this; }
+
+		/**
+		 * Appends a character
+		 */
+		void push_back(char c);
+
+		/**
+		 * Removes the last character
+		 *
+		 * Precondition: The size of the string must be at least 1
+		 */
+		void pop_back();
+
+		/**
+		 * Ensures the string can hold 'n' characters without allocating
+		 */
+		void reserve(size_t n);
+
+		/**
+		 * Changes the size of the string. New characters are copies of 'c'
+		 */
+		void resize(size_t n, char c = '\0');
+
+		/**
+		 * Removes all characters, making its size 0
+		 * Does not free the storage.
+		 */
+		void clear() noexcept;
+
+		/**
+		 * Removes all characters, making its size 0, then frees the storage.
+		 */
+		void clear_and_shrink() noexcept;
+
+		/**
+		 * Potentially reallocate to reduce the capacity of the string to match the size as much as possible.
+		 * If the characters fit in the object, the storage is freed
+		 */
+		void shrink_to_fit();
+
+		/**
+		 * Compares the characters of two strings
+		 */
+		[[nodiscard]] friend bool operator==(string const& lhs, std::string_view rhs) noexcept { return lhs.view() == rhs; }
+		[[nodiscard]] friend std::strong_ordering operator<=>(string const& lhs, std::string_view rhs) noexcept { return lhs.view() <=> rhs; }
+	};
+
+	template<typename MemoryResource>
+	struct is_trivially_relocatable<string<MemoryResource>>
+		: std::conditional_t<std::is_empty_v<MemoryResource> || is_trivially_relocatable_v<MemoryResource>, std::true_type, std::false_type>
+	{
+
+	};
+}
+
+/**
+ * Macro to declare a specialization of the 'string' template
+ *
+ * By having a matching KAB_CONTAINER_STRING_IMPL in a compiled object, other
+ * translation units are free to use only this declaration without having to import the entire template
+ *
+ * The template signature of 'string' is not guaranteed, so use this macro rather than making your own declarations
+ */
+#define KAB_CONTAINER_STRING_DECL(ResourceType) \
+	namespace kab { \
+		extern template class string<ResourceType>; \
+	}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "kaballoc/container/string.decl.h"
+#include "kaballoc/container/detail/string.inl.h"
+
+/**
+ * Macro to define a specialization of the 'string' template
+ *
+ * By having this KAB_CONTAINER_STRING_IMPL in a compiled object, other
+ * translation units are free to use only the declaration header, not having to import the entire template
+ *
+ * The template signature of 'string' is not guaranteed, so use this macro rather than making your own declarations
+ */
+#define KAB_CONTAINER_STRING_IMPL(ResourceType) \
+	namespace kab { \
+		template class string<ResourceType>; \
+	}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "kaballoc/memory/byte_span.h"
+
+#include <compare>
+#include <string_view>
+#include <utility>
+
+namespace kab
+{
+	/**
+	 * string_value is a shared immutable string of char
+	 *
+	 * Like array_value, the characters are allocated once, with a reference count, from the memory resource.
+	 * On copy, the memory resource is propagated, and the characters are shared between the source and destination containers.
+	 * Copying from a string_value object requires no external synchronization with other 'const' operations on the string_value.
+	 * However, mutating a string_value object by changing its value does require external synchronization with other operations on the same object
+	 *
+	 * 'substr' returns a string_value sharing the same characters, so the tokens parsed from a string can be kept without copying them.
+	 * Because of this, the characters of a string_value are not necessarily followed by a null character
+	 */
+	template<typename ResourceT>
+	class string_value : ResourceT
+	{
+		[[nodiscard]] ResourceT& access_resource() & noexcept { return static_cast<ResourceT&>(*this); }
+		[[nodiscard]] ResourceT const& access_resource() const& noexcept { return static_cast<ResourceT const&>(*this); }
+		[[nodiscard]] ResourceT&& access_resource() && noexcept { return static_cast<ResourceT&&>(*this); }
+
+		struct control
+		{
+			size_t count;
+			size_t size; // number of characters
+			char fam[1]; // actually a FAM
+		};
+
+		// allocates the control, with extra space for 'size' characters contiguously after 'fam'
+		// the control starts with a count of 1
+		static control* new_control(ResourceT& r, size_t size);
+		// increase the count of the control
+		static control* acquire_control(control* c) noexcept;
+		// decrease the count of the control, and deletes it if last
+		static void release_control(ResourceT& r, control* c);
+
+		control* m_control = nullptr;
+		char const* m_data = nullptr;
+		size_t m_size = 0;
+
+	public:
+		string_value() = default;
+		explicit string_value(ResourceT r) noexcept;
+		string_value(std::string_view s, ResourceT r);
+		string_value(string_value const& rhs) noexcept;
+		string_value(string_value && rhs) noexcept;
+		string_value& operator=(string_value const& rhs) noexcept;
+		string_value& operator=(string_value && rhs) noexcept;
+		~string_value();
+		void swap(string_value& rhs) noexcept;
+
+		using value_type = char const;
+		using memory_resource = ResourceT;
+		using iterator = char const*;
+		using const_iterator = char const*;
+
+		/**
+		 * Get a copy of the resource's value
+		 */
+		[[nodiscard]] memory_resource get_resource() const noexcept { return access_resource(); }
+
+		/**
+		 * Assigns a copy of the characters of 's' to the container
+		 */
+		string_value& assign(std::string_view s);
+
+		/**
+		 * Returns a string_value sharing the characters [pos, pos + n) of this one, or up to the end if there are fewer characters
+		 *
+		 * Precondition: 'pos' must be smaller than or equal to the size
+		 */
+		[[nodiscard]] string_value substr(size_t pos, size_t n = std::string_view::npos) const noexcept;
+
+		[[nodiscard]] const_iterator begin() const noexcept { return m_data; }
+		[[nodiscard]] const_iterator end() const noexcept { return m_data + m_size; }
+		[[nodiscard]] char const* data() const noexcept { return m_data; }
+		[[nodiscard]] size_t size() const noexcept { return m_size; }
+		[[nodiscard]] bool is_empty() const noexcept { return m_size == 0; }
+		[[nodiscard]] char const& front() const { return *m_data; }
+		[[nodiscard]] char const& back() const { return m_data[m_size - 1]; }
+		[[nodiscard]] char const& operator[](size_t i) const { return m_data[i]; }
+		[[nodiscard]] std::string_view view() const noexcept { return { m_data, m_size }; }
+		[[nodiscard]] operator std::string_view() const noexcept { return view(); }
+
+		[[nodiscard]] friend bool operator==(string_value const& lhs, std::string_view rhs) noexcept { return lhs.view() == rhs; }
+		[[nodiscard]] friend std::strong_ordering operator<=>(string_value const& lhs, std::string_view rhs) noexcept { return lhs.view() <=> rhs; }
+	};
+}
+
+/**
+ * Macro to declare a specialization of the 'string_value' template
+ *
+ * By having a matching KAB_CONTAINER_STRING_VALUE_IMPL in a compiled object, other
+ * translation units are free to use only this declaration without having to import the entire template
+ *
+ * The template signature of 'string_value' is not guaranteed, so use this macro rather than making your own declarations
+ */
+#define KAB_CONTAINER_STRING_VALUE_DECL(ResourceType) \
+	namespace kab { \
+		extern template class string_value<ResourceType>; \
+	}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "kaballoc/container/string_value.decl.h"
+#include "kaballoc/container/detail/string_value.inl.h"
+
+/**
+ * Macro to define a specialization of the 'string_value' template
+ *
+ * By having this KAB_CONTAINER_STRING_VALUE_IMPL in a compiled object, other
+ * translation units are free to use only the declaration header, not having to import the entire template
+ *
+ * The template signature of 'string_value' is not guaranteed, so use this macro rather than making your own declarations
+ */
+#define KAB_CONTAINER_STRING_VALUE_IMPL(ResourceType) \
+	namespace kab { \
+		template class string_value<ResourceType>; \
+	}
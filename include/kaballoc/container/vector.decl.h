@@ -6,6 +6,9 @@
 #include "kaballoc/range/detail/begin.h"
 #include "kaballoc/range/detail/end.h"
 
+#include <new>
+#include <utility>
+
 namespace kab
 {
 	/**
@@ -20,7 +23,8 @@ namespace kab
 	 *
 	 * Functions that add elements to the container, also called construction functions, can cause a reallocation
 	 * if the size cannot grow beyond the current capacity.
-	 * On any function that can reallocate, vector requires its element type to be trivially relocatable.
+	 * On reallocation, the elements are relocated to the new storage (see 'uninitialized_relocate'): trivially relocatable types are copied with memcpy,
+	 * and other types are moved, or copied if their move constructor can throw. In the latter case, a throwing reallocation leaves the vector unchanged.
 	 * Some of these functions may additionally require moveability or copyability
 	 *
 	 * As a general rule, functions that have preconditions or functions that can allocate are not marked noexcept, but everything else should be
@@ -246,6 +250,14 @@ namespace kab
 		 */
 		void pop_back();
 
+		/**
+		 * Removes the element at index 'i' in constant time, by relocating the last element into its place. The order of the elements is not kept.
+		 * If T can throw on relocation, the last element is move assigned instead, and the vector is unchanged if the assignment throws
+		 *
+		 * Precondition: 'i' must be smaller than the size
+		 */
+		void swap_remove(size_t i);
+
 		/**
 		 * Inserts an entire Range at the back of the vector
 		 *
@@ -273,6 +285,14 @@ namespace kab
 		 */
 		void resize(size_t n);
 
+		/**
+		 * Changes the size of the vector, ensuring proper capacity and constructing or destroying elements as necessary
+		 * New elements are copies of 'value', which may be an element of the vector
+		 *
+		 * Requires: T is CopyConstructible
+		 */
+		void resize(size_t n, T const& value);
+
 		/**
 		 * Removes all elements from the vector, making its size 0
 		 * Does not free the storage.
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "kaballoc/core/size_t.h"
+
+#if !defined(KAB_CACHE_LINE_SIZE)
+#  define KAB_CACHE_LINE_SIZE 64
+#endif
+
+namespace kab
+{
+	/**
+	 * Size of a cache line. Data written by different threads is aligned on this size, so that the threads don't invalidate each other's cache line (false sharing)
+	 *
+	 * Define KAB_CACHE_LINE_SIZE to override it, for example to 128 on targets which prefetch cache lines in pairs
+	 */
+	inline constexpr size_t cache_line_size = KAB_CACHE_LINE_SIZE;
+}
@@ -19,3 +19,9 @@
 #if !defined(KAB_COMPILER_GCC)
 #  define KAB_COMPILER_GCC 0
 #endif
+
+#if KAB_COMPILER_MSVC
+#  define KAB_NOINLINE __declspec(noinline)
+#else
+#  define KAB_NOINLINE __attribute__((noinline))
+#endif
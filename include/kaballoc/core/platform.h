@@ -0,0 +1,15 @@
+#pragma once
+
+#if defined(_WIN32)
+#  define KAB_PLATFORM_WINDOWS 1
+#elif defined(__linux__)
+#  define KAB_PLATFORM_LINUX 1
+#endif
+
+#if !defined(KAB_PLATFORM_WINDOWS)
+#  define KAB_PLATFORM_WINDOWS 0
+#endif
+
+#if !defined(KAB_PLATFORM_LINUX)
+#  define KAB_PLATFORM_LINUX 0
+#endif
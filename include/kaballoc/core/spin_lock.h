@@ -0,0 +1,70 @@
+#pragma once
+
+#include "kaballoc/core/compiler.h"
+
+#include <atomic>
+#include <thread>
+
+#if KAB_COMPILER_MSVC
+#  include <intrin.h>
+#  define KAB_SPIN_PAUSE() _mm_pause()
+#elif (KAB_COMPILER_GCC | KAB_COMPILER_CLANG) && (defined(__x86_64__) || defined(__i386__))
+#  define KAB_SPIN_PAUSE() __builtin_ia32_pause()
+#elif (KAB_COMPILER_GCC | KAB_COMPILER_CLANG) && defined(__aarch64__)
+#  define KAB_SPIN_PAUSE() __asm__ __volatile__("yield")
+#else
+#  define KAB_SPIN_PAUSE() ((void)0)
+#endif
+
+namespace kab
+{
+	/**
+	 * 'spin_lock' is an adaptive lock for short critical sections, such as a call to a memory resource
+	 *
+	 * A waiting thread spins on a plain load (so the cache line stays shared until the lock is released), with a pause instruction between tries,
+	 * and yields its time slice once it has spun 'spin_count' times, so a preempted owner can make progress.
+	 *
+	 * spin_lock matches the Lockable requirements (std::lock_guard, std::unique_lock). It's not recursive, and isn't fair.
+	 */
+	class spin_lock
+	{
+		std::atomic<bool> m_locked = false;
+
+	public:
+		static constexpr unsigned spin_count = 64;
+
+		spin_lock() = default;
+		spin_lock(spin_lock const&) = delete;
+		spin_lock& operator=(spin_lock const&) = delete;
+
+		void lock() noexcept
+		{
+			unsigned spins = 0;
+			while (m_locked.exchange(true, std::memory_order_acquire))
+			{
+				while (m_locked.load(std::memory_order_relaxed))
+				{
+					if (spins < spin_count)
+					{
+						++spins;
+						KAB_SPIN_PAUSE();
+					}
+					else
+					{
+						std::this_thread::yield();
+					}
+				}
+			}
+		}
+
+		[[nodiscard]] bool try_lock() noexcept
+		{
+			return !m_locked.load(std::memory_order_relaxed) && !m_locked.exchange(true, std::memory_order_acquire);
+		}
+
+		void unlock() noexcept
+		{
+			m_locked.store(false, std::memory_order_release);
+		}
+	};
+}
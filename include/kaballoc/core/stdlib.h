@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef> // pulls in the configuration header of the standard library
+
+#if defined(_LIBCPP_VERSION)
+#  define KAB_STDLIB_LIBCXX 1
+#elif defined(__GLIBCXX__)
+#  define KAB_STDLIB_LIBSTDCXX 1
+#elif defined(_MSVC_STL_VERSION) || defined(_CPPLIB_VER)
+#  define KAB_STDLIB_MSVC 1
+#endif
+
+#if !defined(KAB_STDLIB_LIBCXX)
+#  define KAB_STDLIB_LIBCXX 0
+#endif
+
+#if !defined(KAB_STDLIB_LIBSTDCXX)
+#  define KAB_STDLIB_LIBSTDCXX 0
+#endif
+
+#if !defined(KAB_STDLIB_MSVC)
+#  define KAB_STDLIB_MSVC 0
+#endif
+
+// Debug modes of the standard libraries make containers register themselves in some iterator-tracking structure,
+// which then points back to the container object. None of those containers are trivially relocatable
+#if KAB_STDLIB_MSVC && defined(_ITERATOR_DEBUG_LEVEL) && _ITERATOR_DEBUG_LEVEL != 0
+#  define KAB_STDLIB_DEBUG_CONTAINERS 1
+#elif KAB_STDLIB_LIBSTDCXX && defined(_GLIBCXX_DEBUG)
+#  define KAB_STDLIB_DEBUG_CONTAINERS 1
+#elif KAB_STDLIB_LIBCXX && (defined(_LIBCPP_ENABLE_DEBUG_MODE) || (defined(_LIBCPP_DEBUG) && _LIBCPP_DEBUG >= 1))
+#  define KAB_STDLIB_DEBUG_CONTAINERS 1
+#else
+#  define KAB_STDLIB_DEBUG_CONTAINERS 0
+#endif
@@ -0,0 +1,251 @@
+#pragma once
+
+#include "kaballoc/memory/resource.h"
+#include "kaballoc/memory/byte_span.h"
+#include "kaballoc/memory/detail/owns.h"
+#include "kaballoc/memory/detail/trim.h"
+
+#include <atomic>
+#include <new>
+#include <utility>
+
+namespace kab
+{
+	class memory_budget;
+
+	/**
+	 * Called when a charge would exceed the hard limit of a budget, with the budget and the requested number of bytes.
+	 * Returning true retries the charge (for example after spilling to disk), returning false fails it
+	 */
+	using budget_exceeded_handler = bool (*)(memory_budget& budget, size_t requested, void* context);
+
+	/**
+	 * Called when the usage of a budget goes above its soft limit, with the budget and the requested number of bytes
+	 */
+	using budget_soft_limit_handler = void (*)(memory_budget& budget, size_t requested, void* context);
+
+	/**
+	 * 'memory_budget' counts the bytes charged to a subsystem, and enforces a hard limit
+	 *
+	 * Budgets form a hierarchy: a charge to a budget is also charged to its parent, and so on up to the root,
+	 * so a child never uses more than any of its ancestors allows (for example a query within a tenant within a process).
+	 * A charge either succeeds at every level or has no effect: the peak and the soft limit are only updated once every ancestor accepted it.
+	 *
+	 * The usage is updated with a compare-and-swap loop, so a budget is never over its hard limit, even with concurrent charges.
+	 * The soft limit only calls a handler when the usage crosses it, which lets a subsystem react (shrink caches, spill) before failing.
+	 * 'peak' reports the high-water mark of the usage.
+	 *
+	 * Charges and releases are thread-safe. Limits and handlers must be set before the budget is shared between threads.
+	 * A budget must outlive its children and the resources using it, so it is neither copyable nor moveable.
+	 */
+	class memory_budget
+	{
+		std::atomic<size_t> m_used = 0;
+		std::atomic<size_t> m_peak = 0;
+		size_t m_hard_limit;
+		size_t m_soft_limit;
+		memory_budget* m_parent;
+
+		budget_exceeded_handler m_on_exceeded = nullptr;
+		void* m_exceeded_context = nullptr;
+		budget_soft_limit_handler m_on_soft_limit = nullptr;
+		void* m_soft_limit_context = nullptr;
+
+		// Charges this budget only, and stores the usage before the charge in 'previous'. Returns false if it would go over the hard limit
+		[[nodiscard]] bool try_charge_local(size_t n, size_t& previous) noexcept
+		{
+			size_t used = m_used.load(std::memory_order_relaxed);
+			do
+			{
+				// The limit may have been lowered below the usage
+				if (used > m_hard_limit || n > m_hard_limit - used)
+				{
+					return false;
+				}
+			} while (!m_used.compare_exchange_weak(used, used + n, std::memory_order_relaxed));
+			previous = used;
+			return true;
+		}
+
+		// Called once every ancestor accepted the charge
+		void on_charged(size_t previous, size_t n)
+		{
+			size_t const new_used = previous + n;
+			size_t peak = m_peak.load(std::memory_order_relaxed);
+			while (new_used > peak && !m_peak.compare_exchange_weak(peak, new_used, std::memory_order_relaxed))
+			{
+
+			}
+
+			if (m_on_soft_limit != nullptr && previous <= m_soft_limit && new_used > m_soft_limit)
+			{
+				m_on_soft_limit(*this, n, m_soft_limit_context);
+			}
+		}
+
+	public:
+		/**
+		 * Creates a budget with a hard limit, an optional soft limit, and an optional parent
+		 */
+		explicit memory_budget(size_t hard_limit, size_t soft_limit = size_t_max_v, memory_budget* parent = nullptr) noexcept
+			: m_hard_limit(hard_limit)
+			, m_soft_limit(soft_limit)
+			, m_parent(parent)
+		{
+
+		}
+		memory_budget(memory_budget const&) = delete;
+		memory_budget& operator=(memory_budget const&) = delete;
+
+		/**
+		 * Charges 'n' bytes to this budget and its ancestors.
+		 * If a budget would go over its hard limit, its handler is called, and the charge is retried as long as the handler returns true.
+		 * Returns false if the charge failed, in which case no budget is charged
+		 */
+		[[nodiscard]] bool try_charge(size_t n)
+		{
+			size_t previous;
+			while (!try_charge_local(n, previous))
+			{
+				if (m_on_exceeded == nullptr || !m_on_exceeded(*this, n, m_exceeded_context))
+				{
+					return false;
+				}
+			}
+			if (m_parent != nullptr && !m_parent->try_charge(n))
+			{
+				m_used.fetch_sub(n, std::memory_order_relaxed);
+				return false;
+			}
+			on_charged(previous, n);
+			return true;
+		}
+
+		/**
+		 * Releases 'n' bytes charged to this budget and its ancestors
+		 */
+		void release(size_t n) noexcept
+		{
+			for (memory_budget* budget = this; budget != nullptr; budget = budget->m_parent)
+			{
+				budget->m_used.fetch_sub(n, std::memory_order_relaxed);
+			}
+		}
+
+		/**
+		 * Returns the number of bytes currently charged
+		 */
+		[[nodiscard]] size_t used() const noexcept { return m_used.load(std::memory_order_relaxed); }
+
+		/**
+		 * Returns the highest number of bytes charged at once, since the creation or the last 'reset_peak'
+		 */
+		[[nodiscard]] size_t peak() const noexcept { return m_peak.load(std::memory_order_relaxed); }
+
+		/**
+		 * Sets the high-water mark to the current usage
+		 */
+		void reset_peak() noexcept { m_peak.store(used(), std::memory_order_relaxed); }
+
+		[[nodiscard]] size_t hard_limit() const noexcept { return m_hard_limit; }
+		[[nodiscard]] size_t soft_limit() const noexcept { return m_soft_limit; }
+		[[nodiscard]] memory_budget* parent() const noexcept { return m_parent; }
+
+		/**
+		 * Changes the limits. A limit lower than the current usage makes the following charges fail, without affecting the existing ones
+		 */
+		void set_limits(size_t hard_limit, size_t soft_limit = size_t_max_v) noexcept
+		{
+			m_hard_limit = hard_limit;
+			m_soft_limit = soft_limit;
+		}
+
+		void set_exceeded_handler(budget_exceeded_handler handler, void* context = nullptr) noexcept
+		{
+			m_on_exceeded = handler;
+			m_exceeded_context = context;
+		}
+
+		void set_soft_limit_handler(budget_soft_limit_handler handler, void* context = nullptr) noexcept
+		{
+			m_on_soft_limit = handler;
+			m_soft_limit_context = context;
+		}
+	};
+
+	/**
+	 * 'budget_resource' is a memory resource which charges the allocations of an inner resource to a 'memory_budget'
+	 *
+	 * An allocation first charges its size to the budget, and throws std::bad_alloc if the budget refuses it (see 'memory_budget::try_charge'),
+	 * without calling the inner resource. Deallocations release their size. Accounting is done on requested sizes, so over-allocation isn't supported.
+	 * If the inner resource reports exhaustion (see memory/resource.h), the charge is released and the null span is returned.
+	 *
+	 * The budget is referenced, not owned: like a 'resource_reference', budget_resource is copyable if the inner resource is,
+	 * and copies charge the same budget. It forwards 'owns' and 'trim' when the inner resource supports them.
+	 */
+	template<typename InnerResource>
+	class budget_resource : InnerResource
+	{
+		[[nodiscard]] InnerResource& access_inner() & noexcept { return static_cast<InnerResource&>(*this); }
+		[[nodiscard]] InnerResource const& access_inner() const& noexcept { return static_cast<InnerResource const&>(*this); }
+
+		memory_budget* m_budget = nullptr;
+
+	public:
+		budget_resource(InnerResource r, memory_budget& budget)
+			: InnerResource(std::move(r))
+			, m_budget(&budget)
+		{
+
+		}
+
+		[[nodiscard]] byte_span allocate(size_t size, align_t alignment)
+		{
+			if (!m_budget->try_charge(size))
+			{
+				throw std::bad_alloc();
+			}
+			byte_span s;
+			try
+			{
+				s = access_inner().allocate(size, alignment);
+			}
+			catch (...)
+			{
+				m_budget->release(size);
+				throw;
+			}
+			if (s.data == nullptr)
+			{
+				m_budget->release(size);
+			}
+			return s;
+		}
+
+		void deallocate(byte_span s, align_t alignment)
+		{
+			access_inner().deallocate(s, alignment);
+			m_budget->release(s.size);
+		}
+
+		[[nodiscard]] bool owns(byte_span s) const noexcept requires detail::has_owns_v<InnerResource>
+		{
+			return access_inner().owns(s);
+		}
+
+		size_t trim(size_t keep_bytes) requires detail::has_trim_v<InnerResource>
+		{
+			return access_inner().trim(keep_bytes);
+		}
+
+		/**
+		 * Returns the budget charged by this resource
+		 */
+		[[nodiscard]] memory_budget& budget() const noexcept { return *m_budget; }
+
+		[[nodiscard]] constexpr bool operator==(budget_resource const& rhs) const noexcept
+		{
+			return m_budget == rhs.m_budget && access_inner() == rhs.access_inner();
+		}
+	};
+}
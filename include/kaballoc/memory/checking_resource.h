@@ -0,0 +1,246 @@
+#pragma once
+
+#include "kaballoc/memory/resource.h"
+#include "kaballoc/memory/byte_span.h"
+#include "kaballoc/memory/new_resource.h"
+#include "kaballoc/memory/detail/over_allocate.h"
+#include "kaballoc/memory/detail/owns.h"
+#include "kaballoc/container/flat_hash_map.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <utility>
+
+namespace kab
+{
+	/**
+	 * Errors detected by a 'checking_resource'
+	 *
+	 * unknown_pointer: the deallocated pointer is not a live allocation of the resource (double free, or allocated by another resource)
+	 * duplicate_allocation: the inner resource returned a pointer which is still live
+	 * size_mismatch: the size of the deallocated span is not the size of the allocated span
+	 * alignment_mismatch: the deallocation alignment is not the allocation alignment
+	 * leak: the allocation is still live when the resource is destroyed
+	 */
+	enum class checking_error : unsigned char
+	{
+		unknown_pointer,
+		duplicate_allocation,
+		size_mismatch,
+		alignment_mismatch,
+		leak,
+	};
+
+	/**
+	 * Description of an error passed to the handler of a 'checking_resource'
+	 *
+	 * 'span' and 'alignment' are the arguments of the faulty deallocation (for a leak, the live allocation, for a duplicate, the new allocation).
+	 * 'expected_size' and 'expected_alignment' are the values of the live allocation, or 0 for an unknown pointer
+	 */
+	struct checking_report
+	{
+		checking_error error;
+		byte_span span;
+		align_t alignment;
+		size_t expected_size;
+		size_t expected_alignment;
+	};
+
+	using checking_handler = void (*)(checking_report const& report);
+
+	namespace detail
+	{
+		struct checked_allocation
+		{
+			size_t size;
+			align_t alignment;
+		};
+
+		inline char const* checking_error_name(checking_error error) noexcept
+		{
+			switch (error)
+			{
+			case checking_error::unknown_pointer: return "deallocation of an unknown pointer (double free?)";
+			case checking_error::duplicate_allocation: return "allocation of a live pointer";
+			case checking_error::size_mismatch: return "deallocation size mismatch";
+			case checking_error::alignment_mismatch: return "deallocation alignment mismatch";
+			case checking_error::leak: return "leak";
+			}
+			return "unknown error";
+		}
+
+		// Prints the error, and aborts unless it's a leak so every leak is reported
+		inline void default_checking_handler(checking_report const& report) noexcept
+		{
+			::fprintf(stderr, "kab::checking_resource: %s: [%p, +%zu) alignment %zu, expected size %zu alignment %zu\n",
+				checking_error_name(report.error), static_cast<void const*>(report.span.data), report.span.size, static_cast<size_t>(report.alignment),
+				report.expected_size, report.expected_alignment);
+			if (report.error != checking_error::leak)
+			{
+				::abort();
+			}
+		}
+	}
+
+	/**
+	 * 'checking_resource' is a memory resource which validates the deallocation protocol of an inner resource (see memory/resource.h):
+	 * every deallocated span must be a live allocation, with the size returned by the allocation function and the alignment it was asked for.
+	 *
+	 * Live allocations are recorded in a hash table allocated from the MetaResource. An allocation returning a live pointer is reported,
+	 * and replaces the previous one. On deallocation:
+	 *   - an unknown pointer (double free, or memory of another resource) is reported, and not forwarded to the inner resource
+	 *   - a size or alignment mismatch is reported, and the recorded span and alignment are forwarded instead of the wrong ones
+	 * When the resource is destroyed, each live allocation is reported as a leak, and is not deallocated.
+	 *
+	 * Errors are passed to the handler, which by default prints them to stderr and aborts, except for leaks which are only printed.
+	 *
+	 * Empty spans (see memory/resource.h) are neither recorded nor checked.
+	 * checking_resource forwards 'owns' when the inner resource supports it. It is move constructible but not assignable, and isn't thread-safe.
+	 */
+	template<typename InnerResource, typename MetaResource = new_resource>
+	class checking_resource : InnerResource
+	{
+		[[nodiscard]] InnerResource& access_inner() & noexcept { return static_cast<InnerResource&>(*this); }
+		[[nodiscard]] InnerResource const& access_inner() const& noexcept { return static_cast<InnerResource const&>(*this); }
+
+		flat_hash_map<byte*, detail::checked_allocation, MetaResource> m_live;
+		size_t m_live_bytes = 0;
+		checking_handler m_handler = &detail::default_checking_handler;
+
+		// 'deallocate' returns the allocation to the inner resource if it can't be recorded
+		template<typename Deallocate>
+		void record(byte_span s, align_t alignment, Deallocate&& deallocate)
+		{
+			if (s.size == 0)
+			{
+				return;
+			}
+			try
+			{
+				auto const [it, inserted] = m_live.try_emplace(s.data, detail::checked_allocation{ s.size, alignment });
+				if (!inserted)
+				{
+					m_handler(checking_report{ checking_error::duplicate_allocation, s, alignment, it->second.size, static_cast<size_t>(it->second.alignment) });
+					m_live_bytes -= it->second.size;
+					it->second = detail::checked_allocation{ s.size, alignment };
+				}
+			}
+			catch (...)
+			{
+				deallocate(s, alignment);
+				throw;
+			}
+			m_live_bytes += s.size;
+		}
+
+		// Returns false if the deallocation must not be forwarded, otherwise fixes 's' and 'alignment' to match the allocation
+		[[nodiscard]] bool check(byte_span& s, align_t& alignment)
+		{
+			auto const it = m_live.find(s.data);
+			if (it == m_live.end())
+			{
+				m_handler(checking_report{ checking_error::unknown_pointer, s, alignment, 0, 0 });
+				return false;
+			}
+
+			detail::checked_allocation const allocation = it->second;
+			if (s.size != allocation.size)
+			{
+				m_handler(checking_report{ checking_error::size_mismatch, s, alignment, allocation.size, static_cast<size_t>(allocation.alignment) });
+			}
+			else if (alignment != allocation.alignment)
+			{
+				m_handler(checking_report{ checking_error::alignment_mismatch, s, alignment, allocation.size, static_cast<size_t>(allocation.alignment) });
+			}
+
+			s.size = allocation.size;
+			alignment = allocation.alignment;
+			m_live_bytes -= allocation.size;
+			m_live.erase(s.data);
+			return true;
+		}
+
+	public:
+		checking_resource() = default;
+		explicit checking_resource(InnerResource r, MetaResource meta = MetaResource())
+			: InnerResource(std::move(r))
+			, m_live(std::move(meta))
+		{
+
+		}
+		checking_resource(checking_resource const&) = delete;
+		checking_resource& operator=(checking_resource const&) = delete;
+		checking_resource(checking_resource && rhs) noexcept
+			: InnerResource(static_cast<InnerResource&&>(rhs))
+			, m_live(std::move(rhs.m_live))
+			, m_live_bytes(std::exchange(rhs.m_live_bytes, 0))
+			, m_handler(rhs.m_handler)
+		{
+
+		}
+		checking_resource& operator=(checking_resource && rhs) = delete;
+
+		~checking_resource()
+		{
+			for (auto const& [data, allocation] : m_live)
+			{
+				m_handler(checking_report{ checking_error::leak, { data, allocation.size }, allocation.alignment, allocation.size, static_cast<size_t>(allocation.alignment) });
+			}
+		}
+
+		[[nodiscard]] byte_span allocate(size_t size, align_t alignment)
+		{
+			byte_span const s = access_inner().allocate(size, alignment);
+			record(s, alignment, [this](byte_span b, align_t a) { access_inner().deallocate(b, a); });
+			return s;
+		}
+
+		[[nodiscard]] byte_span over_allocate(size_t size, align_t alignment)
+		{
+			byte_span const s = detail::over_allocate(access_inner(), size, alignment);
+			record(s, alignment, [this](byte_span b, align_t a) { detail::over_deallocate(access_inner(), b, a); });
+			return s;
+		}
+
+		void deallocate(byte_span s, align_t alignment)
+		{
+			if (s.size == 0 || check(s, alignment))
+			{
+				access_inner().deallocate(s, alignment);
+			}
+		}
+
+		void over_deallocate(byte_span s, align_t alignment)
+		{
+			if (s.size == 0 || check(s, alignment))
+			{
+				detail::over_deallocate(access_inner(), s, alignment);
+			}
+		}
+
+		[[nodiscard]] bool owns(byte_span s) const noexcept requires detail::has_owns_v<InnerResource>
+		{
+			return access_inner().owns(s);
+		}
+
+		/**
+		 * Replaces the function called when an error is detected. If the handler returns, the resource recovers as described above
+		 */
+		void set_handler(checking_handler handler) noexcept { m_handler = handler; }
+
+		/**
+		 * Returns the number of live allocations
+		 */
+		[[nodiscard]] size_t live_allocations() const noexcept { return m_live.size(); }
+
+		/**
+		 * Returns the number of bytes of the live allocations
+		 */
+		[[nodiscard]] size_t live_bytes() const noexcept { return m_live_bytes; }
+
+		[[nodiscard]] bool operator==(checking_resource const& rhs) const noexcept
+		{
+			return this == &rhs;
+		}
+	};
+}
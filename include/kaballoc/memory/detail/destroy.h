@@ -2,27 +2,37 @@
 
 #include "kaballoc/core/size_t.h"
 
+#include <type_traits>
+
 namespace kab
 {
+	// The destroy functions compile to nothing for trivially destructible types
+
 	template<typename T>
 	void destroy_at(T* p)
 	{
-		p->~T();
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			p->~T();
+		}
 	}
 
 	template<typename T>
 	void destroy(T* it, T* sent)
 	{
-		for (; it != sent; ++it) {
-			kab::destroy_at(it);
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			for (; it != sent; ++it) {
+				kab::destroy_at(it);
+			}
 		}
 	}
 
 	template<typename T>
 	void destroy_n(T* it, size_t n) 
 	{
-		for (; n > 0; --n, ++it) {
-			kab::destroy_at(it);
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			for (; n > 0; --n, ++it) {
+				kab::destroy_at(it);
+			}
 		}
 	}
-}
\ No newline at end of file
+}
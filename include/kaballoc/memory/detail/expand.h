@@ -0,0 +1,21 @@
+#pragma once
+
+#include <type_traits>
+
+#include "kaballoc/memory/resource.h"
+#include "kaballoc/memory/byte_span.h"
+
+namespace kab::detail
+{
+	/**
+	 * Whether the resource supports the 'expand' extension (see memory/resource.h)
+	 */
+	template<typename, typename = std::void_t<>>
+	struct has_expand : std::false_type {};
+
+	template<typename T>
+	struct has_expand<T, std::void_t<decltype(std::declval<T&>().expand(std::declval<byte_span>(), std::declval<size_t>(), std::declval<align_t>()))>> : std::true_type {};
+
+	template<typename T>
+	inline constexpr bool has_expand_v = has_expand<std::remove_cvref_t<T>>::value;
+}
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <new>
 #include <type_traits>
+#include <utility>
 
 #include "kaballoc/memory/resource.h"
 #include "kaballoc/memory/byte_span.h"
@@ -62,4 +64,30 @@ namespace kab::detail
 	{
 		over_deallocate_helper<MemoryResource>().over_deallocate(std::forward<MemoryResource>(resource), s, align);
 	}
-}
\ No newline at end of file
+
+	/**
+	 * Containers have no way to report exhaustion (see "Exhaustion" in memory/resource.h), so they allocate with these functions,
+	 * which turn a span with a null pointer into std::bad_alloc
+	 */
+	template<typename MemoryResource>
+	inline byte_span allocate_or_throw(MemoryResource&& resource, size_t byte_size, align_t align)
+	{
+		byte_span const s = resource.allocate(byte_size, align);
+		if (s.data == nullptr && byte_size != 0)
+		{
+			throw std::bad_alloc();
+		}
+		return s;
+	}
+
+	template<typename MemoryResource>
+	inline byte_span over_allocate_or_throw(MemoryResource&& resource, size_t byte_size, align_t align)
+	{
+		byte_span const s = over_allocate(std::forward<MemoryResource>(resource), byte_size, align);
+		if (s.data == nullptr && byte_size != 0)
+		{
+			throw std::bad_alloc();
+		}
+		return s;
+	}
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+#include "kaballoc/memory/byte_span.h"
+
+namespace kab::detail
+{
+	/**
+	 * Whether the resource supports the 'owns' extension (see memory/resource.h)
+	 */
+	template<typename, typename = std::void_t<>>
+	struct has_owns : std::false_type {};
+
+	template<typename T>
+	struct has_owns<T, std::void_t<decltype(std::declval<T const&>().owns(std::declval<byte_span>()))>> : std::true_type {};
+
+	template<typename T>
+	inline constexpr bool has_owns_v = has_owns<std::remove_cvref_t<T>>::value;
+}
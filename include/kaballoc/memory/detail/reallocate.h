@@ -0,0 +1,21 @@
+#pragma once
+
+#include <type_traits>
+
+#include "kaballoc/memory/resource.h"
+#include "kaballoc/memory/byte_span.h"
+
+namespace kab::detail
+{
+	/**
+	 * Whether the resource supports the 'reallocate' extension (see memory/resource.h)
+	 */
+	template<typename, typename = std::void_t<>>
+	struct has_reallocate : std::false_type {};
+
+	template<typename T>
+	struct has_reallocate<T, std::void_t<decltype(std::declval<T&>().reallocate(std::declval<byte_span>(), std::declval<size_t>(), std::declval<align_t>()))>> : std::true_type {};
+
+	template<typename T>
+	inline constexpr bool has_reallocate_v = has_reallocate<std::remove_cvref_t<T>>::value;
+}
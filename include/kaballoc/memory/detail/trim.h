@@ -0,0 +1,58 @@
+#pragma once
+
+#include <type_traits>
+
+#include "kaballoc/memory/resource.h"
+
+namespace kab::detail
+{
+	/**
+	 * Whether the resource supports the 'trim' extension (see memory/resource.h)
+	 */
+	template<typename, typename = std::void_t<>>
+	struct has_trim : std::false_type {};
+
+	template<typename T>
+	struct has_trim<T, std::void_t<decltype(std::declval<T&>().trim(std::declval<size_t>()))>> : std::true_type {};
+
+	template<typename T>
+	inline constexpr bool has_trim_v = has_trim<std::remove_cvref_t<T>>::value;
+
+	/**
+	 * Trims the resource if it supports 'trim', otherwise does nothing. Returns the number of released bytes
+	 */
+	template<typename MemoryResource>
+	inline size_t trim(MemoryResource& resource, size_t keep_bytes)
+	{
+		if constexpr (has_trim_v<MemoryResource>)
+		{
+			return resource.trim(keep_bytes);
+		}
+		else
+		{
+			(void)resource; (void)keep_bytes;
+			return 0;
+		}
+	}
+
+	/**
+	 * Trims the resources of a composite which support 'trim', so that at most 'keep_bytes' bytes stay cached in total.
+	 * Each resource keeps an equal part of what remains of 'keep_bytes', and passes the remainder on. Returns the number of released bytes
+	 */
+	template<typename... MemoryResources>
+	inline size_t trim_split(size_t keep_bytes, MemoryResources&... resources)
+	{
+		size_t trimmable = (size_t(0) + ... + size_t(has_trim_v<MemoryResources>));
+		size_t released = 0;
+		([&](auto& resource)
+		{
+			if constexpr (has_trim_v<decltype(resource)>)
+			{
+				size_t const keep = keep_bytes / trimmable--;
+				keep_bytes -= keep;
+				released += resource.trim(keep);
+			}
+		}(resources), ...);
+		return released;
+	}
+}
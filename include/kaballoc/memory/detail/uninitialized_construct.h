@@ -0,0 +1,122 @@
+#pragma once
+
+#include "kaballoc/trait/zero_initializable.h"
+#include "kaballoc/memory/detail/destroy.h"
+#include "kaballoc/core/size_t.h"
+
+#include <string.h>
+#include <new>
+#include <type_traits>
+
+namespace kab
+{
+	/**
+	 * uninitialized_default_construct_n
+	 *
+	 * Default-initializes 'n' objects in the uninitialized storage starting at 'dst'. 
+	 * Compiles to nothing for trivially default constructible types.
+	 * If a constructor throws, the objects already constructed are destroyed
+	 */
+	template<typename T>
+	void uninitialized_default_construct_n(T* dst, size_t n)
+	{
+		if constexpr (!std::is_trivially_default_constructible_v<T>)
+		{
+			size_t i = 0;
+			try
+			{
+				for (; i < n; ++i)
+				{
+					new(dst + i) T;
+				}
+			}
+			catch (...)
+			{
+				kab::destroy_n(dst, i);
+				throw;
+			}
+		}
+	}
+
+	/**
+	 * uninitialized_value_construct_n
+	 *
+	 * Value-initializes 'n' objects in the uninitialized storage starting at 'dst'.
+	 * Compiles to a memset for zero initializable types (see 'is_zero_initializable').
+	 * If a constructor throws, the objects already constructed are destroyed
+	 */
+	template<typename T>
+	void uninitialized_value_construct_n(T* dst, size_t n)
+	{
+		if constexpr (is_zero_initializable_v<T>)
+		{
+			if (n != 0)
+			{
+				memset(static_cast<void*>(dst), 0, n * sizeof(T));
+			}
+		}
+		else
+		{
+			size_t i = 0;
+			try
+			{
+				for (; i < n; ++i)
+				{
+					new(dst + i) T();
+				}
+			}
+			catch (...)
+			{
+				kab::destroy_n(dst, i);
+				throw;
+			}
+		}
+	}
+
+	/**
+	 * uninitialized_fill_n
+	 *
+	 * Copy-constructs 'n' objects from 'value' in the uninitialized storage starting at 'dst'.
+	 *
+	 * Single-byte trivially copyable types compile to a memset. Other trivially copyable types are filled from a local copy of 'value',
+	 * so that the compiler knows the source can't alias the destination and can vectorize the loop.
+	 * If a constructor throws, the objects already constructed are destroyed
+	 */
+	template<typename T>
+	void uninitialized_fill_n(T* dst, size_t n, T const& value)
+	{
+		if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) == 1)
+		{
+			if (n != 0)
+			{
+				unsigned char byte_value;
+				memcpy(&byte_value, &value, 1);
+				memset(static_cast<void*>(dst), byte_value, n);
+			}
+		}
+		else if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			T const local = value;
+			for (size_t i = 0; i < n; ++i)
+			{
+				new(dst + i) T(local);
+			}
+		}
+		else
+		{
+			size_t i = 0;
+			try
+			{
+				for (; i < n; ++i)
+				{
+					new(dst + i) T(value);
+				}
+			}
+			catch (...)
+			{
+				kab::destroy_n(dst, i);
+				throw;
+			}
+		}
+	}
+}
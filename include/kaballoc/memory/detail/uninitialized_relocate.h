@@ -2,15 +2,98 @@
 
 #include "kaballoc/trait/relocatable.h"
 #include "kaballoc/range/detail/distance.h"
+#include "kaballoc/memory/detail/destroy.h"
 
 #include <string.h>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace kab
 {
+	/**
+	 * uninitialized_relocate
+	 *
+	 * Relocates the objects of [it, sent) to the uninitialized storage starting at 'dst'. The two ranges must not overlap.
+	 * Once done, [it, sent) is uninitialized storage, and its objects must not be destroyed again.
+	 *
+	 * The method is picked at compile time:
+	 *   - Trivially relocatable types are copied with a single memcpy
+	 *   - Types with a noexcept move constructor, or without a copy constructor, are move constructed then destroyed one by one
+	 *   - Other types are copy constructed, and the source objects are only destroyed once every copy succeeded
+	 *
+	 * If an exception is thrown, the objects already constructed in the destination are destroyed. With the copy method,
+	 * the source range is left untouched (strong exception guarantee). With a throwing move, the source range is destroyed
+	 */
 	template<typename T>
 	void uninitialized_relocate(T* it, T* sent, T* dst)
 	{
-		static_assert(is_trivially_relocatable_v<T>, "A trivially relocatable type is required");
-		memcpy(dst, it, range::distance(it, sent) * sizeof(T));
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			if (it != sent) 
+			{
+				memcpy(static_cast<void*>(dst), it, range::distance(it, sent) * sizeof(T));
+			}
+		}
+		else if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+		{
+			T* const first_dst = dst;
+			try
+			{
+				for (; it != sent; ++it, ++dst) 
+				{
+					new(dst) T(std::move(*it));
+					kab::destroy_at(it);
+				}
+			}
+			catch (...)
+			{
+				// Only reachable with a throwing move: nothing can be put back, so nothing is kept
+				kab::destroy(first_dst, dst);
+				kab::destroy(it, sent);
+				throw;
+			}
+		}
+		else
+		{
+			T* const first = it;
+			T* const first_dst = dst;
+			try
+			{
+				for (; it != sent; ++it, ++dst)
+				{
+					new(dst) T(*it);
+				}
+			}
+			catch (...)
+			{
+				kab::destroy(first_dst, dst);
+				throw;
+			}
+			kab::destroy(first, sent);
+		}
+	}
+
+	/**
+	 * relocate_assign
+	 *
+	 * Gives the value of the object at 'src' to 'dst', then destroys the object at 'src'.
+	 * Trivially relocatable types destroy 'dst' then copy 'src' with a memcpy, other types are move assigned.
+	 *
+	 * If the move assignment throws, the object at 'src' is not destroyed
+	 */
+	template<typename T>
+	void relocate_assign(T* src, T& dst)
+	{
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			kab::destroy_at(&dst);
+			memcpy(static_cast<void*>(&dst), src, sizeof(T));
+		}
+		else
+		{
+			dst = std::move(*src);
+			kab::destroy_at(src);
+		}
 	}
 }
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "kaballoc/memory/resource.h"
+#include "kaballoc/memory/byte_span.h"
+#include "kaballoc/memory/detail/over_allocate.h"
+#include "kaballoc/memory/detail/owns.h"
+#include "kaballoc/memory/detail/trim.h"
+
+#include <type_traits>
+#include <utility>
+
+namespace kab
+{
+	/**
+	 * 'fallback_resource' is a composite memory resource which allocates from the Primary resource, and from the Fallback resource when the Primary is exhausted
+	 *
+	 * The Primary resource reports exhaustion by returning a span with a null pointer (see "Exhaustion" in memory/resource.h), for example a 'static_resource'.
+	 * On deallocation, the Primary resource is asked whether it 'owns' the span (see "Owner" in memory/resource.h), so the Primary must support the 'owns' extension.
+	 *
+	 * Fallback resources can be chained, by using a fallback_resource as the Fallback:
+	 *     fallback_resource<static_resource<4096>, fallback_resource<arena, new_resource>>
+	 * The chain supports 'owns' if its last resource does.
+	 *
+	 * fallback_resource is an over-allocator: over-allocation functions are forwarded to the resource which serves the request.
+	 * It has the copy and move semantics of its resources.
+	 */
+	template<typename Primary, typename Fallback>
+	class fallback_resource
+	{
+		static_assert(detail::has_owns_v<Primary>, "The primary resource must support the 'owns' extension");
+
+		[[no_unique_address]] Primary m_primary;
+		[[no_unique_address]] Fallback m_fallback;
+
+	public:
+		fallback_resource() = default;
+		fallback_resource(Primary primary, Fallback fallback)
+			: m_primary(std::move(primary))
+			, m_fallback(std::move(fallback))
+		{
+
+		}
+
+		/**
+		 * allocate
+		 *
+		 * Allocates from the Primary resource, then from the Fallback resource if the Primary returned a null pointer
+		 */
+		[[nodiscard]] byte_span allocate(size_t s, align_t alignment)
+		{
+			byte_span const primary_span = m_primary.allocate(s, alignment);
+			if (primary_span.data != nullptr)
+			{
+				return primary_span;
+			}
+			return m_fallback.allocate(s, alignment);
+		}
+
+		/**
+		 * over_allocate
+		 *
+		 * Like allocate, but the returned size can be bigger than the requested size
+		 */
+		[[nodiscard]] byte_span over_allocate(size_t s, align_t alignment)
+		{
+			byte_span const primary_span = detail::over_allocate(m_primary, s, alignment);
+			if (primary_span.data != nullptr)
+			{
+				return primary_span;
+			}
+			return detail::over_allocate(m_fallback, s, alignment);
+		}
+
+		/**
+		 * deallocate
+		 *
+		 * Deallocates from the Primary resource if it owns the span, otherwise from the Fallback resource
+		 */
+		void deallocate(byte_span s, align_t alignment)
+		{
+			if (m_primary.owns(s))
+			{
+				m_primary.deallocate(s, alignment);
+			}
+			else
+			{
+				m_fallback.deallocate(s, alignment);
+			}
+		}
+
+		void over_deallocate(byte_span s, align_t alignment)
+		{
+			if (m_primary.owns(s))
+			{
+				detail::over_deallocate(m_primary, s, alignment);
+			}
+			else
+			{
+				detail::over_deallocate(m_fallback, s, alignment);
+			}
+		}
+
+		/**
+		 * trim
+		 *
+		 * Trims each resource which supports 'trim', which share 'keep_bytes' bytes
+		 */
+		size_t trim(size_t keep_bytes) requires (detail::has_trim_v<Primary> || detail::has_trim_v<Fallback>)
+		{
+			return detail::trim_split(keep_bytes, m_primary, m_fallback);
+		}
+
+		/**
+		 * owns
+		 *
+		 * Only available if the Fallback resource supports the 'owns' extension
+		 */
+		[[nodiscard]] bool owns(byte_span s) const noexcept requires detail::has_owns_v<Fallback>
+		{
+			return m_primary.owns(s) || m_fallback.owns(s);
+		}
+
+		/**
+		 * Access the composed resources
+		 */
+		[[nodiscard]] Primary& primary() noexcept { return m_primary; }
+		[[nodiscard]] Primary const& primary() const noexcept { return m_primary; }
+		[[nodiscard]] Fallback& fallback() noexcept { return m_fallback; }
+		[[nodiscard]] Fallback const& fallback() const noexcept { return m_fallback; }
+
+		[[nodiscard]] constexpr bool operator==(fallback_resource const& rhs) const noexcept
+		{
+			return m_primary == rhs.m_primary && m_fallback == rhs.m_fallback;
+		}
+	};
+}
@@ -2,6 +2,7 @@
 
 #include "kaballoc/memory/resource.h"
 #include "kaballoc/memory/byte_span.h"
+#include "kaballoc/memory/detail/trim.h"
 
 #include <type_traits>
 #include <utility>
@@ -69,11 +70,17 @@ namespace kab
 		 * Otherwise, a block of BlockSize bytes is allocated from the inner resource.
 		 * If 'byte_size' is bigger than BlockSize, a block is always allocated from the inner resource.
 		 * If the freelist cannot fulfill the alignment requirement with the freelist, it may also allocate from the inner resource.
+		 * An allocation of 0 bytes returns an empty span, without taking a block.
 		 *
 		 * On allocation failure, the behavior depends on the inner resource. This resource has basic exception guarantee.
 		 */
 		[[nodiscard]] byte_span allocate(size_t byte_size, align_t alignment)
 		{
+			if (byte_size == 0)
+			{
+				return { nullptr, 0 };
+			}
+
 			byte_span s = over_allocate(byte_size, alignment);
 			s.size = byte_size;
 			return s;
@@ -116,13 +123,24 @@ namespace kab
 		 */
 		void deallocate(byte_span bytes, align_t alignment) noexcept
 		{
+			// Containers deallocate their empty storage, which must not be pushed on the freelist
+			if (bytes.size == 0)
+			{
+				return;
+			}
+
 			// If the memory was over-sized or over-aligned, we can't put the block on the freelist
 			// This is because when the freelist is cleared, we assume that the allocation was made with "BlockSize" and target alignment as the parameters
 			// If the allocation was made with other values, we can't deallocate it reliably on freelist clear.
 			// Therefore, deallocate it here
-			if (bytes.size > BlockSize || alignment > get_target_alignment())
+			// The size and alignment given to the inner resource must match the ones used by 'over_allocate'
+			if (bytes.size > BlockSize)
 			{
-				return access_inner().deallocate(bytes, alignment);
+				return access_inner().deallocate(bytes, alignment > get_target_alignment() ? alignment : get_target_alignment());
+			}
+			if (alignment > get_target_alignment())
+			{
+				return access_inner().deallocate({ bytes.data, BlockSize }, alignment);
 			}
 
 			// Push this block on top of the freelist
@@ -142,6 +160,34 @@ namespace kab
 			}
 		}
 
+		/**
+		 * trim
+		 *
+		 * Keeps the first 'keep_bytes' bytes of the freelist, and gives the other blocks back to the inner resource.
+		 * The inner resource is then trimmed too, if it supports it, keeping what remains of 'keep_bytes'.
+		 * Returns the number of bytes given back by the freelist and the inner resource
+		 */
+		size_t trim(size_t keep_bytes) noexcept
+		{
+			node** link = &free_head;
+			size_t kept = 0;
+			for (; *link != nullptr && kept + BlockSize <= keep_bytes; kept += BlockSize)
+			{
+				link = &(*link)->next;
+			}
+
+			size_t released = 0;
+			while (*link != nullptr)
+			{
+				node* const head = *link;
+				*link = head->next;
+				access_inner().deallocate({ reinterpret_cast<byte*>(head), BlockSize }, get_target_alignment());
+				released += BlockSize;
+			}
+
+			return released + detail::trim(access_inner(), keep_bytes - kept);
+		}
+
 		[[nodiscard]] constexpr bool operator==(freelist_resource const& rhs) const noexcept
 		{
 			if constexpr (std::is_empty_v<InnerResource>)
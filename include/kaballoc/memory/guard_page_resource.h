@@ -0,0 +1,278 @@
+#pragma once
+
+#include "kaballoc/memory/resource.h"
+#include "kaballoc/memory/byte_span.h"
+#include "kaballoc/memory/page_resource.h"
+#include "kaballoc/core/platform.h"
+
+#include <new>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <utility>
+
+namespace kab
+{
+#if KAB_PLATFORM_LINUX
+	/**
+	 * Which side of a 'guard_page_resource' allocation touches the guard page
+	 *
+	 * after: the allocation ends against the guard page, so reading or writing past its end faults (overflow)
+	 * before: the allocation starts against the guard page, so reading or writing before its start faults (underflow)
+	 */
+	enum class guard_side : unsigned char
+	{
+		after,
+		before,
+	};
+
+	namespace detail
+	{
+		inline constexpr byte guard_canary = 0xFB;
+
+		[[noreturn]] inline void report_guard_corruption(byte const* data, size_t size) noexcept
+		{
+			::fprintf(stderr, "kab::guard_page_resource: heap corruption detected next to the allocation [%p, +%zu)\n", static_cast<void const*>(data), size);
+			::abort();
+		}
+	}
+
+	/**
+	 * 'guard_page_resource' puts every allocation in its own pages, next to an inaccessible guard page, to catch memory errors as they happen
+	 *
+	 * The resource reserves a range of addresses up front, and keeps all of it inaccessible (PROT_NONE) except for the pages of live allocations:
+	 *   - an access past the end (or before the start, see 'guard_side') of an allocation faults on the guard page
+	 *   - an access to freed memory faults, since freed pages are made inaccessible again and their physical memory is released
+	 *   - freed pages are reused as late as possible (the next allocation is searched after the last one), which makes a quarantine
+	 *     as big as the reservation
+	 * The bytes between the allocation and the end of its pages (alignment slack) are filled with a canary, checked on deallocation.
+	 * A modified canary reports the corruption and aborts.
+	 *
+	 * Each allocation costs at least two pages and a few system calls, so it's meant for debugging, or to guard a sampled fraction of the allocations
+	 * in optimized builds (see 'sampled_resource'). When the reservation is exhausted, or when the alignment is bigger than a page,
+	 * allocation functions return a span with a null pointer (see "Exhaustion" in memory/resource.h).
+	 *
+	 * guard_page_resource supports the 'owns' extension. It is moveable but not copyable, and isn't thread-safe.
+	 */
+	template<guard_side Side = guard_side::after>
+	class guard_page_resource
+	{
+		byte* m_base = nullptr;
+		uint64_t* m_used = nullptr; // one bit per page of the reservation
+		size_t m_page_count = 0;
+		size_t m_cursor = 0; // page where the search for the next allocation starts
+		size_t m_page_size = 0;
+
+		[[nodiscard]] bool is_used(size_t page) const noexcept { return (m_used[page / 64] >> (page % 64)) & 1; }
+		void set_used(size_t first, size_t count, bool used) noexcept
+		{
+			for (size_t page = first; page < first + count; ++page)
+			{
+				uint64_t const bit = uint64_t(1) << (page % 64);
+				m_used[page / 64] = used ? (m_used[page / 64] | bit) : (m_used[page / 64] & ~bit);
+			}
+		}
+
+		[[nodiscard]] size_t bitmap_bytes() const noexcept
+		{
+			return detail::round_up_pow2((m_page_count + 63) / 64 * sizeof(uint64_t), m_page_size);
+		}
+
+		// Number of accessible pages for an allocation
+		[[nodiscard]] size_t data_pages(size_t size, size_t alignment) const noexcept
+		{
+			return (size + alignment - 1 + m_page_size - 1) / m_page_size;
+		}
+
+		// Finds 'count' free pages, searching after the cursor first. Returns m_page_count if there's none
+		[[nodiscard]] size_t find_free(size_t count) const noexcept
+		{
+			for (size_t pass = 0; pass < 2; ++pass)
+			{
+				size_t const start = pass == 0 ? m_cursor : 0;
+				size_t const stop = pass == 0 ? m_page_count : m_cursor;
+				size_t run = 0;
+				for (size_t page = start; page < stop && page < m_page_count; ++page)
+				{
+					run = is_used(page) ? 0 : run + 1;
+					if (run == count)
+					{
+						return page + 1 - count;
+					}
+				}
+			}
+			return m_page_count;
+		}
+
+		void release() noexcept
+		{
+			if (m_base != nullptr)
+			{
+				::munmap(m_base, m_page_count * m_page_size);
+				::munmap(m_used, bitmap_bytes());
+			}
+			m_base = nullptr;
+			m_used = nullptr;
+			m_page_count = 0;
+			m_cursor = 0;
+		}
+
+	public:
+		guard_page_resource() = default;
+
+		/**
+		 * Reserves 'reserve_size' bytes of address space, rounded up to whole pages.
+		 * Throws std::bad_alloc if the address space can't be reserved
+		 */
+		explicit guard_page_resource(size_t reserve_size)
+			: m_page_size(detail::system_page_size())
+		{
+			m_page_count = detail::round_up_pow2(reserve_size, m_page_size) / m_page_size;
+
+			void* const range = ::mmap(nullptr, m_page_count * m_page_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+			if (range == MAP_FAILED)
+			{
+				throw std::bad_alloc();
+			}
+			void* const bitmap = ::mmap(nullptr, bitmap_bytes(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (bitmap == MAP_FAILED)
+			{
+				::munmap(range, m_page_count * m_page_size);
+				throw std::bad_alloc();
+			}
+			m_base = static_cast<byte*>(range);
+			m_used = static_cast<uint64_t*>(bitmap);
+		}
+		guard_page_resource(guard_page_resource const&) = delete;
+		guard_page_resource& operator=(guard_page_resource const&) = delete;
+		guard_page_resource(guard_page_resource && rhs) noexcept
+			: m_base(std::exchange(rhs.m_base, nullptr))
+			, m_used(std::exchange(rhs.m_used, nullptr))
+			, m_page_count(std::exchange(rhs.m_page_count, 0))
+			, m_cursor(std::exchange(rhs.m_cursor, 0))
+			, m_page_size(rhs.m_page_size)
+		{
+
+		}
+		guard_page_resource& operator=(guard_page_resource && rhs) noexcept
+		{
+			if (this != &rhs)
+			{
+				release();
+				m_base = std::exchange(rhs.m_base, nullptr);
+				m_used = std::exchange(rhs.m_used, nullptr);
+				m_page_count = std::exchange(rhs.m_page_count, 0);
+				m_cursor = std::exchange(rhs.m_cursor, 0);
+				m_page_size = rhs.m_page_size;
+			}
+			return *this;
+		}
+		~guard_page_resource()
+		{
+			release();
+		}
+
+		/**
+		 * allocate
+		 *
+		 * Makes the pages of the allocation accessible, next to a guard page. Returns a span with a null pointer if that's not possible
+		 */
+		[[nodiscard]] byte_span allocate(size_t size, align_t alignment) noexcept
+		{
+			size_t const align = static_cast<size_t>(alignment);
+			if (size == 0 || m_base == nullptr || align > m_page_size)
+			{
+				return { nullptr, 0 };
+			}
+
+			size_t const pages = data_pages(size, align);
+			size_t const first = find_free(pages + 1);
+			if (first == m_page_count)
+			{
+				return { nullptr, 0 };
+			}
+
+			size_t const first_data = Side == guard_side::after ? first : first + 1;
+			byte* const pages_begin = m_base + first_data * m_page_size;
+			byte* const pages_end = pages_begin + pages * m_page_size;
+			if (::mprotect(pages_begin, pages * m_page_size, PROT_READ | PROT_WRITE) != 0)
+			{
+				return { nullptr, 0 };
+			}
+			set_used(first, pages + 1, true);
+			m_cursor = first + pages + 1;
+
+			byte* data;
+			if constexpr (Side == guard_side::after)
+			{
+				data = reinterpret_cast<byte*>(reinterpret_cast<uintptr_t>(pages_end - size) & ~static_cast<uintptr_t>(align - 1));
+				::memset(data + size, detail::guard_canary, static_cast<size_t>(pages_end - (data + size)));
+			}
+			else
+			{
+				data = pages_begin;
+				::memset(data + size, detail::guard_canary, static_cast<size_t>(pages_end - (data + size)));
+			}
+			return { data, size };
+		}
+
+		/**
+		 * deallocate
+		 *
+		 * Checks the canary, then makes the pages inaccessible again and releases their physical memory
+		 */
+		void deallocate(byte_span s, align_t alignment) noexcept
+		{
+			if (s.size == 0)
+			{
+				return;
+			}
+
+			size_t const align = static_cast<size_t>(alignment);
+			size_t const pages = data_pages(s.size, align);
+			byte* pages_begin;
+			if constexpr (Side == guard_side::after)
+			{
+				pages_begin = m_base + detail::round_up_pow2(static_cast<size_t>(s.data + s.size - m_base), m_page_size) - pages * m_page_size;
+			}
+			else
+			{
+				pages_begin = s.data;
+			}
+			byte* const pages_end = pages_begin + pages * m_page_size;
+
+			for (byte const* canary = s.data + s.size; canary != pages_end; ++canary)
+			{
+				if (*canary != detail::guard_canary)
+				{
+					detail::report_guard_corruption(s.data, s.size);
+				}
+			}
+
+			::madvise(pages_begin, pages * m_page_size, MADV_DONTNEED);
+			::mprotect(pages_begin, pages * m_page_size, PROT_NONE);
+
+			size_t const first_data = static_cast<size_t>(pages_begin - m_base) / m_page_size;
+			set_used(Side == guard_side::after ? first_data : first_data - 1, pages + 1, false);
+		}
+
+		/**
+		 * owns
+		 *
+		 * Returns whether the span points into the reservation
+		 */
+		[[nodiscard]] bool owns(byte_span s) const noexcept
+		{
+			return s.data >= m_base && s.data < m_base + m_page_count * m_page_size;
+		}
+
+		[[nodiscard]] bool operator==(guard_page_resource const& rhs) const noexcept
+		{
+			return this == &rhs;
+		}
+	};
+#else
+#error "guard_page_resource.h: implement non-Linux"
+#endif
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "kaballoc/memory/resource.h"
+#include "kaballoc/memory/byte_span.h"
+#include "kaballoc/memory/detail/over_allocate.h"
+#include "kaballoc/memory/detail/owns.h"
+#include "kaballoc/memory/detail/trim.h"
+
+#include <mutex>
+#include <utility>
+
+namespace kab
+{
+	/**
+	 * 'locked_resource' makes an inner resource thread-safe, by calling it with a Lock held
+	 *
+	 * The Lock must match the Lockable requirements, for example std::mutex, or 'spin_lock' (core/spin_lock.h) when the calls are short,
+	 * as with a 'freelist_resource' over a thread-safe resource.
+	 *
+	 * Allocation, deallocation, over-allocation, 'owns' and 'trim' are forwarded under the lock. The inner resource can be reached with 'unsafe_inner',
+	 * which doesn't lock.
+	 *
+	 * locked_resource is neither copyable nor moveable: share it with a 'resource_reference'.
+	 */
+	template<typename InnerResource, typename Lock = std::mutex>
+	class locked_resource : InnerResource
+	{
+		[[nodiscard]] InnerResource& access_inner() & noexcept { return static_cast<InnerResource&>(*this); }
+		[[nodiscard]] InnerResource const& access_inner() const& noexcept { return static_cast<InnerResource const&>(*this); }
+
+		mutable Lock m_lock;
+
+	public:
+		locked_resource() = default;
+		explicit locked_resource(InnerResource r)
+			: InnerResource(std::move(r))
+		{
+
+		}
+		locked_resource(locked_resource const&) = delete;
+		locked_resource& operator=(locked_resource const&) = delete;
+
+		[[nodiscard]] byte_span allocate(size_t size, align_t alignment)
+		{
+			std::lock_guard<Lock> const guard(m_lock);
+			return access_inner().allocate(size, alignment);
+		}
+
+		[[nodiscard]] byte_span over_allocate(size_t size, align_t alignment)
+		{
+			std::lock_guard<Lock> const guard(m_lock);
+			return detail::over_allocate(access_inner(), size, alignment);
+		}
+
+		void deallocate(byte_span s, align_t alignment)
+		{
+			std::lock_guard<Lock> const guard(m_lock);
+			access_inner().deallocate(s, alignment);
+		}
+
+		void over_deallocate(byte_span s, align_t alignment)
+		{
+			std::lock_guard<Lock> const guard(m_lock);
+			detail::over_deallocate(access_inner(), s, alignment);
+		}
+
+		[[nodiscard]] bool owns(byte_span s) const noexcept requires detail::has_owns_v<InnerResource>
+		{
+			std::lock_guard<Lock> const guard(m_lock);
+			return access_inner().owns(s);
+		}
+
+		size_t trim(size_t keep_bytes) requires detail::has_trim_v<InnerResource>
+		{
+			std::lock_guard<Lock> const guard(m_lock);
+			return access_inner().trim(keep_bytes);
+		}
+
+		/**
+		 * Returns the inner resource, without locking. The caller must ensure no other thread uses the resource
+		 */
+		[[nodiscard]] InnerResource& unsafe_inner() noexcept { return access_inner(); }
+		[[nodiscard]] InnerResource const& unsafe_inner() const noexcept { return access_inner(); }
+
+		[[nodiscard]] bool operator==(locked_resource const& rhs) const noexcept
+		{
+			return this == &rhs;
+		}
+	};
+}
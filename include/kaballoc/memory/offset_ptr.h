@@ -0,0 +1,100 @@
+#pragma once
+
+#include "kaballoc/core/ptrdiff_t.h"
+#include "kaballoc/trait/relocatable.h"
+
+#include <stdint.h>
+#include <type_traits>
+
+namespace kab
+{
+	/**
+	 * 'offset_ptr' is a pointer which stores the distance between itself and the pointee, instead of an address
+	 *
+	 * When a block of memory is mapped at different addresses (for example a shared memory segment mapped by several processes),
+	 * an offset_ptr stored in the block and pointing into the same block stays valid in every mapping.
+	 * An offset_ptr pointing outside of its own block is only valid in the mapping where it was assigned.
+	 *
+	 * Since the offset depends on the address of the offset_ptr itself, copying recomputes it, and offset_ptr is not trivially relocatable.
+	 * The null pointer is encoded as an offset of 1, which would otherwise point inside the offset_ptr itself.
+	 */
+	template<typename T>
+	class offset_ptr
+	{
+		static constexpr ptrdiff_t null_offset = 1;
+
+		ptrdiff_t m_offset = null_offset;
+
+		[[nodiscard]] ptrdiff_t offset_to(T const* p) const noexcept
+		{
+			if (p == nullptr)
+			{
+				return null_offset;
+			}
+			return static_cast<ptrdiff_t>(reinterpret_cast<uintptr_t>(p) - reinterpret_cast<uintptr_t>(this));
+		}
+
+	public:
+		using element_type = T;
+
+		offset_ptr() = default;
+		offset_ptr(decltype(nullptr)) noexcept {}
+		offset_ptr(T* p) noexcept
+			: m_offset(offset_to(p))
+		{
+
+		}
+		offset_ptr(offset_ptr const& rhs) noexcept
+			: m_offset(offset_to(rhs.get()))
+		{
+
+		}
+		template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+		offset_ptr(offset_ptr<U> const& rhs) noexcept
+			: m_offset(offset_to(rhs.get()))
+		{
+
+		}
+		offset_ptr& operator=(offset_ptr const& rhs) noexcept
+		{
+			m_offset = offset_to(rhs.get());
+			return *this;
+		}
+		offset_ptr& operator=(T* p) noexcept
+		{
+			m_offset = offset_to(p);
+			return *this;
+		}
+		offset_ptr& operator=(decltype(nullptr)) noexcept
+		{
+			m_offset = null_offset;
+			return *this;
+		}
+
+		/**
+		 * Returns the address of the pointee in the current mapping
+		 */
+		[[nodiscard]] T* get() const noexcept
+		{
+			if (m_offset == null_offset)
+			{
+				return nullptr;
+			}
+			return reinterpret_cast<T*>(reinterpret_cast<uintptr_t>(this) + static_cast<uintptr_t>(m_offset));
+		}
+
+		[[nodiscard]] explicit operator bool() const noexcept { return m_offset != null_offset; }
+		[[nodiscard]] T* operator->() const noexcept { return get(); }
+		template<typename U = T, typename = std::enable_if_t<!std::is_void_v<U>>>
+		[[nodiscard]] U& operator*() const noexcept { return *get(); }
+		template<typename U = T, typename = std::enable_if_t<!std::is_void_v<U>>>
+		[[nodiscard]] U& operator[](size_t i) const noexcept { return get()[i]; }
+
+		[[nodiscard]] friend bool operator==(offset_ptr const& lhs, offset_ptr const& rhs) noexcept { return lhs.get() == rhs.get(); }
+		[[nodiscard]] friend bool operator==(offset_ptr const& lhs, T const* rhs) noexcept { return lhs.get() == rhs; }
+		[[nodiscard]] friend bool operator==(offset_ptr const& lhs, decltype(nullptr)) noexcept { return !lhs; }
+	};
+
+	template<typename T>
+	struct is_trivially_relocatable<offset_ptr<T>> : std::false_type {};
+}
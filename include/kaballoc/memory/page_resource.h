@@ -0,0 +1,253 @@
+#pragma once
+
+#include "kaballoc/memory/resource.h"
+#include "kaballoc/memory/byte_span.h"
+#include "kaballoc/core/platform.h"
+
+#include <new>
+
+#include <string.h>
+
+#if KAB_PLATFORM_LINUX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#if !defined(KAB_HUGE_PAGE_SIZE)
+#  define KAB_HUGE_PAGE_SIZE (size_t(2) * 1024 * 1024)
+#endif
+
+namespace kab
+{
+	/**
+	 * Huge page policy of a 'page_resource'
+	 *
+	 * none: only the system page size is used
+	 * transparent: big allocations are aligned on huge pages, and the kernel is advised to back them with transparent huge pages (MADV_HUGEPAGE)
+	 * explicit_pages: big allocations are mapped from the reserved huge page pool (MAP_HUGETLB). If the pool is empty, falls back to 'transparent'
+	 */
+	enum class huge_pages : unsigned char
+	{
+		none,
+		transparent,
+		explicit_pages,
+	};
+
+#if KAB_PLATFORM_LINUX
+	namespace detail
+	{
+		[[nodiscard]] inline size_t system_page_size() noexcept
+		{
+			static size_t const page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+			return page_size;
+		}
+
+		[[nodiscard]] constexpr size_t round_up_pow2(size_t n, size_t granularity) noexcept
+		{
+			return (n + granularity - 1) & ~(granularity - 1);
+		}
+
+		// Maps 'size' bytes aligned on 'alignment'. Over-aligned mappings are made bigger, then the excess is unmapped
+		[[nodiscard]] inline byte* map_pages(size_t size, size_t alignment) noexcept
+		{
+			size_t const page_size = system_page_size();
+			if (alignment <= page_size)
+			{
+				void* const p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+				return p == MAP_FAILED ? nullptr : static_cast<byte*>(p);
+			}
+
+			size_t const mapped_size = size + alignment - page_size;
+			void* const p = ::mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (p == MAP_FAILED)
+			{
+				return nullptr;
+			}
+
+			byte* const mapped = static_cast<byte*>(p);
+			byte* const aligned = mapped + (round_up_pow2(reinterpret_cast<size_t>(mapped), alignment) - reinterpret_cast<size_t>(mapped));
+			size_t const head = static_cast<size_t>(aligned - mapped);
+			size_t const tail = mapped_size - head - size;
+			if (head != 0)
+			{
+				::munmap(mapped, head);
+			}
+			if (tail != 0)
+			{
+				::munmap(aligned + size, tail);
+			}
+			return aligned;
+		}
+	}
+
+	/**
+	 * 'page_resource' maps memory directly from the kernel with 'mmap', bypassing the heap and its locks
+	 *
+	 * Allocations are rounded up to whole pages: 'over_allocate' returns the full rounded span, so containers can use the rest of the last page.
+	 * Any power of two alignment is supported, alignments above the page size are obtained by trimming a bigger mapping.
+	 *
+	 * With a huge page policy (see 'huge_pages'), allocations of at least 'huge_page_size' bytes are rounded up and aligned to huge pages,
+	 * which reduces TLB misses on big working sets. Smaller allocations always use the system page size, so they don't waste a whole huge page.
+	 * The rounding only depends on the size, so 'deallocate' unmaps exactly what was mapped without any bookkeeping.
+	 *
+	 * Each allocation is at least one page and one system call: use it as the inner resource of a pool or an arena, for big slabs.
+	 * On failure, throws std::bad_alloc. page_resource is empty, and all its instances are equivalent.
+	 */
+	template<huge_pages HugePages = huge_pages::none>
+	struct page_resource
+	{
+		/**
+		 * Size of a huge page. Define KAB_HUGE_PAGE_SIZE to override it, if the system default huge page size isn't 2MB
+		 */
+		static constexpr size_t huge_page_size = KAB_HUGE_PAGE_SIZE;
+
+		/**
+		 * Returns the size and alignment of the pages used for an allocation of 's' bytes
+		 */
+		[[nodiscard]] static size_t page_granularity(size_t s) noexcept
+		{
+			if constexpr (HugePages != huge_pages::none)
+			{
+				if (s >= huge_page_size)
+				{
+					return huge_page_size;
+				}
+			}
+			return detail::system_page_size();
+		}
+
+		/**
+		 * Returns the number of bytes mapped for an allocation of 's' bytes
+		 */
+		[[nodiscard]] static size_t mapped_size(size_t s) noexcept
+		{
+			return detail::round_up_pow2(s == 0 ? 1 : s, page_granularity(s));
+		}
+
+		/**
+		 * allocate
+		 *
+		 * An allocation of 0 bytes maps nothing, and returns an empty span
+		 */
+		[[nodiscard]] byte_span allocate(size_t size, align_t align)
+		{
+			byte_span s = over_allocate(size, align);
+			s.size = size;
+			return s;
+		}
+
+		/**
+		 * over_allocate
+		 *
+		 * Returns the whole pages mapped for the allocation
+		 */
+		[[nodiscard]] byte_span over_allocate(size_t size, align_t align)
+		{
+			if (size == 0)
+			{
+				return { nullptr, 0 };
+			}
+
+			size_t const granularity = page_granularity(size);
+			size_t const mapped = mapped_size(size);
+			size_t const alignment = static_cast<size_t>(align) > granularity ? static_cast<size_t>(align) : granularity;
+
+#if defined(MAP_HUGETLB)
+			if constexpr (HugePages == huge_pages::explicit_pages)
+			{
+				if (granularity == huge_page_size && alignment == huge_page_size)
+				{
+					void* const huge = ::mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+					if (huge != MAP_FAILED)
+					{
+						return { static_cast<byte*>(huge), mapped };
+					}
+				}
+			}
+#endif
+
+			byte* const p = detail::map_pages(mapped, alignment);
+			if (p == nullptr)
+			{
+				throw std::bad_alloc();
+			}
+
+#if defined(MADV_HUGEPAGE)
+			if (granularity != detail::system_page_size())
+			{
+				// Only a hint: the allocation is still valid if transparent huge pages are disabled
+				::madvise(p, mapped, MADV_HUGEPAGE);
+			}
+#endif
+			return { p, mapped };
+		}
+
+		/**
+		 * reallocate
+		 *
+		 * Grows the mapping with 'mremap', which moves the pages in the page table instead of copying their bytes.
+		 * Over-aligned requests and explicit huge pages can't be remapped, and fall back to a copy
+		 */
+		[[nodiscard]] byte_span reallocate(byte_span s, size_t n, align_t align)
+		{
+			if (s.size == 0)
+			{
+				return over_allocate(n, align);
+			}
+
+			size_t const old_size = mapped_size(s.size);
+			size_t const new_size = mapped_size(n);
+			if (new_size == old_size)
+			{
+				return { s.data, old_size };
+			}
+
+#if defined(MREMAP_MAYMOVE)
+			bool const remappable = static_cast<size_t>(align) <= detail::system_page_size()
+				&& (HugePages != huge_pages::explicit_pages || page_granularity(n) == detail::system_page_size());
+			if (remappable)
+			{
+				void* const p = ::mremap(s.data, old_size, new_size, MREMAP_MAYMOVE);
+				if (p != MAP_FAILED)
+				{
+#if defined(MADV_HUGEPAGE)
+					if (page_granularity(n) != detail::system_page_size())
+					{
+						::madvise(p, new_size, MADV_HUGEPAGE);
+					}
+#endif
+					return { static_cast<byte*>(p), new_size };
+				}
+			}
+#endif
+
+			byte_span const new_block = over_allocate(n, align);
+			::memcpy(new_block.data, s.data, s.size);
+			deallocate(s, align);
+			return new_block;
+		}
+
+		/**
+		 * deallocate
+		 *
+		 * Unmaps the pages. Accepts both the requested size and the size returned by 'over_allocate'
+		 */
+		void deallocate(byte_span s, align_t align) noexcept
+		{
+			(void)align;
+			if (s.size == 0)
+			{
+				return;
+			}
+			::munmap(s.data, mapped_size(s.size));
+		}
+
+		[[nodiscard]] constexpr bool operator==(page_resource const&) const noexcept
+		{
+			return true;
+		}
+	};
+#else
+#error "page_resource.h: implement non-Linux"
+#endif
+}
@@ -0,0 +1,333 @@
+#pragma once
+
+#include "kaballoc/memory/resource.h"
+#include "kaballoc/memory/byte_span.h"
+#include "kaballoc/memory/new_resource.h"
+#include "kaballoc/memory/detail/over_allocate.h"
+#include "kaballoc/memory/detail/owns.h"
+#include "kaballoc/container/flat_hash_map.h"
+#include "kaballoc/container/vector.h"
+#include "kaballoc/core/compiler.h"
+#include "kaballoc/core/platform.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <utility>
+
+#if KAB_PLATFORM_LINUX
+#include <execinfo.h>
+#endif
+
+#if !defined(KAB_PROFILE_MAX_DEPTH)
+#  define KAB_PROFILE_MAX_DEPTH 32
+#endif
+
+namespace kab
+{
+#if KAB_PLATFORM_LINUX
+	/**
+	 * Statistics of the sampled allocations of a call stack, as reported by 'profiling_resource::for_each_stack'
+	 *
+	 * The counts are raw samples: multiply by 'profiling_resource::sample_rate' / size to estimate the actual numbers, or let pprof do it
+	 */
+	struct profile_stack
+	{
+		void* const* frames;
+		size_t depth;
+		size_t live_count;
+		size_t live_bytes;
+		size_t total_count;
+		size_t total_bytes;
+	};
+
+	namespace detail
+	{
+		struct profile_stack_key
+		{
+			void* frames[KAB_PROFILE_MAX_DEPTH];
+			size_t depth;
+
+			[[nodiscard]] bool operator==(profile_stack_key const& rhs) const noexcept
+			{
+				return depth == rhs.depth && ::memcmp(frames, rhs.frames, depth * sizeof(void*)) == 0;
+			}
+		};
+
+		struct profile_stack_hash
+		{
+			[[nodiscard]] size_t operator()(profile_stack_key const& key) const noexcept
+			{
+				size_t hash = key.depth;
+				for (size_t i = 0; i < key.depth; ++i)
+				{
+					hash = (hash ^ reinterpret_cast<size_t>(key.frames[i])) * static_cast<size_t>(0x100000001B3ull);
+				}
+				return hash;
+			}
+		};
+
+		struct profile_stack_stats
+		{
+			size_t live_count = 0;
+			size_t live_bytes = 0;
+			size_t total_count = 0;
+			size_t total_bytes = 0;
+		};
+
+		struct profile_live_sample
+		{
+			size_t stack; // index in the statistics
+			size_t size;
+		};
+	}
+
+	/**
+	 * 'profiling_resource' is a memory resource which samples the allocations of an inner resource, and records the call stack of the sampled ones
+	 *
+	 * Allocations are sampled by bytes, like tcmalloc: on average, one sample is taken every 'sample_rate' allocated bytes, with exponentially distributed
+	 * intervals (a Poisson process), so allocations of every size are sampled with a probability proportional to their size, and periodic allocation
+	 * patterns don't bias the profile. An allocation which isn't sampled costs one subtraction and one comparison, and its deallocation one hash lookup
+	 * (or none, when no sampled allocation is live).
+	 *
+	 * For each call stack, the resource keeps the live samples (allocated and not yet deallocated) and the total samples (allocated since the start).
+	 * 'write_pprof' dumps them in the text format of heap profiles read by pprof, which estimates the actual allocations from the sample rate.
+	 * Stacks are captured with 'backtrace' and hold at most KAB_PROFILE_MAX_DEPTH frames, including the frames of the resource itself.
+	 *
+	 * The tables are allocated from the MetaResource, never from the inner resource, and a sample is dropped if they can't allocate.
+	 * A sample rate of 0 disables sampling.
+	 * profiling_resource forwards 'owns' when the inner resource supports it. It is moveable but not copyable, and isn't thread-safe.
+	 */
+	template<typename InnerResource, typename MetaResource = new_resource>
+	class profiling_resource : InnerResource
+	{
+		[[nodiscard]] InnerResource& access_inner() & noexcept { return static_cast<InnerResource&>(*this); }
+		[[nodiscard]] InnerResource const& access_inner() const& noexcept { return static_cast<InnerResource const&>(*this); }
+
+		// Stacks are never erased: 'm_stacks' maps a stack to the index of its statistics, and live samples keep that index
+		flat_hash_map<detail::profile_stack_key, size_t, MetaResource, detail::profile_stack_hash> m_stacks;
+		vector<detail::profile_stack_stats, MetaResource> m_stats;
+		flat_hash_map<byte*, detail::profile_live_sample, MetaResource> m_live;
+
+		int64_t m_bytes_until_sample = INT64_MAX;
+		size_t m_sample_rate = 0;
+		uint64_t m_random = 0x9E3779B97F4A7C15ull;
+
+		[[nodiscard]] int64_t next_interval() noexcept
+		{
+			if (m_sample_rate == 0)
+			{
+				return INT64_MAX;
+			}
+			// xorshift64, then the inverse of the exponential distribution with a mean of 'm_sample_rate'
+			m_random ^= m_random << 13;
+			m_random ^= m_random >> 7;
+			m_random ^= m_random << 17;
+			double const uniform = (static_cast<double>(m_random >> 11) + 1.0) / 9007199254740992.0; // (0, 1]
+			double const interval = -::log(uniform) * static_cast<double>(m_sample_rate);
+			return interval < 1.0 ? 1 : interval > 9.0e18 ? INT64_MAX : static_cast<int64_t>(interval);
+		}
+
+		// Kept out of line, so the allocation functions stay small. If the tables can't allocate, the sample is dropped
+		KAB_NOINLINE void record(byte_span s) noexcept
+		{
+			m_bytes_until_sample = next_interval();
+			if (s.data == nullptr)
+			{
+				return;
+			}
+
+			detail::profile_stack_key key;
+			int const depth = ::backtrace(key.frames, KAB_PROFILE_MAX_DEPTH);
+			key.depth = depth > 0 ? static_cast<size_t>(depth) : 0;
+
+			try
+			{
+				size_t index;
+				auto const found = m_stacks.find(key);
+				if (found != m_stacks.end())
+				{
+					index = found->second;
+				}
+				else
+				{
+					index = m_stats.size();
+					m_stats.emplace_back();
+					try
+					{
+						m_stacks.try_emplace(key, index);
+					}
+					catch (...)
+					{
+						m_stats.pop_back();
+						throw;
+					}
+				}
+				m_live.insert_or_assign(s.data, detail::profile_live_sample{ index, s.size });
+
+				detail::profile_stack_stats& stats = m_stats[index];
+				++stats.live_count;
+				stats.live_bytes += s.size;
+				++stats.total_count;
+				stats.total_bytes += s.size;
+			}
+			catch (...)
+			{
+
+			}
+		}
+
+		void forget(byte_span s) noexcept
+		{
+			auto const it = m_live.find(s.data);
+			if (it != m_live.end())
+			{
+				detail::profile_stack_stats& stats = m_stats[it->second.stack];
+				--stats.live_count;
+				stats.live_bytes -= it->second.size;
+				m_live.erase(s.data);
+			}
+		}
+
+	public:
+		profiling_resource() = default;
+		profiling_resource(InnerResource r, size_t sample_rate, MetaResource meta = MetaResource())
+			: InnerResource(std::move(r))
+			, m_stacks(meta)
+			, m_stats(meta)
+			, m_live(std::move(meta))
+			, m_sample_rate(sample_rate)
+		{
+			m_bytes_until_sample = next_interval();
+		}
+
+		[[nodiscard]] byte_span allocate(size_t size, align_t alignment)
+		{
+			byte_span const s = access_inner().allocate(size, alignment);
+			if ((m_bytes_until_sample -= static_cast<int64_t>(size)) <= 0)
+			{
+				record(s);
+			}
+			return s;
+		}
+
+		[[nodiscard]] byte_span over_allocate(size_t size, align_t alignment)
+		{
+			byte_span const s = detail::over_allocate(access_inner(), size, alignment);
+			// Counts the bytes handed out, like the recorded sample
+			if ((m_bytes_until_sample -= static_cast<int64_t>(s.size)) <= 0)
+			{
+				record(s);
+			}
+			return s;
+		}
+
+		void deallocate(byte_span s, align_t alignment)
+		{
+			if (!m_live.is_empty())
+			{
+				forget(s);
+			}
+			access_inner().deallocate(s, alignment);
+		}
+
+		void over_deallocate(byte_span s, align_t alignment)
+		{
+			if (!m_live.is_empty())
+			{
+				forget(s);
+			}
+			detail::over_deallocate(access_inner(), s, alignment);
+		}
+
+		[[nodiscard]] bool owns(byte_span s) const noexcept requires detail::has_owns_v<InnerResource>
+		{
+			return access_inner().owns(s);
+		}
+
+		/**
+		 * Returns the average number of bytes between two samples, 0 if sampling is disabled
+		 */
+		[[nodiscard]] size_t sample_rate() const noexcept { return m_sample_rate; }
+
+		/**
+		 * Changes the average number of bytes between two samples. A rate of 0 disables sampling.
+		 * The statistics are kept, but pprof only knows about a single rate, so a profile mixing rates is not accurate
+		 */
+		void set_sample_rate(size_t sample_rate) noexcept
+		{
+			m_sample_rate = sample_rate;
+			m_bytes_until_sample = next_interval();
+		}
+
+		/**
+		 * Returns the number of live sampled allocations
+		 */
+		[[nodiscard]] size_t live_samples() const noexcept { return m_live.size(); }
+
+		/**
+		 * Calls 'f' with a 'profile_stack' for each recorded call stack
+		 */
+		template<typename F>
+		void for_each_stack(F&& f) const
+		{
+			for (auto const& [key, index] : m_stacks)
+			{
+				detail::profile_stack_stats const& stats = m_stats[index];
+				f(profile_stack{ key.frames, key.depth, stats.live_count, stats.live_bytes, stats.total_count, stats.total_bytes });
+			}
+		}
+
+		/**
+		 * Writes the recorded stacks in the legacy text format of pprof heap profiles ("heap_v2"), followed by the memory mappings of the process
+		 * so pprof can symbolize the addresses:
+		 *     pprof --text <binary> <file>
+		 * Returns false if writing failed
+		 */
+		bool write_pprof(FILE* out) const
+		{
+			detail::profile_stack_stats sum;
+			for (detail::profile_stack_stats const& stats : m_stats)
+			{
+				sum.live_count += stats.live_count;
+				sum.live_bytes += stats.live_bytes;
+				sum.total_count += stats.total_count;
+				sum.total_bytes += stats.total_bytes;
+			}
+
+			bool ok = ::fprintf(out, "heap profile: %zu: %zu [%zu: %zu] @ heap_v2/%zu\n",
+				sum.live_count, sum.live_bytes, sum.total_count, sum.total_bytes, m_sample_rate) >= 0;
+			for_each_stack([&](profile_stack const& stack)
+			{
+				ok &= ::fprintf(out, "%zu: %zu [%zu: %zu] @", stack.live_count, stack.live_bytes, stack.total_count, stack.total_bytes) >= 0;
+				for (size_t i = 0; i < stack.depth; ++i)
+				{
+					ok &= ::fprintf(out, " %p", stack.frames[i]) >= 0;
+				}
+				ok &= ::fputc('\n', out) != EOF;
+			});
+
+			ok &= ::fputs("\nMAPPED_LIBRARIES:\n", out) != EOF;
+			if (FILE* const maps = ::fopen("/proc/self/maps", "r"))
+			{
+				char buffer[4096];
+				size_t read;
+				while ((read = ::fread(buffer, 1, sizeof(buffer), maps)) != 0)
+				{
+					ok &= ::fwrite(buffer, 1, read, out) == read;
+				}
+				::fclose(maps);
+			}
+			return ok && ::fflush(out) == 0;
+		}
+
+		[[nodiscard]] bool operator==(profiling_resource const& rhs) const noexcept
+		{
+			return this == &rhs;
+		}
+	};
+#else
+#error "profiling_resource.h: implement non-Linux"
+#endif
+}
@@ -93,6 +93,53 @@ namespace kab
 	 *          - Which is an optional deallocation function. If provided, the user must call this instead of 'deallocate' when using over-allocations
 	 *          - Otherwise, behaves like 'deallocate'
 	 *
+	 *  Expander
+	 *
+	 *  An expander memory resource is a memory resource that can grow an allocation in place:
+	 *      byte_span expand(byte_span s, size_t n, align_t a)
+	 *          - Where 's' is a span returned by an allocation function of this resource, or by a previous 'expand'
+	 *          - Where 'n' is the requested new size, bigger than the size of 's'
+	 *          - Where 'a' is the alignment requested on the allocation function
+	 *          - On success, returns a span with the same pointer as 's' and a size of at least 'n'. The returned span replaces 's', and
+	 *            must be given to 'over_deallocate' (or 'deallocate' if 'over_deallocate' does not exist), like an over-allocation
+	 *          - On failure, returns a span with a null pointer, and 's' is still valid. Failing is not an error: the user falls back to a new allocation
+	 *
+	 *  Reallocator
+	 *
+	 *  A reallocator memory resource is a memory resource that can grow an allocation, moving its bytes if needed:
+	 *      byte_span reallocate(byte_span s, size_t n, align_t a)
+	 *          - Which is an allocation function, behaving like 'over_allocate' followed by a copy of the bytes of 's' and a deallocation of 's'
+	 *          - Where 's' is a span returned by an allocation function of this resource
+	 *          - Where 'n' is the requested new size, bigger than the size of 's'
+	 *          - Where 'a' is the alignment requested on the allocation function
+	 *          - The returned span may have a different pointer, and a size of at least 'n'. It must be deallocated like an over-allocation
+	 *          - On failure, behaves like 'allocate', and 's' is still valid
+	 *  Since the bytes are moved without constructors, it is only meant for trivially relocatable objects.
+	 *  Resources implement it when they can avoid the copy, for example by remapping pages.
+	 *
+	 *  Trimmer
+	 *
+	 *  A trimmer memory resource is a memory resource that caches freed memory, and can give it back:
+	 *      size_t trim(size_t keep_bytes)
+	 *          - Releases cached memory (free blocks, idle pages) to the inner resource or the system, until at most 'keep_bytes' bytes stay cached
+	 *          - Returns the number of released bytes
+	 *          - Never affects live allocations
+	 *  Composite resources forward 'trim' to the resources which support it. See memory/trim.h for helpers.
+	 *
+	 *  Owner
+	 *
+	 *  An owner memory resource is a memory resource that can tell whether it allocated a span:
+	 *      bool owns(byte_span s) const noexcept
+	 *          - Where 's' is a span returned by an allocation function of any resource
+	 *          - Returns true if 's' was returned by an allocation function of this resource (or an equivalent one), and not deallocated yet
+	 *          - Must be cheap, since composite resources call it on every deallocation to find which resource to deallocate from
+	 *
+	 *  Exhaustion
+	 *
+	 *  A memory resource with a bounded capacity may report that it can't fulfill a request by returning a span with a null pointer, instead of throwing.
+	 *  Composite resources (see 'fallback_resource') treat such a span as a request to try another resource.
+	 *  Containers treat it as an allocation failure, and throw std::bad_alloc.
+	 *
 	 *  Comparison
 	 *
 	 *  An allocator may support operator== to compare two resources of the same type for equivalence. 
@@ -43,14 +43,90 @@ namespace kab
 				static_cast<Derived&>(*this).m_resource->over_deallocate(s, alignment);
 			}
 		};
+
+		template<typename Derived, typename Resource, typename = std::void_t<>>
+		struct owns_mixin
+		{
+
+		};
+
+		template<typename Derived, typename Resource>
+		struct owns_mixin<Derived, Resource
+			, std::void_t<decltype(std::declval<Resource const&>().owns(std::declval<byte_span>()))>
+		>
+		{
+			[[nodiscard]] bool owns(byte_span s) const noexcept
+			{
+				return static_cast<Derived const&>(*this).m_resource->owns(s);
+			}
+		};
+
+		template<typename Derived, typename Resource, typename = std::void_t<>>
+		struct expand_mixin
+		{
+
+		};
+
+		template<typename Derived, typename Resource>
+		struct expand_mixin<Derived, Resource
+			, std::void_t<decltype(std::declval<Resource&>().expand(std::declval<byte_span>(), std::declval<size_t>(), std::declval<align_t>()))>
+		>
+		{
+			[[nodiscard]] byte_span expand(byte_span s, size_t n, align_t alignment)
+			{
+				return static_cast<Derived&>(*this).m_resource->expand(s, n, alignment);
+			}
+		};
+
+		template<typename Derived, typename Resource, typename = std::void_t<>>
+		struct reallocate_mixin
+		{
+
+		};
+
+		template<typename Derived, typename Resource>
+		struct reallocate_mixin<Derived, Resource
+			, std::void_t<decltype(std::declval<Resource&>().reallocate(std::declval<byte_span>(), std::declval<size_t>(), std::declval<align_t>()))>
+		>
+		{
+			[[nodiscard]] byte_span reallocate(byte_span s, size_t n, align_t alignment)
+			{
+				return static_cast<Derived&>(*this).m_resource->reallocate(s, n, alignment);
+			}
+		};
+
+		template<typename Derived, typename Resource, typename = std::void_t<>>
+		struct trim_mixin
+		{
+
+		};
+
+		template<typename Derived, typename Resource>
+		struct trim_mixin<Derived, Resource
+			, std::void_t<decltype(std::declval<Resource&>().trim(std::declval<size_t>()))>
+		>
+		{
+			size_t trim(size_t keep_bytes)
+			{
+				return static_cast<Derived&>(*this).m_resource->trim(keep_bytes);
+			}
+		};
 	}
 	template<typename Resource>
 	class resource_reference :
 		public detail::over_allocate_mixin<resource_reference<Resource>, Resource>
 		, public detail::over_deallocate_mixin<resource_reference<Resource>, Resource>
+		, public detail::owns_mixin<resource_reference<Resource>, Resource>
+		, public detail::expand_mixin<resource_reference<Resource>, Resource>
+		, public detail::reallocate_mixin<resource_reference<Resource>, Resource>
+		, public detail::trim_mixin<resource_reference<Resource>, Resource>
 	{
 		friend struct detail::over_allocate_mixin<resource_reference<Resource>, Resource>;
 		friend struct detail::over_deallocate_mixin<resource_reference<Resource>, Resource>;
+		friend struct detail::owns_mixin<resource_reference<Resource>, Resource>;
+		friend struct detail::expand_mixin<resource_reference<Resource>, Resource>;
+		friend struct detail::reallocate_mixin<resource_reference<Resource>, Resource>;
+		friend struct detail::trim_mixin<resource_reference<Resource>, Resource>;
 		
 		Resource* m_resource;
 
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "kaballoc/memory/resource.h"
+#include "kaballoc/memory/byte_span.h"
+#include "kaballoc/memory/detail/owns.h"
+
+#include <stdint.h>
+#include <utility>
+
+namespace kab
+{
+	/**
+	 * 'sampled_resource' forwards one allocation out of every 'period' to the inner resource, and reports exhaustion for the others
+	 * (a span with a null pointer, see "Exhaustion" in memory/resource.h)
+	 *
+	 * It's meant as the Primary of a 'fallback_resource', to send a sampled fraction of the allocations to an expensive resource:
+	 *     fallback_resource<sampled_resource<resource_reference<guard_page_resource<>>>, new_resource>
+	 * guards one allocation out of every 'period' with guard pages, and serves the others from 'new'. Deallocations are routed with 'owns',
+	 * so the inner resource must support it. Allocations which aren't sampled only cost a decrement.
+	 *
+	 * A 'period' of 1 samples every allocation, and a period of 0 samples none.
+	 * sampled_resource has the copy and move semantics of the inner resource, and copies sample independently.
+	 */
+	template<typename InnerResource>
+	class sampled_resource : InnerResource
+	{
+		static_assert(detail::has_owns_v<InnerResource>, "The inner resource must support the 'owns' extension");
+
+		[[nodiscard]] InnerResource& access_inner() & noexcept { return static_cast<InnerResource&>(*this); }
+		[[nodiscard]] InnerResource const& access_inner() const& noexcept { return static_cast<InnerResource const&>(*this); }
+
+		uint32_t m_period = 0;
+		uint32_t m_countdown = 0;
+
+		[[nodiscard]] bool sample() noexcept
+		{
+			if (m_period == 0)
+			{
+				return false;
+			}
+			if (--m_countdown != 0)
+			{
+				return false;
+			}
+			m_countdown = m_period;
+			return true;
+		}
+
+	public:
+		sampled_resource() = default;
+		sampled_resource(InnerResource r, uint32_t period)
+			: InnerResource(std::move(r))
+			, m_period(period)
+			, m_countdown(period)
+		{
+
+		}
+
+		/**
+		 * allocate
+		 *
+		 * Allocates from the inner resource if the allocation is sampled, otherwise returns a span with a null pointer
+		 */
+		[[nodiscard]] byte_span allocate(size_t s, align_t alignment)
+		{
+			if (!sample())
+			{
+				return { nullptr, 0 };
+			}
+			return access_inner().allocate(s, alignment);
+		}
+
+		void deallocate(byte_span s, align_t alignment)
+		{
+			access_inner().deallocate(s, alignment);
+		}
+
+		[[nodiscard]] bool owns(byte_span s) const noexcept
+		{
+			return access_inner().owns(s);
+		}
+
+		/**
+		 * Changes the sampling period. The next sampled allocation is 'period' allocations away
+		 */
+		void set_period(uint32_t period) noexcept
+		{
+			m_period = period;
+			m_countdown = period;
+		}
+
+		[[nodiscard]] uint32_t period() const noexcept { return m_period; }
+
+		[[nodiscard]] constexpr bool operator==(sampled_resource const& rhs) const noexcept
+		{
+			return access_inner() == rhs.access_inner();
+		}
+	};
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "kaballoc/memory/resource.h"
+#include "kaballoc/memory/byte_span.h"
+#include "kaballoc/memory/detail/over_allocate.h"
+#include "kaballoc/memory/detail/owns.h"
+#include "kaballoc/memory/detail/trim.h"
+#include "kaballoc/memory/detail/reallocate.h"
+
+#include <assert.h>
+#include <string.h>
+#include <utility>
+
+namespace kab
+{
+	/**
+	 * 'segregator_resource' is a composite memory resource which sends allocations of at most Threshold bytes to the Small resource,
+	 * and bigger allocations to the Large resource
+	 *
+	 * Deallocations are routed with the size of the span, which the caller always provides: no header, lookup or 'owns' query is needed,
+	 * and the choice of resource is a single comparison with a constant.
+	 *
+	 * Segregators compose into a size-class tree, for example:
+	 *     segregator_resource<64, freelist_resource<R, 64>, segregator_resource<512, freelist_resource<R, 512>, R>>
+	 *
+	 * segregator_resource is an over-allocator: over-allocation functions are forwarded to the resource which serves the request.
+	 * For the routing to stay correct, the Small resource must not over-allocate past Threshold bytes (a 'freelist_resource' with a
+	 * BlockSize of Threshold is fine). The Large resource may return any size, since it only grows.
+	 *
+	 * It has the copy and move semantics of its resources, supports 'owns' if both resources do, and 'reallocate' if the Large resource does:
+	 * composing a small-block resource with a 'page_resource' gives a resource which grows big buffers by remapping pages.
+	 */
+	template<size_t Threshold, typename Small, typename Large>
+	class segregator_resource
+	{
+		[[no_unique_address]] Small m_small;
+		[[no_unique_address]] Large m_large;
+
+	public:
+		segregator_resource() = default;
+		segregator_resource(Small small, Large large)
+			: m_small(std::move(small))
+			, m_large(std::move(large))
+		{
+
+		}
+
+		/**
+		 * allocate
+		 *
+		 * Allocates from the Small resource if 's' is at most Threshold, otherwise from the Large resource
+		 */
+		[[nodiscard]] byte_span allocate(size_t s, align_t alignment)
+		{
+			if (s <= Threshold)
+			{
+				return m_small.allocate(s, alignment);
+			}
+			return m_large.allocate(s, alignment);
+		}
+
+		/**
+		 * over_allocate
+		 *
+		 * Like allocate, but the returned size can be bigger than the requested size
+		 */
+		[[nodiscard]] byte_span over_allocate(size_t s, align_t alignment)
+		{
+			if (s <= Threshold)
+			{
+				byte_span const small_span = detail::over_allocate(m_small, s, alignment);
+				assert(small_span.size <= Threshold);
+				return small_span;
+			}
+			return detail::over_allocate(m_large, s, alignment);
+		}
+
+		/**
+		 * deallocate
+		 *
+		 * Deallocates from the Small resource if the size of the span is at most Threshold, otherwise from the Large resource
+		 */
+		void deallocate(byte_span s, align_t alignment)
+		{
+			if (s.size <= Threshold)
+			{
+				m_small.deallocate(s, alignment);
+			}
+			else
+			{
+				m_large.deallocate(s, alignment);
+			}
+		}
+
+		void over_deallocate(byte_span s, align_t alignment)
+		{
+			if (s.size <= Threshold)
+			{
+				detail::over_deallocate(m_small, s, alignment);
+			}
+			else
+			{
+				detail::over_deallocate(m_large, s, alignment);
+			}
+		}
+
+		/**
+		 * reallocate
+		 *
+		 * Only available if the Large resource supports the 'reallocate' extension.
+		 * Large allocations which stay large are reallocated by the Large resource, otherwise the bytes are copied to a new allocation
+		 */
+		[[nodiscard]] byte_span reallocate(byte_span s, size_t n, align_t alignment) requires detail::has_reallocate_v<Large>
+		{
+			if (s.size > Threshold)
+			{
+				return m_large.reallocate(s, n, alignment);
+			}
+
+			byte_span const new_block = over_allocate(n, alignment);
+			if (new_block.data == nullptr)
+			{
+				return new_block; // exhaustion, 's' is still valid
+			}
+			::memcpy(new_block.data, s.data, s.size);
+			over_deallocate(s, alignment);
+			return new_block;
+		}
+
+		/**
+		 * trim
+		 *
+		 * Trims each resource which supports 'trim', which share 'keep_bytes' bytes
+		 */
+		size_t trim(size_t keep_bytes) requires (detail::has_trim_v<Small> || detail::has_trim_v<Large>)
+		{
+			return detail::trim_split(keep_bytes, m_small, m_large);
+		}
+
+		/**
+		 * owns
+		 *
+		 * Only available if both resources support the 'owns' extension
+		 */
+		[[nodiscard]] bool owns(byte_span s) const noexcept requires (detail::has_owns_v<Small> && detail::has_owns_v<Large>)
+		{
+			return s.size <= Threshold ? m_small.owns(s) : m_large.owns(s);
+		}
+
+		/**
+		 * Access the composed resources
+		 */
+		[[nodiscard]] Small& small() noexcept { return m_small; }
+		[[nodiscard]] Small const& small() const noexcept { return m_small; }
+		[[nodiscard]] Large& large() noexcept { return m_large; }
+		[[nodiscard]] Large const& large() const noexcept { return m_large; }
+
+		[[nodiscard]] constexpr bool operator==(segregator_resource const& rhs) const noexcept
+		{
+			return m_small == rhs.m_small && m_large == rhs.m_large;
+		}
+	};
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "kaballoc/memory/resource.h"
+#include "kaballoc/memory/byte_span.h"
+#include "kaballoc/memory/locked_resource.h"
+#include "kaballoc/memory/detail/owns.h"
+#include "kaballoc/memory/detail/trim.h"
+#include "kaballoc/core/cache_line.h"
+#include "kaballoc/core/platform.h"
+#include "kaballoc/core/spin_lock.h"
+
+#include <functional>
+#include <thread>
+#include <utility>
+
+#if KAB_PLATFORM_LINUX
+#include <sched.h>
+#endif
+
+namespace kab
+{
+	namespace detail
+	{
+		// Number used to pick a shard: the current CPU when the platform can tell, otherwise a hash of the thread id
+		[[nodiscard]] inline size_t current_shard_hint() noexcept
+		{
+#if KAB_PLATFORM_LINUX
+			int const cpu = ::sched_getcpu();
+			if (cpu >= 0)
+			{
+				return static_cast<size_t>(cpu);
+			}
+#endif
+			return std::hash<std::thread::id>()(std::this_thread::get_id());
+		}
+	}
+
+	/**
+	 * 'sharded_resource' is a thread-safe memory resource made of ShardCount instances of an inner resource, each behind its own Lock
+	 *
+	 * An allocation goes to the shard of the current CPU (sched_getcpu on Linux, a hash of the thread id elsewhere), so threads running on different CPUs
+	 * rarely contend on the same lock, and each shard stays in the cache of its CPU. A thread can migrate between two calls: the locks keep this safe.
+	 * Shards are aligned on cache lines to avoid false sharing.
+	 *
+	 * Deallocation has to find the shard that allocated the span:
+	 *   - if the inner resource supports 'owns', the current shard is asked first, then every other shard
+	 *   - otherwise the span goes to the current shard, so memory moves between shards. This is only valid for inner resources which can deallocate
+	 *     each other's memory, for example 'freelist_resource' over a thread-safe resource such as 'new_resource'
+	 *
+	 * Shards are default constructed, or copied from a prototype. 'owns' and 'trim' are forwarded when the inner resource supports them.
+	 * sharded_resource is neither copyable nor moveable: share it with a 'resource_reference'.
+	 */
+	template<typename InnerResource, size_t ShardCount, typename Lock = spin_lock>
+	class sharded_resource
+	{
+		static_assert(ShardCount > 0, "A sharded resource needs at least one shard");
+
+		struct alignas(cache_line_size) shard
+		{
+			locked_resource<InnerResource, Lock> resource;
+		};
+
+		shard m_shards[ShardCount];
+
+		template<size_t... Indices>
+		sharded_resource(InnerResource const& prototype, std::index_sequence<Indices...>)
+			: m_shards{ shard{ locked_resource<InnerResource, Lock>((static_cast<void>(Indices), prototype)) }... }
+		{
+
+		}
+
+		[[nodiscard]] static size_t current_shard() noexcept
+		{
+			return detail::current_shard_hint() % ShardCount;
+		}
+
+	public:
+		sharded_resource() = default;
+		/**
+		 * Constructs every shard as a copy of 'prototype'
+		 */
+		explicit sharded_resource(InnerResource const& prototype)
+			: sharded_resource(prototype, std::make_index_sequence<ShardCount>())
+		{
+
+		}
+		sharded_resource(sharded_resource const&) = delete;
+		sharded_resource& operator=(sharded_resource const&) = delete;
+
+		[[nodiscard]] byte_span allocate(size_t size, align_t alignment)
+		{
+			return m_shards[current_shard()].resource.allocate(size, alignment);
+		}
+
+		void deallocate(byte_span s, align_t alignment)
+		{
+			size_t const current = current_shard();
+			if constexpr (detail::has_owns_v<InnerResource>)
+			{
+				for (size_t i = 0; i < ShardCount; ++i)
+				{
+					locked_resource<InnerResource, Lock>& resource = m_shards[(current + i) % ShardCount].resource;
+					if (resource.owns(s))
+					{
+						resource.deallocate(s, alignment);
+						return;
+					}
+				}
+			}
+			m_shards[current].resource.deallocate(s, alignment);
+		}
+
+		[[nodiscard]] bool owns(byte_span s) const noexcept requires detail::has_owns_v<InnerResource>
+		{
+			for (shard const& sh : m_shards)
+			{
+				if (sh.resource.owns(s))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/**
+		 * Trims every shard, each keeping an equal part of what remains of 'keep_bytes', so the shards keep at most 'keep_bytes' in total.
+		 * Returns the total number of released bytes
+		 */
+		size_t trim(size_t keep_bytes) requires detail::has_trim_v<InnerResource>
+		{
+			size_t released = 0;
+			for (size_t i = 0; i < ShardCount; ++i)
+			{
+				size_t const keep = keep_bytes / (ShardCount - i);
+				keep_bytes -= keep;
+				released += m_shards[i].resource.trim(keep);
+			}
+			return released;
+		}
+
+		/**
+		 * Returns the shard at 'index', for example to inspect it or to allocate from a given shard
+		 */
+		[[nodiscard]] locked_resource<InnerResource, Lock>& shard_at(size_t index) noexcept { return m_shards[index].resource; }
+		[[nodiscard]] locked_resource<InnerResource, Lock> const& shard_at(size_t index) const noexcept { return m_shards[index].resource; }
+
+		[[nodiscard]] static constexpr size_t shard_count() noexcept { return ShardCount; }
+
+		[[nodiscard]] bool operator==(sharded_resource const& rhs) const noexcept
+		{
+			return this == &rhs;
+		}
+	};
+}
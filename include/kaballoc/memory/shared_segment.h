@@ -0,0 +1,519 @@
+#pragma once
+
+#include "kaballoc/memory/resource.h"
+#include "kaballoc/memory/byte_span.h"
+#include "kaballoc/memory/offset_ptr.h"
+#include "kaballoc/core/platform.h"
+
+#include <atomic>
+#include <new>
+#include <stdint.h>
+#include <system_error>
+#include <utility>
+
+#if KAB_PLATFORM_LINUX
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace kab
+{
+#if KAB_PLATFORM_LINUX
+	namespace detail
+	{
+		/**
+		 * A mutex on a 32-bit word which works across processes: uncontended operations are a single atomic instruction,
+		 * and contended threads sleep on a (shared) futex. 0 is unlocked, 1 is locked, 2 is locked with waiters
+		 */
+		inline void futex_lock(std::atomic<uint32_t>& word) noexcept
+		{
+			uint32_t state = 0;
+			if (word.compare_exchange_strong(state, 1, std::memory_order_acquire, std::memory_order_relaxed))
+			{
+				return;
+			}
+
+			if (state != 2)
+			{
+				state = word.exchange(2, std::memory_order_acquire);
+			}
+			while (state != 0)
+			{
+				::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, 2, nullptr, nullptr, 0);
+				state = word.exchange(2, std::memory_order_acquire);
+			}
+		}
+
+		inline void futex_unlock(std::atomic<uint32_t>& word) noexcept
+		{
+			if (word.exchange(0, std::memory_order_release) == 2)
+			{
+				::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+			}
+		}
+
+		/**
+		 * State of a shared segment, stored at its start. Every position is an offset from the header, so it's valid in every mapping
+		 *
+		 * Blocks are sized in power of two classes, from 16 bytes. Freed blocks are kept in a list per class, and reused for the same class.
+		 * Other blocks are taken from the top of the segment, moving upwards. Memory is never given back to the top.
+		 */
+		struct shared_segment_header
+		{
+			static constexpr uint64_t magic_value = 0x6B61622D73686D31ull; // "kab-shm1"
+			static constexpr size_t min_block_size = 16;
+			static constexpr size_t class_count = 48;
+
+			std::atomic<uint64_t> magic; // 'magic' and 'size' are read from the file before mapping it
+			uint64_t size;
+			std::atomic<uint32_t> lock;
+			uint64_t top;
+			std::atomic<uint64_t> root;
+			uint64_t free_lists[class_count];
+
+			static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t), "the header is read from files");
+			static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free, "shared atomics must be lock-free");
+
+			[[nodiscard]] static size_t size_class(size_t n) noexcept
+			{
+				size_t c = 0;
+				while (c < class_count && (min_block_size << c) < n)
+				{
+					++c;
+				}
+				return c;
+			}
+
+			[[nodiscard]] static size_t data_offset() noexcept
+			{
+				return (sizeof(shared_segment_header) + 63) & ~size_t(63);
+			}
+
+			[[nodiscard]] byte* base() noexcept { return reinterpret_cast<byte*>(this); }
+
+			[[nodiscard]] byte_span allocate(size_t n, size_t alignment)
+			{
+				if (n == 0)
+				{
+					return { nullptr, 0 };
+				}
+
+				size_t const c = size_class(n > alignment ? n : alignment);
+				if (c >= class_count)
+				{
+					throw std::bad_alloc();
+				}
+				size_t const block_size = min_block_size << c;
+				size_t const block_align = alignment > min_block_size ? alignment : min_block_size;
+
+				futex_lock(lock);
+				uint64_t offset = free_lists[c];
+				if (offset != 0 && offset % block_align == 0)
+				{
+					free_lists[c] = *reinterpret_cast<uint64_t*>(base() + offset);
+				}
+				else
+				{
+					offset = (top + block_align - 1) & ~static_cast<uint64_t>(block_align - 1);
+					if (offset > size || size - offset < block_size)
+					{
+						futex_unlock(lock);
+						throw std::bad_alloc();
+					}
+					top = offset + block_size;
+				}
+				futex_unlock(lock);
+
+				return { base() + offset, block_size };
+			}
+
+			void deallocate(byte_span s, size_t alignment) noexcept
+			{
+				if (s.size == 0)
+				{
+					return;
+				}
+
+				size_t const c = size_class(s.size > alignment ? s.size : alignment);
+				uint64_t const offset = static_cast<uint64_t>(s.data - base());
+
+				futex_lock(lock);
+				*reinterpret_cast<uint64_t*>(s.data) = free_lists[c];
+				free_lists[c] = offset;
+				futex_unlock(lock);
+			}
+		};
+	}
+
+	/**
+	 * 'shared_segment_resource' allocates from a shared memory segment (see 'shared_segment')
+	 *
+	 * It only stores an offset to the segment, so the resource itself can be stored in the segment, for example in a container
+	 * shared with other processes: it stays valid in every process mapping the segment, at any address.
+	 * A resource stored outside of the segment is only valid in the process which made it.
+	 *
+	 * Allocations are thread-safe and process-safe, guarded by a futex stored in the segment. Sizes are rounded up to powers of two,
+	 * and 'over_allocate' returns the whole block. When the segment is full, throws std::bad_alloc.
+	 *
+	 * Two resources are equivalent if they use the same segment. shared_segment_resource supports the 'owns' extension.
+	 */
+	class shared_segment_resource
+	{
+		offset_ptr<detail::shared_segment_header> m_header;
+
+	public:
+		shared_segment_resource() = default;
+		explicit shared_segment_resource(detail::shared_segment_header* header) noexcept
+			: m_header(header)
+		{
+
+		}
+
+		[[nodiscard]] byte_span allocate(size_t size, align_t align)
+		{
+			byte_span s = m_header->allocate(size, static_cast<size_t>(align));
+			s.size = size;
+			return s;
+		}
+
+		[[nodiscard]] byte_span over_allocate(size_t size, align_t align)
+		{
+			return m_header->allocate(size, static_cast<size_t>(align));
+		}
+
+		void deallocate(byte_span s, align_t align) noexcept
+		{
+			m_header->deallocate(s, static_cast<size_t>(align));
+		}
+
+		[[nodiscard]] bool owns(byte_span s) const noexcept
+		{
+			byte* const base = reinterpret_cast<byte*>(m_header.get());
+			return base != nullptr && s.data >= base && s.data < base + m_header->size;
+		}
+
+		[[nodiscard]] bool operator==(shared_segment_resource const& rhs) const noexcept
+		{
+			return m_header == rhs.m_header;
+		}
+	};
+
+	/**
+	 * How a 'shared_segment' is mapped. A read-only segment can't be allocated from, nor modified
+	 */
+	enum class segment_access : unsigned char
+	{
+		read_write,
+		read_only,
+	};
+
+	/**
+	 * 'shared_segment' maps a shared memory segment, which several processes can map at the same time
+	 *
+	 * A named segment is made with 'create' and mapped by other processes with 'open'. An anonymous segment ('create_anonymous') is backed by a memfd,
+	 * and is shared by passing its file descriptor, or by forking. Every process may map the segment at a different address: objects stored in the segment
+	 * must only use offsets to refer to each other, for example with 'offset_ptr', 'offset_vector' and 'offset_array_value'.
+	 *
+	 * 'resource' returns the memory resource allocating from the segment. The segment has one "root" pointer, which a producer sets to
+	 * the top-level object it built, and consumers read to find it.
+	 *
+	 * A segment can also be backed by a file ('create_file'), which persists the objects it holds: reopening the file with 'open_file' maps them back
+	 * without parsing nor rebuilding anything, and 'root' recovers the top-level object. Every process mapping the same file shares its pages in the page cache.
+	 * Only position-independent objects can be stored: trivially copyable types without pointers, and offset containers.
+	 * The allocator's lock is stored in the file, so a file must not be reopened after a process crashed while allocating from it.
+	 *
+	 * The segment object owns the mapping, not the shared memory: it is unmapped on destruction, and a named segment lives until 'unlink'.
+	 * Objects in the segment are never destroyed automatically. On failure, functions throw std::system_error.
+	 */
+	class shared_segment
+	{
+		detail::shared_segment_header* m_header = nullptr;
+		size_t m_size = 0;
+		int m_fd = -1;
+
+		[[noreturn]] static void throw_errno(char const* what)
+		{
+			throw std::system_error(errno, std::generic_category(), what);
+		}
+
+		// Checks the size of a new segment before anything is created
+		static void check_size(size_t size)
+		{
+			if (size < detail::shared_segment_header::data_offset())
+			{
+				errno = EINVAL;
+				throw_errno("shared_segment: size too small for a segment");
+			}
+		}
+
+		// Takes ownership of 'fd' (closed on failure), maps it, and initializes the header if 'size' is not 0
+		static shared_segment map_fd(int fd, size_t size, segment_access access = segment_access::read_write)
+		{
+			shared_segment segment;
+			segment.m_fd = fd;
+
+			bool const initialize = size != 0;
+			if (initialize)
+			{
+				if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+				{
+					throw_errno("shared_segment: ftruncate");
+				}
+			}
+			else
+			{
+				struct stat info;
+				if (::fstat(fd, &info) != 0)
+				{
+					throw_errno("shared_segment: fstat");
+				}
+
+				// Validates the header before mapping: a truncated file would fault when accessed past its end
+				uint64_t prefix[2]; // magic and size
+				if (static_cast<size_t>(info.st_size) < detail::shared_segment_header::data_offset()
+					|| ::pread(fd, prefix, sizeof(prefix), 0) != static_cast<ssize_t>(sizeof(prefix))
+					|| prefix[0] != detail::shared_segment_header::magic_value
+					|| prefix[1] < detail::shared_segment_header::data_offset()
+					|| prefix[1] > static_cast<uint64_t>(info.st_size))
+				{
+					errno = EINVAL;
+					throw_errno("shared_segment: not a segment");
+				}
+				size = static_cast<size_t>(prefix[1]);
+			}
+
+			int const protection = access == segment_access::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+			void* const p = ::mmap(nullptr, size, protection, MAP_SHARED, fd, 0);
+			if (p == MAP_FAILED)
+			{
+				throw_errno("shared_segment: mmap");
+			}
+			segment.m_header = static_cast<detail::shared_segment_header*>(p);
+			segment.m_size = size;
+
+			if (initialize)
+			{
+				detail::shared_segment_header* const h = new(p) detail::shared_segment_header{};
+				h->size = size;
+				h->top = detail::shared_segment_header::data_offset();
+				h->magic.store(detail::shared_segment_header::magic_value, std::memory_order_release);
+			}
+			else if (segment.m_header->magic.load(std::memory_order_acquire) != detail::shared_segment_header::magic_value)
+			{
+				errno = EINVAL;
+				throw_errno("shared_segment: not a segment");
+			}
+			return segment;
+		}
+
+	public:
+		shared_segment() = default;
+		shared_segment(shared_segment const&) = delete;
+		shared_segment& operator=(shared_segment const&) = delete;
+		shared_segment(shared_segment && rhs) noexcept
+			: m_header(std::exchange(rhs.m_header, nullptr))
+			, m_size(std::exchange(rhs.m_size, 0))
+			, m_fd(std::exchange(rhs.m_fd, -1))
+		{
+
+		}
+		shared_segment& operator=(shared_segment && rhs) noexcept
+		{
+			if (this != &rhs)
+			{
+				close();
+				m_header = std::exchange(rhs.m_header, nullptr);
+				m_size = std::exchange(rhs.m_size, 0);
+				m_fd = std::exchange(rhs.m_fd, -1);
+			}
+			return *this;
+		}
+		~shared_segment()
+		{
+			close();
+		}
+
+		/**
+		 * Creates a named segment of 'size' bytes. Fails if a segment with this name already exists
+		 */
+		[[nodiscard]] static shared_segment create(char const* name, size_t size)
+		{
+			check_size(size);
+
+			int const fd = ::shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+			if (fd < 0)
+			{
+				throw_errno("shared_segment: shm_open");
+			}
+
+			try
+			{
+				return map_fd(fd, size);
+			}
+			catch (...)
+			{
+				::shm_unlink(name);
+				throw;
+			}
+		}
+
+		/**
+		 * Creates an anonymous segment of 'size' bytes, shared through its file descriptor (see 'fd')
+		 */
+		[[nodiscard]] static shared_segment create_anonymous(size_t size)
+		{
+			check_size(size);
+
+			int const fd = ::memfd_create("kab_shared_segment", MFD_CLOEXEC);
+			if (fd < 0)
+			{
+				throw_errno("shared_segment: memfd_create");
+			}
+			return map_fd(fd, size);
+		}
+
+		/**
+		 * Maps an existing named segment
+		 */
+		[[nodiscard]] static shared_segment open(char const* name)
+		{
+			int const fd = ::shm_open(name, O_RDWR, 0);
+			if (fd < 0)
+			{
+				throw_errno("shared_segment: shm_open");
+			}
+			return map_fd(fd, 0);
+		}
+
+		/**
+		 * Maps an existing segment from a file descriptor, for example received from another process. The descriptor is duplicated
+		 */
+		[[nodiscard]] static shared_segment open_fd(int fd)
+		{
+			int const own_fd = ::fcntl(fd, F_DUPFD_CLOEXEC, 0);
+			if (own_fd < 0)
+			{
+				throw_errno("shared_segment: dup");
+			}
+			return map_fd(own_fd, 0);
+		}
+
+		/**
+		 * Creates a segment of 'size' bytes backed by a new file. Fails if the file already exists
+		 */
+		[[nodiscard]] static shared_segment create_file(char const* path, size_t size)
+		{
+			check_size(size);
+
+			int const fd = ::open(path, O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0644);
+			if (fd < 0)
+			{
+				throw_errno("shared_segment: open");
+			}
+
+			try
+			{
+				return map_fd(fd, size);
+			}
+			catch (...)
+			{
+				::unlink(path);
+				throw;
+			}
+		}
+
+		/**
+		 * Maps a segment file made by 'create_file'. Its objects are found back through 'root'
+		 */
+		[[nodiscard]] static shared_segment open_file(char const* path, segment_access access = segment_access::read_write)
+		{
+			int const fd = ::open(path, (access == segment_access::read_only ? O_RDONLY : O_RDWR) | O_CLOEXEC);
+			if (fd < 0)
+			{
+				throw_errno("shared_segment: open");
+			}
+			return map_fd(fd, 0, access);
+		}
+
+		/**
+		 * Writes the modified pages of a file-backed segment to the file, and waits for the write to complete
+		 */
+		void flush()
+		{
+			if (::msync(m_header, m_size, MS_SYNC) != 0)
+			{
+				throw_errno("shared_segment: msync");
+			}
+		}
+
+		/**
+		 * Removes the name of a segment. The memory is freed when the last mapping is closed
+		 */
+		static bool unlink(char const* name) noexcept
+		{
+			return ::shm_unlink(name) == 0;
+		}
+
+		/**
+		 * Unmaps the segment
+		 */
+		void close() noexcept
+		{
+			if (m_header != nullptr)
+			{
+				::munmap(m_header, m_size);
+			}
+			if (m_fd >= 0)
+			{
+				::close(m_fd);
+			}
+			m_header = nullptr;
+			m_size = 0;
+			m_fd = -1;
+		}
+
+		/**
+		 * Returns the resource allocating from this segment
+		 */
+		[[nodiscard]] shared_segment_resource resource() const noexcept { return shared_segment_resource(m_header); }
+
+		/**
+		 * Returns the root object of the segment, or nullptr if there's none
+		 */
+		template<typename T>
+		[[nodiscard]] T* root() const noexcept
+		{
+			uint64_t const offset = m_header->root.load(std::memory_order_acquire);
+			return offset == 0 ? nullptr : reinterpret_cast<T*>(reinterpret_cast<byte*>(m_header) + offset);
+		}
+
+		/**
+		 * Publishes the root object of the segment. 'p' must point into the segment, or be nullptr
+		 * Everything written to the segment before is visible to the processes which read the new root
+		 */
+		template<typename T>
+		void set_root(T* p) noexcept
+		{
+			uint64_t const offset = p == nullptr ? 0 : static_cast<uint64_t>(reinterpret_cast<byte*>(p) - reinterpret_cast<byte*>(m_header));
+			m_header->root.store(offset, std::memory_order_release);
+		}
+
+		/**
+		 * Returns the file descriptor of the segment
+		 */
+		[[nodiscard]] int fd() const noexcept { return m_fd; }
+
+		/**
+		 * Returns the mapped bytes of the segment
+		 */
+		[[nodiscard]] byte_span bytes() const noexcept { return { reinterpret_cast<byte*>(m_header), m_size }; }
+	};
+#else
+#error "shared_segment.h: implement non-Linux"
+#endif
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "kaballoc/memory/resource.h"
+#include "kaballoc/memory/byte_span.h"
+
+#include <stdint.h>
+
+namespace kab
+{
+	/**
+	 * 'static_resource' is a memory resource allocating from a buffer stored in the resource itself, for example on the stack
+	 *
+	 * Allocations are taken from the buffer in order, moving upwards. On deallocation, the memory is only reclaimed if it is at the top of the buffer,
+	 * so the buffer is reusable when allocations are freed in reverse order.
+	 * Otherwise, and for the padding inserted to align an allocation, memory is only reclaimed by 'clear'.
+	 *
+	 * When the buffer can't fit an allocation, the resource returns a span with a null pointer (see "Exhaustion" in memory/resource.h),
+	 * so it is usually the primary resource of a 'fallback_resource'.
+	 *
+	 * static_resource supports the 'owns' extension. It is neither copyable nor moveable, since the allocations point into the object:
+	 * use a 'resource_reference' to share it with containers.
+	 */
+	template<size_t Size, align_t Alignment = default_align_v>
+	class static_resource
+	{
+		static_assert(is_power_of_two(static_cast<size_t>(Alignment)), "Alignment must be a power of two");
+
+		alignas(static_cast<size_t>(Alignment)) byte m_buffer[Size];
+		size_t m_top = 0;
+
+	public:
+		static_resource() = default;
+		static_resource(static_resource const&) = delete;
+		static_resource& operator=(static_resource const&) = delete;
+
+		/**
+		 * allocate
+		 *
+		 * Returns the next 's' bytes of the buffer, aligned on 'alignment', or a span with a null pointer if they don't fit
+		 */
+		[[nodiscard]] byte_span allocate(size_t s, align_t alignment) noexcept
+		{
+			size_t const align = static_cast<size_t>(alignment);
+			uintptr_t const base = reinterpret_cast<uintptr_t>(m_buffer);
+			size_t const offset = static_cast<size_t>(((base + m_top + align - 1) & ~static_cast<uintptr_t>(align - 1)) - base);
+			if (offset > Size || Size - offset < s)
+			{
+				return { nullptr, 0 };
+			}
+
+			m_top = offset + s;
+			return { m_buffer + offset, s };
+		}
+
+		/**
+		 * deallocate
+		 *
+		 * Reclaims the memory if it is at the top of the buffer
+		 */
+		void deallocate(byte_span s, align_t alignment) noexcept
+		{
+			(void)alignment;
+			if (s.data + s.size == m_buffer + m_top)
+			{
+				m_top = static_cast<size_t>(s.data - m_buffer);
+			}
+		}
+
+		/**
+		 * owns
+		 *
+		 * Returns whether the span points into the buffer
+		 */
+		[[nodiscard]] bool owns(byte_span s) const noexcept
+		{
+			uintptr_t const p = reinterpret_cast<uintptr_t>(s.data);
+			uintptr_t const base = reinterpret_cast<uintptr_t>(m_buffer);
+			return p >= base && p < base + Size;
+		}
+
+		/**
+		 * Returns the number of bytes between the start of the buffer and the top of the last allocation
+		 */
+		[[nodiscard]] size_t used() const noexcept { return m_top; }
+
+		/**
+		 * Returns the size of the buffer
+		 */
+		[[nodiscard]] static constexpr size_t capacity() noexcept { return Size; }
+
+		/**
+		 * Makes the whole buffer available again
+		 * Every allocation must have been deallocated, or not be used anymore
+		 */
+		void clear() noexcept { m_top = 0; }
+
+		[[nodiscard]] bool operator==(static_resource const& rhs) const noexcept
+		{
+			return this == &rhs;
+		}
+	};
+}
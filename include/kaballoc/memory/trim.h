@@ -0,0 +1,75 @@
+#pragma once
+
+#include "kaballoc/memory/detail/trim.h"
+
+#include <chrono>
+
+namespace kab
+{
+	/**
+	 * Gives the memory cached by 'resource' back, until at most 'keep_bytes' bytes stay cached. Returns the number of released bytes.
+	 * Does nothing for resources which don't support the 'trim' extension (see memory/resource.h).
+	 *
+	 * Call it with 'keep_bytes' of 0 when the process is under memory pressure, for example on a cgroup memory notification.
+	 */
+	template<typename MemoryResource>
+	size_t trim(MemoryResource& resource, size_t keep_bytes = 0)
+	{
+		return detail::trim(resource, keep_bytes);
+	}
+
+	/**
+	 * 'periodic_trimmer' trims a resource when it's polled, at most once per 'interval'
+	 *
+	 * It's meant to be polled from a loop which already runs regularly (an event loop, a frame, a housekeeping timer), so that memory cached during a burst
+	 * is given back once the burst is over, without trimming on every deallocation. The trimmer doesn't own the resource and isn't thread-safe:
+	 * poll it from the thread which uses the resource.
+	 */
+	class periodic_trimmer
+	{
+	public:
+		using clock = std::chrono::steady_clock;
+
+	private:
+		clock::duration m_interval;
+		size_t m_keep_bytes;
+		clock::time_point m_last_trim;
+
+	public:
+		/**
+		 * 'keep_bytes' is given to each 'trim'. The first trim happens 'interval' after construction
+		 */
+		periodic_trimmer(clock::duration interval, size_t keep_bytes, clock::time_point now = clock::now()) noexcept
+			: m_interval(interval)
+			, m_keep_bytes(keep_bytes)
+			, m_last_trim(now)
+		{
+
+		}
+
+		/**
+		 * Trims 'resource' if 'interval' elapsed since the last trim. Returns the number of released bytes
+		 */
+		template<typename MemoryResource>
+		size_t poll(MemoryResource& resource, clock::time_point now = clock::now())
+		{
+			if (now - m_last_trim < m_interval)
+			{
+				return 0;
+			}
+
+			m_last_trim = now;
+			return detail::trim(resource, m_keep_bytes);
+		}
+
+		/**
+		 * Trims 'resource' now, keeping nothing cached, and restarts the interval. Returns the number of released bytes
+		 */
+		template<typename MemoryResource>
+		size_t on_pressure(MemoryResource& resource, clock::time_point now = clock::now())
+		{
+			m_last_trim = now;
+			return detail::trim(resource, 0);
+		}
+	};
+}
@@ -0,0 +1,293 @@
+#pragma once
+
+#include "kaballoc/memory/resource.h"
+#include "kaballoc/memory/byte_span.h"
+#include "kaballoc/memory/page_resource.h"
+
+#include <new>
+#include <stdint.h>
+#include <utility>
+
+namespace kab
+{
+	/**
+	 * 'virtual_arena_resource' reserves a big range of virtual addresses up front, and commits physical pages on demand as it allocates
+	 *
+	 * Reserving address space is cheap: no memory is used until the pages are committed, so the reservation can be much bigger than
+	 * the expected use, up to hundreds of GB on 64-bit systems.
+	 * Allocations are taken from the range in order, moving upwards. On deallocation, the memory is only reclaimed if it is at the top,
+	 * otherwise it is only reclaimed by 'clear'.
+	 *
+	 * The arena supports the 'expand' extension: the top allocation can always grow in place, until the reservation is exhausted.
+	 * A 'vector' using the arena (through a 'resource_reference') never relocates its elements while it is the last allocation,
+	 * so growing doesn't need twice the memory, nor copying.
+	 *
+	 * Pages are committed by chunks of 'commit_granularity' bytes, to limit the number of system calls. 'decommit' gives the pages above the top back to the system.
+	 * When the reservation is exhausted, allocation functions return a span with a null pointer (see "Exhaustion" in memory/resource.h).
+	 *
+	 * virtual_arena_resource supports the 'owns' extension. It is moveable but not copyable, and the moved-from arena has no reservation.
+	 */
+	class virtual_arena_resource
+	{
+		byte* m_base = nullptr;
+		size_t m_reserved = 0;
+		size_t m_committed = 0;
+		size_t m_top = 0;
+		size_t m_commit_granularity = 0;
+
+		// Makes [0, end) accessible. 'end' must be within the reservation
+		[[nodiscard]] bool commit_to(size_t end) noexcept
+		{
+			if (end <= m_committed)
+			{
+				return true;
+			}
+
+			size_t new_committed = detail::round_up_pow2(end, m_commit_granularity);
+			if (new_committed > m_reserved)
+			{
+				new_committed = m_reserved;
+			}
+			if (::mprotect(m_base + m_committed, new_committed - m_committed, PROT_READ | PROT_WRITE) != 0)
+			{
+				return false;
+			}
+			m_committed = new_committed;
+			return true;
+		}
+
+		// The base is only aligned on pages: the address is aligned, not the offset
+		[[nodiscard]] size_t aligned_top(size_t alignment) const noexcept
+		{
+			uintptr_t const base = reinterpret_cast<uintptr_t>(m_base);
+			return static_cast<size_t>(detail::round_up_pow2(base + m_top, alignment) - base);
+		}
+
+	public:
+		static constexpr size_t default_commit_granularity = 64 * 1024;
+
+		virtual_arena_resource() = default;
+
+		/**
+		 * Reserves 'reserve_size' bytes of address space, rounded up to whole pages. No page is committed yet.
+		 * 'commit_granularity' is rounded up to a power of two, and at least the page size.
+		 * Throws std::bad_alloc if the address space can't be reserved
+		 */
+		explicit virtual_arena_resource(size_t reserve_size, size_t commit_granularity = default_commit_granularity)
+		{
+			size_t const page_size = detail::system_page_size();
+			m_commit_granularity = page_size;
+			while (m_commit_granularity < commit_granularity)
+			{
+				m_commit_granularity *= 2;
+			}
+
+			size_t const size = detail::round_up_pow2(reserve_size, page_size);
+			void* const p = ::mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+			if (p == MAP_FAILED)
+			{
+				throw std::bad_alloc();
+			}
+			m_base = static_cast<byte*>(p);
+			m_reserved = size;
+		}
+		virtual_arena_resource(virtual_arena_resource const&) = delete;
+		virtual_arena_resource& operator=(virtual_arena_resource const&) = delete;
+		virtual_arena_resource(virtual_arena_resource && rhs) noexcept
+			: m_base(std::exchange(rhs.m_base, nullptr))
+			, m_reserved(std::exchange(rhs.m_reserved, 0))
+			, m_committed(std::exchange(rhs.m_committed, 0))
+			, m_top(std::exchange(rhs.m_top, 0))
+			, m_commit_granularity(rhs.m_commit_granularity)
+		{
+
+		}
+		virtual_arena_resource& operator=(virtual_arena_resource && rhs) noexcept
+		{
+			if (this != &rhs)
+			{
+				release();
+				m_base = std::exchange(rhs.m_base, nullptr);
+				m_reserved = std::exchange(rhs.m_reserved, 0);
+				m_committed = std::exchange(rhs.m_committed, 0);
+				m_top = std::exchange(rhs.m_top, 0);
+				m_commit_granularity = rhs.m_commit_granularity;
+			}
+			return *this;
+		}
+		~virtual_arena_resource()
+		{
+			release();
+		}
+
+		/**
+		 * allocate
+		 *
+		 * Returns the next 's' bytes of the reservation, aligned on 'alignment', committing pages if needed.
+		 * Returns a span with a null pointer if the reservation is exhausted, or if the pages can't be committed
+		 */
+		[[nodiscard]] byte_span allocate(size_t s, align_t alignment) noexcept
+		{
+			size_t const offset = aligned_top(static_cast<size_t>(alignment));
+			if (offset > m_reserved || m_reserved - offset < s || !commit_to(offset + s))
+			{
+				return { nullptr, 0 };
+			}
+
+			m_top = offset + s;
+			return { m_base + offset, s };
+		}
+
+		/**
+		 * over_allocate
+		 *
+		 * Like allocate, but the returned span extends to the end of the committed pages
+		 */
+		[[nodiscard]] byte_span over_allocate(size_t s, align_t alignment) noexcept
+		{
+			byte_span const allocation = allocate(s, alignment);
+			if (allocation.data == nullptr)
+			{
+				return allocation;
+			}
+
+			m_top = m_committed;
+			return { allocation.data, static_cast<size_t>(m_base + m_committed - allocation.data) };
+		}
+
+		/**
+		 * expand
+		 *
+		 * Grows the allocation in place if it is the top allocation and the reservation has enough space left.
+		 * The returned span extends to the end of the committed pages
+		 */
+		[[nodiscard]] byte_span expand(byte_span s, size_t n, align_t alignment) noexcept
+		{
+			(void)alignment;
+			if (s.data + s.size != m_base + m_top)
+			{
+				return { nullptr, 0 };
+			}
+
+			size_t const offset = static_cast<size_t>(s.data - m_base);
+			if (m_reserved - offset < n || !commit_to(offset + n))
+			{
+				return { nullptr, 0 };
+			}
+
+			m_top = m_committed;
+			return { s.data, m_committed - offset };
+		}
+
+		/**
+		 * deallocate
+		 *
+		 * Reclaims the memory if it is at the top. The pages stay committed until 'decommit'
+		 */
+		void deallocate(byte_span s, align_t alignment) noexcept
+		{
+			(void)alignment;
+			if (s.size != 0 && s.data + s.size == m_base + m_top)
+			{
+				m_top = static_cast<size_t>(s.data - m_base);
+			}
+		}
+
+		/**
+		 * owns
+		 *
+		 * Returns whether the span points into the reservation
+		 */
+		[[nodiscard]] bool owns(byte_span s) const noexcept
+		{
+			return s.data >= m_base && s.data < m_base + m_reserved;
+		}
+
+		/**
+		 * Gives the committed pages above the top back to the system. Their addresses stay reserved, and are committed again on demand
+		 */
+		void decommit() noexcept
+		{
+			size_t const keep = detail::round_up_pow2(m_top, detail::system_page_size());
+			if (keep >= m_committed)
+			{
+				return;
+			}
+
+			::madvise(m_base + keep, m_committed - keep, MADV_DONTNEED);
+			::mprotect(m_base + keep, m_committed - keep, PROT_NONE);
+			m_committed = keep;
+		}
+
+		/**
+		 * trim
+		 *
+		 * Tells the system that the committed pages above the top, after the first 'keep_bytes' bytes, are idle (MADV_FREE).
+		 * The pages stay committed: the system reclaims them lazily under memory pressure, and they read as zeroes if it did.
+		 * Returns the number of bytes marked idle
+		 */
+		size_t trim(size_t keep_bytes) noexcept
+		{
+			size_t const page_size = detail::system_page_size();
+			size_t const top = detail::round_up_pow2(m_top, page_size);
+			if (top >= m_committed || m_committed - top <= keep_bytes)
+			{
+				return 0;
+			}
+
+			size_t const start = top + detail::round_up_pow2(keep_bytes, page_size);
+			if (start >= m_committed)
+			{
+				return 0;
+			}
+#if defined(MADV_FREE)
+			::madvise(m_base + start, m_committed - start, MADV_FREE);
+#else
+			::madvise(m_base + start, m_committed - start, MADV_DONTNEED);
+#endif
+			return m_committed - start;
+		}
+
+		/**
+		 * Makes the whole reservation available again. The pages stay committed until 'decommit'
+		 * Every allocation must have been deallocated, or not be used anymore
+		 */
+		void clear() noexcept { m_top = 0; }
+
+		/**
+		 * Unmaps the reservation. The arena can't allocate anymore
+		 * Every allocation must have been deallocated, or not be used anymore
+		 */
+		void release() noexcept
+		{
+			if (m_base != nullptr)
+			{
+				::munmap(m_base, m_reserved);
+			}
+			m_base = nullptr;
+			m_reserved = 0;
+			m_committed = 0;
+			m_top = 0;
+		}
+
+		/**
+		 * Returns the number of bytes between the start of the reservation and the top of the last allocation
+		 */
+		[[nodiscard]] size_t used() const noexcept { return m_top; }
+
+		/**
+		 * Returns the number of committed bytes
+		 */
+		[[nodiscard]] size_t committed() const noexcept { return m_committed; }
+
+		/**
+		 * Returns the number of reserved bytes
+		 */
+		[[nodiscard]] size_t reserved() const noexcept { return m_reserved; }
+
+		[[nodiscard]] bool operator==(virtual_arena_resource const& rhs) const noexcept
+		{
+			return this == &rhs;
+		}
+	};
+}
@@ -8,18 +8,26 @@ namespace kab::range
 	{
 		struct begin_invoker
 		{
+			// The member function is preferred over the ADL function (the 'int' overload is a better match for 0),
+			// since ranges that have both would otherwise be ambiguous, for example when std is an associated namespace
 			template<typename Range>
-			auto operator()(Range&& r) const noexcept -> decltype(r.begin())
+			static auto invoke(Range&& r, int) noexcept -> decltype(r.begin())
 			{
 				return r.begin();
 			}
 
 			template<typename Range>
-			auto operator()(Range&& r) const noexcept -> decltype(begin(r))
+			static auto invoke(Range&& r, long) noexcept -> decltype(begin(r))
 			{
 				return begin(r);
 			}
 
+			template<typename Range>
+			auto operator()(Range&& r) const noexcept -> decltype(invoke(r, 0))
+			{
+				return invoke(r, 0);
+			}
+
 			template<typename T, size_t N>
 			auto operator()(T(&arr)[N]) const noexcept -> T*
 			{
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "kaballoc/trait/relocatable.h"
+#include "kaballoc/memory/memory_common.h"
+
+#include <string.h>
+#include <utility>
+
+namespace kab::range::detail
+{
+	// Size of the stack buffers used to move trivially relocatable objects around
+	inline constexpr size_t relocate_buffer_size = 256;
+
+	// Number of T that fit in a relocation buffer. Always at least one
+	template<typename T>
+	inline constexpr size_t relocate_buffer_count = sizeof(T) < relocate_buffer_size ? relocate_buffer_size / sizeof(T) : 1;
+
+	/**
+	 * Swaps two objects. Trivially relocatable objects are swapped by copying their bytes, 
+	 * without calling any move constructor, move assignment or destructor
+	 */
+	template<typename T>
+	void relocate_swap(T& a, T& b) noexcept(is_trivially_relocatable_v<T> || std::is_nothrow_swappable_v<T>)
+	{
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			alignas(T) byte buffer[sizeof(T)];
+			memcpy(buffer, &a, sizeof(T));
+			memcpy(static_cast<void*>(&a), &b, sizeof(T));
+			memcpy(static_cast<void*>(&b), buffer, sizeof(T));
+		}
+		else
+		{
+			using std::swap;
+			swap(a, b);
+		}
+	}
+}
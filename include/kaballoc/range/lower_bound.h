@@ -0,0 +1,38 @@
+#pragma once
+
+#include "kaballoc/range/detail/distance.h"
+#include "kaballoc/core/size_t.h"
+
+#include <functional>
+
+namespace kab::range
+{
+	/**
+	 * lower_bound
+	 *
+	 * Returns a pointer to the first element of the sorted range [first, last) which is not ordered before 'value', or 'last' if there's none.
+	 *
+	 * The search halves the range without branching on the comparison: the comparison result only selects the next base pointer,
+	 * which compilers turn into a conditional move. The loop runs the same number of iterations for every value,
+	 * so there are no mispredicted branches, at the cost of not stopping early
+	 */
+	template<typename T, typename Value, typename Compare = std::less<>>
+	T* lower_bound(T* first, T* last, Value const& value, Compare comp = Compare())
+	{
+		size_t n = static_cast<size_t>(range::distance(first, last));
+		if (n == 0)
+		{
+			return first;
+		}
+
+		T* base = first;
+		while (n > 1)
+		{
+			size_t const half = n / 2;
+			base = comp(base[half], value) ? base + half : base;
+			n -= half;
+		}
+
+		return base + static_cast<size_t>(comp(*base, value));
+	}
+}
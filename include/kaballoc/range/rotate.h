@@ -0,0 +1,71 @@
+#pragma once
+
+#include "kaballoc/range/swap_ranges.h"
+#include "kaballoc/range/detail/relocate_swap.h"
+#include "kaballoc/range/detail/distance.h"
+
+#include <algorithm>
+
+namespace kab::range
+{
+	/**
+	 * rotate
+	 *
+	 * Rotates [first, last) so that 'middle' becomes the new first element. Returns the new position of the element pointed by 'first'
+	 *
+	 * For trivially relocatable elements, the smaller side is copied to a stack buffer if it fits, and the bigger side is moved with a single memmove.
+	 * Otherwise, the sides are exchanged by blocks with 'swap_ranges'. Other elements use std::rotate
+	 */
+	template<typename T>
+	T* rotate(T* first, T* middle, T* last)
+	{
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			T* const result = first + range::distance(middle, last);
+
+			constexpr size_t buffer_count = detail::relocate_buffer_count<T>;
+			alignas(T) byte buffer[buffer_count * sizeof(T)];
+
+			while (first != middle && middle != last)
+			{
+				size_t const left = range::distance(first, middle);
+				size_t const right = range::distance(middle, last);
+
+				if (left <= right && left <= buffer_count)
+				{
+					memcpy(buffer, first, left * sizeof(T));
+					memmove(static_cast<void*>(first), middle, right * sizeof(T));
+					memcpy(static_cast<void*>(first + right), buffer, left * sizeof(T));
+					break;
+				}
+				
+				if (right < left && right <= buffer_count)
+				{
+					memcpy(buffer, middle, right * sizeof(T));
+					memmove(static_cast<void*>(first + right), first, left * sizeof(T));
+					memcpy(static_cast<void*>(first), buffer, right * sizeof(T));
+					break;
+				}
+
+				// Put the smaller side in its final position, then rotate what's left
+				if (left <= right)
+				{
+					range::swap_ranges(first, middle, middle);
+					first = middle;
+					middle += left;
+				}
+				else
+				{
+					range::swap_ranges(first, first + right, middle);
+					first += right;
+				}
+			}
+
+			return result;
+		}
+		else
+		{
+			return std::rotate(first, middle, last);
+		}
+	}
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+#include "kaballoc/range/detail/relocate_swap.h"
+#include "kaballoc/range/detail/distance.h"
+
+#include <algorithm>
+#include <functional>
+#include <new>
+
+namespace kab::range
+{
+	namespace detail
+	{
+		// Below this size, partitions are left to the final insertion sort
+		inline constexpr ptrdiff_t sort_threshold = 16;
+
+		// Insertion sort which takes the inserted element out as bytes, and shifts the sorted run with a single memmove
+		template<typename T, typename Compare>
+		void relocate_insertion_sort(T* first, T* last, Compare& comp)
+		{
+			for (T* it = first + 1; it < last; ++it)
+			{
+				if (!comp(*it, *(it - 1)))
+				{
+					continue;
+				}
+
+				alignas(T) byte hole[sizeof(T)];
+				memcpy(hole, it, sizeof(T));
+				T const& value = *std::launder(reinterpret_cast<T const*>(hole));
+
+				// Nothing is modified until the position is found, so a throwing comparison leaves the range untouched
+				T* pos = it - 1;
+				while (pos != first && comp(value, *(pos - 1)))
+				{
+					--pos;
+				}
+
+				memmove(static_cast<void*>(pos + 1), pos, range::distance(pos, it) * sizeof(T));
+				memcpy(static_cast<void*>(pos), hole, sizeof(T));
+			}
+		}
+
+		template<typename T, typename Compare>
+		void relocate_sift_down(T* first, size_t n, size_t i, Compare& comp)
+		{
+			while (true)
+			{
+				size_t child = 2 * i + 1;
+				if (child >= n)
+				{
+					return;
+				}
+
+				if (child + 1 < n && comp(first[child], first[child + 1]))
+				{
+					++child;
+				}
+
+				if (!comp(first[i], first[child]))
+				{
+					return;
+				}
+
+				detail::relocate_swap(first[i], first[child]);
+				i = child;
+			}
+		}
+
+		template<typename T, typename Compare>
+		void relocate_heap_sort(T* first, T* last, Compare& comp)
+		{
+			size_t const n = range::distance(first, last);
+			for (size_t i = n / 2; i > 0; --i)
+			{
+				detail::relocate_sift_down(first, n, i - 1, comp);
+			}
+
+			for (size_t end = n - 1; end > 0; --end)
+			{
+				detail::relocate_swap(first[0], first[end]);
+				detail::relocate_sift_down(first, end, 0, comp);
+			}
+		}
+
+		template<typename T, typename Compare>
+		void move_median_to_first(T* result, T* a, T* b, T* c, Compare& comp)
+		{
+			if (comp(*a, *b))
+			{
+				if (comp(*b, *c)) detail::relocate_swap(*result, *b);
+				else if (comp(*a, *c)) detail::relocate_swap(*result, *c);
+				else detail::relocate_swap(*result, *a);
+			}
+			else if (comp(*a, *c)) detail::relocate_swap(*result, *a);
+			else if (comp(*b, *c)) detail::relocate_swap(*result, *c);
+			else detail::relocate_swap(*result, *b);
+		}
+
+		// Partitions around the pivot in 'first'. The median-of-three guarantees that both scans stop inside the range
+		template<typename T, typename Compare>
+		T* relocate_partition(T* first, T* last, Compare& comp)
+		{
+			T* const mid = first + range::distance(first, last) / 2;
+			detail::move_median_to_first(first, first + 1, mid, last - 1, comp);
+
+			T* lo = first + 1;
+			T* hi = last;
+			while (true)
+			{
+				while (comp(*lo, *first))
+				{
+					++lo;
+				}
+
+				--hi;
+				while (comp(*first, *hi))
+				{
+					--hi;
+				}
+
+				if (!(lo < hi))
+				{
+					return lo;
+				}
+
+				detail::relocate_swap(*lo, *hi);
+				++lo;
+			}
+		}
+
+		template<typename T, typename Compare>
+		void relocate_introsort_loop(T* first, T* last, size_t depth_limit, Compare& comp)
+		{
+			while (range::distance(first, last) > sort_threshold)
+			{
+				if (depth_limit == 0)
+				{
+					detail::relocate_heap_sort(first, last, comp);
+					return;
+				}
+				--depth_limit;
+
+				T* const cut = detail::relocate_partition(first, last, comp);
+				detail::relocate_introsort_loop(cut, last, depth_limit, comp);
+				last = cut;
+			}
+		}
+	}
+
+	/**
+	 * sort
+	 *
+	 * Sorts [first, last) according to 'comp'. The sort is not stable.
+	 *
+	 * Trivially relocatable elements are sorted with an introsort where every exchange is a byte copy, 
+	 * so no move constructor, move assignment or destructor is ever called. Other elements use std::sort
+	 */
+	template<typename T, typename Compare = std::less<>>
+	void sort(T* first, T* last, Compare comp = Compare())
+	{
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			size_t const n = range::distance(first, last);
+			if (n < 2)
+			{
+				return;
+			}
+
+			size_t depth_limit = 0;
+			for (size_t i = n; i > 1; i >>= 1)
+			{
+				depth_limit += 2;
+			}
+
+			detail::relocate_introsort_loop(first, last, depth_limit, comp);
+			detail::relocate_insertion_sort(first, last, comp);
+		}
+		else
+		{
+			std::sort(first, last, comp);
+		}
+	}
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "kaballoc/trait/relocatable.h"
+#include "kaballoc/memory/resource.h"
+#include "kaballoc/memory/detail/destroy.h"
+#include "kaballoc/memory/detail/over_allocate.h"
+#include "kaballoc/range/detail/distance.h"
+
+#include <string.h>
+#include <algorithm>
+#include <new>
+#include <utility>
+
+namespace kab::range
+{
+	/**
+	 * stable_partition
+	 *
+	 * Reorders [first, last) so that the elements satisfying 'pred' come before the others, preserving the relative order in both groups.
+	 * Returns the first element of the second group.
+	 *
+	 * The scratch storage comes from 'resource', with a single allocation of the size of the range. Throws std::bad_alloc if the resource is exhausted, leaving the range unchanged.
+	 * Trivially relocatable elements are relocated with byte copies. Other elements are moved, with basic exception guarantee
+	 */
+	template<typename T, typename Predicate, typename MemoryResource>
+	T* stable_partition(T* first, T* last, Predicate pred, MemoryResource&& resource)
+	{
+		size_t const n = range::distance(first, last);
+		if (n == 0)
+		{
+			return first;
+		}
+
+		byte_span const scratch = detail::allocate_or_throw(resource, n * sizeof(T), align_v<T>);
+		T* const scratch_begin = reinterpret_cast<T*>(scratch.data);
+		T* out_true = first;
+		T* out_false = scratch_begin;
+
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			try
+			{
+				for (T* it = first; it != last; ++it)
+				{
+					if (pred(*it))
+					{
+						if (out_true != it)
+						{
+							memcpy(static_cast<void*>(out_true), it, sizeof(T));
+						}
+						++out_true;
+					}
+					else
+					{
+						memcpy(static_cast<void*>(out_false), it, sizeof(T));
+						++out_false;
+					}
+				}
+			}
+			catch (...)
+			{
+				// The holes left by the relocated elements are exactly as big as the scratch content. Fill them back
+				memcpy(static_cast<void*>(out_true), scratch_begin, range::distance(scratch_begin, out_false) * sizeof(T));
+				resource.deallocate(scratch, align_v<T>);
+				throw;
+			}
+
+			memcpy(static_cast<void*>(out_true), scratch_begin, range::distance(scratch_begin, out_false) * sizeof(T));
+		}
+		else
+		{
+			try
+			{
+				for (T* it = first; it != last; ++it)
+				{
+					if (pred(*it))
+					{
+						if (out_true != it)
+						{
+							*out_true = std::move(*it);
+						}
+						++out_true;
+					}
+					else
+					{
+						new(out_false) T(std::move(*it));
+						++out_false;
+					}
+				}
+
+				std::move(scratch_begin, out_false, out_true);
+			}
+			catch (...)
+			{
+				kab::destroy(scratch_begin, out_false);
+				resource.deallocate(scratch, align_v<T>);
+				throw;
+			}
+
+			kab::destroy(scratch_begin, out_false);
+		}
+
+		resource.deallocate(scratch, align_v<T>);
+		return out_true;
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "kaballoc/range/detail/relocate_swap.h"
+#include "kaballoc/range/detail/distance.h"
+#include "kaballoc/core/comparison.h"
+
+namespace kab::range
+{
+	/**
+	 * swap_ranges
+	 *
+	 * Swaps the elements of [it, sent) with the elements of the range starting at 'it2', which must not overlap with the first range.
+	 * Returns the end of the second range.
+	 *
+	 * Trivially relocatable elements are exchanged by blocks, through a small stack buffer. Other elements are swapped one by one
+	 */
+	template<typename T>
+	T* swap_ranges(T* it, T* sent, T* it2)
+	{
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			constexpr size_t buffer_count = detail::relocate_buffer_count<T>;
+			alignas(T) byte buffer[buffer_count * sizeof(T)];
+
+			size_t n = range::distance(it, sent);
+			while (n > 0)
+			{
+				size_t const count = kab::min(n, buffer_count);
+				size_t const bytes = count * sizeof(T);
+				memcpy(buffer, it, bytes);
+				memcpy(static_cast<void*>(it), it2, bytes);
+				memcpy(static_cast<void*>(it2), buffer, bytes);
+				it += count;
+				it2 += count;
+				n -= count;
+			}
+			return it2;
+		}
+		else
+		{
+			for (; it != sent; ++it, ++it2)
+			{
+				detail::relocate_swap(*it, *it2);
+			}
+			return it2;
+		}
+	}
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+// Add std types as relocatable based on the table found on this site: https://quuxplusone.github.io/blog/2019/02/20/p1144-what-types-are-relocatable/
+
+#include "kaballoc/trait/relocatable.h"
+
+#include <memory>
+
+namespace kab
+{
+	// std::allocator is empty, but its copy constructor is user-provided, so it's not trivially copyable
+	template<typename T>
+	struct is_trivially_relocatable<std::allocator<T>> : std::true_type {};
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+// Add std types as relocatable based on the table found on this site: https://quuxplusone.github.io/blog/2019/02/20/p1144-what-types-are-relocatable/
+
+#include "kaballoc/trait/relocatable.h"
+
+#include <array>
+
+namespace kab
+{
+	template<typename T, size_t N>
+	using array = std::array<T, N>;
+
+	template<typename T, size_t N>
+	struct is_trivially_relocatable<array<T, N>> : is_trivially_relocatable<T> {};
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+// Add std types as relocatable based on the table found on this site: https://quuxplusone.github.io/blog/2019/02/20/p1144-what-types-are-relocatable/
+
+#include "kaballoc/trait/relocatable.h"
+#include "kaballoc/std/allocator.h"
+
+#include <deque>
+
+#include "kaballoc/core/stdlib.h"
+
+namespace kab
+{
+	namespace detail
+	{
+#if KAB_STDLIB_DEBUG_CONTAINERS
+		inline constexpr bool std_deque_relocatable = false;
+#elif KAB_STDLIB_LIBCXX || KAB_STDLIB_LIBSTDCXX || KAB_STDLIB_MSVC
+		inline constexpr bool std_deque_relocatable = true;
+#else
+		inline constexpr bool std_deque_relocatable = false;
+#endif
+	}
+
+	template<typename T, typename Allocator = std::allocator<T>>
+	using deque = std::deque<T, Allocator>;
+
+	template<typename T, typename Allocator>
+	struct is_trivially_relocatable<deque<T, Allocator>> 
+		: std::bool_constant<detail::std_deque_relocatable && is_trivially_relocatable_v<Allocator>> {};
+}
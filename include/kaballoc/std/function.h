@@ -0,0 +1,28 @@
+#pragma once
+
+// Add std types as relocatable based on the table found on this site: https://quuxplusone.github.io/blog/2019/02/20/p1144-what-types-are-relocatable/
+
+#include "kaballoc/trait/relocatable.h"
+
+#include <functional>
+
+#include "kaballoc/core/stdlib.h"
+
+namespace kab
+{
+	namespace detail
+	{
+		// libstdc++ only stores trivially copyable callables in its small buffer. libc++ and MSVC point into their own small buffer
+#if KAB_STDLIB_LIBSTDCXX
+		inline constexpr bool std_function_relocatable = true;
+#else
+		inline constexpr bool std_function_relocatable = false;
+#endif
+	}
+
+	template<typename Signature>
+	using function = std::function<Signature>;
+
+	template<typename Signature>
+	struct is_trivially_relocatable<function<Signature>> : std::bool_constant<detail::std_function_relocatable> {};
+}
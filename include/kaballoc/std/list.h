@@ -0,0 +1,30 @@
+#pragma once
+
+// Add std types as relocatable based on the table found on this site: https://quuxplusone.github.io/blog/2019/02/20/p1144-what-types-are-relocatable/
+
+#include "kaballoc/trait/relocatable.h"
+#include "kaballoc/std/allocator.h"
+
+#include <list>
+
+#include "kaballoc/core/stdlib.h"
+
+namespace kab
+{
+	namespace detail
+	{
+		// libc++ and libstdc++ keep the sentinel node inside the list object, MSVC allocates it
+#if KAB_STDLIB_MSVC && !KAB_STDLIB_DEBUG_CONTAINERS
+		inline constexpr bool std_list_relocatable = true;
+#else
+		inline constexpr bool std_list_relocatable = false;
+#endif
+	}
+
+	template<typename T, typename Allocator = std::allocator<T>>
+	using list = std::list<T, Allocator>;
+
+	template<typename T, typename Allocator>
+	struct is_trivially_relocatable<list<T, Allocator>> 
+		: std::bool_constant<detail::std_list_relocatable && is_trivially_relocatable_v<Allocator>> {};
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+// Add std types as relocatable based on the table found on this site: https://quuxplusone.github.io/blog/2019/02/20/p1144-what-types-are-relocatable/
+
+#include "kaballoc/trait/relocatable.h"
+#include "kaballoc/std/allocator.h"
+
+#include <map>
+
+#include "kaballoc/core/stdlib.h"
+
+namespace kab
+{
+	namespace detail
+	{
+		// libc++ and libstdc++ keep the header node of the tree inside the map object, MSVC allocates it
+#if KAB_STDLIB_MSVC && !KAB_STDLIB_DEBUG_CONTAINERS
+		inline constexpr bool std_map_relocatable = true;
+#else
+		inline constexpr bool std_map_relocatable = false;
+#endif
+	}
+
+	template<typename Key, typename T, typename Compare = std::less<Key>, typename Allocator = std::allocator<std::pair<Key const, T>>>
+	using map = std::map<Key, T, Compare, Allocator>;
+
+	template<typename Key, typename T, typename Compare = std::less<Key>, typename Allocator = std::allocator<std::pair<Key const, T>>>
+	using multimap = std::multimap<Key, T, Compare, Allocator>;
+
+	template<typename Key, typename T, typename Compare, typename Allocator>
+	struct is_trivially_relocatable<map<Key, T, Compare, Allocator>> 
+		: std::bool_constant<detail::std_map_relocatable && is_trivially_relocatable_v<Compare> && is_trivially_relocatable_v<Allocator>> {};
+
+	template<typename Key, typename T, typename Compare, typename Allocator>
+	struct is_trivially_relocatable<multimap<Key, T, Compare, Allocator>> 
+		: std::bool_constant<detail::std_map_relocatable && is_trivially_relocatable_v<Compare> && is_trivially_relocatable_v<Allocator>> {};
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+// Add std types as relocatable based on the table found on this site: https://quuxplusone.github.io/blog/2019/02/20/p1144-what-types-are-relocatable/
+
+#include "kaballoc/trait/relocatable.h"
+
+#include <optional>
+
+namespace kab
+{
+	template<typename T>
+	using optional = std::optional<T>;
+
+	template<typename T>
+	struct is_trivially_relocatable<optional<T>> : std::bool_constant<is_trivially_relocatable_v<T>> {};
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+// Add std types as relocatable based on the table found on this site: https://quuxplusone.github.io/blog/2019/02/20/p1144-what-types-are-relocatable/
+
+#include "kaballoc/trait/relocatable.h"
+
+#include <utility>
+
+namespace kab
+{
+	template<typename T1, typename T2>
+	using pair = std::pair<T1, T2>;
+
+	template<typename T1, typename T2>
+	struct is_trivially_relocatable<pair<T1, T2>> : std::conjunction<is_trivially_relocatable<T1>, is_trivially_relocatable<T2>> {};
+}
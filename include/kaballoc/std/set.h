@@ -0,0 +1,37 @@
+#pragma once
+
+// Add std types as relocatable based on the table found on this site: https://quuxplusone.github.io/blog/2019/02/20/p1144-what-types-are-relocatable/
+
+#include "kaballoc/trait/relocatable.h"
+#include "kaballoc/std/allocator.h"
+
+#include <set>
+
+#include "kaballoc/core/stdlib.h"
+
+namespace kab
+{
+	namespace detail
+	{
+		// libc++ and libstdc++ keep the header node of the tree inside the set object, MSVC allocates it
+#if KAB_STDLIB_MSVC && !KAB_STDLIB_DEBUG_CONTAINERS
+		inline constexpr bool std_set_relocatable = true;
+#else
+		inline constexpr bool std_set_relocatable = false;
+#endif
+	}
+
+	template<typename Key, typename Compare = std::less<Key>, typename Allocator = std::allocator<Key>>
+	using set = std::set<Key, Compare, Allocator>;
+
+	template<typename Key, typename Compare = std::less<Key>, typename Allocator = std::allocator<Key>>
+	using multiset = std::multiset<Key, Compare, Allocator>;
+
+	template<typename Key, typename Compare, typename Allocator>
+	struct is_trivially_relocatable<set<Key, Compare, Allocator>> 
+		: std::bool_constant<detail::std_set_relocatable && is_trivially_relocatable_v<Compare> && is_trivially_relocatable_v<Allocator>> {};
+
+	template<typename Key, typename Compare, typename Allocator>
+	struct is_trivially_relocatable<multiset<Key, Compare, Allocator>> 
+		: std::bool_constant<detail::std_set_relocatable && is_trivially_relocatable_v<Compare> && is_trivially_relocatable_v<Allocator>> {};
+}
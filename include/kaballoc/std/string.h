@@ -0,0 +1,31 @@
+#pragma once
+
+// Add std types as relocatable based on the table found on this site: https://quuxplusone.github.io/blog/2019/02/20/p1144-what-types-are-relocatable/
+
+#include "kaballoc/trait/relocatable.h"
+#include "kaballoc/std/allocator.h"
+
+#include <string>
+
+#include "kaballoc/core/stdlib.h"
+
+namespace kab
+{
+	namespace detail
+	{
+#if KAB_STDLIB_DEBUG_CONTAINERS
+		inline constexpr bool std_string_relocatable = false;
+#elif KAB_STDLIB_LIBCXX || KAB_STDLIB_MSVC
+		inline constexpr bool std_string_relocatable = true;
+#elif KAB_STDLIB_LIBSTDCXX
+		// The old copy-on-write string is a single pointer, but the SSO string points into its own small buffer
+		inline constexpr bool std_string_relocatable = !_GLIBCXX_USE_CXX11_ABI;
+#else
+		inline constexpr bool std_string_relocatable = false;
+#endif
+	}
+
+	template<typename CharT, typename Traits, typename Allocator>
+	struct is_trivially_relocatable<std::basic_string<CharT, Traits, Allocator>> 
+		: std::bool_constant<detail::std_string_relocatable && is_trivially_relocatable_v<Allocator>> {};
+}
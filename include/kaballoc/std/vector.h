@@ -0,0 +1,29 @@
+#pragma once
+
+// Add std types as relocatable based on the table found on this site: https://quuxplusone.github.io/blog/2019/02/20/p1144-what-types-are-relocatable/
+
+#include "kaballoc/trait/relocatable.h"
+#include "kaballoc/std/allocator.h"
+
+#include <vector>
+
+#include "kaballoc/core/stdlib.h"
+
+namespace kab
+{
+	namespace detail
+	{
+#if KAB_STDLIB_DEBUG_CONTAINERS
+		inline constexpr bool std_vector_relocatable = false;
+#elif KAB_STDLIB_LIBCXX || KAB_STDLIB_LIBSTDCXX || KAB_STDLIB_MSVC
+		inline constexpr bool std_vector_relocatable = true;
+#else
+		inline constexpr bool std_vector_relocatable = false;
+#endif
+	}
+
+	// No 'kab::vector' alias here: kab::vector is the container from "kaballoc/container/vector.h"
+	template<typename T, typename Allocator>
+	struct is_trivially_relocatable<std::vector<T, Allocator>> 
+		: std::bool_constant<detail::std_vector_relocatable && is_trivially_relocatable_v<Allocator>> {};
+}
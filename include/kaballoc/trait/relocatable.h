@@ -3,6 +3,7 @@
 #include <type_traits>
 
 #include "kaballoc/core/compiler.h"
+#include "kaballoc/core/size_t.h"
 
 namespace kab
 {
@@ -54,14 +55,39 @@ namespace kab
 	template<> struct is_trivially_relocatable<long double> : std::true_type {};
 	template<> struct is_trivially_relocatable<bool> : std::true_type {};
 
+	// Arrays are relocatable if their elements are
+	template<typename T, size_t N> struct is_trivially_relocatable<T[N]> : is_trivially_relocatable<T> {};
+
 	template<typename T>
 	inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+	/**
+	 * is_nothrow_relocatable
+	 *
+	 * The type T is nothrow relocatable if relocation cannot throw: either T is trivially relocatable, 
+	 * or it can be relocated by a noexcept move construction followed by a noexcept destruction
+	 */
+	template<typename T>
+	struct is_nothrow_relocatable : 
+		std::bool_constant<
+			is_trivially_relocatable_v<T>
+			|| (std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>)
+		>
+	{};
+
+	template<typename T>
+	inline constexpr bool is_nothrow_relocatable_v = is_nothrow_relocatable<T>::value;
 }
 
 #define KAB_DETAIL_DECLARE_RELOCATABLE(T) struct is_trivially_relocatable< T > : std::true_type {};
 #define KAB_DETAIL_DECLARE_RELOCATABLE_COND(T, Cond) struct is_trivially_relocatable<T> : std::conditional_t<Cond, std::true_type, std::false_type> {};
-#define KAB_DETAIL_COMMA_CAT_2(A, B) A, ## B
-#define KAB_DETAIL_COMMA_CAT_3(A, B, C) A, ## B, ## C
+#if KAB_COMPILER_MSVC
+#  define KAB_DETAIL_COMMA_CAT_2(A, B) A, ## B
+#  define KAB_DETAIL_COMMA_CAT_3(A, B, C) A, ## B, ## C
+#else // pasting a comma is an MSVC extension, but conforming preprocessors already keep the expanded commas inside a single argument
+#  define KAB_DETAIL_COMMA_CAT_2(A, B) A, B
+#  define KAB_DETAIL_COMMA_CAT_3(A, B, C) A, B, C
+#endif
 
 // Declare a concrete type as relocatable
 #define KAB_DECLARE_RELOCATABLE(T) namespace kab { template<> KAB_DETAIL_DECLARE_RELOCATABLE(T) }
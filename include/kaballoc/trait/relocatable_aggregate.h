@@ -0,0 +1,112 @@
+#pragma once
+
+#include "kaballoc/trait/relocatable.h"
+#include "kaballoc/core/size_t.h"
+
+#include <type_traits>
+#include <utility>
+
+namespace kab
+{
+	namespace detail
+	{
+		// Converts to any member type. Converting to the aggregate itself is excluded, so that 'Aggregate{ any }' can't pick the copy constructor
+		template<typename Aggregate>
+		struct any_member
+		{
+			template<typename U, typename = std::enable_if_t<!std::is_same_v<std::remove_cv_t<U>, Aggregate>>>
+			operator U() const noexcept;
+		};
+
+		template<typename T, typename Indices, typename = std::void_t<>>
+		struct is_brace_constructible_n : std::false_type {};
+
+		template<typename T, size_t... I>
+		struct is_brace_constructible_n<T, std::index_sequence<I...>, std::void_t<decltype(T{ (void(I), any_member<T>{})... })>> : std::true_type {};
+
+		// An aggregate of N members can be brace-initialized with up to N values. Find the first count that doesn't work
+		template<typename T, size_t N = 0, bool = is_brace_constructible_n<T, std::make_index_sequence<N + 1>>::value>
+		struct aggregate_member_count : aggregate_member_count<T, N + 1> {};
+
+		template<typename T, size_t N>
+		struct aggregate_member_count<T, N, false> : std::integral_constant<size_t, N> {};
+
+		template<typename... Members>
+		auto are_members_relocatable(Members&...) -> std::bool_constant<(is_trivially_relocatable_v<std::remove_cv_t<Members>> && ...)>
+		{
+			return {};
+		}
+
+		// Only used in unevaluated contexts, to get the type of each member through a structured binding
+		template<typename T>
+		auto aggregate_members_relocatable(T&, std::integral_constant<size_t, 0>) -> std::true_type;
+
+#define KAB_DETAIL_AGGREGATE_MEMBERS(N, ...) \
+		template<typename T> \
+		auto aggregate_members_relocatable(T& t, std::integral_constant<size_t, N>) \
+		{ \
+			auto& [__VA_ARGS__] = t; \
+			return are_members_relocatable(__VA_ARGS__); \
+		}
+
+		KAB_DETAIL_AGGREGATE_MEMBERS(1, m0)
+		KAB_DETAIL_AGGREGATE_MEMBERS(2, m0, m1)
+		KAB_DETAIL_AGGREGATE_MEMBERS(3, m0, m1, m2)
+		KAB_DETAIL_AGGREGATE_MEMBERS(4, m0, m1, m2, m3)
+		KAB_DETAIL_AGGREGATE_MEMBERS(5, m0, m1, m2, m3, m4)
+		KAB_DETAIL_AGGREGATE_MEMBERS(6, m0, m1, m2, m3, m4, m5)
+		KAB_DETAIL_AGGREGATE_MEMBERS(7, m0, m1, m2, m3, m4, m5, m6)
+		KAB_DETAIL_AGGREGATE_MEMBERS(8, m0, m1, m2, m3, m4, m5, m6, m7)
+		KAB_DETAIL_AGGREGATE_MEMBERS(9, m0, m1, m2, m3, m4, m5, m6, m7, m8)
+		KAB_DETAIL_AGGREGATE_MEMBERS(10, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9)
+		KAB_DETAIL_AGGREGATE_MEMBERS(11, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10)
+		KAB_DETAIL_AGGREGATE_MEMBERS(12, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11)
+		KAB_DETAIL_AGGREGATE_MEMBERS(13, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12)
+		KAB_DETAIL_AGGREGATE_MEMBERS(14, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13)
+		KAB_DETAIL_AGGREGATE_MEMBERS(15, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14)
+		KAB_DETAIL_AGGREGATE_MEMBERS(16, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15)
+		KAB_DETAIL_AGGREGATE_MEMBERS(17, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16)
+		KAB_DETAIL_AGGREGATE_MEMBERS(18, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17)
+		KAB_DETAIL_AGGREGATE_MEMBERS(19, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18)
+		KAB_DETAIL_AGGREGATE_MEMBERS(20, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19)
+		KAB_DETAIL_AGGREGATE_MEMBERS(21, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20)
+		KAB_DETAIL_AGGREGATE_MEMBERS(22, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21)
+		KAB_DETAIL_AGGREGATE_MEMBERS(23, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22)
+		KAB_DETAIL_AGGREGATE_MEMBERS(24, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23)
+		KAB_DETAIL_AGGREGATE_MEMBERS(25, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24)
+		KAB_DETAIL_AGGREGATE_MEMBERS(26, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25)
+		KAB_DETAIL_AGGREGATE_MEMBERS(27, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26)
+		KAB_DETAIL_AGGREGATE_MEMBERS(28, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27)
+		KAB_DETAIL_AGGREGATE_MEMBERS(29, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28)
+		KAB_DETAIL_AGGREGATE_MEMBERS(30, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29)
+		KAB_DETAIL_AGGREGATE_MEMBERS(31, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30)
+		KAB_DETAIL_AGGREGATE_MEMBERS(32, m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31)
+
+#undef KAB_DETAIL_AGGREGATE_MEMBERS
+
+		template<typename T>
+		struct is_relocatable_aggregate 
+			: decltype(aggregate_members_relocatable(std::declval<T&>(), aggregate_member_count<T>{}))
+		{
+			static_assert(std::is_aggregate_v<T>, "Only aggregates can have their relocatability inferred from their members");
+		};
+	}
+}
+
+/**
+ * Opt-in inference of the relocatability of aggregates
+ *
+ * An aggregate declared with these macros is trivially relocatable if all its members are trivially relocatable.
+ * The members are found without reflection, by brace-initializing the aggregate and taking a structured binding to it. As a result:
+ *   - The aggregate must have at most 32 members, none of them being references or C arrays, and no base classes
+ *   - The specializations of 'is_trivially_relocatable' for the member types must be visible at the point of use (ex: "kaballoc/std/string.h")
+ */
+
+// Declare a concrete aggregate type as relocatable if all its members are relocatable
+#define KAB_DECLARE_RELOCATABLE_AGGREGATE(T) namespace kab { template<> struct is_trivially_relocatable< T > : detail::is_relocatable_aggregate< T > {}; }
+// Declare a single-parameter aggregate template as relocatable if all its members are relocatable
+#define KAB_DECLARE_RELOCATABLE_AGGREGATE_TMP_1(T) namespace kab { template<typename T1> struct is_trivially_relocatable< T<T1> > : detail::is_relocatable_aggregate< T<T1> > {}; }
+// Declare a two-parameters aggregate template as relocatable if all its members are relocatable
+#define KAB_DECLARE_RELOCATABLE_AGGREGATE_TMP_2(T) namespace kab { template<typename T1, typename T2> struct is_trivially_relocatable< T<T1, T2> > : detail::is_relocatable_aggregate< T<T1, T2> > {}; }
+// Declare a three-parameters aggregate template as relocatable if all its members are relocatable
+#define KAB_DECLARE_RELOCATABLE_AGGREGATE_TMP_3(T) namespace kab { template<typename T1, typename T2, typename T3> struct is_trivially_relocatable< T<T1, T2, T3> > : detail::is_relocatable_aggregate< T<T1, T2, T3> > {}; }
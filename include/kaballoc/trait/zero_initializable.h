@@ -0,0 +1,33 @@
+#pragma once
+
+#include <type_traits>
+
+#include "kaballoc/core/size_t.h"
+
+namespace kab
+{
+	/**
+	 * is_zero_initializable
+	 *
+	 * The type T is zero initializable if value-initializing an object of type T is equivalent to setting all its bytes to zero.
+	 *
+	 * This is true for arithmetic types, enumerations and pointers on every supported platform. 
+	 * It is not true for pointers to data members, whose null value is usually -1, and therefore not true for every trivial class either.
+	 * Class types can opt in by specializing this trait
+	 */
+	template<typename T>
+	struct is_zero_initializable :
+		std::bool_constant<
+			std::is_arithmetic_v<T>
+			|| std::is_enum_v<T>
+			|| std::is_pointer_v<T>
+			|| std::is_null_pointer_v<T>
+		>
+	{};
+
+	template<typename T, size_t N> 
+	struct is_zero_initializable<T[N]> : is_zero_initializable<T> {};
+
+	template<typename T>
+	inline constexpr bool is_zero_initializable_v = is_zero_initializable<T>::value;
+}
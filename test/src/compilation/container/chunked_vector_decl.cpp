@@ -0,0 +1,16 @@
+#include "chunked_vector_decl.h"
+
+volatile int chunked_vector_decl_observe;
+
+kab::chunked_vector<int, kab::new_resource> chunked_vector_decl()
+{
+	kab::chunked_vector<int, kab::new_resource> v;
+	v.push_back(1);
+	auto const v2 = kab::chunked_vector<int, kab::new_resource>::from_container(v);
+	chunked_vector_decl_observe = v2.back();
+	chunked_vector_decl_observe = v.front();
+	chunked_vector_decl_observe = static_cast<int>(v.capacity());
+	v.emplace_back(0);
+
+	return v;
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "kaballoc/container/chunked_vector.decl.h"
+#include "kaballoc/memory/new_resource.h"
+
+KAB_CONTAINER_CHUNKED_VECTOR_DECL(int, kab::new_resource)
+
+kab::chunked_vector<int, kab::new_resource> chunked_vector_decl();
@@ -0,0 +1,4 @@
+#include "kaballoc/container/chunked_vector.h"
+#include "kaballoc/memory/new_resource.h"
+
+KAB_CONTAINER_CHUNKED_VECTOR_IMPL(int, kab::new_resource)
@@ -0,0 +1,15 @@
+#include "flat_hash_map_decl.h"
+
+volatile int flat_hash_map_decl_observe;
+
+kab::flat_hash_map<int, int, kab::new_resource> flat_hash_map_decl()
+{
+	kab::flat_hash_map<int, int, kab::new_resource> m;
+	m[1] = 2;
+	m.try_emplace(3, 4);
+	flat_hash_map_decl_observe = m.find(1)->second;
+	flat_hash_map_decl_observe = static_cast<int>(m.erase(3));
+	flat_hash_map_decl_observe = m.contains(3);
+
+	return m;
+}
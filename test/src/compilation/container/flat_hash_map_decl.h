@@ -0,0 +1,8 @@
+#pragma once
+
+#include "kaballoc/container/flat_hash_map.decl.h"
+#include "kaballoc/memory/new_resource.h"
+
+KAB_CONTAINER_FLAT_HASH_MAP_DECL(int, int, kab::new_resource)
+
+kab::flat_hash_map<int, int, kab::new_resource> flat_hash_map_decl();
@@ -0,0 +1,4 @@
+#include "kaballoc/container/flat_hash_map.h"
+#include "kaballoc/memory/new_resource.h"
+
+KAB_CONTAINER_FLAT_HASH_MAP_IMPL(int, int, kab::new_resource)
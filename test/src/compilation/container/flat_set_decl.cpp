@@ -0,0 +1,15 @@
+#include "flat_set_decl.h"
+
+volatile int flat_set_decl_observe;
+
+kab::flat_set<int, kab::new_resource> flat_set_decl()
+{
+	kab::flat_set<int, kab::new_resource> s;
+	s.insert(1);
+	s.insert(3);
+	flat_set_decl_observe = *s.find(1);
+	flat_set_decl_observe = static_cast<int>(s.erase(3));
+	flat_set_decl_observe = s.contains(3);
+
+	return s;
+}
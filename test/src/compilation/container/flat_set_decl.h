@@ -0,0 +1,8 @@
+#pragma once
+
+#include "kaballoc/container/flat_set.decl.h"
+#include "kaballoc/memory/new_resource.h"
+
+KAB_CONTAINER_FLAT_SET_DECL(int, kab::new_resource)
+
+kab::flat_set<int, kab::new_resource> flat_set_decl();
@@ -0,0 +1,4 @@
+#include "kaballoc/container/flat_set.h"
+#include "kaballoc/memory/new_resource.h"
+
+KAB_CONTAINER_FLAT_SET_IMPL(int, kab::new_resource)
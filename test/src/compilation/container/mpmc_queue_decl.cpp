@@ -0,0 +1,11 @@
+#include "mpmc_queue_decl.h"
+
+int mpmc_queue_decl(kab::mpmc_queue<int, kab::new_resource>& q)
+{
+	q.try_push(1);
+	q.try_emplace(2);
+
+	int value = 0;
+	q.try_pop(value);
+	return value + static_cast<int>(q.size() + q.capacity());
+}
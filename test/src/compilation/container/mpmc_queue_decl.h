@@ -0,0 +1,8 @@
+#pragma once
+
+#include "kaballoc/container/mpmc_queue.decl.h"
+#include "kaballoc/memory/new_resource.h"
+
+KAB_CONTAINER_MPMC_QUEUE_DECL(int, kab::new_resource)
+
+int mpmc_queue_decl(kab::mpmc_queue<int, kab::new_resource>& q);
@@ -0,0 +1,4 @@
+#include "kaballoc/container/mpmc_queue.h"
+#include "kaballoc/memory/new_resource.h"
+
+KAB_CONTAINER_MPMC_QUEUE_IMPL(int, kab::new_resource)
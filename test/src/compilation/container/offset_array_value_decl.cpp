@@ -0,0 +1,12 @@
+#include "offset_array_value_decl.h"
+
+volatile int offset_array_value_decl_observe;
+
+void offset_array_value_decl(kab::offset_array_value<int, kab::new_resource>& a)
+{
+	int const value[] = { 1 };
+	a.assign(value);
+	kab::offset_array_value<int, kab::new_resource> const copy = a;
+	offset_array_value_decl_observe = copy.front();
+	offset_array_value_decl_observe = static_cast<int>(copy.size());
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "kaballoc/container/offset_array_value.decl.h"
+#include "kaballoc/memory/new_resource.h"
+
+KAB_CONTAINER_OFFSET_ARRAY_VALUE_DECL(int, kab::new_resource)
+
+void offset_array_value_decl(kab::offset_array_value<int, kab::new_resource>& a);
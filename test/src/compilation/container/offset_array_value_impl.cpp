@@ -0,0 +1,4 @@
+#include "kaballoc/container/offset_array_value.h"
+#include "kaballoc/memory/new_resource.h"
+
+KAB_CONTAINER_OFFSET_ARRAY_VALUE_IMPL(int, kab::new_resource)
@@ -0,0 +1,15 @@
+#include "offset_vector_decl.h"
+
+volatile int offset_vector_decl_observe;
+
+void offset_vector_decl(kab::offset_vector<int, kab::new_resource>& v)
+{
+	v.push_back(1);
+	v.emplace_back(2);
+	v.reserve(10);
+	offset_vector_decl_observe = v.back();
+	offset_vector_decl_observe = v.front();
+	offset_vector_decl_observe = static_cast<int>(v.capacity());
+	v.pop_back();
+	v.clear();
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "kaballoc/container/offset_vector.decl.h"
+#include "kaballoc/memory/new_resource.h"
+
+KAB_CONTAINER_OFFSET_VECTOR_DECL(int, kab::new_resource)
+
+void offset_vector_decl(kab::offset_vector<int, kab::new_resource>& v);
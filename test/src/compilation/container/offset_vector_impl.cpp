@@ -0,0 +1,4 @@
+#include "kaballoc/container/offset_vector.h"
+#include "kaballoc/memory/new_resource.h"
+
+KAB_CONTAINER_OFFSET_VECTOR_IMPL(int, kab::new_resource)
@@ -0,0 +1,18 @@
+#include "ring_buffer_decl.h"
+
+volatile int ring_buffer_decl_observe;
+
+kab::ring_buffer<int, kab::new_resource> ring_buffer_decl()
+{
+	kab::ring_buffer<int, kab::new_resource> b;
+	b.push_back(1);
+	b.push_front(0);
+	int const src[] = { 2, 3 };
+	b.push_back_n(src, 2);
+	ring_buffer_decl_observe = b.back();
+	ring_buffer_decl_observe = b.front();
+	ring_buffer_decl_observe = static_cast<int>(b.capacity());
+	b.pop_front_n(1);
+
+	return b;
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "kaballoc/container/ring_buffer.decl.h"
+#include "kaballoc/memory/new_resource.h"
+
+KAB_CONTAINER_RING_BUFFER_DECL(int, kab::new_resource)
+
+kab::ring_buffer<int, kab::new_resource> ring_buffer_decl();
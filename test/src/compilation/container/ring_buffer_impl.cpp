@@ -0,0 +1,4 @@
+#include "kaballoc/container/ring_buffer.h"
+#include "kaballoc/memory/new_resource.h"
+
+KAB_CONTAINER_RING_BUFFER_IMPL(int, kab::new_resource)
@@ -0,0 +1,15 @@
+#include "slot_map_decl.h"
+
+volatile int slot_map_decl_observe;
+
+kab::slot_map<int, kab::new_resource> slot_map_decl()
+{
+	kab::slot_map<int, kab::new_resource> m;
+	auto const h = m.insert(1);
+	m.emplace(2);
+	slot_map_decl_observe = m[h];
+	slot_map_decl_observe = *m.find(h);
+	m.erase(h);
+
+	return m;
+}
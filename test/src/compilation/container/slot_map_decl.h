@@ -0,0 +1,8 @@
+#pragma once
+
+#include "kaballoc/container/slot_map.decl.h"
+#include "kaballoc/memory/new_resource.h"
+
+KAB_CONTAINER_SLOT_MAP_DECL(int, kab::new_resource)
+
+kab::slot_map<int, kab::new_resource> slot_map_decl();
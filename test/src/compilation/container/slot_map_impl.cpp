@@ -0,0 +1,4 @@
+#include "kaballoc/container/slot_map.h"
+#include "kaballoc/memory/new_resource.h"
+
+KAB_CONTAINER_SLOT_MAP_IMPL(int, kab::new_resource)
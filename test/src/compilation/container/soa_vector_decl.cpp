@@ -0,0 +1,14 @@
+#include "soa_vector_decl.h"
+
+volatile float soa_vector_decl_observe;
+
+kab::soa_vector<soa_vector_decl_tuple, kab::new_resource> soa_vector_decl()
+{
+	kab::soa_vector<soa_vector_decl_tuple, kab::new_resource> v;
+	v.push_back({ 1, 2.0f });
+	v.reserve(10);
+	soa_vector_decl_observe = v.column<1>()[0];
+	soa_vector_decl_observe = static_cast<float>(v.size());
+
+	return v;
+}
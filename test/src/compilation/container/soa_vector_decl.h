@@ -0,0 +1,10 @@
+#pragma once
+
+#include "kaballoc/container/soa_vector.decl.h"
+#include "kaballoc/memory/new_resource.h"
+
+using soa_vector_decl_tuple = std::tuple<int, float>;
+
+KAB_CONTAINER_SOA_VECTOR_DECL(soa_vector_decl_tuple, kab::new_resource)
+
+kab::soa_vector<soa_vector_decl_tuple, kab::new_resource> soa_vector_decl();
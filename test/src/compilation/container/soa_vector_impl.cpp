@@ -0,0 +1,6 @@
+#include "kaballoc/container/soa_vector.h"
+#include "kaballoc/memory/new_resource.h"
+
+using soa_vector_impl_tuple = std::tuple<int, float>;
+
+KAB_CONTAINER_SOA_VECTOR_IMPL(soa_vector_impl_tuple, kab::new_resource)
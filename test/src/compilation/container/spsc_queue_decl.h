@@ -0,0 +1,8 @@
+#pragma once
+
+#include "kaballoc/container/spsc_queue.decl.h"
+#include "kaballoc/memory/new_resource.h"
+
+KAB_CONTAINER_SPSC_QUEUE_DECL(int, kab::new_resource)
+
+int spsc_queue_decl(kab::spsc_queue<int, kab::new_resource>& q);
@@ -0,0 +1,4 @@
+#include "kaballoc/container/spsc_queue.h"
+#include "kaballoc/memory/new_resource.h"
+
+KAB_CONTAINER_SPSC_QUEUE_IMPL(int, kab::new_resource)
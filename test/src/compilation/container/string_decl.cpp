@@ -0,0 +1,15 @@
+#include "string_decl.h"
+
+volatile char string_decl_observe;
+
+kab::string<kab::new_resource> string_decl()
+{
+	kab::string<kab::new_resource> s;
+	s.append("hello");
+	s.push_back('!');
+	string_decl_observe = s.back();
+	string_decl_observe = s.c_str()[0];
+	string_decl_observe = static_cast<char>(s.capacity());
+
+	return s;
+}
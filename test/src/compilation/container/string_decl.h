@@ -0,0 +1,8 @@
+#pragma once
+
+#include "kaballoc/container/string.decl.h"
+#include "kaballoc/memory/new_resource.h"
+
+KAB_CONTAINER_STRING_DECL(kab::new_resource)
+
+kab::string<kab::new_resource> string_decl();
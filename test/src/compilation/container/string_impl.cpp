@@ -0,0 +1,4 @@
+#include "kaballoc/container/string.h"
+#include "kaballoc/memory/new_resource.h"
+
+KAB_CONTAINER_STRING_IMPL(kab::new_resource)
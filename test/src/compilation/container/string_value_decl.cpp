@@ -0,0 +1,12 @@
+#include "string_value_decl.h"
+
+volatile char string_value_decl_observe;
+
+kab::string_value<kab::new_resource> string_value_decl()
+{
+	kab::string_value<kab::new_resource> s;
+	s.assign("hello");
+	string_value_decl_observe = s.back();
+
+	return s.substr(1, 3);
+}
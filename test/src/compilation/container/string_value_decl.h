@@ -0,0 +1,8 @@
+#pragma once
+
+#include "kaballoc/container/string_value.decl.h"
+#include "kaballoc/memory/new_resource.h"
+
+KAB_CONTAINER_STRING_VALUE_DECL(kab::new_resource)
+
+kab::string_value<kab::new_resource> string_value_decl();
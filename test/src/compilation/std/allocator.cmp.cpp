@@ -0,0 +1,3 @@
+#include "kaballoc/std/allocator.h"
+
+static_assert(kab::is_trivially_relocatable_v<std::allocator<int>>);
@@ -0,0 +1,6 @@
+#include "kaballoc/std/array.h"
+#include "kaballoc/std/unique_ptr.h"
+
+static_assert(kab::is_trivially_relocatable_v<kab::array<int, 4>>);
+static_assert(kab::is_trivially_relocatable_v<kab::array<kab::unique_ptr<int>, 4>>);
+static_assert(kab::is_trivially_relocatable_v<kab::unique_ptr<int>[4]>);
@@ -0,0 +1,5 @@
+#include "kaballoc/std/deque.h"
+
+#if !KAB_STDLIB_DEBUG_CONTAINERS
+static_assert(kab::is_trivially_relocatable_v<kab::deque<int>>);
+#endif
@@ -0,0 +1,7 @@
+#include "kaballoc/std/function.h"
+
+#if KAB_STDLIB_LIBSTDCXX
+static_assert(kab::is_trivially_relocatable_v<kab::function<int(float)>>);
+#else
+static_assert(!kab::is_trivially_relocatable_v<kab::function<int(float)>>);
+#endif
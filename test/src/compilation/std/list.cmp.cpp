@@ -0,0 +1,7 @@
+#include "kaballoc/std/list.h"
+
+#if KAB_STDLIB_MSVC && !KAB_STDLIB_DEBUG_CONTAINERS
+static_assert(kab::is_trivially_relocatable_v<kab::list<int>>);
+#else
+static_assert(!kab::is_trivially_relocatable_v<kab::list<int>>);
+#endif
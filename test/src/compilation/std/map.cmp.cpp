@@ -0,0 +1,9 @@
+#include "kaballoc/std/map.h"
+
+#if KAB_STDLIB_MSVC && !KAB_STDLIB_DEBUG_CONTAINERS
+static_assert(kab::is_trivially_relocatable_v<kab::map<int, float>>);
+static_assert(kab::is_trivially_relocatable_v<kab::multimap<int, float>>);
+#else
+static_assert(!kab::is_trivially_relocatable_v<kab::map<int, float>>);
+static_assert(!kab::is_trivially_relocatable_v<kab::multimap<int, float>>);
+#endif
@@ -0,0 +1,5 @@
+#include "kaballoc/std/optional.h"
+#include "kaballoc/std/unique_ptr.h"
+
+static_assert(kab::is_trivially_relocatable_v<kab::optional<int>>);
+static_assert(kab::is_trivially_relocatable_v<kab::optional<kab::unique_ptr<int>>>);
@@ -0,0 +1,5 @@
+#include "kaballoc/std/pair.h"
+#include "kaballoc/std/unique_ptr.h"
+
+static_assert(kab::is_trivially_relocatable_v<kab::pair<int, float>>);
+static_assert(kab::is_trivially_relocatable_v<kab::pair<int, kab::unique_ptr<int>>>);
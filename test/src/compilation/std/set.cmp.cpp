@@ -0,0 +1,9 @@
+#include "kaballoc/std/set.h"
+
+#if KAB_STDLIB_MSVC && !KAB_STDLIB_DEBUG_CONTAINERS
+static_assert(kab::is_trivially_relocatable_v<kab::set<int>>);
+static_assert(kab::is_trivially_relocatable_v<kab::multiset<int>>);
+#else
+static_assert(!kab::is_trivially_relocatable_v<kab::set<int>>);
+static_assert(!kab::is_trivially_relocatable_v<kab::multiset<int>>);
+#endif
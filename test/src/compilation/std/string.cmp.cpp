@@ -0,0 +1,10 @@
+#include "kaballoc/std/string.h"
+
+#if KAB_STDLIB_DEBUG_CONTAINERS
+static_assert(!kab::is_trivially_relocatable_v<std::string>);
+#elif KAB_STDLIB_LIBCXX || KAB_STDLIB_MSVC
+static_assert(kab::is_trivially_relocatable_v<std::string>);
+static_assert(kab::is_trivially_relocatable_v<std::wstring>);
+#elif KAB_STDLIB_LIBSTDCXX && _GLIBCXX_USE_CXX11_ABI
+static_assert(!kab::is_trivially_relocatable_v<std::string>);
+#endif
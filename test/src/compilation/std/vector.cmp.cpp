@@ -0,0 +1,6 @@
+#include "kaballoc/std/vector.h"
+
+#if !KAB_STDLIB_DEBUG_CONTAINERS
+static_assert(kab::is_trivially_relocatable_v<std::vector<int>>);
+static_assert(kab::is_trivially_relocatable_v<std::vector<std::vector<int>>>);
+#endif
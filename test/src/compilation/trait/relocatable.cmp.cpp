@@ -1,6 +1,10 @@
 #include "kaballoc/trait/relocatable.h"
 
-#define CAT_2(A, B) A, ## B
+#if KAB_COMPILER_MSVC
+#  define CAT_2(A, B) A, ## B
+#else
+#  define CAT_2(A, B) (A, B) // the expanded comma would split the macro arguments again, keep it in parentheses
+#endif
 
 struct A {};
 namespace foo { struct B { }; }
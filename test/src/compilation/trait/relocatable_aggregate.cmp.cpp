@@ -0,0 +1,40 @@
+#include "kaballoc/trait/relocatable_aggregate.h"
+#include "kaballoc/std/unique_ptr.h"
+
+#include <string>
+
+namespace
+{
+	struct not_relocatable
+	{
+		not_relocatable* self = this;
+		not_relocatable() = default;
+		not_relocatable(not_relocatable const&) : self(this) {}
+	};
+}
+
+struct A { int i; float f; };
+struct B { kab::unique_ptr<int> p; A a; double d; };
+struct C { kab::unique_ptr<int> p; not_relocatable n; };
+struct D { };
+struct E { int const i; kab::unique_ptr<A> const p; };
+template<typename T1> struct F { T1 t; int i; };
+
+KAB_DECLARE_RELOCATABLE_AGGREGATE(A);
+KAB_DECLARE_RELOCATABLE_AGGREGATE(B);
+KAB_DECLARE_RELOCATABLE_AGGREGATE(C);
+KAB_DECLARE_RELOCATABLE_AGGREGATE(D);
+KAB_DECLARE_RELOCATABLE_AGGREGATE(E);
+KAB_DECLARE_RELOCATABLE_AGGREGATE_TMP_1(F);
+
+static_assert(kab::detail::aggregate_member_count<A>::value == 2);
+static_assert(kab::detail::aggregate_member_count<B>::value == 3);
+static_assert(kab::detail::aggregate_member_count<D>::value == 0);
+
+static_assert(kab::is_trivially_relocatable_v<A>);
+static_assert(kab::is_trivially_relocatable_v<B>);
+static_assert(!kab::is_trivially_relocatable_v<C>);
+static_assert(kab::is_trivially_relocatable_v<D>);
+static_assert(kab::is_trivially_relocatable_v<E>);
+static_assert(kab::is_trivially_relocatable_v<F<kab::unique_ptr<int>>>);
+static_assert(!kab::is_trivially_relocatable_v<F<not_relocatable>>);
@@ -0,0 +1,204 @@
+#include "kaballoc/container/chunked_vector.h"
+
+#include <catch.hpp>
+
+#include "kaballoc/memory/resource_reference.h"
+#include "kaballoc/memory/freelist_resource.h"
+#include "kaballoc/memory/new_resource.h"
+#include "kaballoc/std/string.h"
+#include "test_resource.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+template<typename T, size_t ChunkByteSize = 64>
+using chunked_vector = kab::chunked_vector<T, kab::resource_reference<test_resource>, ChunkByteSize>;
+
+TEST_CASE("Container Chunked Vector Compilation", "[container]")
+{
+	REQUIRE(!std::is_default_constructible_v<chunked_vector<int>>); // kab::resource_reference is not default constructible
+	REQUIRE(std::is_default_constructible_v<kab::chunked_vector<int, kab::new_resource>>);
+	REQUIRE(!std::is_copy_constructible_v<chunked_vector<int>>);
+	REQUIRE(!std::is_copy_assignable_v<chunked_vector<int>>);
+	REQUIRE(std::is_nothrow_move_constructible_v<chunked_vector<int>>);
+	REQUIRE(std::is_nothrow_move_assignable_v<chunked_vector<int>>);
+	REQUIRE(std::is_nothrow_swappable_v<chunked_vector<int>>);
+	REQUIRE(kab::is_trivially_relocatable_v<chunked_vector<int>>);
+	REQUIRE(chunked_vector<int>::elements_per_chunk == 16);
+	REQUIRE(kab::chunked_vector<int, kab::new_resource>::elements_per_chunk == 1024);
+
+	using iterator = chunked_vector<int>::iterator;
+	using const_iterator = chunked_vector<int>::const_iterator;
+	REQUIRE(std::is_convertible_v<iterator, const_iterator>);
+	REQUIRE(!std::is_convertible_v<const_iterator, iterator>);
+	REQUIRE(std::is_same_v<std::iterator_traits<iterator>::iterator_category, std::random_access_iterator_tag>);
+}
+
+TEST_CASE("Container Chunked Vector Empty", "[container]")
+{
+	test_resource r;
+
+	{
+		chunked_vector<int> v(r);
+		REQUIRE(v.is_empty());
+		REQUIRE(v.size() == 0);
+		REQUIRE(v.capacity() == 0);
+		REQUIRE(v.begin() == v.end());
+		REQUIRE(v.get_resource() == kab::make_reference(r));
+
+		chunked_vector<int> move(std::move(v));
+		REQUIRE(move.is_empty());
+		v = std::move(move);
+		v.swap(move);
+		v.shrink_to_fit();
+		v.clear_and_shrink();
+	}
+
+	REQUIRE(r.get_total_alloc() == 0);
+}
+
+TEST_CASE("Container Chunked Vector Stable Addresses", "[container]")
+{
+	test_resource r;
+
+	{
+		chunked_vector<int> v(r);
+		std::vector<int*> addresses;
+		for (int i = 0; i < 1000; ++i)
+		{
+			addresses.push_back(&v.push_back(i));
+		}
+
+		REQUIRE(v.size() == 1000);
+		REQUIRE(v.capacity() >= 1000);
+		REQUIRE(v.chunk_count() == (1000 + 15) / 16);
+		REQUIRE(v.front() == 0);
+		REQUIRE(v.back() == 999);
+		for (int i = 0; i < 1000; ++i)
+		{
+			REQUIRE(&v[i] == addresses[i]);
+			REQUIRE(v[i] == i);
+		}
+
+		// Iterators
+		REQUIRE(v.end() - v.begin() == 1000);
+		REQUIRE(std::accumulate(v.begin(), v.end(), 0) == 999 * 1000 / 2);
+		auto const it = std::lower_bound(v.begin(), v.end(), 500);
+		REQUIRE(&*it == addresses[500]);
+		REQUIRE(it[-1] == 499);
+		chunked_vector<int>::const_iterator const cit = it;
+		REQUIRE(*(cit + 20) == 520);
+
+		// Every chunk is allocated with the chunk size
+		size_t const alloc = r.get_current_alloc();
+		v.push_back_n(16 * 4);
+		REQUIRE(r.get_last_alloc() == 64);
+		REQUIRE(r.get_last_alloc_align() == alignof(int));
+		REQUIRE(&v[999] == addresses[999]);
+
+		// Removing elements keeps the chunks
+		v.resize(10);
+		REQUIRE(v.size() == 10);
+		REQUIRE(r.get_current_alloc() > alloc);
+		v.shrink_to_fit();
+		REQUIRE(v.chunk_count() == 1);
+		REQUIRE(&v[9] == addresses[9]);
+
+		v.pop_back();
+		REQUIRE(v.back() == 8);
+		v.clear();
+		REQUIRE(v.is_empty());
+		REQUIRE(v.chunk_count() == 1);
+		v.clear_and_shrink();
+		REQUIRE(r.get_current_alloc() == 0);
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+TEST_CASE("Container Chunked Vector String", "[container]")
+{
+	test_resource r;
+
+	{
+		chunked_vector<std::string, 128> v(r);
+		for (int i = 0; i < 100; ++i)
+		{
+			v.emplace_back(i, 'a'); // both small and heap strings
+		}
+		v.reserve(300);
+		v.resize(200);
+
+		for (int i = 0; i < 100; ++i)
+		{
+			REQUIRE(v[i] == std::string(i, 'a'));
+		}
+		REQUIRE(v[150].empty());
+
+		auto const v2 = chunked_vector<std::string, 128>::from_container(v);
+		REQUIRE(v2.size() == 200);
+		REQUIRE(std::equal(v.begin(), v.end(), v2.begin()));
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+namespace
+{
+	struct throwing_default
+	{
+		static inline int constructions_left = 0;
+		static inline int alive = 0;
+
+		throwing_default()
+		{
+			if (constructions_left-- == 0)
+			{
+				throw 0;
+			}
+			++alive;
+		}
+		~throwing_default() { --alive; }
+	};
+}
+
+TEST_CASE("Container Chunked Vector Throwing Construction", "[container]")
+{
+	test_resource r;
+
+	{
+		chunked_vector<throwing_default, 16> v(r);
+		throwing_default::constructions_left = 5;
+		v.push_back_n(5);
+		REQUIRE(throwing_default::alive == 5);
+
+		throwing_default::constructions_left = 30; // throws in the middle of a chunk
+		REQUIRE_THROWS(v.push_back_n(100));
+		REQUIRE(v.size() == 5);
+		REQUIRE(throwing_default::alive == 5);
+	}
+
+	REQUIRE(throwing_default::alive == 0);
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+TEST_CASE("Container Chunked Vector Freelist", "[container]")
+{
+	test_resource r;
+
+	{
+		using freelist = kab::freelist_resource<kab::resource_reference<test_resource>, 256>;
+		kab::chunked_vector<int, freelist, 256> v(freelist(kab::make_reference(r)));
+
+		v.push_back_n(1000);
+		size_t const alloc = r.get_current_alloc();
+
+		// Freed chunks go to the freelist, and are reused when growing again
+		v.clear_and_shrink();
+		v.push_back_n(1000);
+		REQUIRE(r.get_current_alloc() == alloc);
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
@@ -0,0 +1,257 @@
+#include "kaballoc/container/flat_hash_map.h"
+
+#include <catch.hpp>
+
+#include "kaballoc/memory/resource_reference.h"
+#include "kaballoc/memory/new_resource.h"
+#include "kaballoc/std/string.h"
+#include "kaballoc/std/unique_ptr.h"
+#include "test_resource.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+using flat_hash_map = kab::flat_hash_map<Key, Value, kab::resource_reference<test_resource>, Hash>;
+
+TEST_CASE("Container Flat Hash Map Compilation", "[container]")
+{
+	REQUIRE(!std::is_default_constructible_v<flat_hash_map<int, int>>); // kab::resource_reference is not default constructible
+	REQUIRE(std::is_default_constructible_v<kab::flat_hash_map<int, int, kab::new_resource>>);
+	REQUIRE(!std::is_copy_constructible_v<flat_hash_map<int, int>>);
+	REQUIRE(!std::is_copy_assignable_v<flat_hash_map<int, int>>);
+	REQUIRE(std::is_nothrow_move_constructible_v<flat_hash_map<int, int>>);
+	REQUIRE(std::is_nothrow_move_assignable_v<flat_hash_map<int, int>>);
+	REQUIRE(std::is_nothrow_swappable_v<flat_hash_map<int, int>>);
+	REQUIRE(kab::is_trivially_relocatable_v<flat_hash_map<int, int>>);
+	REQUIRE(kab::is_trivially_relocatable_v<flat_hash_map<std::string, std::string>>);
+}
+
+TEST_CASE("Container Flat Hash Map Empty", "[container]")
+{
+	test_resource r;
+
+	{
+		flat_hash_map<int, int> m(r);
+		REQUIRE(m.is_empty());
+		REQUIRE(m.size() == 0);
+		REQUIRE(m.capacity() == 0);
+		REQUIRE(m.begin() == m.end());
+		REQUIRE(m.find(0) == m.end());
+		REQUIRE(!m.contains(0));
+		REQUIRE(m.erase(0) == 0);
+		REQUIRE(m.get_resource() == kab::make_reference(r));
+
+		flat_hash_map<int, int> move(std::move(m));
+		m = std::move(move);
+		m.swap(move);
+		m.clear();
+		m.clear_and_shrink();
+	}
+
+	REQUIRE(r.get_total_alloc() == 0);
+}
+
+TEST_CASE("Container Flat Hash Map Insert Find Erase", "[container]")
+{
+	test_resource r;
+
+	{
+		flat_hash_map<int, int> m(r);
+		std::unordered_map<int, int> expected;
+
+		// Sequential keys are the worst case for identity hashes
+		for (int i = 0; i < 5000; ++i)
+		{
+			auto const [it, inserted] = m.try_emplace(i * 16, i);
+			REQUIRE(inserted);
+			REQUIRE(it->first == i * 16);
+			REQUIRE(it->second == i);
+			expected.emplace(i * 16, i);
+		}
+		REQUIRE(m.size() == 5000);
+		REQUIRE(m.size() <= m.capacity() - m.capacity() / 8);
+		REQUIRE(r.get_last_alloc_align() == 16);
+
+		auto const [it, inserted] = m.try_emplace(16, -1);
+		REQUIRE(!inserted);
+		REQUIRE(it->second == 1);
+
+		// Erase every other key, which leaves deleted slots behind
+		for (int i = 0; i < 5000; i += 2)
+		{
+			REQUIRE(m.erase(i * 16) == 1);
+			expected.erase(i * 16);
+		}
+		REQUIRE(m.size() == 2500);
+
+		for (int i = 0; i < 5000; ++i)
+		{
+			auto const found = m.find(i * 16);
+			if (i % 2 == 0)
+			{
+				REQUIRE(found == m.end());
+			}
+			else
+			{
+				REQUIRE(found != m.end());
+				REQUIRE(found->second == i);
+			}
+		}
+
+		// Iteration sees every element exactly once
+		size_t count = 0;
+		for (auto const& [key, value] : m)
+		{
+			REQUIRE(expected.at(key) == value);
+			++count;
+		}
+		REQUIRE(count == expected.size());
+
+		// Reinserting many times doesn't grow the table forever, deleted slots are reused
+		size_t const capacity = m.capacity();
+		for (int round = 0; round < 10; ++round)
+		{
+			for (int i = 0; i < 5000; i += 2)
+			{
+				m[i * 16] = round;
+			}
+			for (int i = 0; i < 5000; i += 2)
+			{
+				REQUIRE(m.erase(i * 16) == 1);
+			}
+		}
+		REQUIRE(m.capacity() == capacity);
+		REQUIRE(m.size() == 2500);
+
+		// Erase while iterating
+		for (auto i = m.begin(); i != m.end();)
+		{
+			i = m.erase(i);
+		}
+		REQUIRE(m.is_empty());
+		REQUIRE(m.begin() == m.end());
+
+		m[3] = 4;
+		m.insert_or_assign(3, 5);
+		m.insert({ 4, 6 });
+		REQUIRE(m[3] == 5);
+		REQUIRE(m[4] == 6);
+		REQUIRE(m[5] == 0);
+		REQUIRE(m.size() == 3);
+
+		m.clear();
+		REQUIRE(m.is_empty());
+		REQUIRE(!m.contains(3));
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+TEST_CASE("Container Flat Hash Map Non-Trivial Elements", "[container]")
+{
+	test_resource r;
+
+	{
+		flat_hash_map<std::string, std::unique_ptr<int>> m(r);
+		m.reserve(100);
+		size_t const capacity = m.capacity();
+		REQUIRE(capacity >= 100);
+
+		for (int i = 0; i < 100; ++i)
+		{
+			m.try_emplace(std::to_string(i), std::make_unique<int>(i));
+		}
+		REQUIRE(m.capacity() == capacity);
+
+		for (int i = 100; i < 1000; ++i)
+		{
+			m.try_emplace(std::to_string(i), std::make_unique<int>(i));
+		}
+
+		for (int i = 0; i < 1000; ++i)
+		{
+			auto const it = m.find(std::to_string(i));
+			REQUIRE(it != m.end());
+			REQUIRE(*it->second == i);
+		}
+
+		std::string const key(50, 'k'); // heap string
+		m[key] = std::make_unique<int>(-1);
+		REQUIRE(*m.find(key)->second == -1);
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+namespace
+{
+	struct collision_hash
+	{
+		size_t operator()(int) const noexcept { return 0; }
+	};
+
+	struct throwing_hash
+	{
+		static inline int hashes_left = 0;
+
+		size_t operator()(int i) const
+		{
+			if (hashes_left-- == 0)
+			{
+				throw 0;
+			}
+			return static_cast<size_t>(i);
+		}
+	};
+}
+
+TEST_CASE("Container Flat Hash Map Collisions", "[container]")
+{
+	test_resource r;
+
+	{
+		// Every element has the same hash, and probing has to go through every group
+		flat_hash_map<int, int, collision_hash> m(r);
+		for (int i = 0; i < 200; ++i)
+		{
+			m[i] = i;
+		}
+		for (int i = 0; i < 200; ++i)
+		{
+			REQUIRE(m.find(i)->second == i);
+		}
+		REQUIRE(m.find(200) == m.end());
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+TEST_CASE("Container Flat Hash Map Throwing Hash", "[container]")
+{
+	test_resource r;
+
+	{
+		flat_hash_map<int, std::string, throwing_hash> m(r);
+		throwing_hash::hashes_left = 1000;
+		for (int i = 0; i < 14; ++i)
+		{
+			m[i] = std::string(100, 'a');
+		}
+		REQUIRE(m.capacity() == 16);
+
+		// The hash throws in the middle of the rehash: the map is cleared
+		throwing_hash::hashes_left = 5;
+		REQUIRE_THROWS(m[14]);
+		REQUIRE(m.is_empty());
+		REQUIRE(r.get_current_alloc() == 0);
+
+		throwing_hash::hashes_left = 1000;
+		m[1] = "b";
+		REQUIRE(m[1] == "b");
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
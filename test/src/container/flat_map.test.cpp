@@ -0,0 +1,197 @@
+#include "kaballoc/container/flat_map.h"
+
+#include <catch.hpp>
+
+#include "kaballoc/memory/resource_reference.h"
+#include "kaballoc/memory/new_resource.h"
+#include "kaballoc/range/move_view.h"
+#include "kaballoc/std/string.h"
+#include "kaballoc/std/unique_ptr.h"
+#include "test_resource.h"
+
+#include <algorithm>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+template<typename Key, typename Value>
+using flat_map = kab::flat_map<Key, Value, kab::resource_reference<test_resource>>;
+
+TEST_CASE("Container Flat Map Compilation", "[container]")
+{
+	REQUIRE(!std::is_default_constructible_v<flat_map<int, int>>); // kab::resource_reference is not default constructible
+	REQUIRE(std::is_default_constructible_v<kab::flat_map<int, int, kab::new_resource>>);
+	REQUIRE(!std::is_copy_constructible_v<flat_map<int, int>>);
+	REQUIRE(!std::is_copy_assignable_v<flat_map<int, int>>);
+	REQUIRE(std::is_nothrow_move_constructible_v<flat_map<int, int>>);
+	REQUIRE(std::is_nothrow_move_assignable_v<flat_map<int, int>>);
+	REQUIRE(std::is_nothrow_swappable_v<flat_map<int, int>>);
+	REQUIRE(kab::is_trivially_relocatable_v<flat_map<int, int>>);
+}
+
+TEST_CASE("Container Flat Map Bulk", "[container]")
+{
+	test_resource r;
+
+	{
+		flat_map<int, int> m(r);
+		REQUIRE(m.is_empty());
+		REQUIRE(m.find(0) == nullptr);
+		REQUIRE(m.get_resource() == kab::make_reference(r));
+
+		// Unsorted, with duplicates: the first element of every key is kept
+		std::vector<std::pair<int, int>> elements;
+		for (int i = 0; i < 1000; ++i)
+		{
+			elements.emplace_back((i * 7919) % 500, i);
+		}
+		m.insert_back(elements);
+
+		std::map<int, int> expected;
+		for (auto const& [key, value] : elements)
+		{
+			expected.emplace(key, value);
+		}
+
+		REQUIRE(m.size() == expected.size());
+		REQUIRE(std::is_sorted(m.keys().begin(), m.keys().end()));
+		size_t i = 0;
+		for (auto const& [key, value] : expected)
+		{
+			REQUIRE(m.keys()[i] == key);
+			REQUIRE(m.values()[i] == value);
+			REQUIRE(*m.find(key) == value);
+			++i;
+		}
+		REQUIRE(m.find(-1) == nullptr);
+		REQUIRE(m.find(500) == nullptr);
+
+		// Existing elements win over the inserted ones
+		std::pair<int, int> const more[] = { { 3, -1 }, { 1000, -2 }, { -5, -3 } };
+		m.insert_back(more);
+		REQUIRE(m.size() == expected.size() + 2);
+		REQUIRE(*m.find(3) == expected[3]);
+		REQUIRE(*m.find(1000) == -2);
+		REQUIRE(*m.find(-5) == -3);
+		REQUIRE(m.keys().front() == -5);
+
+		// Already sorted elements at the back don't need a sort
+		size_t const total_alloc = r.get_total_alloc();
+		std::pair<int, int> const sorted[] = { { 2000, 0 }, { 2001, 1 } };
+		m.reserve(m.size() + 2);
+		size_t const reserved_alloc = r.get_total_alloc();
+		m.insert_back(sorted);
+		REQUIRE(r.get_total_alloc() == reserved_alloc);
+		REQUIRE(reserved_alloc >= total_alloc);
+		REQUIRE(m.keys().back() == 2001);
+
+		m.clear();
+		REQUIRE(m.is_empty());
+		m.clear_and_shrink();
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+TEST_CASE("Container Flat Map Single Element", "[container]")
+{
+	test_resource r;
+
+	{
+		flat_map<std::string, std::unique_ptr<int>> m(r);
+		for (int i : { 5, 3, 9, 1, 7 })
+		{
+			auto const [value, inserted] = m.try_emplace(std::to_string(i), std::make_unique<int>(i));
+			REQUIRE(inserted);
+			REQUIRE(**value == i);
+		}
+
+		auto const [value, inserted] = m.try_emplace("3", std::make_unique<int>(-1));
+		REQUIRE(!inserted);
+		REQUIRE(**value == 3);
+
+		REQUIRE(m.size() == 5);
+		REQUIRE(std::is_sorted(m.keys().begin(), m.keys().end()));
+		for (size_t i = 0; i < m.size(); ++i)
+		{
+			REQUIRE(std::to_string(*m.values()[i]) == m.keys()[i]);
+		}
+
+		m["4"] = std::make_unique<int>(4);
+		REQUIRE(m.keys()[2] == "4");
+		m.insert_or_assign("4", std::make_unique<int>(44));
+		REQUIRE(**m.find("4") == 44);
+
+		REQUIRE(m.erase("3") == 1);
+		REQUIRE(m.erase("3") == 0);
+		REQUIRE(!m.contains("3"));
+		REQUIRE(m.size() == 5);
+		REQUIRE(std::is_sorted(m.keys().begin(), m.keys().end()));
+		REQUIRE(**m.find("9") == 9);
+
+		// Bulk insertion from a moved range
+		std::vector<std::pair<std::string, std::unique_ptr<int>>> elements;
+		elements.emplace_back("0", std::make_unique<int>(0));
+		elements.emplace_back("8", std::make_unique<int>(8));
+		m.insert_back(kab::move_view(elements));
+		REQUIRE(m.size() == 7);
+		REQUIRE(**m.find("0") == 0);
+		REQUIRE(**m.find("8") == 8);
+
+		m.shrink_to_fit();
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+namespace
+{
+	struct counting_resource : test_resource
+	{
+		size_t allocations = 0;
+
+		[[nodiscard]] kab::byte_span allocate(size_t n, kab::align_t alignment)
+		{
+			++allocations;
+			return test_resource::allocate(n, alignment);
+		}
+	};
+}
+
+TEST_CASE("Container Flat Map Growth", "[container]")
+{
+	counting_resource r;
+
+	{
+		kab::flat_map<int, int, kab::resource_reference<counting_resource>> m(r);
+
+		// A sized range is reserved at once
+		std::vector<std::pair<int, int>> elements;
+		for (int i = 0; i < 10000; ++i)
+		{
+			elements.emplace_back(i, i);
+		}
+		m.insert_back(elements);
+		REQUIRE(m.size() == 10000);
+		REQUIRE(r.allocations == 2);
+
+		// Other ranges and single insertions grow the vectors geometrically
+		std::list<std::pair<int, int>> more;
+		for (int i = 10000; i < 20000; ++i)
+		{
+			more.emplace_back(i, i);
+		}
+		m.insert_back(more);
+		for (int i = 20000; i < 30000; ++i)
+		{
+			m[i] = i;
+		}
+		REQUIRE(m.size() == 30000);
+		REQUIRE(r.allocations <= 2 + 2 * 4);
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
@@ -0,0 +1,125 @@
+#include "kaballoc/container/flat_set.h"
+
+#include <catch.hpp>
+
+#include "kaballoc/memory/resource_reference.h"
+#include "kaballoc/memory/new_resource.h"
+#include "kaballoc/std/string.h"
+#include "test_resource.h"
+
+#include <algorithm>
+#include <list>
+#include <set>
+#include <string>
+#include <vector>
+
+template<typename Key>
+using flat_set = kab::flat_set<Key, kab::resource_reference<test_resource>>;
+
+TEST_CASE("Container Flat Set Compilation", "[container]")
+{
+	REQUIRE(!std::is_default_constructible_v<flat_set<int>>); // kab::resource_reference is not default constructible
+	REQUIRE(std::is_default_constructible_v<kab::flat_set<int, kab::new_resource>>);
+	REQUIRE(!std::is_copy_constructible_v<flat_set<int>>);
+	REQUIRE(!std::is_copy_assignable_v<flat_set<int>>);
+	REQUIRE(std::is_nothrow_move_constructible_v<flat_set<int>>);
+	REQUIRE(std::is_nothrow_move_assignable_v<flat_set<int>>);
+	REQUIRE(std::is_nothrow_swappable_v<flat_set<int>>);
+	REQUIRE(kab::is_trivially_relocatable_v<flat_set<int>>);
+}
+
+TEST_CASE("Container Flat Set", "[container]")
+{
+	test_resource r;
+
+	{
+		flat_set<int> s(r);
+		REQUIRE(s.is_empty());
+		REQUIRE(s.find(0) == s.end());
+
+		std::vector<int> keys;
+		for (int i = 0; i < 1000; ++i)
+		{
+			keys.push_back((i * 7919) % 600);
+		}
+		s.insert_back(keys);
+
+		std::set<int> const expected(keys.begin(), keys.end());
+		REQUIRE(s.size() == expected.size());
+		REQUIRE(std::equal(s.begin(), s.end(), expected.begin(), expected.end()));
+
+		auto const [it, inserted] = s.insert(-1);
+		REQUIRE(inserted);
+		REQUIRE(it == s.begin());
+		REQUIRE(!s.insert(-1).second);
+		REQUIRE(s.contains(-1));
+		REQUIRE(s.erase(-1) == 1);
+		REQUIRE(s.erase(-1) == 0);
+		REQUIRE(s.lower_bound(-1) == s.begin());
+		REQUIRE(s.lower_bound(10000) == s.end());
+
+		s.clear_and_shrink();
+		REQUIRE(s.is_empty());
+	}
+
+	{
+		flat_set<std::string> s(r);
+		std::string const words[] = { "pear", "apple", "fig", "apple", "kiwi", std::string(50, 'z') };
+		s.insert_back(words);
+		REQUIRE(s.size() == 5);
+		REQUIRE(*s.begin() == "apple");
+		REQUIRE(*s.find("kiwi") == "kiwi");
+		REQUIRE(s.find("plum") == s.end());
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+namespace
+{
+	struct counting_resource : test_resource
+	{
+		size_t allocations = 0;
+
+		[[nodiscard]] kab::byte_span allocate(size_t n, kab::align_t alignment)
+		{
+			++allocations;
+			return test_resource::allocate(n, alignment);
+		}
+	};
+}
+
+TEST_CASE("Container Flat Set Growth", "[container]")
+{
+	counting_resource r;
+
+	{
+		kab::flat_set<int, kab::resource_reference<counting_resource>> s(r);
+
+		// A sized range is reserved at once
+		std::vector<int> keys;
+		for (int i = 0; i < 10000; ++i)
+		{
+			keys.push_back(i);
+		}
+		s.insert_back(keys);
+		REQUIRE(s.size() == 10000);
+		REQUIRE(r.allocations == 1);
+
+		// Other ranges and single insertions grow the vector geometrically
+		std::list<int> more;
+		for (int i = 10000; i < 20000; ++i)
+		{
+			more.push_back(i);
+		}
+		s.insert_back(more);
+		for (int i = 20000; i < 30000; ++i)
+		{
+			s.insert(i);
+		}
+		REQUIRE(s.size() == 30000);
+		REQUIRE(r.allocations <= 1 + 4);
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
@@ -0,0 +1,170 @@
+#include "kaballoc/container/mpmc_queue.h"
+
+#include <catch.hpp>
+
+#include "kaballoc/memory/resource_reference.h"
+#include "kaballoc/memory/new_resource.h"
+#include "kaballoc/std/string.h"
+#include "test_resource.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+template<typename T>
+using mpmc_queue = kab::mpmc_queue<T, kab::resource_reference<test_resource>>;
+
+TEST_CASE("Container MPMC Queue Compilation", "[container]")
+{
+	REQUIRE(!std::is_copy_constructible_v<mpmc_queue<int>>);
+	REQUIRE(!std::is_move_constructible_v<mpmc_queue<int>>);
+	REQUIRE(!std::is_copy_assignable_v<mpmc_queue<int>>);
+	REQUIRE(!std::is_move_assignable_v<mpmc_queue<int>>);
+	REQUIRE(std::is_constructible_v<kab::mpmc_queue<int, kab::new_resource>, size_t>);
+	REQUIRE(!kab::is_trivially_relocatable_v<mpmc_queue<int>>);
+	REQUIRE(alignof(mpmc_queue<int>) == kab::cache_line_size);
+}
+
+TEST_CASE("Container MPMC Queue Push Pop", "[container]")
+{
+	test_resource r;
+
+	{
+		mpmc_queue<int> q(1, r);
+		REQUIRE(q.capacity() == 2);
+
+		mpmc_queue<int> q2(5, r);
+		REQUIRE(q2.capacity() == 8);
+		REQUIRE(q2.is_empty());
+		REQUIRE(q2.get_resource() == kab::make_reference(r));
+
+		int value = -1;
+		REQUIRE(!q2.try_pop(value));
+		REQUIRE(value == -1);
+
+		int next_pop = 0;
+		int next_push = 0;
+		for (int round = 0; round < 5; ++round) {
+			while (q2.try_push(next_push)) {
+				++next_push;
+			}
+			REQUIRE(q2.size() == 8);
+
+			for (int i = 0; i < 5; ++i) {
+				REQUIRE(q2.try_pop(value));
+				REQUIRE(value == next_pop++);
+			}
+			REQUIRE(q2.size() == 3);
+		}
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+namespace
+{
+	// Trivially relocatable element whose constructor can throw
+	struct throwing_constructor
+	{
+		std::unique_ptr<int> value;
+
+		explicit throwing_constructor(int v)
+		{
+			if (v < 0) {
+				throw 0;
+			}
+			value = std::make_unique<int>(v);
+		}
+	};
+}
+
+namespace kab
+{
+	template<>
+	struct is_trivially_relocatable<throwing_constructor> : std::true_type {};
+}
+
+TEST_CASE("Container MPMC Queue Destruction", "[container]")
+{
+	test_resource r;
+
+	{
+		mpmc_queue<std::unique_ptr<std::string>> q(4, r);
+		q.try_push(std::make_unique<std::string>(100, 'a'));
+		q.try_push(std::make_unique<std::string>(100, 'b'));
+
+		auto out = std::make_unique<std::string>(100, 'z');
+		REQUIRE(q.try_pop(out));
+		REQUIRE(*out == std::string(100, 'a'));
+
+		mpmc_queue<throwing_constructor> throwing_q(2, r);
+		REQUIRE(throwing_q.try_emplace(1));
+		REQUIRE_THROWS(throwing_q.try_emplace(-1));
+		REQUIRE(throwing_q.size() == 1);
+		REQUIRE(throwing_q.try_emplace(2));
+		REQUIRE(!throwing_q.try_emplace(3)); // constructed then destroyed, since the queue is full
+
+		throwing_constructor popped(0);
+		REQUIRE(throwing_q.try_pop(popped));
+		REQUIRE(*popped.value == 1);
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+TEST_CASE("Container MPMC Queue Threads", "[container]")
+{
+	constexpr size_t thread_count = 4;
+	constexpr size_t count_per_thread = 50000;
+	kab::mpmc_queue<size_t, kab::new_resource> q(64);
+
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < thread_count; ++t) {
+		threads.emplace_back([&q, t] {
+			for (size_t i = 0; i < count_per_thread; ++i) {
+				// Each producer pushes increasing values, tagged with the producer index
+				while (!q.try_push(i * thread_count + t)) {
+					std::this_thread::yield();
+				}
+			}
+		});
+	}
+
+	std::atomic<size_t> popped_count = 0;
+	std::vector<std::vector<size_t>> popped(thread_count);
+	for (size_t t = 0; t < thread_count; ++t) {
+		threads.emplace_back([&, t] {
+			size_t value;
+			while (popped_count.load() < thread_count * count_per_thread) {
+				if (q.try_pop(value)) {
+					popped[t].push_back(value);
+					popped_count.fetch_add(1);
+				}
+			}
+		});
+	}
+
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	// Every value is popped once, and each consumer sees the values of a producer in order
+	std::vector<size_t> seen(thread_count * count_per_thread);
+	bool ordered = true;
+	for (std::vector<size_t> const& values : popped) {
+		std::vector<size_t> last(thread_count, 0);
+		std::vector<bool> any(thread_count, false);
+		for (size_t value : values) {
+			size_t const producer = value % thread_count;
+			ordered &= !any[producer] || last[producer] < value;
+			last[producer] = value;
+			any[producer] = true;
+			++seen[value];
+		}
+	}
+
+	REQUIRE(ordered);
+	REQUIRE(std::all_of(seen.begin(), seen.end(), [](size_t n) { return n == 1; }));
+	REQUIRE(q.is_empty());
+}
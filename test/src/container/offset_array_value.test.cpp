@@ -0,0 +1,123 @@
+#include "kaballoc/container/offset_array_value.h"
+
+#include "test_resource.h"
+
+#include <catch.hpp>
+
+#include "kaballoc/memory/resource_reference.h"
+#include "kaballoc/memory/checking_resource.h"
+
+#include <string>
+
+template<typename T>
+using offset_array_value = kab::offset_array_value<T, kab::resource_reference<test_resource>>;
+
+TEST_CASE("Container Offset Array Value Compilation", "[container]")
+{
+	REQUIRE(std::is_nothrow_copy_constructible_v<offset_array_value<int>>);
+	REQUIRE(std::is_nothrow_copy_assignable_v<offset_array_value<int>>);
+	REQUIRE(std::is_nothrow_move_constructible_v<offset_array_value<int>>);
+	REQUIRE(std::is_nothrow_move_assignable_v<offset_array_value<int>>);
+	REQUIRE(std::is_nothrow_swappable_v<offset_array_value<int>>);
+	REQUIRE(!kab::is_trivially_relocatable_v<offset_array_value<int>>);
+}
+
+TEST_CASE("Container Offset Array Value Sharing", "[container]")
+{
+	test_resource r;
+
+	{
+		offset_array_value<std::string> a(r);
+		REQUIRE(a.is_empty());
+		REQUIRE(a.begin() == a.end());
+
+		std::string const values[] = { "a", "b", "c" };
+		a.assign(values);
+		REQUIRE(a.size() == 3);
+		REQUIRE(a.front() == "a");
+		REQUIRE(a.back() == "c");
+		REQUIRE(a[1] == "b");
+		size_t const allocated = r.get_current_alloc();
+
+		// Copies share the value
+		offset_array_value<std::string> copy = a;
+		REQUIRE(copy.data() == a.data());
+		REQUIRE(r.get_current_alloc() == allocated);
+
+		offset_array_value<std::string> moved = std::move(a);
+		REQUIRE(a.is_empty());
+		REQUIRE(moved.data() == copy.data());
+
+		copy.swap(a);
+		REQUIRE(copy.is_empty());
+		REQUIRE(a.data() == moved.data());
+
+		a = copy;
+		moved = copy;
+		REQUIRE(r.get_current_alloc() == 0);
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+namespace
+{
+	// Copy throws after a given number of copies
+	struct throwing_copy
+	{
+		static inline int copies_left = 0;
+
+		int value = 0;
+
+		throwing_copy() = default;
+		explicit throwing_copy(int v) : value(v) {}
+		throwing_copy(throwing_copy const& rhs)
+			: value(rhs.value)
+		{
+			if (copies_left-- == 0)
+			{
+				throw 0;
+			}
+		}
+	};
+
+	size_t checking_errors = 0;
+
+	void count_checking_error(kab::checking_report const&)
+	{
+		++checking_errors;
+	}
+}
+
+TEST_CASE("Container Offset Array Value Throwing Copy", "[container]")
+{
+	checking_errors = 0;
+	test_resource r;
+
+	{
+		using checker_type = kab::checking_resource<kab::resource_reference<test_resource>>;
+		checker_type checker{ kab::resource_reference<test_resource>(r) };
+		checker.set_handler(&count_checking_error);
+
+		kab::offset_array_value<throwing_copy, kab::resource_reference<checker_type>> a{ kab::resource_reference<checker_type>(checker) };
+		throwing_copy const values[] = { throwing_copy(1), throwing_copy(2), throwing_copy(3), throwing_copy(4) };
+
+		// The 4th copy throws
+		throwing_copy::copies_left = 3;
+		REQUIRE_THROWS(a.assign(values));
+		REQUIRE(a.is_empty());
+		REQUIRE(checker.live_allocations() == 0);
+		REQUIRE(r.get_current_alloc() == 0);
+
+		throwing_copy::copies_left = 4;
+		a.assign(values);
+		REQUIRE(a.size() == 4);
+		REQUIRE(a.back().value == 4);
+
+		a = kab::offset_array_value<throwing_copy, kab::resource_reference<checker_type>>{ kab::resource_reference<checker_type>(checker) };
+		REQUIRE(checker.live_allocations() == 0);
+	}
+
+	REQUIRE(checking_errors == 0);
+	REQUIRE(r.get_current_alloc() == 0);
+}
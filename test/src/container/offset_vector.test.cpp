@@ -0,0 +1,95 @@
+#include "kaballoc/container/offset_vector.h"
+
+#include "test_resource.h"
+
+#include <catch.hpp>
+
+#include "kaballoc/memory/resource_reference.h"
+
+#include <string>
+
+template<typename T>
+using offset_vector = kab::offset_vector<T, kab::resource_reference<test_resource>>;
+
+TEST_CASE("Container Offset Vector Compilation", "[container]")
+{
+	REQUIRE(!std::is_copy_constructible_v<offset_vector<int>>);
+	REQUIRE(std::is_nothrow_move_constructible_v<offset_vector<int>>);
+	REQUIRE(std::is_nothrow_move_assignable_v<offset_vector<int>>);
+	REQUIRE(!kab::is_trivially_relocatable_v<offset_vector<int>>);
+}
+
+TEST_CASE("Container Offset Vector Push", "[container]")
+{
+	test_resource r;
+
+	{
+		offset_vector<std::string> v(r);
+		REQUIRE(v.is_empty());
+
+		for (int i = 0; i < 100; ++i)
+		{
+			v.push_back(std::to_string(i));
+		}
+		REQUIRE(v.size() == 100);
+		REQUIRE(v.capacity() >= 100);
+		for (int i = 0; i < 100; ++i)
+		{
+			REQUIRE(v[i] == std::to_string(i));
+		}
+		REQUIRE(v.front() == "0");
+		REQUIRE(v.back() == "99");
+
+		v.pop_back();
+		REQUIRE(v.size() == 99);
+
+		size_t count = 0;
+		for (std::string const& s : v)
+		{
+			REQUIRE(s == std::to_string(count));
+			++count;
+		}
+		REQUIRE(count == 99);
+
+		v.clear();
+		REQUIRE(v.is_empty());
+		REQUIRE(r.get_current_alloc() > 0);
+		v.clear_and_shrink();
+		REQUIRE(r.get_current_alloc() == 0);
+
+		v.emplace_back(3, 'a');
+		REQUIRE(v[0] == "aaa");
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+TEST_CASE("Container Offset Vector Move", "[container]")
+{
+	test_resource r;
+
+	{
+		offset_vector<int> v(r);
+		int const values[] = { 1, 2, 3 };
+		v.insert_back(values);
+		int const* const data = v.data();
+
+		offset_vector<int> moved(std::move(v));
+		REQUIRE(v.is_empty());
+		REQUIRE(v.data() == nullptr);
+		REQUIRE(moved.data() == data);
+		REQUIRE(moved.size() == 3);
+
+		offset_vector<int> assigned(r);
+		assigned.push_back(0);
+		assigned = std::move(moved);
+		REQUIRE(assigned.data() == data);
+		REQUIRE(assigned[2] == 3);
+
+		assigned.reserve(1000);
+		REQUIRE(assigned.capacity() >= 1000);
+		REQUIRE(assigned[2] == 3);
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
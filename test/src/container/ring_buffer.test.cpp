@@ -0,0 +1,276 @@
+#include "kaballoc/container/ring_buffer.h"
+
+#include <catch.hpp>
+
+#include "kaballoc/memory/resource_reference.h"
+#include "kaballoc/memory/new_resource.h"
+#include "kaballoc/std/string.h"
+#include "test_resource.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+template<typename T>
+using ring_buffer = kab::ring_buffer<T, kab::resource_reference<test_resource>>;
+
+TEST_CASE("Container Ring Buffer Compilation", "[container]")
+{
+	REQUIRE(!std::is_default_constructible_v<ring_buffer<int>>); // kab::resource_reference is not default constructible
+	REQUIRE(std::is_default_constructible_v<kab::ring_buffer<int, kab::new_resource>>);
+	REQUIRE(!std::is_copy_constructible_v<ring_buffer<int>>);
+	REQUIRE(!std::is_copy_assignable_v<ring_buffer<int>>);
+	REQUIRE(std::is_nothrow_move_constructible_v<ring_buffer<int>>);
+	REQUIRE(std::is_nothrow_move_assignable_v<ring_buffer<int>>);
+	REQUIRE(std::is_nothrow_swappable_v<ring_buffer<int>>);
+	REQUIRE(kab::is_trivially_relocatable_v<ring_buffer<int>>);
+
+	using iterator = ring_buffer<int>::iterator;
+	using const_iterator = ring_buffer<int>::const_iterator;
+	REQUIRE(std::is_convertible_v<iterator, const_iterator>);
+	REQUIRE(!std::is_convertible_v<const_iterator, iterator>);
+	REQUIRE(std::is_same_v<std::iterator_traits<iterator>::iterator_category, std::random_access_iterator_tag>);
+}
+
+TEST_CASE("Container Ring Buffer Empty", "[container]")
+{
+	test_resource r;
+
+	{
+		ring_buffer<int> b(r);
+		REQUIRE(b.is_empty());
+		REQUIRE(b.size() == 0);
+		REQUIRE(b.capacity() == 0);
+		REQUIRE(b.begin() == b.end());
+		REQUIRE(b.get_resource() == kab::make_reference(r));
+
+		b.pop_front_n(0);
+		b.push_back_n(nullptr, 0);
+
+		ring_buffer<int> move(std::move(b));
+		REQUIRE(move.is_empty());
+		b = std::move(move);
+		b.swap(move);
+		b.shrink_to_fit();
+		b.clear_and_shrink();
+	}
+
+	REQUIRE(r.get_total_alloc() == 0);
+}
+
+TEST_CASE("Container Ring Buffer Capacity", "[container]")
+{
+	test_resource r;
+
+	{
+		ring_buffer<int> b(r);
+		b.reserve(5);
+		REQUIRE(b.capacity() == 8);
+		REQUIRE(r.get_last_alloc_align() == alignof(int));
+
+		b.reserve(8);
+		REQUIRE(b.capacity() == 8);
+		REQUIRE(r.get_total_alloc() == 8 * sizeof(int));
+
+		for (int i = 0; i < 9; ++i) {
+			b.push_back(i);
+		}
+		REQUIRE(b.capacity() == 16);
+
+		b.pop_front_n(6);
+		b.shrink_to_fit();
+		REQUIRE(b.capacity() == 4);
+		REQUIRE(b.size() == 3);
+		REQUIRE(b.front() == 6);
+		REQUIRE(b.back() == 8);
+
+		b.clear();
+		REQUIRE(b.is_empty());
+		REQUIRE(b.capacity() == 4);
+
+		b.clear_and_shrink();
+		REQUIRE(b.capacity() == 0);
+		REQUIRE(r.get_current_alloc() == 0);
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+TEST_CASE("Container Ring Buffer Wrap Around", "[container]")
+{
+	test_resource r;
+
+	ring_buffer<int> b(r);
+	b.reserve(8);
+
+	// Moves the head to the end of the storage, so that the elements wrap around
+	for (int i = 0; i < 6; ++i) {
+		b.push_back(i);
+	}
+	b.pop_front_n(6);
+
+	for (int i = 0; i < 8; ++i) {
+		b.push_back(i);
+	}
+	REQUIRE(b.capacity() == 8);
+	REQUIRE(r.get_total_alloc() == 8 * sizeof(int));
+
+	std::vector<int> expected(8);
+	std::iota(expected.begin(), expected.end(), 0);
+	REQUIRE(std::equal(b.begin(), b.end(), expected.begin(), expected.end()));
+	REQUIRE(b.end() - b.begin() == 8);
+	REQUIRE(b.begin() < b.end());
+	for (size_t i = 0; i < expected.size(); ++i) {
+		REQUIRE(b[i] == expected[i]);
+	}
+
+	// Grows while wrapped
+	b.push_back(8);
+	expected.push_back(8);
+	REQUIRE(b.capacity() == 16);
+	REQUIRE(std::equal(b.begin(), b.end(), expected.begin(), expected.end()));
+
+	std::reverse(b.begin(), b.end());
+	REQUIRE(std::equal(b.begin(), b.end(), expected.rbegin(), expected.rend()));
+}
+
+TEST_CASE("Container Ring Buffer Push Front", "[container]")
+{
+	test_resource r;
+
+	ring_buffer<int> b(r);
+	b.push_front(1);
+	b.push_front(0);
+	b.push_back(2);
+	b.emplace_front(-1);
+
+	std::vector<int> const expected = { -1, 0, 1, 2 };
+	REQUIRE(std::equal(b.begin(), b.end(), expected.begin(), expected.end()));
+
+	b.pop_front();
+	b.pop_back();
+	REQUIRE(b.size() == 2);
+	REQUIRE(b.front() == 0);
+	REQUIRE(b.back() == 1);
+}
+
+TEST_CASE("Container Ring Buffer Bulk", "[container]")
+{
+	test_resource r;
+
+	ring_buffer<int> b(r);
+	std::vector<int> src(100);
+	std::iota(src.begin(), src.end(), 0);
+
+	b.push_back_n(src.data(), 5);
+	REQUIRE(b.capacity() == 8);
+
+	int dst[5];
+	b.pop_front_n(dst, 3);
+	REQUIRE(std::equal(dst, dst + 3, src.begin()));
+
+	// Wraps around the end of the storage
+	b.push_back_n(src.data() + 5, 6);
+	REQUIRE(b.capacity() == 8);
+	REQUIRE(b.size() == 8);
+	REQUIRE(std::equal(b.begin(), b.end(), src.begin() + 3, src.begin() + 11));
+
+	b.pop_front_n(dst, 5);
+	REQUIRE(std::equal(dst, dst + 5, src.begin() + 3));
+
+	b.push_back_n(src.data() + 11, 89);
+	REQUIRE(b.size() == 92);
+	REQUIRE(b.capacity() == 128);
+	REQUIRE(std::equal(b.begin(), b.end(), src.begin() + 8, src.end()));
+}
+
+TEST_CASE("Container Ring Buffer String", "[container]")
+{
+	test_resource r;
+
+	{
+		ring_buffer<std::string> b(r);
+		for (int i = 0; i < 20; ++i) {
+			b.emplace_back(i * 2, 'a'); // both small and heap strings
+			if (i % 3 == 0) {
+				b.pop_front();
+			}
+		}
+
+		REQUIRE(b.size() == 13);
+		REQUIRE(b.front() == std::string(7 * 2, 'a'));
+		REQUIRE(b.back() == std::string(19 * 2, 'a'));
+
+		b.pop_front_n(4);
+		REQUIRE(b.front() == std::string(11 * 2, 'a'));
+		b.shrink_to_fit();
+		REQUIRE(b.capacity() == 16);
+		REQUIRE(b.back() == std::string(19 * 2, 'a'));
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+namespace
+{
+	// Copyable element with a throwing move, so the ring buffer copies it when growing
+	struct throwing_copy
+	{
+		static inline int copies_left = 0;
+		static inline int alive = 0;
+
+		int value;
+
+		explicit throwing_copy(int v) : value(v) { ++alive; }
+		throwing_copy(throwing_copy const& rhs)
+			: value(rhs.value)
+		{
+			if (copies_left-- == 0) {
+				throw 0;
+			}
+			++alive;
+		}
+		throwing_copy(throwing_copy && rhs) noexcept(false) : throwing_copy(static_cast<throwing_copy const&>(rhs)) { }
+		~throwing_copy() { --alive; }
+	};
+}
+
+TEST_CASE("Container Ring Buffer Throwing Copy", "[container]")
+{
+	test_resource r;
+
+	{
+		ring_buffer<throwing_copy> b(r);
+		throwing_copy::copies_left = 100;
+		b.reserve(4);
+		b.emplace_back(1);
+		b.emplace_back(2);
+		b.emplace_front(0);
+		b.emplace_back(3);
+		REQUIRE(b.capacity() == 4);
+
+		// Growing copies the elements, and the ring buffer is unchanged when a copy throws
+		throwing_copy::copies_left = 2;
+		REQUIRE_THROWS(b.emplace_back(4));
+		REQUIRE(throwing_copy::alive == 4);
+		REQUIRE(b.size() == 4);
+		REQUIRE(b.capacity() == 4);
+		for (size_t i = 0; i < 4; ++i) {
+			REQUIRE(b[i].value == static_cast<int>(i));
+		}
+		REQUIRE(r.get_current_alloc() == 4 * sizeof(throwing_copy));
+
+		throwing_copy const src[] = { throwing_copy(4), throwing_copy(5) };
+		throwing_copy::copies_left = 100;
+		b.push_back_n(src, 2);
+		REQUIRE(b.size() == 6);
+
+		throwing_copy::copies_left = 1;
+		REQUIRE_THROWS(b.push_back_n(src, 2));
+		REQUIRE(b.size() == 6);
+		REQUIRE(throwing_copy::alive == 8);
+	}
+
+	REQUIRE(throwing_copy::alive == 0);
+	REQUIRE(r.get_current_alloc() == 0);
+}
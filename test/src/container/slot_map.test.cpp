@@ -0,0 +1,197 @@
+#include "kaballoc/container/slot_map.h"
+
+#include <catch.hpp>
+
+#include "kaballoc/memory/resource_reference.h"
+#include "kaballoc/memory/new_resource.h"
+#include "kaballoc/std/string.h"
+#include "test_resource.h"
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+
+template<typename T>
+using slot_map = kab::slot_map<T, kab::resource_reference<test_resource>>;
+
+TEST_CASE("Container Slot Map Compilation", "[container]")
+{
+	REQUIRE(!std::is_default_constructible_v<slot_map<int>>); // kab::resource_reference is not default constructible
+	REQUIRE(std::is_default_constructible_v<kab::slot_map<int, kab::new_resource>>);
+	REQUIRE(!std::is_copy_constructible_v<slot_map<int>>);
+	REQUIRE(!std::is_copy_assignable_v<slot_map<int>>);
+	REQUIRE(std::is_nothrow_move_constructible_v<slot_map<int>>);
+	REQUIRE(std::is_nothrow_move_assignable_v<slot_map<int>>);
+	REQUIRE(std::is_nothrow_swappable_v<slot_map<int>>);
+	REQUIRE(kab::is_trivially_relocatable_v<slot_map<int>>);
+}
+
+TEST_CASE("Container Slot Map Empty", "[container]")
+{
+	test_resource r;
+
+	{
+		slot_map<int> m(r);
+		REQUIRE(m.is_empty());
+		REQUIRE(m.size() == 0);
+		REQUIRE(m.begin() == m.end());
+		REQUIRE(!m.contains({ 0, 0 }));
+		REQUIRE(m.find({ 0, 0 }) == nullptr);
+		REQUIRE(!m.erase({ 0, 0 }));
+		REQUIRE(m.get_resource() == kab::make_reference(r));
+
+		slot_map<int> move(std::move(m));
+		m = std::move(move);
+		m.swap(move);
+		m.clear();
+		m.shrink_to_fit();
+	}
+
+	REQUIRE(r.get_total_alloc() == 0);
+}
+
+TEST_CASE("Container Slot Map Handles", "[container]")
+{
+	test_resource r;
+
+	{
+		slot_map<std::string> m(r);
+		auto const a = m.insert(std::string(100, 'a'));
+		auto const b = m.emplace(100, 'b');
+		auto const c = m.emplace(100, 'c');
+		REQUIRE(m.size() == 3);
+		REQUIRE(m[a] == std::string(100, 'a'));
+		REQUIRE(*m.find(b) == std::string(100, 'b'));
+		REQUIRE(m.contains(c));
+
+		// Erasing relocates the last element, and its handle follows it
+		REQUIRE(m.erase(a));
+		REQUIRE(!m.erase(a));
+		REQUIRE(!m.contains(a));
+		REQUIRE(m.find(a) == nullptr);
+		REQUIRE(m.size() == 2);
+		REQUIRE(m.data()[0] == std::string(100, 'c'));
+		REQUIRE(m[c] == std::string(100, 'c'));
+		REQUIRE(m[b] == std::string(100, 'b'));
+		REQUIRE(m.handle_at(0) == c);
+		REQUIRE(m.handle_at(1) == b);
+
+		// The slot is reused, with a new generation
+		auto const d = m.emplace(100, 'd');
+		REQUIRE(d.index == a.index);
+		REQUIRE(d != a);
+		REQUIRE(!m.contains(a));
+		REQUIRE(m[d] == std::string(100, 'd'));
+
+		m.clear();
+		REQUIRE(m.is_empty());
+		REQUIRE(!m.contains(b));
+		REQUIRE(!m.contains(c));
+		REQUIRE(!m.contains(d));
+
+		auto const e = m.emplace(1, 'e');
+		REQUIRE(m[e] == "e");
+		REQUIRE(!m.contains(b));
+		REQUIRE(!m.contains(c));
+		REQUIRE(!m.contains(d));
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+TEST_CASE("Container Slot Map Random", "[container]")
+{
+	test_resource r;
+
+	slot_map<int> m(r);
+	std::map<int, kab::slot_map_handle> expected;
+	std::vector<kab::slot_map_handle> erased;
+	std::mt19937 random(42);
+
+	for (int i = 0; i < 10000; ++i) {
+		if (expected.empty() || random() % 3 != 0) {
+			expected.emplace(i, m.insert(i));
+		}
+		else {
+			auto it = expected.begin();
+			std::advance(it, random() % expected.size());
+			REQUIRE(m.erase(it->second));
+			erased.push_back(it->second);
+			expected.erase(it);
+		}
+	}
+
+	REQUIRE(m.size() == expected.size());
+	for (auto const& [value, h] : expected) {
+		REQUIRE(m.contains(h));
+		REQUIRE(m[h] == value);
+	}
+	for (kab::slot_map_handle const h : erased) {
+		REQUIRE(!m.contains(h));
+	}
+	for (size_t i = 0; i < m.size(); ++i) {
+		REQUIRE(expected.at(m.data()[i]) == m.handle_at(i));
+	}
+}
+
+namespace
+{
+	struct throwing_constructor
+	{
+		explicit throwing_constructor(int v)
+		{
+			if (v < 0) {
+				throw 0;
+			}
+		}
+	};
+}
+
+TEST_CASE("Container Slot Map Throwing Constructor", "[container]")
+{
+	test_resource r;
+
+	slot_map<throwing_constructor> m(r);
+	auto const a = m.emplace(1);
+	REQUIRE_THROWS(m.emplace(-1));
+	REQUIRE(m.size() == 1);
+	REQUIRE(m.contains(a));
+
+	auto const b = m.emplace(2);
+	REQUIRE(m.size() == 2);
+	REQUIRE(m.handle_at(1) == b);
+}
+
+namespace
+{
+	struct counting_resource : test_resource
+	{
+		size_t allocations = 0;
+
+		[[nodiscard]] kab::byte_span allocate(size_t n, kab::align_t alignment)
+		{
+			++allocations;
+			return test_resource::allocate(n, alignment);
+		}
+	};
+}
+
+TEST_CASE("Container Slot Map Growth", "[container]")
+{
+	counting_resource r;
+
+	{
+		kab::slot_map<int, kab::resource_reference<counting_resource>> m(r);
+		for (int i = 0; i < 10000; ++i)
+		{
+			m.insert(i);
+		}
+		REQUIRE(m.size() == 10000);
+
+		// Each of the three vectors grows geometrically, so insertion is amortized constant time
+		REQUIRE(r.allocations <= 3 * 16);
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
@@ -0,0 +1,191 @@
+#include "kaballoc/container/soa_vector.h"
+
+#include <catch.hpp>
+
+#include "kaballoc/memory/resource_reference.h"
+#include "kaballoc/memory/new_resource.h"
+#include "kaballoc/std/string.h"
+#include "kaballoc/std/unique_ptr.h"
+#include "test_resource.h"
+
+#include <numeric>
+#include <stdint.h>
+
+template<typename... Ts>
+using soa_vector = kab::soa_vector<std::tuple<Ts...>, kab::resource_reference<test_resource>>;
+
+TEST_CASE("Container SoA Vector Compilation", "[container]")
+{
+	REQUIRE(!std::is_default_constructible_v<soa_vector<int, float>>); // kab::resource_reference is not default constructible
+	REQUIRE(std::is_default_constructible_v<kab::soa_vector<std::tuple<int, float>, kab::new_resource>>);
+	REQUIRE(!std::is_copy_constructible_v<soa_vector<int, float>>);
+	REQUIRE(!std::is_copy_assignable_v<soa_vector<int, float>>);
+	REQUIRE(std::is_nothrow_move_constructible_v<soa_vector<int, float>>);
+	REQUIRE(std::is_nothrow_move_assignable_v<soa_vector<int, float>>);
+	REQUIRE(std::is_nothrow_swappable_v<soa_vector<int, float>>);
+	REQUIRE(kab::is_trivially_relocatable_v<soa_vector<int, float>>);
+	REQUIRE(std::is_same_v<soa_vector<int, float>::reference, std::tuple<int&, float&>>);
+}
+
+TEST_CASE("Container SoA Vector Empty", "[container]")
+{
+	test_resource r;
+
+	{
+		soa_vector<int, double> v(r);
+		REQUIRE(v.is_empty());
+		REQUIRE(v.size() == 0);
+		REQUIRE(v.capacity() == 0);
+		REQUIRE(v.column<0>().empty());
+		REQUIRE(v.column<1>().empty());
+		REQUIRE(v.get_resource() == kab::make_reference(r));
+
+		soa_vector<int, double> move(std::move(v));
+		v = std::move(move);
+		v.swap(move);
+		v.shrink_to_fit();
+		v.clear_and_shrink();
+	}
+
+	REQUIRE(r.get_total_alloc() == 0);
+}
+
+TEST_CASE("Container SoA Vector Columns", "[container]")
+{
+	test_resource r;
+
+	{
+		soa_vector<uint8_t, double, uint16_t> v(r);
+		v.reserve(3);
+		REQUIRE(v.capacity() == 3);
+		REQUIRE(r.get_last_alloc_align() == alignof(double));
+		// Each column is aligned for its type: 3 bytes, then 5 bytes of padding, then 3 doubles, then 3 uint16_t
+		REQUIRE(r.get_last_alloc() == 8 + 3 * sizeof(double) + 3 * sizeof(uint16_t));
+
+		for (int i = 0; i < 100; ++i) {
+			if (i % 2 == 0) {
+				v.push_back({ static_cast<uint8_t>(i), i * 0.5, static_cast<uint16_t>(i * 3) });
+			}
+			else {
+				v.emplace_back(static_cast<uint8_t>(i), i * 0.5, static_cast<uint16_t>(i * 3));
+			}
+		}
+
+		REQUIRE(v.size() == 100);
+		REQUIRE(v.capacity() >= 100);
+		REQUIRE(reinterpret_cast<uintptr_t>(v.data<1>()) % alignof(double) == 0);
+		REQUIRE(reinterpret_cast<uintptr_t>(v.data<2>()) % alignof(uint16_t) == 0);
+
+		auto const doubles = v.column<1>();
+		REQUIRE(doubles.size() == 100);
+		REQUIRE(std::accumulate(doubles.begin(), doubles.end(), 0.0) == 2475.0);
+
+		auto const shorts = v.column<2>();
+		for (size_t i = 0; i < shorts.size(); ++i) {
+			REQUIRE(shorts[i] == i * 3);
+		}
+
+		auto [byte, d, s] = v[42];
+		REQUIRE(byte == 42);
+		REQUIRE(d == 21.0);
+		s = 7;
+		REQUIRE(v.column<2>()[42] == 7);
+
+		v.pop_back();
+		REQUIRE(v.size() == 99);
+		v.resize(10);
+		REQUIRE(v.size() == 10);
+		v.shrink_to_fit();
+		REQUIRE(v.capacity() == 10);
+		REQUIRE(std::get<1>(v[9]) == 4.5);
+
+		v.resize(20);
+		REQUIRE(v.size() == 20);
+		REQUIRE(std::get<0>(v[9]) == 9);
+
+		v.clear();
+		REQUIRE(v.is_empty());
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+TEST_CASE("Container SoA Vector Non-Trivial", "[container]")
+{
+	test_resource r;
+
+	{
+		soa_vector<std::string, std::unique_ptr<int>> v(r);
+		for (int i = 0; i < 50; ++i) {
+			v.emplace_back(std::string(i, 'a'), std::make_unique<int>(i));
+		}
+
+		for (int i = 0; i < 50; ++i) {
+			REQUIRE(v.column<0>()[i] == std::string(i, 'a'));
+			REQUIRE(*v.column<1>()[i] == i);
+		}
+
+		v.resize(60);
+		REQUIRE(v.column<0>()[55].empty());
+		REQUIRE(v.column<1>()[55] == nullptr);
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+namespace
+{
+	struct throwing_copy
+	{
+		static inline int copies_left = 0;
+		static inline int alive = 0;
+
+		int value;
+
+		explicit throwing_copy(int v) : value(v) { ++alive; }
+		throwing_copy(throwing_copy const& rhs)
+			: value(rhs.value)
+		{
+			if (copies_left-- == 0) {
+				throw 0;
+			}
+			++alive;
+		}
+		~throwing_copy() { --alive; }
+	};
+}
+
+TEST_CASE("Container SoA Vector Throwing Relocation", "[container]")
+{
+	test_resource r;
+
+	{
+		soa_vector<std::unique_ptr<int>, throwing_copy> v(r);
+		throwing_copy::copies_left = 100;
+		v.reserve(4);
+		for (int i = 0; i < 4; ++i) {
+			v.emplace_back(std::make_unique<int>(i), throwing_copy(i));
+		}
+		REQUIRE(throwing_copy::alive == 4);
+
+		// A throwing copy while growing leaves the soa_vector unchanged
+		throwing_copy::copies_left = 2;
+		REQUIRE_THROWS(v.emplace_back(std::make_unique<int>(4), throwing_copy(4)));
+		REQUIRE(v.size() == 4);
+		REQUIRE(v.capacity() == 4);
+		REQUIRE(throwing_copy::alive == 4);
+		for (int i = 0; i < 4; ++i) {
+			REQUIRE(*v.column<0>()[i] == i);
+			REQUIRE(v.column<1>()[i].value == i);
+		}
+
+		throwing_copy::copies_left = 100;
+		v.emplace_back(std::make_unique<int>(4), throwing_copy(4));
+		REQUIRE(v.size() == 5);
+		REQUIRE(*v.column<0>()[4] == 4);
+		REQUIRE(v.column<1>()[3].value == 3);
+	}
+
+	REQUIRE(throwing_copy::alive == 0);
+	REQUIRE(r.get_current_alloc() == 0);
+}
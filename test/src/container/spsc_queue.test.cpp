@@ -0,0 +1,140 @@
+#include "kaballoc/container/spsc_queue.h"
+
+#include <catch.hpp>
+
+#include "kaballoc/memory/resource_reference.h"
+#include "kaballoc/memory/new_resource.h"
+#include "kaballoc/std/string.h"
+#include "test_resource.h"
+
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+template<typename T>
+using spsc_queue = kab::spsc_queue<T, kab::resource_reference<test_resource>>;
+
+TEST_CASE("Container SPSC Queue Compilation", "[container]")
+{
+	REQUIRE(!std::is_copy_constructible_v<spsc_queue<int>>);
+	REQUIRE(!std::is_move_constructible_v<spsc_queue<int>>);
+	REQUIRE(!std::is_copy_assignable_v<spsc_queue<int>>);
+	REQUIRE(!std::is_move_assignable_v<spsc_queue<int>>);
+	REQUIRE(std::is_constructible_v<kab::spsc_queue<int, kab::new_resource>, size_t>);
+	REQUIRE(!kab::is_trivially_relocatable_v<spsc_queue<int>>);
+	REQUIRE(alignof(spsc_queue<int>) == kab::cache_line_size);
+}
+
+TEST_CASE("Container SPSC Queue Push Pop", "[container]")
+{
+	test_resource r;
+
+	{
+		spsc_queue<int> q(5, r);
+		REQUIRE(q.capacity() == 8);
+		REQUIRE(q.is_empty());
+		REQUIRE(r.get_last_alloc() == 8 * sizeof(int));
+		REQUIRE(q.get_resource() == kab::make_reference(r));
+
+		int value = -1;
+		REQUIRE(!q.try_pop(value));
+		REQUIRE(value == -1);
+
+		// Goes around the storage a few times
+		int next_pop = 0;
+		int next_push = 0;
+		for (int round = 0; round < 5; ++round) {
+			while (q.try_push(next_push)) {
+				++next_push;
+			}
+			REQUIRE(q.size() == 8);
+
+			for (int i = 0; i < 5; ++i) {
+				REQUIRE(q.try_pop(value));
+				REQUIRE(value == next_pop++);
+			}
+			REQUIRE(q.size() == 3);
+		}
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+TEST_CASE("Container SPSC Queue Bulk", "[container]")
+{
+	test_resource r;
+
+	spsc_queue<int> q(8, r);
+	std::vector<int> src(20);
+	std::iota(src.begin(), src.end(), 0);
+
+	REQUIRE(q.try_push_n(src.data(), 6) == 6);
+	int dst[8];
+	REQUIRE(q.try_pop_n(dst, 4) == 4);
+	REQUIRE(std::equal(dst, dst + 4, src.begin()));
+
+	// Wraps around the end of the storage, and only copies what fits
+	REQUIRE(q.try_push_n(src.data() + 6, 14) == 6);
+	REQUIRE(q.size() == 8);
+	REQUIRE(q.try_pop_n(dst, 20) == 8);
+	REQUIRE(std::equal(dst, dst + 8, src.begin() + 4));
+	REQUIRE(q.try_pop_n(dst, 1) == 0);
+}
+
+TEST_CASE("Container SPSC Queue Destruction", "[container]")
+{
+	test_resource r;
+
+	{
+		spsc_queue<std::unique_ptr<std::string>> q(4, r);
+		q.try_push(std::make_unique<std::string>(100, 'a'));
+		q.try_push(std::make_unique<std::string>(100, 'b'));
+		q.try_emplace(new std::string(100, 'c'));
+
+		auto out = std::make_unique<std::string>(100, 'z');
+		REQUIRE(q.try_pop(out));
+		REQUIRE(*out == std::string(100, 'a'));
+
+		std::string strings[] = { "d", "e" };
+		spsc_queue<std::string> string_q(2, r);
+		REQUIRE(string_q.try_push_n(strings, 2) == 2);
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+TEST_CASE("Container SPSC Queue Threads", "[container]")
+{
+	constexpr size_t count = 100000;
+	kab::spsc_queue<size_t, kab::new_resource> q(64);
+
+	std::thread producer([&] {
+		size_t i = 0;
+		while (i < count) {
+			if (i % 2 == 0) {
+				if (q.try_push(i)) {
+					++i;
+				}
+			}
+			else {
+				size_t const batch[] = { i, i + 1, i + 2 };
+				i += q.try_push_n(batch, std::min<size_t>(3, count - i));
+			}
+		}
+	});
+
+	bool ordered = true;
+	size_t next = 0;
+	size_t value;
+	while (next < count) {
+		if (q.try_pop(value)) {
+			ordered &= value == next;
+			++next;
+		}
+	}
+	producer.join();
+
+	REQUIRE(ordered);
+	REQUIRE(q.is_empty());
+}
@@ -0,0 +1,187 @@
+#include "kaballoc/container/string.h"
+
+#include <catch.hpp>
+
+#include "kaballoc/container/vector.h"
+#include "kaballoc/memory/resource_reference.h"
+#include "kaballoc/memory/new_resource.h"
+#include "test_resource.h"
+
+#include <string>
+
+using string = kab::string<kab::resource_reference<test_resource>>;
+
+TEST_CASE("Container String Compilation", "[container]")
+{
+	REQUIRE(!std::is_default_constructible_v<string>); // kab::resource_reference is not default constructible
+	REQUIRE(std::is_default_constructible_v<kab::string<kab::new_resource>>);
+	REQUIRE(!std::is_copy_constructible_v<string>);
+	REQUIRE(!std::is_copy_assignable_v<string>);
+	REQUIRE(std::is_nothrow_move_constructible_v<string>);
+	REQUIRE(std::is_nothrow_move_assignable_v<string>);
+	REQUIRE(std::is_nothrow_swappable_v<string>);
+	REQUIRE(kab::is_trivially_relocatable_v<string>);
+	REQUIRE(kab::is_trivially_relocatable_v<kab::string<kab::new_resource>>);
+	REQUIRE(sizeof(kab::string<kab::new_resource>) == 3 * sizeof(void*));
+	REQUIRE(kab::string<kab::new_resource>::inline_capacity == 3 * sizeof(void*) - 1);
+}
+
+TEST_CASE("Container String Empty", "[container]")
+{
+	test_resource r;
+
+	{
+		string s(r);
+		REQUIRE(s.is_empty());
+		REQUIRE(s.size() == 0);
+		REQUIRE(s.is_small());
+		REQUIRE(s.capacity() == string::inline_capacity);
+		REQUIRE(s.c_str()[0] == '\0');
+		REQUIRE(s.begin() == s.end());
+		REQUIRE(s == "");
+		REQUIRE(s.get_resource() == kab::make_reference(r));
+
+		s.append("");
+		s.assign("");
+
+		string move(std::move(s));
+		REQUIRE(move.is_empty());
+		s = std::move(move);
+		s.swap(move);
+		s.shrink_to_fit();
+		s.clear_and_shrink();
+	}
+
+	REQUIRE(r.get_total_alloc() == 0);
+}
+
+TEST_CASE("Container String Small", "[container]")
+{
+	test_resource r;
+
+	{
+		std::string const full(string::inline_capacity, 'x');
+
+		string s(full, r);
+		REQUIRE(s.is_small());
+		REQUIRE(s.size() == string::inline_capacity);
+		REQUIRE(s == full);
+		REQUIRE(s.c_str()[s.size()] == '\0');
+
+		s.pop_back();
+		s.push_back('y');
+		REQUIRE(s.back() == 'y');
+		REQUIRE(s.is_small());
+
+		s.resize(3);
+		REQUIRE(s == "xxx");
+		s.resize(5, 'z');
+		REQUIRE(s == "xxxzz");
+		s += "ab";
+		s += 'c';
+		REQUIRE(s == "xxxzzabc");
+		REQUIRE(s < "y");
+		REQUIRE(s > "xxx");
+		REQUIRE(std::string(s.view()) == "xxxzzabc");
+
+		s.clear();
+		REQUIRE(s.is_empty());
+		REQUIRE(s.is_small());
+	}
+
+	REQUIRE(r.get_total_alloc() == 0);
+}
+
+TEST_CASE("Container String Heap", "[container]")
+{
+	test_resource r;
+
+	{
+		string s(r);
+		std::string expected;
+		for (int i = 0; i < 100; ++i) {
+			s.push_back(static_cast<char>('a' + i % 26));
+			expected.push_back(static_cast<char>('a' + i % 26));
+			REQUIRE(s.c_str()[s.size()] == '\0');
+		}
+
+		REQUIRE(!s.is_small());
+		REQUIRE(s == expected);
+		REQUIRE(r.get_last_alloc_align() == 1);
+
+		// Geometric growth: the number of allocations grows with the logarithm of the size
+		REQUIRE(r.get_total_alloc() < 4 * 128);
+		REQUIRE(s.capacity() >= 100);
+
+		s.shrink_to_fit();
+		REQUIRE(s.capacity() == 100);
+		REQUIRE(s == expected);
+
+		s.resize(10);
+		s.shrink_to_fit();
+		REQUIRE(s.is_small());
+		REQUIRE(s == expected.substr(0, 10));
+		REQUIRE(r.get_current_alloc() == 0);
+
+		s.reserve(50);
+		REQUIRE(!s.is_small());
+		REQUIRE(s.capacity() == 50);
+		REQUIRE(s == expected.substr(0, 10));
+
+		s.assign(expected);
+		REQUIRE(s == expected);
+		s.assign("short");
+		REQUIRE(s == "short");
+		REQUIRE(!s.is_small());
+
+		string move(std::move(s));
+		REQUIRE(move == "short");
+		REQUIRE(s.is_empty());
+		REQUIRE(s.is_small());
+
+		move.clear_and_shrink();
+		REQUIRE(move.is_small());
+		REQUIRE(r.get_current_alloc() == 0);
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+TEST_CASE("Container String Self Append", "[container]")
+{
+	test_resource r;
+
+	{
+		string s("0123456789", r);
+		s.append(s.view());
+		REQUIRE(s == "01234567890123456789");
+		s.append(s.view());
+		REQUIRE(!s.is_small());
+		REQUIRE(s == "0123456789012345678901234567890123456789");
+		s.append(std::string_view(s).substr(5, 3));
+		REQUIRE(s == "0123456789012345678901234567890123456789567");
+		s.assign(std::string_view(s).substr(10, 5));
+		REQUIRE(s == "01234");
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+TEST_CASE("Container String Relocation", "[container]")
+{
+	test_resource r;
+
+	{
+		// The vector relocates the strings with memcpy, small and heap strings both stay valid
+		kab::vector<string, kab::resource_reference<test_resource>> v(r);
+		for (size_t i = 0; i < 50; ++i) {
+			v.emplace_back(std::string(i, 'a'), r);
+		}
+		for (size_t i = 0; i < 50; ++i) {
+			REQUIRE(v[i] == std::string(i, 'a'));
+			REQUIRE(v[i].c_str()[i] == '\0');
+		}
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
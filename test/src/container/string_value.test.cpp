@@ -0,0 +1,93 @@
+#include "kaballoc/container/string_value.h"
+
+#include "test_resource.h"
+
+#include <catch.hpp>
+
+#include "kaballoc/memory/resource_reference.h"
+#include "kaballoc/memory/new_resource.h"
+
+#include <vector>
+
+using string_value = kab::string_value<kab::resource_reference<test_resource>>;
+
+TEST_CASE("Container String Value Compilation", "[container]")
+{
+	REQUIRE(!std::is_default_constructible_v<string_value>); // kab::resource_reference is not default constructible
+	REQUIRE(std::is_default_constructible_v<kab::string_value<kab::new_resource>>);
+	REQUIRE(std::is_nothrow_copy_constructible_v<string_value>);
+	REQUIRE(std::is_nothrow_copy_assignable_v<string_value>);
+	REQUIRE(std::is_nothrow_move_constructible_v<string_value>);
+	REQUIRE(std::is_nothrow_move_assignable_v<string_value>);
+	REQUIRE(std::is_nothrow_swappable_v<string_value>);
+}
+
+TEST_CASE("Container String Value Empty", "[container]")
+{
+	test_resource r;
+
+	string_value v(r);
+	REQUIRE(v.is_empty());
+	REQUIRE(v.size() == 0);
+	REQUIRE(v.begin() == v.end());
+	REQUIRE(v == "");
+	REQUIRE(v.get_resource() == kab::make_reference(r));
+
+	string_value copy(v);
+	REQUIRE(copy.is_empty());
+	v.assign("");
+	REQUIRE(v.is_empty());
+	REQUIRE(v.substr(0).is_empty());
+
+	REQUIRE(r.get_total_alloc() == 0);
+}
+
+TEST_CASE("Container String Value Sharing", "[container]")
+{
+	test_resource r;
+
+	{
+		string_value line("key=value;other=thing", r);
+		REQUIRE(line == "key=value;other=thing");
+		REQUIRE(r.get_total_alloc() > 0);
+		size_t const allocated = r.get_total_alloc();
+
+		// Tokens share the characters of the line
+		std::vector<string_value> tokens;
+		std::string_view const view = line;
+		size_t start = 0;
+		for (size_t i = 0; i <= view.size(); ++i) {
+			if (i == view.size() || view[i] == '=' || view[i] == ';') {
+				tokens.push_back(line.substr(start, i - start));
+				start = i + 1;
+			}
+		}
+
+		REQUIRE(tokens.size() == 4);
+		REQUIRE(tokens[0] == "key");
+		REQUIRE(tokens[1] == "value");
+		REQUIRE(tokens[2] == "other");
+		REQUIRE(tokens[3] == "thing");
+		REQUIRE(tokens[1].data() == line.data() + 4);
+		REQUIRE(line.substr(18, 100) == "ing");
+		REQUIRE(r.get_total_alloc() == allocated);
+
+		// The characters are kept alive by the tokens
+		line = string_value(r);
+		REQUIRE(r.get_current_alloc() == allocated);
+		REQUIRE(tokens[3] == "thing");
+
+		string_value copy = tokens[0];
+		copy = tokens[1];
+		copy = copy;
+		REQUIRE(copy == "value");
+		copy.assign(copy.view().substr(1, 2));
+		REQUIRE(copy == "al");
+		REQUIRE(copy < "b");
+
+		tokens.clear();
+		REQUIRE(r.get_current_alloc() != 0);
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
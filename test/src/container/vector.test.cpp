@@ -4,6 +4,7 @@
 
 #include "kaballoc/memory/resource_reference.h"
 #include "kaballoc/memory/new_resource.h"
+#include "kaballoc/std/string.h"
 #include "test_resource.h"
 
 template<typename T>
@@ -183,4 +184,199 @@ TEST_CASE("Container Vector Overallocate", "[container]")
 	REQUIRE(r.get_total_alloc() == current_alloc); // expected no reallocation
 	REQUIRE(v.size() == overallocate_size);
 	REQUIRE(v.capacity() == overallocate_size);
-}
\ No newline at end of file
+}
+
+namespace
+{
+	// Points to itself, so memcpy would break it
+	struct self_reference
+	{
+		self_reference* self = this;
+		int value;
+
+		explicit self_reference(int v) noexcept : value(v) {}
+		self_reference(self_reference && rhs) noexcept : value(rhs.value) {}
+		self_reference& operator=(self_reference &&) = delete;
+	};
+
+	// Copy throws after a given number of copies, and the move constructor is not noexcept
+	struct throwing_copy
+	{
+		static inline int copies_left = 0;
+
+		int value;
+
+		explicit throwing_copy(int v) : value(v) {}
+		throwing_copy(throwing_copy const& rhs) 
+			: value(rhs.value) 
+		{
+			if (copies_left-- == 0)
+			{
+				throw 0;
+			}
+		}
+		throwing_copy(throwing_copy && rhs) noexcept(false) : value(rhs.value) {}
+	};
+}
+
+TEST_CASE("Container Vector Non-Trivial Relocation", "[container]")
+{
+	REQUIRE(!kab::is_trivially_relocatable_v<self_reference>);
+	REQUIRE(kab::is_nothrow_relocatable_v<self_reference>);
+
+	test_resource r;
+
+	{
+		vector<self_reference> v(r);
+		for (int i = 0; i < 100; ++i)
+		{
+			v.emplace_back(i);
+		}
+
+		REQUIRE(v.size() == 100);
+		for (int i = 0; i < 100; ++i)
+		{
+			REQUIRE(v[i].self == &v[i]);
+			REQUIRE(v[i].value == i);
+		}
+
+		v.shrink_to_fit();
+		REQUIRE(v.capacity() == 100);
+		REQUIRE(v.front().self == &v.front());
+		REQUIRE(v.back().self == &v.back());
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+TEST_CASE("Container Vector String", "[container]")
+{
+	test_resource r;
+
+	{
+		vector<std::string> v(r);
+		for (int i = 0; i < 50; ++i)
+		{
+			v.push_back(std::string(i, 'a')); // both small and heap strings
+		}
+
+		for (int i = 0; i < 50; ++i)
+		{
+			REQUIRE(v[i] == std::string(i, 'a'));
+		}
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+TEST_CASE("Container Vector Throwing Relocation", "[container]")
+{
+	REQUIRE(!kab::is_nothrow_relocatable_v<throwing_copy>);
+
+	test_resource r;
+
+	{
+		vector<throwing_copy> v(r);
+		v.reserve(4);
+		for (int i = 0; i < 4; ++i)
+		{
+			v.emplace_back(i);
+		}
+		throwing_copy const* const data = v.data();
+		size_t const alloc = r.get_current_alloc();
+
+		throwing_copy::copies_left = 2; // the third relocated element throws
+		REQUIRE_THROWS(v.reserve(8));
+
+		// Strong exception guarantee: the vector still has its elements and its storage
+		REQUIRE(r.get_current_alloc() == alloc);
+		REQUIRE(v.data() == data);
+		REQUIRE(v.size() == 4);
+		REQUIRE(v.capacity() == 4);
+		for (int i = 0; i < 4; ++i)
+		{
+			REQUIRE(v[i].value == i);
+		}
+
+		throwing_copy::copies_left = 4;
+		v.reserve(8);
+		REQUIRE(v.capacity() == 8);
+		REQUIRE(v.size() == 4);
+		REQUIRE(v[3].value == 3);
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+TEST_CASE("Container Vector Resize Value", "[container]")
+{
+	test_resource r;
+
+	{
+		vector<int> v(r);
+		v.resize(10, 7);
+		REQUIRE(v.size() == 10);
+		REQUIRE(v[0] == 7);
+		REQUIRE(v[9] == 7);
+
+		// The value may be an element of the vector, even when resizing reallocates
+		v[9] = 3;
+		v.resize(v.capacity() + 100, v[9]);
+		REQUIRE(v[8] == 7);
+		REQUIRE(v[9] == 3);
+		REQUIRE(v.back() == 3);
+
+		v.resize(5, 1);
+		REQUIRE(v.size() == 5);
+		REQUIRE(v.back() == 7);
+	}
+
+	{
+		vector<std::string> v(r);
+		v.resize(3, std::string(100, 'a'));
+		v.resize(100, v[1]);
+		REQUIRE(v.size() == 100);
+		REQUIRE(v.back() == std::string(100, 'a'));
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+TEST_CASE("Container Vector Swap Remove", "[container]")
+{
+	test_resource r;
+
+	{
+		vector<int> v(r);
+		for (int i = 0; i < 5; ++i) {
+			v.push_back(i);
+		}
+
+		v.swap_remove(1);
+		REQUIRE(v.size() == 4);
+		REQUIRE(v[0] == 0);
+		REQUIRE(v[1] == 4);
+		REQUIRE(v[3] == 3);
+
+		v.swap_remove(3);
+		REQUIRE(v.size() == 3);
+		REQUIRE(v.back() == 2);
+	}
+
+	{
+		vector<std::string> v(r);
+		v.emplace_back(100, 'a');
+		v.emplace_back(100, 'b');
+		v.emplace_back(100, 'c');
+
+		v.swap_remove(0);
+		REQUIRE(v.size() == 2);
+		REQUIRE(v[0] == std::string(100, 'c'));
+		REQUIRE(v[1] == std::string(100, 'b'));
+		v.swap_remove(1);
+		v.swap_remove(0);
+		REQUIRE(v.is_empty());
+	}
+
+	REQUIRE(r.get_current_alloc() == 0);
+}
@@ -0,0 +1,208 @@
+#include "kaballoc/memory/budget_resource.h"
+#include "kaballoc/memory/static_resource.h"
+#include "kaballoc/memory/resource_reference.h"
+#include "kaballoc/memory/detail/owns.h"
+#include "kaballoc/container/vector.h"
+
+#include "test_resource.h"
+
+#include <catch.hpp>
+
+#include <atomic>
+#include <new>
+#include <thread>
+#include <vector>
+
+static_assert(!kab::detail::has_owns_v<kab::budget_resource<kab::resource_reference<test_resource>>>);
+static_assert(kab::detail::has_owns_v<kab::budget_resource<kab::resource_reference<kab::static_resource<256>>>>);
+
+using budget_t = kab::budget_resource<kab::resource_reference<test_resource>>;
+
+TEST_CASE("Budget limits", "[memory]")
+{
+	test_resource tester;
+	kab::memory_budget budget(1000);
+	budget_t resource(tester, budget);
+
+	kab::byte_span const a = resource.allocate(600, kab::default_align_v);
+	REQUIRE(budget.used() == 600);
+	REQUIRE_THROWS_AS(resource.allocate(401, kab::default_align_v), std::bad_alloc);
+	REQUIRE(budget.used() == 600);
+	REQUIRE(tester.get_current_alloc() == 600); // the inner resource was not called
+
+	kab::byte_span const b = resource.allocate(400, kab::default_align_v);
+	REQUIRE(budget.used() == 1000);
+	resource.deallocate(a, kab::default_align_v);
+	resource.deallocate(b, kab::default_align_v);
+	REQUIRE(budget.used() == 0);
+	REQUIRE(budget.peak() == 1000);
+
+	budget.reset_peak();
+	REQUIRE(budget.peak() == 0);
+
+	// Copies charge the same budget
+	budget_t copy = resource;
+	REQUIRE(copy == resource);
+	kab::byte_span const c = copy.allocate(10, kab::default_align_v);
+	REQUIRE(&resource.budget() == &budget);
+	REQUIRE(budget.used() == 10);
+	resource.deallocate(c, kab::default_align_v);
+
+	// Containers see a failed charge as std::bad_alloc
+	kab::vector<int, budget_t> v{ resource };
+	v.reserve(200);
+	REQUIRE_THROWS_AS(v.reserve(300), std::bad_alloc);
+	REQUIRE(v.capacity() == 200);
+}
+
+TEST_CASE("Budget hierarchy", "[memory]")
+{
+	test_resource tester;
+	kab::memory_budget process(1000);
+	kab::memory_budget tenant(800, kab::size_t_max_v, &process);
+	kab::memory_budget query_a(500, kab::size_t_max_v, &tenant);
+	kab::memory_budget query_b(500, kab::size_t_max_v, &tenant);
+	REQUIRE(query_a.parent() == &tenant);
+
+	budget_t resource_a(tester, query_a);
+	budget_t resource_b(tester, query_b);
+
+	kab::byte_span const a = resource_a.allocate(500, kab::default_align_v);
+	REQUIRE(tenant.used() == 500);
+	REQUIRE(process.used() == 500);
+
+	// query_b is under its own limit, but the tenant is not
+	REQUIRE_THROWS_AS(resource_b.allocate(400, kab::default_align_v), std::bad_alloc);
+	REQUIRE(query_b.used() == 0);
+	REQUIRE(query_b.peak() == 0); // a refused charge doesn't raise the peak
+	REQUIRE(tenant.used() == 500);
+
+	kab::byte_span const b = resource_b.allocate(300, kab::default_align_v);
+	REQUIRE(tenant.used() == 800);
+	REQUIRE(process.used() == 800);
+
+	resource_a.deallocate(a, kab::default_align_v);
+	resource_b.deallocate(b, kab::default_align_v);
+	REQUIRE(process.used() == 0);
+	REQUIRE(tenant.peak() == 800);
+	REQUIRE(query_a.peak() == 500);
+}
+
+TEST_CASE("Budget handlers", "[memory]")
+{
+	struct spill
+	{
+		budget_t* resource;
+		kab::byte_span cached;
+		int soft_calls = 0;
+		int exceeded_calls = 0;
+	};
+
+	test_resource tester;
+	kab::memory_budget budget(1000, 500);
+	budget_t resource(tester, budget);
+	spill state{ &resource, {}, 0, 0 };
+
+	budget.set_soft_limit_handler([](kab::memory_budget&, size_t, void* context)
+	{
+		++static_cast<spill*>(context)->soft_calls;
+	}, &state);
+	// Frees the cache when the budget is exceeded, then retries
+	budget.set_exceeded_handler([](kab::memory_budget&, size_t, void* context)
+	{
+		spill& s = *static_cast<spill*>(context);
+		++s.exceeded_calls;
+		if (s.cached.data == nullptr)
+		{
+			return false;
+		}
+		s.resource->deallocate(s.cached, kab::default_align_v);
+		s.cached = {};
+		return true;
+	}, &state);
+
+	state.cached = resource.allocate(400, kab::default_align_v);
+	REQUIRE(state.soft_calls == 0);
+	kab::byte_span const a = resource.allocate(200, kab::default_align_v);
+	REQUIRE(state.soft_calls == 1);
+	kab::byte_span const b = resource.allocate(100, kab::default_align_v);
+	REQUIRE(state.soft_calls == 1); // only when crossing
+
+	kab::byte_span const c = resource.allocate(600, kab::default_align_v);
+	REQUIRE(state.exceeded_calls == 1);
+	REQUIRE(state.cached.data == nullptr);
+	REQUIRE(budget.used() == 900);
+
+	REQUIRE_THROWS_AS(resource.allocate(200, kab::default_align_v), std::bad_alloc);
+	REQUIRE(state.exceeded_calls == 2);
+
+	resource.deallocate(a, kab::default_align_v);
+	resource.deallocate(b, kab::default_align_v);
+	resource.deallocate(c, kab::default_align_v);
+	REQUIRE(tester.get_current_alloc() == 0);
+}
+
+TEST_CASE("Budget lowered limits", "[memory]")
+{
+	kab::memory_budget parent(100);
+	kab::memory_budget child(1000, 50, &parent);
+	int soft_calls = 0;
+	child.set_soft_limit_handler([](kab::memory_budget&, size_t, void* context)
+	{
+		++*static_cast<int*>(context);
+	}, &soft_calls);
+
+	// The parent refuses the charge: the child's soft limit and peak are untouched
+	REQUIRE_FALSE(child.try_charge(200));
+	REQUIRE(soft_calls == 0);
+	REQUIRE(child.peak() == 0);
+
+	REQUIRE(child.try_charge(80));
+	REQUIRE(soft_calls == 1);
+
+	// A limit lower than the usage refuses the following charges
+	child.set_limits(60);
+	REQUIRE_FALSE(child.try_charge(1));
+	REQUIRE(child.used() == 80);
+	REQUIRE(parent.used() == 80);
+
+	child.release(80);
+	REQUIRE(child.try_charge(60));
+	child.release(60);
+	REQUIRE(parent.used() == 0);
+}
+
+TEST_CASE("Budget threads", "[memory]")
+{
+	kab::memory_budget parent(64 * 100);
+	kab::memory_budget child(64 * 80, kab::size_t_max_v, &parent);
+
+	std::atomic<bool> over_limit = false;
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t)
+	{
+		threads.emplace_back([&]
+		{
+			for (int i = 0; i < 10000; ++i)
+			{
+				if (child.try_charge(64))
+				{
+					if (child.used() > child.hard_limit())
+					{
+						over_limit = true;
+					}
+					child.release(64);
+				}
+			}
+		});
+	}
+	for (std::thread& t : threads)
+	{
+		t.join();
+	}
+	REQUIRE_FALSE(over_limit);
+	REQUIRE(child.used() == 0);
+	REQUIRE(parent.used() == 0);
+	REQUIRE(child.peak() <= child.hard_limit());
+	REQUIRE(child.peak() >= 64);
+}
@@ -0,0 +1,179 @@
+#include "kaballoc/memory/checking_resource.h"
+#include "kaballoc/memory/freelist_resource.h"
+#include "kaballoc/memory/static_resource.h"
+#include "kaballoc/memory/resource_reference.h"
+#include "kaballoc/memory/detail/owns.h"
+#include "kaballoc/container/vector.h"
+
+#include "test_resource.h"
+
+#include <catch.hpp>
+
+#include <new>
+
+static_assert(!kab::detail::has_owns_v<kab::checking_resource<kab::resource_reference<test_resource>>>);
+static_assert(kab::detail::has_owns_v<kab::checking_resource<kab::resource_reference<kab::static_resource<256>>>>);
+
+namespace
+{
+	kab::checking_report reports[8];
+	size_t report_count = 0;
+
+	void record_report(kab::checking_report const& report)
+	{
+		if (report_count < 8)
+		{
+			reports[report_count] = report;
+		}
+		++report_count;
+	}
+}
+
+TEST_CASE("Checking valid deallocations", "[memory]")
+{
+	report_count = 0;
+	test_resource tester;
+	{
+		kab::checking_resource<kab::resource_reference<test_resource>> checker{ kab::resource_reference<test_resource>(tester) };
+		checker.set_handler(&record_report);
+
+		kab::byte_span const a = checker.allocate(24, kab::align_v<double>);
+		kab::byte_span const b = checker.over_allocate(100, kab::default_align_v);
+		REQUIRE(checker.live_allocations() == 2);
+		REQUIRE(checker.live_bytes() == 24 + b.size);
+
+		checker.deallocate(a, kab::align_v<double>);
+		checker.deallocate(b, kab::default_align_v);
+		REQUIRE(checker.live_allocations() == 0);
+		REQUIRE(checker.live_bytes() == 0);
+
+		// Under containers and freelists
+		kab::vector<int, kab::resource_reference<decltype(checker)>> v{ kab::resource_reference<decltype(checker)>(checker) };
+		for (int i = 0; i < 100; ++i)
+		{
+			v.push_back(i);
+		}
+		v.clear_and_shrink();
+
+		kab::freelist_resource<kab::resource_reference<decltype(checker)>, 32> freelist{ kab::resource_reference<decltype(checker)>(checker) };
+		kab::byte_span const f = freelist.allocate(20, kab::default_align_v);
+		freelist.deallocate(f, kab::default_align_v);
+		REQUIRE(checker.live_allocations() == 1); // kept by the freelist
+	}
+	REQUIRE(report_count == 0);
+	REQUIRE(tester.get_current_alloc() == 0);
+}
+
+TEST_CASE("Checking protocol errors", "[memory]")
+{
+	report_count = 0;
+	test_resource tester;
+	kab::checking_resource<kab::resource_reference<test_resource>> checker{ kab::resource_reference<test_resource>(tester) };
+	checker.set_handler(&record_report);
+
+	kab::byte_span const a = checker.allocate(24, kab::align_v<double>);
+	checker.deallocate({ a.data, 16 }, kab::align_v<double>);
+	REQUIRE(report_count == 1);
+	REQUIRE(reports[0].error == kab::checking_error::size_mismatch);
+	REQUIRE(reports[0].span.size == 16);
+	REQUIRE(reports[0].expected_size == 24);
+	// The recorded span was forwarded
+	REQUIRE(tester.get_last_dealloc() == 24);
+	REQUIRE(tester.get_current_alloc() == 0);
+
+	// Double free is not forwarded
+	checker.deallocate(a, kab::align_v<double>);
+	REQUIRE(report_count == 2);
+	REQUIRE(reports[1].error == kab::checking_error::unknown_pointer);
+	REQUIRE(reports[1].span.data == a.data);
+
+	kab::byte_span const b = checker.allocate(64, kab::align_t(32));
+	checker.deallocate(b, kab::align_t(16));
+	REQUIRE(report_count == 3);
+	REQUIRE(reports[2].error == kab::checking_error::alignment_mismatch);
+	REQUIRE(reports[2].expected_alignment == 32);
+	REQUIRE(tester.get_last_dealloc_align() == 32);
+
+	int foreign = 0;
+	checker.deallocate({ reinterpret_cast<kab::byte*>(&foreign), sizeof(foreign) }, kab::align_v<int>);
+	REQUIRE(report_count == 4);
+	REQUIRE(reports[3].error == kab::checking_error::unknown_pointer);
+	REQUIRE(tester.get_current_alloc() == 0);
+}
+
+TEST_CASE("Checking duplicate allocations", "[memory]")
+{
+	// Returns the same buffer for every allocation
+	struct repeating_resource
+	{
+		alignas(16) kab::byte buffer[64];
+
+		kab::byte_span allocate(size_t size, kab::align_t) noexcept { return { buffer, size }; }
+		void deallocate(kab::byte_span, kab::align_t) noexcept {}
+		bool operator==(repeating_resource const& rhs) const noexcept { return this == &rhs; }
+	};
+
+	report_count = 0;
+	repeating_resource repeating;
+	kab::checking_resource<kab::resource_reference<repeating_resource>> checker{ kab::resource_reference<repeating_resource>(repeating) };
+	checker.set_handler(&record_report);
+
+	kab::byte_span const a = checker.allocate(16, kab::default_align_v);
+	kab::byte_span const b = checker.allocate(32, kab::default_align_v);
+	REQUIRE(a.data == b.data);
+	REQUIRE(report_count == 1);
+	REQUIRE(reports[0].error == kab::checking_error::duplicate_allocation);
+	REQUIRE(reports[0].span.size == 32);
+	REQUIRE(reports[0].expected_size == 16);
+	REQUIRE(checker.live_allocations() == 1);
+	REQUIRE(checker.live_bytes() == 32);
+
+	checker.deallocate(b, kab::default_align_v);
+	REQUIRE(report_count == 1);
+
+	// Empty spans are not checked
+	checker.deallocate({ repeating.buffer, 0 }, kab::default_align_v);
+	REQUIRE(report_count == 1);
+}
+
+TEST_CASE("Checking exhausted meta resource", "[memory]")
+{
+	report_count = 0;
+	test_resource tester;
+	kab::static_resource<16> meta;
+	using checker_type = kab::checking_resource<kab::resource_reference<test_resource>, kab::resource_reference<kab::static_resource<16>>>;
+	checker_type checker{ kab::resource_reference<test_resource>(tester), kab::resource_reference<kab::static_resource<16>>(meta) };
+	checker.set_handler(&record_report);
+
+	// The allocations can't be recorded, and are returned to the inner resource
+	REQUIRE_THROWS_AS(checker.allocate(24, kab::default_align_v), std::bad_alloc);
+	REQUIRE_THROWS_AS(checker.over_allocate(100, kab::default_align_v), std::bad_alloc);
+	REQUIRE(tester.get_current_alloc() == 0);
+	REQUIRE(report_count == 0);
+}
+
+TEST_CASE("Checking leaks", "[memory]")
+{
+	report_count = 0;
+	test_resource tester;
+	kab::byte_span leaked;
+	{
+		kab::checking_resource<kab::resource_reference<test_resource>> checker{ kab::resource_reference<test_resource>(tester) };
+		checker.set_handler(&record_report);
+		leaked = checker.allocate(40, kab::default_align_v);
+		kab::byte_span const freed = checker.allocate(8, kab::default_align_v);
+		checker.deallocate(freed, kab::default_align_v);
+
+		auto moved = std::move(checker);
+		REQUIRE(moved.live_allocations() == 1);
+		REQUIRE(checker.live_allocations() == 0);
+	}
+	REQUIRE(report_count == 1);
+	REQUIRE(reports[0].error == kab::checking_error::leak);
+	REQUIRE(reports[0].span.data == leaked.data);
+	REQUIRE(reports[0].span.size == 40);
+
+	// Leaks are not deallocated
+	REQUIRE(tester.get_current_alloc() == 40);
+	tester.deallocate(leaked, kab::default_align_v);
+}
@@ -0,0 +1,95 @@
+#include "kaballoc/memory/fallback_resource.h"
+#include "kaballoc/memory/static_resource.h"
+#include "kaballoc/memory/resource_reference.h"
+#include "kaballoc/container/vector.h"
+
+#include <catch.hpp>
+
+#include "test_resource.h"
+
+using static_ref = kab::resource_reference<kab::static_resource<256>>;
+using fallback_resource = kab::fallback_resource<static_ref, kab::resource_reference<test_resource>>;
+
+static_assert(kab::detail::has_owns_v<static_ref>);
+static_assert(!kab::detail::has_owns_v<fallback_resource>); // test_resource doesn't support 'owns'
+static_assert(kab::detail::has_owns_v<kab::fallback_resource<static_ref, static_ref>>);
+
+TEST_CASE("Fallback resource allocations", "[memory]")
+{
+	kab::static_resource<256> primary;
+	test_resource tester;
+
+	{
+		fallback_resource resource(primary, tester);
+
+		// Fits in the primary resource
+		kab::byte_span const small = resource.allocate(128, kab::default_align_v);
+		REQUIRE(primary.owns(small));
+		REQUIRE(tester.get_total_alloc() == 0);
+
+		// Doesn't fit: served by the fallback resource
+		kab::byte_span const big = resource.allocate(256, kab::default_align_v);
+		REQUIRE(!primary.owns(big));
+		REQUIRE(tester.get_current_alloc() == 256);
+
+		// Deallocations are routed to the owner
+		resource.deallocate(big, kab::default_align_v);
+		REQUIRE(tester.get_current_alloc() == 0);
+		resource.deallocate(small, kab::default_align_v);
+		REQUIRE(primary.used() == 0);
+	}
+
+	REQUIRE(tester.get_current_alloc() == 0);
+}
+
+TEST_CASE("Fallback resource chain", "[memory]")
+{
+	kab::static_resource<256> first;
+	kab::static_resource<256> second;
+	test_resource tester;
+
+	using chain = kab::fallback_resource<static_ref, kab::fallback_resource<static_ref, kab::resource_reference<test_resource>>>;
+	chain resource(first, { second, tester });
+
+	kab::byte_span const a = resource.allocate(200, kab::default_align_v);
+	kab::byte_span const b = resource.allocate(200, kab::default_align_v);
+	kab::byte_span const c = resource.allocate(200, kab::default_align_v);
+	REQUIRE(first.owns(a));
+	REQUIRE(second.owns(b));
+	REQUIRE(tester.get_current_alloc() == 200);
+
+	resource.deallocate(c, kab::default_align_v);
+	resource.deallocate(b, kab::default_align_v);
+	resource.deallocate(a, kab::default_align_v);
+	REQUIRE(tester.get_current_alloc() == 0);
+	REQUIRE(first.used() == 0);
+	REQUIRE(second.used() == 0);
+}
+
+TEST_CASE("Fallback resource with vector", "[memory]")
+{
+	kab::static_resource<256> primary;
+	test_resource tester;
+
+	{
+		kab::vector<int, fallback_resource> v(fallback_resource(primary, tester));
+		v.reserve(16);
+		for (int i = 0; i < 16; ++i)
+		{
+			v.push_back(i);
+		}
+		REQUIRE(tester.get_total_alloc() == 0);
+
+		for (int i = 16; i < 1000; ++i)
+		{
+			v.push_back(i);
+		}
+		REQUIRE(tester.get_current_alloc() > 0);
+		for (int i = 0; i < 1000; ++i)
+		{
+			REQUIRE(v[i] == i);
+		}
+	}
+
+	REQUIRE(tester.get_current_alloc() == 0);
+}
@@ -137,3 +137,106 @@ TEST_CASE("Freelist Big Alloc", "[memory]")
 
 	REQUIRE(tester.get_current_alloc() == 0);
 }
+
+TEST_CASE("Freelist Inner Deallocation", "[memory]")
+{
+	test_resource tester;
+
+	{
+		freelist_resource freelist(tester);
+
+		// Big blocks go back to the inner resource with the alignment they were allocated with
+		const kab::byte_span big = freelist.allocate(BlockSize * 2, kab::align_v<int>);
+		const size_t big_align = tester.get_last_alloc_align();
+		freelist.deallocate(big, kab::align_v<int>);
+		REQUIRE(tester.get_last_dealloc_align() == big_align);
+
+		// Over-aligned blocks go back with the block size
+		const kab::byte_span over_aligned = freelist.allocate(16, static_cast<kab::align_t>(BlockSize * 2));
+		freelist.deallocate(over_aligned, static_cast<kab::align_t>(BlockSize * 2));
+		REQUIRE(tester.get_last_dealloc() == BlockSize);
+		REQUIRE(tester.get_current_alloc() == 0);
+
+		// Empty spans, as deallocated by empty containers, are ignored
+		freelist.deallocate({ nullptr, 0 }, kab::default_align_v);
+		const kab::byte_span empty = freelist.allocate(0, kab::default_align_v);
+		REQUIRE(empty.size == 0);
+		freelist.deallocate(empty, kab::default_align_v);
+		REQUIRE(freelist.trim(0) == 0);
+	}
+
+	REQUIRE(tester.get_current_alloc() == 0);
+}
+
+TEST_CASE("Freelist Trim", "[memory]")
+{
+	test_resource tester;
+
+	{
+		freelist_resource freelist(tester);
+
+		constexpr size_t AllocCount = 10;
+		kab::byte_span allocations[AllocCount];
+		for (kab::byte_span& alloc : allocations)
+		{
+			alloc = freelist.allocate(BlockSize, kab::default_align_v);
+		}
+		for (kab::byte_span& alloc : allocations)
+		{
+			freelist.deallocate(alloc, kab::default_align_v);
+		}
+		REQUIRE(tester.get_current_alloc() == AllocCount * BlockSize);
+
+		// Keeps the requested number of bytes, rounded down to blocks
+		REQUIRE(freelist.trim(3 * BlockSize + 1) == (AllocCount - 3) * BlockSize);
+		REQUIRE(tester.get_current_alloc() == 3 * BlockSize);
+
+		// Kept blocks are still reused
+		kab::byte_span const reused = freelist.allocate(BlockSize, kab::default_align_v);
+		REQUIRE(tester.get_current_alloc() == 3 * BlockSize);
+		freelist.deallocate(reused, kab::default_align_v);
+
+		REQUIRE(freelist.trim(3 * BlockSize) == 0);
+		REQUIRE(freelist.trim(0) == 3 * BlockSize);
+		REQUIRE(tester.get_current_alloc() == 0);
+	}
+
+	REQUIRE(tester.get_current_alloc() == 0);
+}
+
+TEST_CASE("Freelist Trim Inner", "[memory]")
+{
+	test_resource tester;
+
+	{
+		freelist_resource inner(tester);
+		kab::freelist_resource<kab::resource_reference<freelist_resource>, BlockSize> outer(inner);
+
+		// 4 blocks cached by each freelist
+		kab::byte_span allocations[8];
+		for (size_t i = 0; i < 8; ++i)
+		{
+			allocations[i] = i < 4 ? outer.allocate(BlockSize, kab::default_align_v) : inner.allocate(BlockSize, kab::default_align_v);
+		}
+		for (size_t i = 0; i < 8; ++i)
+		{
+			if (i < 4)
+			{
+				outer.deallocate(allocations[i], kab::default_align_v);
+			}
+			else
+			{
+				inner.deallocate(allocations[i], kab::default_align_v);
+			}
+		}
+		REQUIRE(tester.get_current_alloc() == 8 * BlockSize);
+
+		// The inner freelist only keeps what the outer one didn't
+		REQUIRE(outer.trim(5 * BlockSize) == 3 * BlockSize);
+		REQUIRE(tester.get_current_alloc() == 5 * BlockSize);
+		REQUIRE(outer.trim(0) == 4 * BlockSize + 5 * BlockSize); // the outer blocks are released twice, to the inner freelist then to the tester
+		REQUIRE(tester.get_current_alloc() == 0);
+	}
+
+	REQUIRE(tester.get_current_alloc() == 0);
+}
@@ -0,0 +1,193 @@
+#include "kaballoc/core/platform.h"
+
+#if KAB_PLATFORM_LINUX
+
+#include "kaballoc/memory/guard_page_resource.h"
+#include "kaballoc/memory/sampled_resource.h"
+#include "kaballoc/memory/fallback_resource.h"
+#include "kaballoc/memory/freelist_resource.h"
+#include "kaballoc/memory/resource_reference.h"
+#include "kaballoc/memory/detail/owns.h"
+#include "kaballoc/container/vector.h"
+
+#include "test_resource.h"
+
+#include <catch.hpp>
+
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static_assert(kab::detail::has_owns_v<kab::guard_page_resource<>>);
+static_assert(kab::detail::has_owns_v<kab::sampled_resource<kab::resource_reference<kab::guard_page_resource<>>>>);
+
+namespace
+{
+	// Runs 'f' in a child process, and returns whether the child crashed
+	template<typename F>
+	bool crashes(F f)
+	{
+		pid_t const child = ::fork();
+		if (child == 0)
+		{
+			f();
+			::_exit(0);
+		}
+		int status = 0;
+		if (::waitpid(child, &status, 0) != child)
+		{
+			return false;
+		}
+		return !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+	}
+}
+
+TEMPLATE_TEST_CASE_SIG("Guard page allocations", "[memory]", ((kab::guard_side Side), Side), kab::guard_side::after, kab::guard_side::before)
+{
+	size_t const page_size = kab::detail::system_page_size();
+	kab::guard_page_resource<Side> resource(64 * page_size);
+
+	kab::byte_span const small = resource.allocate(10, kab::default_align_v);
+	REQUIRE(small.size == 10);
+	REQUIRE(reinterpret_cast<size_t>(small.data) % static_cast<size_t>(kab::default_align_v) == 0);
+	REQUIRE(resource.owns(small));
+	memset(small.data, 0xAB, small.size);
+
+	kab::byte_span const big = resource.allocate(3 * page_size + 5, kab::align_v<double>);
+	REQUIRE(big.size == 3 * page_size + 5);
+	REQUIRE(reinterpret_cast<size_t>(big.data) % alignof(double) == 0);
+	memset(big.data, 0xCD, big.size);
+
+	if constexpr (Side == kab::guard_side::after)
+	{
+		// The end of the allocation is as close to the guard page as the alignment allows
+		REQUIRE((reinterpret_cast<size_t>(small.data + small.size) + static_cast<size_t>(kab::default_align_v)) / page_size
+			!= reinterpret_cast<size_t>(small.data) / page_size);
+	}
+	else
+	{
+		REQUIRE(reinterpret_cast<size_t>(small.data) % page_size == 0);
+	}
+
+	int outside = 0;
+	REQUIRE_FALSE(resource.owns({ reinterpret_cast<kab::byte*>(&outside), sizeof(outside) }));
+
+	// Over-aligned and empty requests report exhaustion
+	REQUIRE(resource.allocate(10, kab::align_t(page_size * 2)).data == nullptr);
+	REQUIRE(resource.allocate(0, kab::default_align_v).data == nullptr);
+
+	resource.deallocate(small, kab::default_align_v);
+	resource.deallocate(big, kab::align_v<double>);
+}
+
+TEST_CASE("Guard page faults", "[memory]")
+{
+	size_t const page_size = kab::detail::system_page_size();
+
+	kab::guard_page_resource<kab::guard_side::after> after(16 * page_size);
+	kab::byte_span const a = after.allocate(24, kab::align_v<double>);
+	REQUIRE(crashes([&] { a.data[a.size + 8] = 1; })); // past the alignment slack, on the guard page
+
+	kab::guard_page_resource<kab::guard_side::before> before(16 * page_size);
+	kab::byte_span const b = before.allocate(24, kab::align_v<double>);
+	REQUIRE(crashes([&] { b.data[-1] = 1; }));
+
+	// Writing in the alignment slack is detected by the canary when freeing
+	kab::byte_span const c = before.allocate(24, kab::align_v<double>);
+	REQUIRE(crashes([&] { c.data[c.size] = 1; before.deallocate(c, kab::align_v<double>); }));
+
+	// Freed memory stays inaccessible
+	after.deallocate(a, kab::align_v<double>);
+	REQUIRE(crashes([&] { volatile kab::byte read = a.data[0]; (void)read; }));
+
+	before.deallocate(b, kab::align_v<double>);
+	before.deallocate(c, kab::align_v<double>);
+}
+
+TEST_CASE("Guard page reuse", "[memory]")
+{
+	size_t const page_size = kab::detail::system_page_size();
+	kab::guard_page_resource<> resource(8 * page_size);
+
+	// Each allocation takes a data page and a guard page
+	kab::byte_span spans[4];
+	for (kab::byte_span& s : spans)
+	{
+		s = resource.allocate(100, kab::default_align_v);
+		REQUIRE(s.data != nullptr);
+	}
+	REQUIRE(resource.allocate(100, kab::default_align_v).data == nullptr);
+
+	// Freed pages are reused after the rest of the reservation
+	resource.deallocate(spans[1], kab::default_align_v);
+	kab::byte_span const reused = resource.allocate(100, kab::default_align_v);
+	REQUIRE(reused.data == spans[1].data);
+	memset(reused.data, 0, reused.size);
+
+	resource.deallocate(reused, kab::default_align_v);
+	resource.deallocate(spans[0], kab::default_align_v);
+	resource.deallocate(spans[2], kab::default_align_v);
+	resource.deallocate(spans[3], kab::default_align_v);
+
+	kab::guard_page_resource<> moved = std::move(resource);
+	REQUIRE(moved.allocate(100, kab::default_align_v).data != nullptr);
+	REQUIRE(resource.allocate(100, kab::default_align_v).data == nullptr);
+}
+
+TEST_CASE("Sampled guard pages", "[memory]")
+{
+	using guard_t = kab::guard_page_resource<>;
+	using sampled_t = kab::sampled_resource<kab::resource_reference<guard_t>>;
+	using resource_t = kab::fallback_resource<sampled_t, kab::resource_reference<test_resource>>;
+
+	guard_t guard(256 * kab::detail::system_page_size());
+	test_resource fallback;
+	resource_t resource(sampled_t(guard, 4), fallback);
+
+	kab::byte_span spans[8];
+	for (kab::byte_span& s : spans)
+	{
+		s = resource.allocate(32, kab::default_align_v);
+	}
+	size_t guarded = 0;
+	for (kab::byte_span const& s : spans)
+	{
+		guarded += guard.owns(s) ? 1 : 0;
+	}
+	REQUIRE(guarded == 2);
+	REQUIRE(guard.owns(spans[3]));
+	REQUIRE(guard.owns(spans[7]));
+	REQUIRE(fallback.get_current_alloc() == 6 * 32);
+
+	for (kab::byte_span const& s : spans)
+	{
+		resource.deallocate(s, kab::default_align_v);
+	}
+	REQUIRE(fallback.get_current_alloc() == 0);
+
+	// Guarded allocations under a vector and a freelist
+	{
+		kab::vector<int, kab::resource_reference<resource_t>> v{ kab::resource_reference<resource_t>(resource) };
+		for (int i = 0; i < 1000; ++i)
+		{
+			v.push_back(i);
+		}
+		REQUIRE(v[999] == 999);
+	}
+	REQUIRE(fallback.get_current_alloc() == 0);
+
+	resource.primary().set_period(1);
+	{
+		kab::freelist_resource<kab::resource_reference<resource_t>, 64> freelist{ kab::resource_reference<resource_t>(resource) };
+		kab::byte_span const s = freelist.allocate(64, kab::default_align_v);
+		REQUIRE(guard.owns(s));
+		freelist.deallocate(s, kab::default_align_v);
+	}
+
+	resource.primary().set_period(0);
+	kab::byte_span const unsampled = resource.allocate(32, kab::default_align_v);
+	REQUIRE_FALSE(guard.owns(unsampled));
+	resource.deallocate(unsampled, kab::default_align_v);
+}
+
+#endif
@@ -0,0 +1,101 @@
+#include "kaballoc/memory/locked_resource.h"
+#include "kaballoc/memory/freelist_resource.h"
+#include "kaballoc/memory/static_resource.h"
+#include "kaballoc/memory/new_resource.h"
+#include "kaballoc/memory/resource_reference.h"
+#include "kaballoc/memory/detail/owns.h"
+#include "kaballoc/memory/detail/trim.h"
+#include "kaballoc/container/vector.h"
+#include "kaballoc/core/spin_lock.h"
+
+#include "test_resource.h"
+
+#include <catch.hpp>
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static_assert(kab::detail::has_owns_v<kab::locked_resource<kab::static_resource<256>>>);
+static_assert(!kab::detail::has_owns_v<kab::locked_resource<kab::new_resource>>);
+static_assert(kab::detail::has_trim_v<kab::locked_resource<kab::freelist_resource<kab::new_resource, 32>>>);
+
+TEST_CASE("Spin lock", "[memory]")
+{
+	kab::spin_lock lock;
+	REQUIRE(lock.try_lock());
+	REQUIRE_FALSE(lock.try_lock());
+	lock.unlock();
+
+	size_t counter = 0;
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t)
+	{
+		threads.emplace_back([&]
+		{
+			for (int i = 0; i < 10000; ++i)
+			{
+				std::lock_guard<kab::spin_lock> const guard(lock);
+				++counter;
+			}
+		});
+	}
+	for (std::thread& t : threads)
+	{
+		t.join();
+	}
+	REQUIRE(counter == 40000);
+}
+
+TEMPLATE_TEST_CASE("Locked freelist", "[memory]", std::mutex, kab::spin_lock)
+{
+	using freelist_t = kab::freelist_resource<kab::new_resource, 64>;
+	kab::locked_resource<freelist_t, TestType> resource;
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t)
+	{
+		threads.emplace_back([&]
+		{
+			kab::byte_span spans[16] = {};
+			for (int i = 0; i < 2000; ++i)
+			{
+				kab::byte_span& s = spans[i % 16];
+				if (s.data != nullptr)
+				{
+					resource.deallocate(s, kab::default_align_v);
+				}
+				s = resource.allocate(48, kab::default_align_v);
+				s.data[0] = static_cast<kab::byte>(i);
+			}
+			for (kab::byte_span const& s : spans)
+			{
+				resource.deallocate(s, kab::default_align_v);
+			}
+		});
+	}
+	for (std::thread& t : threads)
+	{
+		t.join();
+	}
+	REQUIRE(resource.trim(0) > 0);
+}
+
+TEST_CASE("Locked resource forwarding", "[memory]")
+{
+	test_resource tester;
+	kab::locked_resource<kab::resource_reference<test_resource>> resource{ kab::resource_reference<test_resource>(tester) };
+	REQUIRE(resource == resource);
+
+	kab::vector<int, kab::resource_reference<decltype(resource)>> v{ kab::resource_reference<decltype(resource)>(resource) };
+	v.reserve(10);
+	REQUIRE(tester.get_current_alloc() == 10 * sizeof(int));
+	v.clear_and_shrink();
+	REQUIRE(tester.get_current_alloc() == 0);
+	REQUIRE(resource.unsafe_inner() == kab::resource_reference<test_resource>(tester));
+
+	kab::locked_resource<kab::static_resource<256>, kab::spin_lock> arena;
+	kab::byte_span const s = arena.allocate(32, kab::default_align_v);
+	REQUIRE(arena.owns(s));
+	arena.deallocate(s, kab::default_align_v);
+}
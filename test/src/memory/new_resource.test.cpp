@@ -47,4 +47,6 @@ TEST_CASE("New resource", "[memory]")
 
 	resource.deallocate(s, kab::default_align_v);
 	REQUIRE(tester.get_current_alloc() == 0);
-}
\ No newline at end of file
+
+	clear_new_observer();
+}
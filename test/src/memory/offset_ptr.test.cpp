@@ -0,0 +1,64 @@
+#include "kaballoc/memory/offset_ptr.h"
+
+#include <catch.hpp>
+
+#include <string.h>
+
+namespace
+{
+	struct node
+	{
+		int value;
+		kab::offset_ptr<node> next;
+	};
+}
+
+static_assert(!kab::is_trivially_relocatable_v<kab::offset_ptr<int>>);
+
+TEST_CASE("Offset pointer basics", "[memory]")
+{
+	kab::offset_ptr<int> p;
+	REQUIRE(!p);
+	REQUIRE(p == nullptr);
+	REQUIRE(p.get() == nullptr);
+
+	int values[2] = { 1, 2 };
+	p = values;
+	REQUIRE(p);
+	REQUIRE(p.get() == values);
+	REQUIRE(*p == 1);
+	REQUIRE(p[1] == 2);
+
+	// Copies point to the same object, wherever they are
+	kab::offset_ptr<int> const copy = p;
+	REQUIRE(copy == p);
+	REQUIRE(copy.get() == values);
+
+	kab::offset_ptr<int const> const const_copy = p;
+	REQUIRE(const_copy.get() == values);
+
+	p = nullptr;
+	REQUIRE(!p);
+}
+
+TEST_CASE("Offset pointer position independence", "[memory]")
+{
+	// A linked list in a block stays valid when the whole block is copied somewhere else
+	node block[3];
+	block[0] = { 0, &block[1] };
+	block[1] = { 1, &block[2] };
+	block[2] = { 2, nullptr };
+
+	alignas(node) unsigned char other[sizeof(block)];
+	memcpy(other, block, sizeof(block));
+	memset(static_cast<void*>(block), 0, sizeof(block));
+
+	node const* n = reinterpret_cast<node const*>(other);
+	for (int i = 0; i < 3; ++i)
+	{
+		REQUIRE(n != nullptr);
+		REQUIRE(n->value == i);
+		n = n->next.get();
+	}
+	REQUIRE(n == nullptr);
+}
@@ -0,0 +1,124 @@
+#include "kaballoc/core/platform.h"
+
+#if KAB_PLATFORM_LINUX
+
+#include "kaballoc/memory/page_resource.h"
+#include "kaballoc/memory/detail/reallocate.h"
+#include "kaballoc/memory/freelist_resource.h"
+#include "kaballoc/container/vector.h"
+
+#include <catch.hpp>
+
+#include <string.h>
+
+static_assert(kab::detail::has_reallocate_v<kab::page_resource<>>);
+
+TEST_CASE("Page resource allocations", "[memory]")
+{
+	kab::page_resource<> resource;
+	size_t const page_size = kab::detail::system_page_size();
+
+	kab::byte_span const small = resource.over_allocate(10, kab::default_align_v);
+	REQUIRE(small.size == page_size);
+	REQUIRE(reinterpret_cast<size_t>(small.data) % page_size == 0);
+	memset(small.data, 0xAB, small.size);
+	resource.deallocate(small, kab::default_align_v);
+
+	kab::byte_span const exact = resource.allocate(page_size + 1, kab::default_align_v);
+	REQUIRE(exact.size == page_size + 1);
+	memset(exact.data, 0xCD, exact.size);
+	resource.deallocate(exact, kab::default_align_v);
+
+	// Alignments above the page size
+	constexpr size_t big_align = size_t(1) << 20;
+	kab::byte_span const aligned = resource.allocate(100, kab::align_t(big_align));
+	REQUIRE(reinterpret_cast<size_t>(aligned.data) % big_align == 0);
+	memset(aligned.data, 0, aligned.size);
+	resource.deallocate(aligned, kab::align_t(big_align));
+}
+
+TEMPLATE_TEST_CASE("Page resource huge pages", "[memory]", kab::page_resource<kab::huge_pages::transparent>, kab::page_resource<kab::huge_pages::explicit_pages>)
+{
+	TestType resource;
+	size_t const huge_size = TestType::huge_page_size;
+
+	// Small allocations don't waste a huge page
+	kab::byte_span const small = resource.over_allocate(100, kab::default_align_v);
+	REQUIRE(small.size == kab::detail::system_page_size());
+	resource.deallocate(small, kab::default_align_v);
+
+	// Big allocations are rounded and aligned to huge pages, whether the huge pages are available or not
+	kab::byte_span const big = resource.over_allocate(huge_size + 1, kab::default_align_v);
+	REQUIRE(big.size == 2 * huge_size);
+	REQUIRE(reinterpret_cast<size_t>(big.data) % huge_size == 0);
+	memset(big.data, 0x11, big.size);
+	resource.deallocate(big, kab::default_align_v);
+
+	kab::byte_span const requested = resource.allocate(huge_size + 1, kab::default_align_v);
+	REQUIRE(requested.size == huge_size + 1);
+	resource.deallocate(requested, kab::default_align_v);
+}
+
+TEST_CASE("Page resource empty allocation", "[memory]")
+{
+	kab::page_resource<> resource;
+
+	kab::byte_span s = resource.allocate(0, kab::default_align_v);
+	REQUIRE(s.data == nullptr);
+	REQUIRE(s.size == 0);
+	resource.deallocate(s, kab::default_align_v);
+
+	s = resource.reallocate(s, 100, kab::default_align_v);
+	REQUIRE(s.data != nullptr);
+	REQUIRE(s.size >= 100);
+	resource.deallocate(s, kab::default_align_v);
+}
+
+TEST_CASE("Page resource reallocate", "[memory]")
+{
+	kab::page_resource<> resource;
+	size_t const page_size = kab::detail::system_page_size();
+
+	kab::byte_span s = resource.allocate(page_size, kab::default_align_v);
+	memset(s.data, 0x5A, s.size);
+
+	s = resource.reallocate(s, 64 * page_size, kab::default_align_v);
+	REQUIRE(s.size == 64 * page_size);
+	for (size_t i = 0; i < page_size; ++i)
+	{
+		REQUIRE(s.data[i] == 0x5A);
+	}
+	memset(s.data, 0x3C, s.size);
+
+	// Over-aligned requests are copied
+	constexpr size_t big_align = size_t(1) << 20;
+	kab::byte_span aligned = resource.allocate(page_size, kab::align_t(big_align));
+	memset(aligned.data, 0x7E, aligned.size);
+	aligned = resource.reallocate(aligned, 4 * page_size, kab::align_t(big_align));
+	REQUIRE(reinterpret_cast<size_t>(aligned.data) % big_align == 0);
+	REQUIRE(aligned.data[page_size - 1] == 0x7E);
+
+	resource.deallocate(aligned, kab::align_t(big_align));
+	resource.deallocate(s, kab::default_align_v);
+}
+
+TEST_CASE("Page resource as slab provider", "[memory]")
+{
+	constexpr size_t slab_size = 64 * 1024;
+	kab::freelist_resource<kab::page_resource<>, slab_size, kab::align_t(4096)> slabs;
+
+	kab::byte_span const a = slabs.allocate(slab_size, kab::default_align_v);
+	slabs.deallocate(a, kab::default_align_v);
+	kab::byte_span const b = slabs.allocate(slab_size, kab::default_align_v);
+	REQUIRE(a.data == b.data);
+	slabs.deallocate(b, kab::default_align_v);
+
+	kab::vector<int, kab::page_resource<>> v;
+	for (int i = 0; i < 100000; ++i)
+	{
+		v.push_back(i);
+	}
+	REQUIRE(v[99999] == 99999);
+}
+
+#endif
@@ -0,0 +1,144 @@
+#include "kaballoc/core/platform.h"
+
+#if KAB_PLATFORM_LINUX
+
+#include "kaballoc/memory/profiling_resource.h"
+#include "kaballoc/memory/resource_reference.h"
+#include "kaballoc/container/vector.h"
+#include "kaballoc/core/compiler.h"
+
+#include "test_resource.h"
+
+#include <catch.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+using profiler_t = kab::profiling_resource<kab::resource_reference<test_resource>>;
+
+namespace
+{
+	kab::profile_stack sum_stacks(profiler_t const& profiler)
+	{
+		kab::profile_stack sum{ nullptr, 0, 0, 0, 0, 0 };
+		profiler.for_each_stack([&](kab::profile_stack const& stack)
+		{
+			REQUIRE(stack.depth > 0);
+			sum.depth += 1;
+			sum.live_count += stack.live_count;
+			sum.live_bytes += stack.live_bytes;
+			sum.total_count += stack.total_count;
+			sum.total_bytes += stack.total_bytes;
+		});
+		return sum;
+	}
+
+	KAB_NOINLINE kab::byte_span allocate_here(profiler_t& profiler, size_t size)
+	{
+		return profiler.allocate(size, kab::default_align_v);
+	}
+
+	KAB_NOINLINE kab::byte_span allocate_there(profiler_t& profiler, size_t size)
+	{
+		return profiler.allocate(size, kab::default_align_v);
+	}
+}
+
+TEST_CASE("Profiling every allocation", "[memory]")
+{
+	test_resource tester;
+	profiler_t profiler(tester, 1);
+
+	kab::byte_span spans[10];
+	for (size_t i = 0; i < 10; ++i)
+	{
+		spans[i] = i % 2 == 0 ? allocate_here(profiler, 16) : allocate_there(profiler, 32);
+	}
+	REQUIRE(profiler.live_samples() == 10);
+	REQUIRE(tester.get_current_alloc() == 5 * 16 + 5 * 32);
+
+	kab::profile_stack sum = sum_stacks(profiler);
+	REQUIRE(sum.depth >= 2); // at least one stack per call site
+	REQUIRE(sum.live_count == 10);
+	REQUIRE(sum.live_bytes == 5 * 16 + 5 * 32);
+	REQUIRE(sum.total_count == 10);
+
+	for (size_t i = 0; i < 10; i += 2)
+	{
+		profiler.deallocate(spans[i], kab::default_align_v);
+	}
+	sum = sum_stacks(profiler);
+	REQUIRE(profiler.live_samples() == 5);
+	REQUIRE(sum.live_count == 5);
+	REQUIRE(sum.live_bytes == 5 * 32);
+	REQUIRE(sum.total_count == 10);
+	REQUIRE(sum.total_bytes == 5 * 16 + 5 * 32);
+
+	for (size_t i = 1; i < 10; i += 2)
+	{
+		profiler.deallocate(spans[i], kab::default_align_v);
+	}
+	REQUIRE(profiler.live_samples() == 0);
+	REQUIRE(tester.get_current_alloc() == 0);
+
+	// Without sampling, nothing is recorded
+	profiler.set_sample_rate(0);
+	kab::byte_span const unsampled = allocate_here(profiler, 1000000);
+	REQUIRE(profiler.live_samples() == 0);
+	profiler.deallocate(unsampled, kab::default_align_v);
+	REQUIRE(sum_stacks(profiler).total_count == 10);
+}
+
+TEST_CASE("Profiling sample rate", "[memory]")
+{
+	test_resource tester;
+	profiler_t profiler(tester, 1024);
+	REQUIRE(profiler.sample_rate() == 1024);
+
+	// 68000 bytes at one sample per 1024 bytes on average: about 66 samples
+	{
+		kab::vector<int, kab::resource_reference<profiler_t>> v{ kab::resource_reference<profiler_t>(profiler) };
+		v.reserve(1000);
+		for (int i = 0; i < 1000; ++i)
+		{
+			kab::byte_span const s = profiler.allocate(64, kab::default_align_v);
+			v.push_back(i);
+			profiler.deallocate(s, kab::default_align_v);
+		}
+		REQUIRE(sum_stacks(profiler).live_count <= 1);
+	}
+
+	kab::profile_stack const sum = sum_stacks(profiler);
+	REQUIRE(sum.live_count == 0);
+	REQUIRE(sum.total_count > 30);
+	REQUIRE(sum.total_count < 110);
+	REQUIRE(tester.get_current_alloc() == 0);
+}
+
+TEST_CASE("Profiling pprof output", "[memory]")
+{
+	test_resource tester;
+	profiler_t profiler(tester, 1);
+	kab::byte_span const live = allocate_here(profiler, 100);
+	kab::byte_span const freed = allocate_there(profiler, 50);
+	profiler.deallocate(freed, kab::default_align_v);
+
+	char* buffer = nullptr;
+	size_t size = 0;
+	FILE* const out = ::open_memstream(&buffer, &size);
+	REQUIRE(out != nullptr);
+	REQUIRE(profiler.write_pprof(out));
+	::fclose(out);
+
+	std::string const text(buffer, size);
+	::free(buffer);
+	REQUIRE(text.rfind("heap profile: 1: 100 [2: 150] @ heap_v2/1\n", 0) == 0);
+	REQUIRE(text.find("1: 100 [1: 100] @ 0x") != std::string::npos);
+	REQUIRE(text.find("0: 0 [1: 50] @ 0x") != std::string::npos);
+	REQUIRE(text.find("\nMAPPED_LIBRARIES:\n") != std::string::npos);
+
+	profiler.deallocate(live, kab::default_align_v);
+}
+
+#endif
@@ -0,0 +1,151 @@
+#include "kaballoc/memory/segregator_resource.h"
+#include "kaballoc/memory/freelist_resource.h"
+#include "kaballoc/memory/static_resource.h"
+#include "kaballoc/memory/resource_reference.h"
+#include "kaballoc/container/vector.h"
+#include "kaballoc/core/platform.h"
+
+#if KAB_PLATFORM_LINUX
+#include "kaballoc/memory/page_resource.h"
+#endif
+
+#include <catch.hpp>
+
+#include <new>
+
+#include "test_resource.h"
+
+using test_ref = kab::resource_reference<test_resource>;
+
+TEST_CASE("Segregator routing", "[memory]")
+{
+	test_resource small;
+	test_resource large;
+
+	{
+		kab::segregator_resource<64, test_ref, test_ref> resource(small, large);
+
+		kab::byte_span const a = resource.allocate(64, kab::default_align_v);
+		REQUIRE(small.get_current_alloc() == 64);
+		REQUIRE(large.get_current_alloc() == 0);
+
+		kab::byte_span const b = resource.allocate(65, kab::default_align_v);
+		REQUIRE(small.get_current_alloc() == 64);
+		REQUIRE(large.get_current_alloc() == 65);
+
+		kab::byte_span const c = resource.over_allocate(1, kab::default_align_v);
+		REQUIRE(small.get_current_alloc() == 65);
+
+		resource.deallocate(b, kab::default_align_v);
+		REQUIRE(large.get_current_alloc() == 0);
+		resource.deallocate(a, kab::default_align_v);
+		resource.over_deallocate(c, kab::default_align_v);
+		REQUIRE(small.get_current_alloc() == 0);
+	}
+}
+
+TEST_CASE("Segregator with freelists", "[memory]")
+{
+	test_resource tester;
+
+	using small_pool = kab::freelist_resource<test_ref, 32>;
+	using medium_pool = kab::freelist_resource<test_ref, 256>;
+	using resource_type = kab::segregator_resource<32, small_pool, kab::segregator_resource<256, medium_pool, test_ref>>;
+
+	{
+		resource_type resource(small_pool(tester), { medium_pool(tester), test_ref(tester) });
+
+		kab::byte_span const a = resource.over_allocate(8, kab::default_align_v);
+		REQUIRE(a.size == 32);
+		kab::byte_span const b = resource.over_allocate(100, kab::default_align_v);
+		REQUIRE(b.size == 256);
+		kab::byte_span const c = resource.over_allocate(1000, kab::default_align_v);
+		REQUIRE(c.size == 1000);
+		REQUIRE(tester.get_current_alloc() == 32 + 256 + 1000);
+
+		// Freed blocks are kept by their pool, and reused for the same size class
+		resource.over_deallocate(a, kab::default_align_v);
+		resource.over_deallocate(b, kab::default_align_v);
+		resource.over_deallocate(c, kab::default_align_v);
+		REQUIRE(tester.get_current_alloc() == 32 + 256);
+
+		REQUIRE(resource.over_allocate(16, kab::default_align_v).data == a.data);
+		REQUIRE(resource.over_allocate(200, kab::default_align_v).data == b.data);
+		REQUIRE(tester.get_current_alloc() == 32 + 256);
+
+		resource.deallocate({ a.data, 16 }, kab::default_align_v);
+		resource.deallocate({ b.data, 200 }, kab::default_align_v);
+	}
+
+	REQUIRE(tester.get_current_alloc() == 0);
+}
+
+TEST_CASE("Segregator owns", "[memory]")
+{
+	using static_ref = kab::resource_reference<kab::static_resource<256>>;
+	static_assert(!kab::detail::has_owns_v<kab::segregator_resource<64, static_ref, test_ref>>);
+	static_assert(kab::detail::has_owns_v<kab::segregator_resource<64, static_ref, static_ref>>);
+
+	kab::static_resource<256> small;
+	kab::static_resource<256> large;
+	kab::segregator_resource<64, static_ref, static_ref> resource(small, large);
+
+	kab::byte_span const a = resource.allocate(16, kab::default_align_v);
+	kab::byte_span const b = resource.allocate(128, kab::default_align_v);
+	REQUIRE(small.owns(a));
+	REQUIRE(large.owns(b));
+	REQUIRE(resource.owns(a));
+	REQUIRE(resource.owns(b));
+	resource.deallocate(b, kab::default_align_v);
+	resource.deallocate(a, kab::default_align_v);
+	REQUIRE(small.used() == 0);
+	REQUIRE(large.used() == 0);
+}
+
+#if KAB_PLATFORM_LINUX
+TEST_CASE("Segregator reallocate", "[memory]")
+{
+	static_assert(!kab::detail::has_reallocate_v<kab::segregator_resource<64, test_ref, test_ref>>);
+
+	test_resource tester;
+	using resource_type = kab::segregator_resource<4096, test_ref, kab::page_resource<>>;
+	static_assert(kab::detail::has_reallocate_v<resource_type>);
+
+	{
+		kab::vector<int, resource_type> v(resource_type(tester, {}));
+		for (int i = 0; i < 100000; ++i)
+		{
+			v.push_back(i);
+		}
+		REQUIRE(tester.get_current_alloc() == 0); // small blocks were moved to pages
+		REQUIRE(tester.get_total_alloc() > 0);
+		for (int i = 0; i < 100000; ++i)
+		{
+			REQUIRE(v[i] == i);
+		}
+	}
+
+	REQUIRE(tester.get_current_alloc() == 0);
+}
+
+TEST_CASE("Segregator reallocate on exhaustion", "[memory]")
+{
+	kab::static_resource<128> small;
+	using resource_type = kab::segregator_resource<1024, kab::resource_reference<kab::static_resource<128>>, kab::page_resource<>>;
+	resource_type resource(small, {});
+
+	kab::byte_span const s = resource.allocate(64, kab::default_align_v);
+	REQUIRE(s.data != nullptr);
+	kab::byte_span const r = resource.reallocate(s, 512, kab::default_align_v);
+	REQUIRE(r.data == nullptr); // the small resource is exhausted, and 's' is still valid
+	resource.deallocate(s, kab::default_align_v);
+
+	kab::vector<int, resource_type> v(resource);
+	v.reserve(16);
+	int const* const data = v.data();
+	v.push_back(1);
+	REQUIRE_THROWS_AS(v.reserve(128), std::bad_alloc);
+	REQUIRE(v.data() == data);
+	REQUIRE(v[0] == 1);
+}
+#endif
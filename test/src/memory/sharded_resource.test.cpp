@@ -0,0 +1,107 @@
+#include "kaballoc/memory/sharded_resource.h"
+#include "kaballoc/memory/freelist_resource.h"
+#include "kaballoc/memory/static_resource.h"
+#include "kaballoc/memory/new_resource.h"
+#include "kaballoc/memory/resource_reference.h"
+#include "kaballoc/memory/detail/owns.h"
+#include "kaballoc/memory/detail/trim.h"
+#include "kaballoc/container/vector.h"
+
+#include <catch.hpp>
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static_assert(kab::detail::has_owns_v<kab::sharded_resource<kab::static_resource<256>, 4>>);
+static_assert(!kab::detail::has_owns_v<kab::sharded_resource<kab::new_resource, 4>>);
+static_assert(kab::detail::has_trim_v<kab::sharded_resource<kab::freelist_resource<kab::new_resource, 32>, 4>>);
+
+TEST_CASE("Sharded freelist", "[memory]")
+{
+	using freelist_t = kab::freelist_resource<kab::new_resource, 64>;
+	using sharded_t = kab::sharded_resource<freelist_t, 4>;
+	sharded_t resource;
+	REQUIRE(sharded_t::shard_count() == 4);
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 8; ++t)
+	{
+		threads.emplace_back([&]
+		{
+			kab::vector<int, kab::resource_reference<sharded_t>> v{ kab::resource_reference<sharded_t>(resource) };
+			kab::byte_span spans[16] = {};
+			for (int i = 0; i < 2000; ++i)
+			{
+				kab::byte_span& s = spans[i % 16];
+				if (s.data != nullptr)
+				{
+					resource.deallocate(s, kab::default_align_v);
+				}
+				s = resource.allocate(48, kab::default_align_v);
+				s.data[0] = static_cast<kab::byte>(i);
+				if (i % 100 == 0)
+				{
+					v.push_back(i);
+				}
+			}
+			for (kab::byte_span const& s : spans)
+			{
+				resource.deallocate(s, kab::default_align_v);
+			}
+		});
+	}
+	for (std::thread& t : threads)
+	{
+		t.join();
+	}
+	REQUIRE(resource.trim(0) > 0);
+}
+
+TEST_CASE("Sharded owners", "[memory]")
+{
+	using sharded_t = kab::sharded_resource<kab::static_resource<256>, 3, std::mutex>;
+	sharded_t resource;
+
+	// Memory of a given shard goes back to that shard, whatever the current CPU
+	kab::byte_span spans[3];
+	for (size_t i = 0; i < 3; ++i)
+	{
+		spans[i] = resource.shard_at(i).allocate(32, kab::default_align_v);
+		REQUIRE(resource.owns(spans[i]));
+		REQUIRE(resource.shard_at(i).unsafe_inner().used() == 32);
+	}
+	int outside = 0;
+	REQUIRE_FALSE(resource.owns({ reinterpret_cast<kab::byte*>(&outside), sizeof(outside) }));
+
+	for (size_t i = 0; i < 3; ++i)
+	{
+		resource.deallocate(spans[i], kab::default_align_v);
+		REQUIRE(resource.shard_at(i).unsafe_inner().used() == 0);
+	}
+
+	kab::byte_span const s = resource.allocate(16, kab::default_align_v);
+	REQUIRE(resource.owns(s));
+	resource.deallocate(s, kab::default_align_v);
+	for (size_t i = 0; i < 3; ++i)
+	{
+		REQUIRE(resource.shard_at(i).unsafe_inner().used() == 0);
+	}
+}
+
+TEST_CASE("Sharded prototype", "[memory]")
+{
+	struct counted
+	{
+		int id = 0;
+		[[nodiscard]] kab::byte_span allocate(size_t size, kab::align_t align) { return kab::new_resource().allocate(size, align); }
+		void deallocate(kab::byte_span s, kab::align_t align) { kab::new_resource().deallocate(s, align); }
+	};
+
+	kab::sharded_resource<counted, 2> resource(counted{ 7 });
+	REQUIRE(resource.shard_at(0).unsafe_inner().id == 7);
+	REQUIRE(resource.shard_at(1).unsafe_inner().id == 7);
+
+	kab::byte_span const s = resource.allocate(10, kab::default_align_v);
+	resource.deallocate(s, kab::default_align_v);
+}
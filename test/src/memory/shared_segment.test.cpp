@@ -0,0 +1,250 @@
+#include "kaballoc/core/platform.h"
+
+#if KAB_PLATFORM_LINUX
+
+#include "kaballoc/memory/shared_segment.h"
+#include "kaballoc/container/offset_vector.h"
+#include "kaballoc/container/offset_array_value.h"
+
+#include <catch.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+	struct quote
+	{
+		int instrument;
+		double price;
+	};
+
+	struct snapshot
+	{
+		kab::offset_vector<quote, kab::shared_segment_resource> quotes;
+		kab::offset_array_value<char, kab::shared_segment_resource> venue;
+
+		explicit snapshot(kab::shared_segment_resource r)
+			: quotes(r)
+			, venue(r)
+		{
+
+		}
+	};
+
+	constexpr size_t segment_size = 1 << 20;
+}
+
+TEST_CASE("Shared segment allocations", "[memory]")
+{
+	kab::shared_segment segment = kab::shared_segment::create_anonymous(segment_size);
+	kab::shared_segment_resource resource = segment.resource();
+
+	kab::byte_span const a = resource.over_allocate(100, kab::default_align_v);
+	REQUIRE(a.size == 128);
+	REQUIRE(resource.owns(a));
+
+	kab::byte_span const b = resource.allocate(100, kab::align_t(64));
+	REQUIRE(b.size == 100);
+	REQUIRE(reinterpret_cast<size_t>(b.data) % 64 == 0);
+
+	// Freed blocks are reused by the same size class
+	resource.deallocate(a, kab::default_align_v);
+	REQUIRE(resource.allocate(65, kab::default_align_v).data == a.data);
+
+	REQUIRE_THROWS_AS(resource.allocate(segment_size, kab::default_align_v), std::bad_alloc);
+	REQUIRE_THROWS_AS(resource.allocate(~size_t(0), kab::default_align_v), std::bad_alloc);
+
+	int outside = 0;
+	REQUIRE(!resource.owns({ reinterpret_cast<kab::byte*>(&outside), sizeof(outside) }));
+}
+
+TEST_CASE("Shared segment threads", "[memory]")
+{
+	kab::shared_segment segment = kab::shared_segment::create_anonymous(16 * segment_size);
+	kab::shared_segment_resource resource = segment.resource();
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t)
+	{
+		threads.emplace_back([resource, t]() mutable
+		{
+			kab::byte_span blocks[64];
+			for (int round = 0; round < 200; ++round)
+			{
+				for (size_t i = 0; i < 64; ++i)
+				{
+					blocks[i] = resource.allocate(16 + i * 8, kab::default_align_v);
+					blocks[i].data[0] = static_cast<kab::byte>(t);
+				}
+				for (size_t i = 0; i < 64; ++i)
+				{
+					REQUIRE(blocks[i].data[0] == static_cast<kab::byte>(t));
+					resource.deallocate(blocks[i], kab::default_align_v);
+				}
+			}
+		});
+	}
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+}
+
+TEST_CASE("Shared segment position independence", "[memory]")
+{
+	kab::shared_segment writer = kab::shared_segment::create_anonymous(segment_size);
+
+	// A second mapping of the same memory, at another address
+	kab::shared_segment reader = kab::shared_segment::open_fd(writer.fd());
+	REQUIRE(reader.bytes().data != writer.bytes().data);
+	REQUIRE(reader.root<snapshot>() == nullptr);
+
+	kab::shared_segment_resource resource = writer.resource();
+	snapshot* const s = new(resource.allocate(sizeof(snapshot), kab::align_v<snapshot>).data) snapshot(resource);
+	for (int i = 0; i < 1000; ++i)
+	{
+		s->quotes.push_back({ i, i * 0.5 });
+	}
+	std::string const venue = "XPAR";
+	s->venue.assign(venue);
+	writer.set_root(s);
+
+	snapshot* const view = reader.root<snapshot>();
+	REQUIRE(view != nullptr);
+	REQUIRE(static_cast<void*>(view) != static_cast<void*>(s));
+	REQUIRE(view->quotes.size() == 1000);
+	REQUIRE(view->quotes[999].instrument == 999);
+	REQUIRE(view->quotes[999].price == 499.5);
+	REQUIRE(std::string(view->venue.begin(), view->venue.end()) == "XPAR");
+
+	// The reader can also allocate through the resource stored in the segment
+	view->quotes.push_back({ 1000, 500.0 });
+	REQUIRE(s->quotes.size() == 1001);
+	REQUIRE(s->quotes.back().instrument == 1000);
+
+	// Copies made in one mapping share the value with the other
+	auto venue_copy = view->venue;
+	REQUIRE(venue_copy.data() == view->venue.data());
+}
+
+TEST_CASE("Shared segment processes", "[memory]")
+{
+	std::string const name = "/kab_test_" + std::to_string(::getpid());
+	kab::shared_segment::unlink(name.c_str());
+
+	kab::shared_segment segment = kab::shared_segment::create(name.c_str(), segment_size);
+	REQUIRE_THROWS_AS(kab::shared_segment::create(name.c_str(), segment_size), std::system_error);
+
+	pid_t const child = ::fork();
+	if (child == 0)
+	{
+		// The producer maps the segment by name, and publishes a snapshot
+		int code = 0;
+		try
+		{
+			kab::shared_segment producer = kab::shared_segment::open(name.c_str());
+			kab::shared_segment_resource resource = producer.resource();
+			snapshot* const s = new(resource.allocate(sizeof(snapshot), kab::align_v<snapshot>).data) snapshot(resource);
+			for (int i = 0; i < 100; ++i)
+			{
+				s->quotes.push_back({ i, 1.0 });
+			}
+			producer.set_root(s);
+		}
+		catch (...)
+		{
+			code = 1;
+		}
+		::_exit(code);
+	}
+
+	int status = 0;
+	REQUIRE(::waitpid(child, &status, 0) == child);
+	REQUIRE(WIFEXITED(status));
+	REQUIRE(WEXITSTATUS(status) == 0);
+
+	snapshot const* const s = segment.root<snapshot>();
+	REQUIRE(s != nullptr);
+	REQUIRE(s->quotes.size() == 100);
+	REQUIRE(s->quotes[42].instrument == 42);
+
+	REQUIRE(kab::shared_segment::unlink(name.c_str()));
+	REQUIRE_THROWS_AS(kab::shared_segment::open(name.c_str()), std::system_error);
+}
+
+TEST_CASE("Shared segment files", "[memory]")
+{
+	std::string const path = "/tmp/kab_test_segment_" + std::to_string(::getpid());
+	::unlink(path.c_str());
+
+	{
+		kab::shared_segment segment = kab::shared_segment::create_file(path.c_str(), segment_size);
+		kab::shared_segment_resource resource = segment.resource();
+		snapshot* const s = new(resource.allocate(sizeof(snapshot), kab::align_v<snapshot>).data) snapshot(resource);
+		for (int i = 0; i < 500; ++i)
+		{
+			s->quotes.push_back({ i, i * 2.0 });
+		}
+		std::string const venue = "XLON";
+		s->venue.assign(venue);
+		segment.set_root(s);
+		segment.flush();
+	}
+
+	REQUIRE_THROWS_AS(kab::shared_segment::create_file(path.c_str(), segment_size), std::system_error);
+
+	{
+		// The objects are mapped back, without rebuilding anything
+		kab::shared_segment const segment = kab::shared_segment::open_file(path.c_str(), kab::segment_access::read_only);
+		snapshot const* const s = segment.root<snapshot>();
+		REQUIRE(s != nullptr);
+		REQUIRE(s->quotes.size() == 500);
+		REQUIRE(s->quotes[250].price == 500.0);
+		REQUIRE(std::string(s->venue.begin(), s->venue.end()) == "XLON");
+	}
+
+	{
+		// A writable mapping can keep allocating after the recovered objects
+		kab::shared_segment segment = kab::shared_segment::open_file(path.c_str());
+		snapshot* const s = segment.root<snapshot>();
+		s->quotes.push_back({ 500, 1000.0 });
+		REQUIRE(s->quotes.size() == 501);
+	}
+
+	::unlink(path.c_str());
+	REQUIRE_THROWS_AS(kab::shared_segment::open_file(path.c_str()), std::system_error);
+
+	// Sizes too small for the header are rejected before creating the file
+	try
+	{
+		(void)kab::shared_segment::create_file(path.c_str(), 10);
+		FAIL("a segment of 10 bytes was created");
+	}
+	catch (std::system_error const& e)
+	{
+		REQUIRE(e.code() == std::errc::invalid_argument);
+	}
+	REQUIRE(::access(path.c_str(), F_OK) != 0);
+
+	// Files which aren't segments are rejected
+	int const fd = ::open(path.c_str(), O_CREAT | O_RDWR, 0644);
+	REQUIRE(::ftruncate(fd, 4096) == 0);
+	::close(fd);
+	REQUIRE_THROWS_AS(kab::shared_segment::open_file(path.c_str()), std::system_error);
+	::unlink(path.c_str());
+
+	// Truncated segments are rejected before being mapped
+	{
+		kab::shared_segment const segment = kab::shared_segment::create_file(path.c_str(), segment_size);
+	}
+	REQUIRE(::truncate(path.c_str(), segment_size / 2) == 0);
+	REQUIRE_THROWS_AS(kab::shared_segment::open_file(path.c_str()), std::system_error);
+	::unlink(path.c_str());
+}
+
+#endif
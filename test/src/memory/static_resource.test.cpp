@@ -0,0 +1,83 @@
+#include "kaballoc/memory/static_resource.h"
+#include "kaballoc/memory/resource_reference.h"
+#include "kaballoc/container/vector.h"
+#include "kaballoc/container/string.h"
+
+#include <catch.hpp>
+
+#include <new>
+#include <stdint.h>
+
+TEST_CASE("Static resource allocations", "[memory]")
+{
+	kab::static_resource<256> resource;
+
+	kab::byte_span const first = resource.allocate(16, kab::align_t(16));
+	REQUIRE(first.data != nullptr);
+	REQUIRE(first.size == 16);
+	REQUIRE(resource.owns(first));
+
+	kab::byte_span const second = resource.allocate(16, kab::align_t(16));
+	REQUIRE(second.data != nullptr);
+	REQUIRE(reinterpret_cast<uintptr_t>(second.data) % 16 == 0);
+	REQUIRE(second.data >= first.data + first.size);
+	REQUIRE(resource.owns(second));
+
+	// Deallocating in reverse order reclaims the memory
+	size_t const used = resource.used();
+	resource.deallocate(second, kab::align_t(16));
+	REQUIRE(resource.used() < used);
+	resource.deallocate(first, kab::align_t(16));
+	REQUIRE(resource.used() == 0);
+}
+
+TEST_CASE("Static resource exhaustion", "[memory]")
+{
+	kab::static_resource<64> resource;
+
+	kab::byte_span const first = resource.allocate(48, kab::default_align_v);
+	REQUIRE(first.data != nullptr);
+
+	// Doesn't fit: the resource returns a null span instead of throwing
+	kab::byte_span const second = resource.allocate(32, kab::default_align_v);
+	REQUIRE(second.data == nullptr);
+	REQUIRE(second.size == 0);
+
+	// Deallocating out of order doesn't reclaim, but clear does
+	kab::byte_span const third = resource.allocate(8, kab::align_t(1));
+	REQUIRE(third.data != nullptr);
+	resource.deallocate(first, kab::default_align_v);
+	REQUIRE(resource.allocate(32, kab::default_align_v).data == nullptr);
+
+	resource.clear();
+	REQUIRE(resource.allocate(64, kab::default_align_v).data != nullptr);
+
+	int outside = 0;
+	REQUIRE(!resource.owns({ reinterpret_cast<kab::byte*>(&outside), sizeof(outside) }));
+}
+
+TEST_CASE("Static resource owns through reference", "[memory]")
+{
+	kab::static_resource<64> resource;
+	kab::resource_reference<kab::static_resource<64>> ref(resource);
+
+	kab::byte_span const s = ref.allocate(8, kab::default_align_v);
+	REQUIRE(ref.owns(s));
+	ref.deallocate(s, kab::default_align_v);
+	REQUIRE(resource.used() == 0);
+}
+
+TEST_CASE("Static resource under containers", "[memory]")
+{
+	using reference_t = kab::resource_reference<kab::static_resource<64>>;
+	kab::static_resource<64> resource;
+
+	// Containers can't report exhaustion, they throw instead
+	kab::vector<int, reference_t> v{ reference_t(resource) };
+	v.reserve(8);
+	REQUIRE_THROWS_AS(v.reserve(32), std::bad_alloc);
+	REQUIRE(v.capacity() == 8);
+
+	kab::string<reference_t> s{ reference_t(resource) };
+	REQUIRE_THROWS_AS(s.reserve(100), std::bad_alloc);
+}
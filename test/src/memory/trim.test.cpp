@@ -0,0 +1,113 @@
+#include "kaballoc/memory/trim.h"
+#include "kaballoc/memory/freelist_resource.h"
+#include "kaballoc/memory/segregator_resource.h"
+#include "kaballoc/memory/resource_reference.h"
+#include "kaballoc/memory/new_resource.h"
+
+#include <catch.hpp>
+
+#include "test_resource.h"
+
+using test_ref = kab::resource_reference<test_resource>;
+using pool = kab::freelist_resource<test_ref, 64>;
+
+static_assert(kab::detail::has_trim_v<pool>);
+static_assert(kab::detail::has_trim_v<kab::resource_reference<pool>>);
+static_assert(!kab::detail::has_trim_v<kab::new_resource>);
+static_assert(!kab::detail::has_trim_v<kab::segregator_resource<64, test_ref, test_ref>>);
+static_assert(kab::detail::has_trim_v<kab::segregator_resource<64, pool, test_ref>>);
+
+namespace
+{
+	void fill_freelist(pool& p, size_t n)
+	{
+		kab::byte_span blocks[16];
+		for (size_t i = 0; i < n; ++i)
+		{
+			blocks[i] = p.allocate(64, kab::default_align_v);
+		}
+		for (size_t i = 0; i < n; ++i)
+		{
+			p.deallocate(blocks[i], kab::default_align_v);
+		}
+	}
+}
+
+TEST_CASE("Trim helper", "[memory]")
+{
+	test_resource tester;
+	pool p(tester);
+	fill_freelist(p, 4);
+
+	kab::new_resource r;
+	REQUIRE(kab::trim(r) == 0); // unsupported, does nothing
+
+	REQUIRE(kab::trim(p, 64) == 3 * 64);
+	REQUIRE(kab::trim(p) == 64);
+	REQUIRE(tester.get_current_alloc() == 0);
+}
+
+TEST_CASE("Trim composite", "[memory]")
+{
+	test_resource tester;
+	kab::segregator_resource<64, pool, test_ref> resource(pool(tester), tester);
+
+	kab::byte_span const small = resource.allocate(32, kab::default_align_v);
+	kab::byte_span const large = resource.allocate(1000, kab::default_align_v);
+	resource.deallocate(small, kab::default_align_v);
+	resource.deallocate(large, kab::default_align_v);
+	REQUIRE(tester.get_current_alloc() == 64);
+
+	REQUIRE(kab::trim(resource) == 64);
+	REQUIRE(tester.get_current_alloc() == 0);
+}
+
+TEST_CASE("Trim composite split", "[memory]")
+{
+	test_resource tester;
+	kab::segregator_resource<32, pool, pool> resource{ pool(tester), pool(tester) };
+
+	kab::byte_span blocks[8];
+	for (size_t i = 0; i < 8; ++i)
+	{
+		blocks[i] = resource.allocate(i % 2 == 0 ? 16 : 48, kab::default_align_v);
+	}
+	for (size_t i = 0; i < 8; ++i)
+	{
+		resource.deallocate(blocks[i], kab::default_align_v);
+	}
+	REQUIRE(tester.get_current_alloc() == 8 * 64);
+
+	// The resources share the bytes to keep
+	REQUIRE(kab::trim(resource, 4 * 64) == 4 * 64);
+	REQUIRE(tester.get_current_alloc() == 4 * 64);
+	REQUIRE(kab::trim(resource) == 4 * 64);
+	REQUIRE(tester.get_current_alloc() == 0);
+}
+
+TEST_CASE("Periodic trimmer", "[memory]")
+{
+	using clock = kab::periodic_trimmer::clock;
+	using namespace std::chrono_literals;
+
+	test_resource tester;
+	pool p(tester);
+
+	clock::time_point const start{};
+	kab::periodic_trimmer trimmer(10s, 2 * 64, start);
+
+	fill_freelist(p, 8);
+	REQUIRE(trimmer.poll(p, start + 5s) == 0); // too early
+	REQUIRE(tester.get_current_alloc() == 8 * 64);
+
+	REQUIRE(trimmer.poll(p, start + 10s) == 6 * 64);
+	REQUIRE(tester.get_current_alloc() == 2 * 64);
+
+	fill_freelist(p, 8);
+	REQUIRE(trimmer.poll(p, start + 15s) == 0); // the interval restarted on the last trim
+
+	// Pressure trims everything, right away
+	REQUIRE(trimmer.on_pressure(p, start + 16s) == 8 * 64);
+	REQUIRE(tester.get_current_alloc() == 0);
+	REQUIRE(trimmer.poll(p, start + 20s) == 0);
+}
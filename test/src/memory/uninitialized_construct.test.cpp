@@ -0,0 +1,152 @@
+#include "kaballoc/memory/detail/uninitialized_construct.h"
+
+#include <catch.hpp>
+
+#include <string>
+
+namespace
+{
+	struct counted
+	{
+		static inline int alive = 0;
+		static inline int constructions_left = 0;
+
+		int value = 42;
+
+		counted() 
+		{
+			throw_if_exhausted();
+			++alive;
+		}
+		counted(counted const& rhs) 
+			: value(rhs.value)
+		{
+			throw_if_exhausted();
+			++alive;
+		}
+		~counted() { --alive; }
+
+		static void throw_if_exhausted()
+		{
+			if (constructions_left-- == 0)
+			{
+				throw 0;
+			}
+		}
+	};
+
+	struct zero_struct { int a; float b; };
+	enum class zero_enum : short { a = 1 };
+}
+
+namespace kab
+{
+	template<>
+	struct is_zero_initializable<zero_struct> : std::true_type {};
+}
+
+TEST_CASE("Uninitialized Construct Zero Initializable", "[memory]")
+{
+	static_assert(kab::is_zero_initializable_v<int>);
+	static_assert(kab::is_zero_initializable_v<double const>);
+	static_assert(kab::is_zero_initializable_v<int*>);
+	static_assert(kab::is_zero_initializable_v<zero_enum>);
+	static_assert(kab::is_zero_initializable_v<int[4]>);
+	static_assert(kab::is_zero_initializable_v<zero_struct>);
+	static_assert(!kab::is_zero_initializable_v<int zero_struct::*>);
+	static_assert(!kab::is_zero_initializable_v<std::string>);
+	static_assert(!kab::is_zero_initializable_v<counted>);
+}
+
+TEST_CASE("Uninitialized Construct Value", "[memory]")
+{
+	SECTION("Zero initializable")
+	{
+		alignas(zero_struct) unsigned char buffer[sizeof(zero_struct) * 8];
+		memset(buffer, 0xAB, sizeof(buffer));
+
+		auto const p = reinterpret_cast<zero_struct*>(buffer);
+		kab::uninitialized_value_construct_n(p, 8);
+		for (int i = 0; i < 8; ++i)
+		{
+			REQUIRE(p[i].a == 0);
+			REQUIRE(p[i].b == 0.f);
+		}
+	}
+
+	SECTION("Constructor")
+	{
+		counted::constructions_left = 100;
+		alignas(counted) unsigned char buffer[sizeof(counted) * 8];
+
+		auto const p = reinterpret_cast<counted*>(buffer);
+		kab::uninitialized_value_construct_n(p, 8);
+		REQUIRE(counted::alive == 8);
+		REQUIRE(p[7].value == 42);
+
+		kab::destroy_n(p, 8);
+		REQUIRE(counted::alive == 0);
+	}
+}
+
+TEST_CASE("Uninitialized Construct Default", "[memory]")
+{
+	counted::constructions_left = 3; // the fourth construction throws
+	alignas(counted) unsigned char buffer[sizeof(counted) * 8];
+
+	auto const p = reinterpret_cast<counted*>(buffer);
+	REQUIRE_THROWS(kab::uninitialized_default_construct_n(p, 8));
+	REQUIRE(counted::alive == 0);
+
+	counted::constructions_left = 100;
+	kab::uninitialized_default_construct_n(p, 8);
+	REQUIRE(counted::alive == 8);
+	kab::destroy_n(p, 8);
+	REQUIRE(counted::alive == 0);
+}
+
+TEST_CASE("Uninitialized Construct Fill", "[memory]")
+{
+	SECTION("Bytes")
+	{
+		char buffer[37];
+		kab::uninitialized_fill_n(buffer, 37, 'x');
+		for (char c : buffer)
+		{
+			REQUIRE(c == 'x');
+		}
+	}
+
+	SECTION("Trivial")
+	{
+		double buffer[37];
+		kab::uninitialized_fill_n(buffer, 36, 1.5);
+		buffer[36] = 0.;
+		for (int i = 0; i < 36; ++i)
+		{
+			REQUIRE(buffer[i] == 1.5);
+		}
+		REQUIRE(buffer[36] == 0.);
+	}
+
+	SECTION("Throwing copy")
+	{
+		counted::constructions_left = 100;
+		counted const value;
+		REQUIRE(counted::alive == 1);
+
+		alignas(counted) unsigned char buffer[sizeof(counted) * 8];
+		auto const p = reinterpret_cast<counted*>(buffer);
+
+		counted::constructions_left = 5;
+		REQUIRE_THROWS(kab::uninitialized_fill_n(p, 8, value));
+		REQUIRE(counted::alive == 1);
+
+		counted::constructions_left = 100;
+		kab::uninitialized_fill_n(p, 8, value);
+		REQUIRE(counted::alive == 9);
+		kab::destroy_n(p, 8);
+	}
+
+	REQUIRE(counted::alive == 0);
+}
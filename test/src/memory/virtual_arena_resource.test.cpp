@@ -0,0 +1,138 @@
+#include "kaballoc/core/platform.h"
+
+#if KAB_PLATFORM_LINUX
+
+#include "kaballoc/memory/virtual_arena_resource.h"
+#include "kaballoc/memory/resource_reference.h"
+#include "kaballoc/container/vector.h"
+
+#include <catch.hpp>
+
+#include <stdint.h>
+#include <string.h>
+
+using arena_ref = kab::resource_reference<kab::virtual_arena_resource>;
+
+static_assert(kab::detail::has_expand_v<kab::virtual_arena_resource>);
+static_assert(kab::detail::has_expand_v<arena_ref>);
+
+TEST_CASE("Virtual arena allocations", "[memory]")
+{
+	constexpr size_t reserve_size = size_t(1) << 30;
+	kab::virtual_arena_resource arena(reserve_size);
+	REQUIRE(arena.reserved() == reserve_size);
+	REQUIRE(arena.committed() == 0);
+
+	kab::byte_span const a = arena.allocate(128, kab::default_align_v);
+	REQUIRE(a.data != nullptr);
+	REQUIRE(arena.owns(a));
+	REQUIRE(arena.committed() == kab::virtual_arena_resource::default_commit_granularity);
+	memset(a.data, 0xAB, a.size);
+
+	kab::byte_span const b = arena.allocate(200000, kab::align_t(64));
+	REQUIRE(reinterpret_cast<size_t>(b.data) % 64 == 0);
+	REQUIRE(arena.committed() >= arena.used());
+	memset(b.data, 0xCD, b.size);
+
+	// The top allocation grows in place
+	kab::byte_span const expanded = arena.expand(b, 1000000, kab::align_t(64));
+	REQUIRE(expanded.data == b.data);
+	REQUIRE(expanded.size >= 1000000);
+	memset(expanded.data, 0xEF, expanded.size);
+
+	// Other allocations don't
+	REQUIRE(arena.expand(a, 1000, kab::default_align_v).data == nullptr);
+
+	// Exhaustion returns a null span
+	REQUIRE(arena.allocate(reserve_size, kab::default_align_v).data == nullptr);
+	REQUIRE(arena.expand(expanded, reserve_size, kab::align_t(64)).data == nullptr);
+
+	arena.deallocate(expanded, kab::align_t(64));
+	arena.deallocate(a, kab::default_align_v);
+	REQUIRE(arena.used() == 0);
+
+	arena.decommit();
+	REQUIRE(arena.committed() == 0);
+
+	// Decommitted pages are committed again on demand
+	kab::byte_span const c = arena.allocate(100, kab::default_align_v);
+	memset(c.data, 0, c.size);
+	REQUIRE(c.data == a.data);
+}
+
+TEST_CASE("Virtual arena vector growth", "[memory]")
+{
+	kab::virtual_arena_resource arena(size_t(1) << 32);
+
+	kab::vector<int, arena_ref> v(arena);
+	v.push_back(0);
+	int const* const data = v.data();
+	for (int i = 1; i < 1000000; ++i)
+	{
+		v.push_back(i);
+		REQUIRE(v.data() == data); // never relocated
+	}
+	REQUIRE(v[999999] == 999999);
+	REQUIRE(arena.committed() < 2 * 1000000 * sizeof(int));
+
+	// Another allocation on top stops in-place growth, but the vector still grows by reallocating
+	kab::byte_span const blocker = arena.allocate(16, kab::default_align_v);
+	v.reserve(v.capacity() + 1);
+	REQUIRE(v.data() != data);
+	REQUIRE(v[999999] == 999999);
+	arena.deallocate(blocker, kab::default_align_v);
+}
+
+TEST_CASE("Virtual arena over-aligned allocations", "[memory]")
+{
+	// The reservation is only aligned on pages
+	kab::virtual_arena_resource arena(size_t(1) << 30);
+	kab::byte_span const a = arena.allocate(1, kab::default_align_v);
+	REQUIRE(a.data != nullptr);
+
+	for (size_t const alignment : { kab::detail::system_page_size() * 4, size_t(1) << 26 })
+	{
+		kab::byte_span const s = arena.allocate(16, kab::align_t(alignment));
+		REQUIRE(s.data != nullptr);
+		REQUIRE(reinterpret_cast<uintptr_t>(s.data) % alignment == 0);
+		memset(s.data, 1, s.size);
+	}
+}
+
+TEST_CASE("Virtual arena trim", "[memory]")
+{
+	size_t const page_size = kab::detail::system_page_size();
+	kab::virtual_arena_resource arena(size_t(1) << 24, 16 * page_size);
+
+	kab::byte_span const a = arena.allocate(page_size, kab::default_align_v);
+	memset(a.data, 1, a.size);
+	REQUIRE(arena.committed() == 16 * page_size);
+
+	// Idle pages above the top, minus the kept bytes
+	REQUIRE(arena.trim(4 * page_size) == 11 * page_size);
+	REQUIRE(arena.trim(16 * page_size) == 0);
+	REQUIRE(arena.committed() == 16 * page_size);
+
+	// Idle pages can still be used
+	kab::byte_span const b = arena.allocate(15 * page_size, kab::default_align_v);
+	memset(b.data, 2, b.size);
+	REQUIRE(a.data[0] == 1);
+
+	arena.deallocate(b, kab::default_align_v);
+	arena.deallocate(a, kab::default_align_v);
+	REQUIRE(arena.trim(0) == 16 * page_size);
+}
+
+TEST_CASE("Virtual arena move", "[memory]")
+{
+	kab::virtual_arena_resource arena(size_t(1) << 20);
+	kab::byte_span const a = arena.allocate(100, kab::default_align_v);
+
+	kab::virtual_arena_resource moved(std::move(arena));
+	REQUIRE(arena.reserved() == 0);
+	REQUIRE(!arena.owns(a));
+	REQUIRE(moved.owns(a));
+	REQUIRE(arena.allocate(1, kab::default_align_v).data == nullptr);
+}
+
+#endif
@@ -0,0 +1,38 @@
+#include "kaballoc/range/lower_bound.h"
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+TEST_CASE("Lower Bound", "[range]")
+{
+	for (int n : { 0, 1, 2, 3, 7, 8, 9, 100, 1000 })
+	{
+		// Every other value, with duplicates
+		std::vector<int> v(n);
+		for (int i = 0; i < n; ++i)
+		{
+			v[i] = (i / 2) * 2;
+		}
+
+		for (int value = -1; value <= n + 1; ++value)
+		{
+			int const* const result = kab::range::lower_bound(v.data(), v.data() + n, value);
+			auto const expected = std::lower_bound(v.begin(), v.end(), value);
+			REQUIRE(result - v.data() == expected - v.begin());
+		}
+	}
+}
+
+TEST_CASE("Lower Bound Compare", "[range]")
+{
+	std::vector<std::string> v = { "e", "d", "c", "b", "a" };
+	auto const greater = std::greater<>();
+
+	REQUIRE(kab::range::lower_bound(v.data(), v.data() + v.size(), std::string("c"), greater) == v.data() + 2);
+	REQUIRE(kab::range::lower_bound(v.data(), v.data() + v.size(), std::string("f"), greater) == v.data());
+	REQUIRE(kab::range::lower_bound(v.data(), v.data() + v.size(), std::string(""), greater) == v.data() + 5);
+}
@@ -0,0 +1,71 @@
+#include "kaballoc/range/rotate.h"
+
+#include <catch.hpp>
+
+#include "kaballoc/std/unique_ptr.h"
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+TEST_CASE("Rotate Trivial", "[range]")
+{
+	for (int n : { 0, 1, 2, 10, 100, 1000 })
+	{
+		for (int m = 0; m <= n; m += n / 7 + 1)
+		{
+			std::vector<int> v(n);
+			std::iota(v.begin(), v.end(), 0);
+			std::vector<int> expected = v;
+			auto const expected_result = std::rotate(expected.begin(), expected.begin() + m, expected.end());
+
+			int* const result = kab::range::rotate(v.data(), v.data() + m, v.data() + n);
+			REQUIRE(v == expected);
+			REQUIRE(result - v.data() == expected_result - expected.begin());
+		}
+	}
+}
+
+TEST_CASE("Rotate Big Elements", "[range]")
+{
+	// Bigger than the stack buffer, so the sides are exchanged by blocks
+	struct big { int values[100]; };
+
+	std::vector<big> v(50);
+	for (int i = 0; i < 50; ++i)
+	{
+		v[i].values[0] = i;
+		v[i].values[99] = i;
+	}
+
+	big* const result = kab::range::rotate(v.data(), v.data() + 13, v.data() + v.size());
+	REQUIRE(result == v.data() + 37);
+	for (int i = 0; i < 50; ++i)
+	{
+		REQUIRE(v[i].values[0] == (i + 13) % 50);
+		REQUIRE(v[i].values[99] == (i + 13) % 50);
+	}
+}
+
+TEST_CASE("Rotate Relocatable", "[range]")
+{
+	std::vector<kab::unique_ptr<int>> v;
+	for (int i = 0; i < 300; ++i)
+	{
+		v.push_back(std::make_unique<int>(i));
+	}
+
+	kab::range::rotate(v.data(), v.data() + 200, v.data() + v.size());
+	for (int i = 0; i < 300; ++i)
+	{
+		REQUIRE(*v[i] == (i + 200) % 300);
+	}
+}
+
+TEST_CASE("Rotate Non-Relocatable", "[range]")
+{
+	std::vector<std::string> v = { "c", "d", "a", "b" };
+	kab::range::rotate(v.data(), v.data() + 2, v.data() + v.size());
+	REQUIRE(v == std::vector<std::string>{ "a", "b", "c", "d" });
+}
@@ -0,0 +1,67 @@
+#include "kaballoc/range/sort.h"
+
+#include <catch.hpp>
+
+#include "kaballoc/std/unique_ptr.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+TEST_CASE("Sort Trivial", "[range]")
+{
+	std::mt19937 rng(42);
+
+	for (int n : { 0, 1, 2, 15, 16, 17, 100, 1000, 10000 })
+	{
+		std::vector<int> v(n);
+		std::generate(v.begin(), v.end(), [&rng] { return static_cast<int>(rng() % 100); }); // lots of duplicates
+		std::vector<int> expected = v;
+		std::sort(expected.begin(), expected.end());
+
+		kab::range::sort(v.data(), v.data() + v.size());
+		REQUIRE(v == expected);
+
+		kab::range::sort(v.data(), v.data() + v.size(), std::greater<>());
+		REQUIRE(std::is_sorted(v.begin(), v.end(), std::greater<>()));
+	}
+}
+
+TEST_CASE("Sort Sorted Input", "[range]")
+{
+	std::vector<int> v(5000);
+	for (int i = 0; i < 5000; ++i)
+	{
+		v[i] = 5000 - i;
+	}
+
+	kab::range::sort(v.data(), v.data() + v.size());
+	REQUIRE(std::is_sorted(v.begin(), v.end()));
+
+	kab::range::sort(v.data(), v.data() + v.size());
+	REQUIRE(std::is_sorted(v.begin(), v.end()));
+}
+
+TEST_CASE("Sort Relocatable", "[range]")
+{
+	REQUIRE(kab::is_trivially_relocatable_v<kab::unique_ptr<int>>);
+
+	std::mt19937 rng(7);
+	std::vector<kab::unique_ptr<int>> v;
+	for (int i = 0; i < 1000; ++i)
+	{
+		v.push_back(std::make_unique<int>(static_cast<int>(rng() % 500)));
+	}
+
+	kab::range::sort(v.data(), v.data() + v.size(), [](auto const& lhs, auto const& rhs) { return *lhs < *rhs; });
+	REQUIRE(std::is_sorted(v.begin(), v.end(), [](auto const& lhs, auto const& rhs) { return *lhs < *rhs; }));
+	REQUIRE(std::none_of(v.begin(), v.end(), [](auto const& p) { return p == nullptr; }));
+}
+
+TEST_CASE("Sort Non-Relocatable", "[range]")
+{
+	std::vector<std::string> v = { "delta", "alpha", "charlie", "bravo" };
+	kab::range::sort(v.data(), v.data() + v.size());
+	REQUIRE(v == std::vector<std::string>{ "alpha", "bravo", "charlie", "delta" });
+}
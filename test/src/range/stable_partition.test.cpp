@@ -0,0 +1,100 @@
+#include "kaballoc/range/stable_partition.h"
+
+#include <catch.hpp>
+
+#include "kaballoc/memory/resource_reference.h"
+#include "kaballoc/memory/static_resource.h"
+#include "kaballoc/std/unique_ptr.h"
+#include "test_resource.h"
+
+#include <new>
+#include <string>
+#include <vector>
+
+TEST_CASE("Stable Partition Relocatable", "[range]")
+{
+	test_resource r;
+
+	std::vector<kab::unique_ptr<int>> v;
+	for (int i = 0; i < 100; ++i)
+	{
+		v.push_back(std::make_unique<int>(i));
+	}
+
+	auto* const middle = kab::range::stable_partition(v.data(), v.data() + v.size(), [](auto const& p) { return *p % 3 == 0; }, kab::make_reference(r));
+	REQUIRE(middle == v.data() + 34);
+	REQUIRE(r.get_total_alloc() == 100 * sizeof(kab::unique_ptr<int>)); // one scratch allocation
+	REQUIRE(r.get_current_alloc() == 0);
+
+	for (int i = 0; i < 34; ++i)
+	{
+		REQUIRE(*v[i] == i * 3);
+	}
+
+	int previous = -1;
+	for (auto it = v.begin() + 34; it != v.end(); ++it)
+	{
+		REQUIRE(**it % 3 != 0);
+		REQUIRE(**it > previous);
+		previous = **it;
+	}
+}
+
+TEST_CASE("Stable Partition Throwing Predicate", "[range]")
+{
+	test_resource r;
+
+	std::vector<kab::unique_ptr<int>> v;
+	for (int i = 0; i < 10; ++i)
+	{
+		v.push_back(std::make_unique<int>(i));
+	}
+
+	auto const pred = [](auto const& p)
+	{
+		if (*p == 7)
+		{
+			throw 0;
+		}
+		return *p % 2 == 0;
+	};
+	REQUIRE_THROWS(kab::range::stable_partition(v.data(), v.data() + v.size(), pred, kab::make_reference(r)));
+	REQUIRE(r.get_current_alloc() == 0);
+
+	// Every element is still there exactly once
+	std::vector<bool> seen(10);
+	for (auto const& p : v)
+	{
+		REQUIRE(p != nullptr);
+		REQUIRE(!seen[*p]);
+		seen[*p] = true;
+	}
+}
+
+TEST_CASE("Stable Partition Non-Relocatable", "[range]")
+{
+	test_resource r;
+
+	std::vector<std::string> v = { "a1", "b1", "a2", "b2", "a3" };
+	auto* const middle = kab::range::stable_partition(v.data(), v.data() + v.size(), [](std::string const& s) { return s[0] == 'a'; }, kab::make_reference(r));
+	REQUIRE(middle == v.data() + 3);
+	REQUIRE(v == std::vector<std::string>{ "a1", "a2", "a3", "b1", "b2" });
+	REQUIRE(r.get_current_alloc() == 0);
+}
+
+TEST_CASE("Stable Partition Exhausted Resource", "[range]")
+{
+	kab::static_resource<16> r;
+
+	std::vector<int> v;
+	for (int i = 0; i < 64; ++i)
+	{
+		v.push_back(i);
+	}
+
+	REQUIRE_THROWS_AS(kab::range::stable_partition(v.data(), v.data() + v.size(), [](int i) { return i % 2 == 0; }, kab::make_reference(r)), std::bad_alloc);
+	for (int i = 0; i < 64; ++i)
+	{
+		REQUIRE(v[i] == i);
+	}
+}
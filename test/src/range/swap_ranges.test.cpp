@@ -0,0 +1,38 @@
+#include "kaballoc/range/swap_ranges.h"
+
+#include <catch.hpp>
+
+#include "kaballoc/std/unique_ptr.h"
+
+#include <string>
+#include <vector>
+
+TEST_CASE("Swap Ranges Relocatable", "[range]")
+{
+	// More than a stack buffer worth of elements
+	std::vector<kab::unique_ptr<int>> a, b;
+	for (int i = 0; i < 100; ++i)
+	{
+		a.push_back(std::make_unique<int>(i));
+		b.push_back(std::make_unique<int>(-i));
+	}
+
+	auto* const result = kab::range::swap_ranges(a.data(), a.data() + a.size(), b.data());
+	REQUIRE(result == b.data() + b.size());
+	for (int i = 0; i < 100; ++i)
+	{
+		REQUIRE(*a[i] == -i);
+		REQUIRE(*b[i] == i);
+	}
+}
+
+TEST_CASE("Swap Ranges Non-Relocatable", "[range]")
+{
+	std::vector<std::string> a = { "a", "b" };
+	std::vector<std::string> b = { "c", "d", "e" };
+
+	auto* const result = kab::range::swap_ranges(a.data(), a.data() + a.size(), b.data());
+	REQUIRE(result == b.data() + 2);
+	REQUIRE(a == std::vector<std::string>{ "c", "d" });
+	REQUIRE(b == std::vector<std::string>{ "a", "b", "e" });
+}